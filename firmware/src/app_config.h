@@ -32,6 +32,7 @@ struct ProximityState
 {
     uint16_t RangeMilliMeter;
     uint8_t RangeStatus;
+    uint32_t measured_at_us; // micros() when the measurement was read off the sensor
 };
 
 struct StrainState
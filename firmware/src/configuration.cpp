@@ -307,6 +307,164 @@ bool Configuration::setMotorCalibrationAndSave(PB_MotorCalibration &motor_calibr
     return saveToDisk();
 }
 
+bool Configuration::loadCoggingMapFromDisk()
+{
+    SemaphoreGuard lock(mutex_);
+    FatGuard fatGuard;
+    if (!fatGuard.mounted_)
+    {
+        return false;
+    }
+
+    File f = FFat.open(COGGING_PATH);
+    if (!f)
+    {
+        LOGV(LOG_LEVEL_DEBUG, "No cogging map file");
+        return false;
+    }
+
+    size_t read = f.readBytes((char *)cogging_stream_buffer_, sizeof(cogging_stream_buffer_));
+    f.close();
+
+    pb_istream_t stream = pb_istream_from_buffer(cogging_stream_buffer_, read);
+    if (!pb_decode(&stream, PB_CoggingMap_fields, &cogging_map_))
+    {
+        char buf_[200];
+        snprintf(buf_, sizeof(buf_), "Decoding cogging map failed: %s", PB_GET_ERROR(&stream));
+        LOGE(buf_);
+        cogging_map_ = {};
+        return false;
+    }
+
+    LOGV(LOG_LEVEL_DEBUG, "Cogging map: %u samples, scale=%.4f", cogging_map_.samples.size, cogging_map_.scale);
+    return true;
+}
+
+bool Configuration::setCoggingMapAndSave(const PB_CoggingMap &cogging_map)
+{
+    SemaphoreGuard lock(mutex_);
+    cogging_map_ = cogging_map;
+
+    pb_ostream_t stream = pb_ostream_from_buffer(cogging_stream_buffer_, sizeof(cogging_stream_buffer_));
+    if (!pb_encode(&stream, PB_CoggingMap_fields, &cogging_map_))
+    {
+        char buf_[200];
+        snprintf(buf_, sizeof(buf_), "Encoding failed: %s", PB_GET_ERROR(&stream));
+        LOGE(buf_);
+        return false;
+    }
+
+    FatGuard fatGuard;
+    if (!fatGuard.mounted_)
+    {
+        return false;
+    }
+
+    File f = FFat.open(COGGING_PATH, FILE_WRITE);
+    if (!f)
+    {
+        LOGV(LOG_LEVEL_WARNING, "Failed to write cogging map file");
+        return false;
+    }
+
+    size_t written = f.write(cogging_stream_buffer_, stream.bytes_written);
+    f.close();
+
+    LOGD("Saved cogging map. Wrote %d bytes", written);
+
+    if (written != stream.bytes_written)
+    {
+        LOGE("Failed to write all bytes to cogging map file");
+        return false;
+    }
+    return true;
+}
+
+PB_CoggingMap Configuration::getCoggingMap()
+{
+    SemaphoreGuard lock(mutex_);
+    return cogging_map_;
+}
+
+bool Configuration::loadGainScheduleFromDisk()
+{
+    SemaphoreGuard lock(mutex_);
+    FatGuard fatGuard;
+    if (!fatGuard.mounted_)
+    {
+        return false;
+    }
+
+    File f = FFat.open(GAIN_SCHEDULE_PATH);
+    if (!f)
+    {
+        LOGV(LOG_LEVEL_DEBUG, "No gain schedule file");
+        return false;
+    }
+
+    size_t read = f.readBytes((char *)gain_schedule_stream_buffer_, sizeof(gain_schedule_stream_buffer_));
+    f.close();
+
+    pb_istream_t stream = pb_istream_from_buffer(gain_schedule_stream_buffer_, read);
+    if (!pb_decode(&stream, PB_GainSchedule_fields, &gain_schedule_))
+    {
+        char buf_[200];
+        snprintf(buf_, sizeof(buf_), "Decoding gain schedule failed: %s", PB_GET_ERROR(&stream));
+        LOGE(buf_);
+        gain_schedule_ = {};
+        return false;
+    }
+
+    LOGV(LOG_LEVEL_DEBUG, "Gain schedule: %u widths, %u strengths", gain_schedule_.position_widths_radians_count, gain_schedule_.strengths_count);
+    return true;
+}
+
+bool Configuration::setGainScheduleAndSave(const PB_GainSchedule &gain_schedule)
+{
+    SemaphoreGuard lock(mutex_);
+    gain_schedule_ = gain_schedule;
+
+    pb_ostream_t stream = pb_ostream_from_buffer(gain_schedule_stream_buffer_, sizeof(gain_schedule_stream_buffer_));
+    if (!pb_encode(&stream, PB_GainSchedule_fields, &gain_schedule_))
+    {
+        char buf_[200];
+        snprintf(buf_, sizeof(buf_), "Encoding failed: %s", PB_GET_ERROR(&stream));
+        LOGE(buf_);
+        return false;
+    }
+
+    FatGuard fatGuard;
+    if (!fatGuard.mounted_)
+    {
+        return false;
+    }
+
+    File f = FFat.open(GAIN_SCHEDULE_PATH, FILE_WRITE);
+    if (!f)
+    {
+        LOGV(LOG_LEVEL_WARNING, "Failed to write gain schedule file");
+        return false;
+    }
+
+    size_t written = f.write(gain_schedule_stream_buffer_, stream.bytes_written);
+    f.close();
+
+    LOGD("Saved gain schedule. Wrote %d bytes", written);
+
+    if (written != stream.bytes_written)
+    {
+        LOGE("Failed to write all bytes to gain schedule file");
+        return false;
+    }
+    return true;
+}
+
+PB_GainSchedule Configuration::getGainSchedule()
+{
+    SemaphoreGuard lock(mutex_);
+    return gain_schedule_;
+}
+
 void Configuration::setSharedEventsQueue(QueueHandle_t shared_events_queue)
 {
     this->shared_events_queue = shared_events_queue;
@@ -13,6 +13,8 @@
 
 static const char *CONFIG_PATH = "/config.pb";
 static const char *SETTINGS_PATH = "/settings.pb";
+static const char *COGGING_PATH = "/cogging.pb";
+static const char *GAIN_SCHEDULE_PATH = "/gains.pb";
 
 // OS configurations
 static const uint16_t OS_MODE_LENGTH = 1;
@@ -76,6 +78,18 @@ public:
 
     bool setMotorCalibrationAndSave(PB_MotorCalibration &motor_calibration);
 
+    // The cogging map is kept in its own file so it doesn't bloat the persistent configuration (which is also
+    // sent to the host as part of PB_Knob). A missing file just means no cogging compensation.
+    bool loadCoggingMapFromDisk();
+    bool setCoggingMapAndSave(const PB_CoggingMap &cogging_map);
+    PB_CoggingMap getCoggingMap();
+
+    // Uploaded detent controller gain schedule, in its own file for the same reason. A missing file (or an
+    // empty schedule) means the built-in schedule.
+    bool loadGainScheduleFromDisk();
+    bool setGainScheduleAndSave(const PB_GainSchedule &gain_schedule);
+    PB_GainSchedule getGainSchedule();
+
     bool saveOSConfiguration(OSConfiguration os_config);
     bool saveOSConfigurationInMemory(OSConfiguration os_config);
     bool loadOSConfiguration();
@@ -102,6 +116,12 @@ private:
     uint8_t pb_stream_buffer_[PB_PersistentConfiguration_size];
     uint8_t settings_stream_buffer_[SETTINGS_Settings_size];
 
+    PB_CoggingMap cogging_map_ = {};
+    uint8_t cogging_stream_buffer_[PB_CoggingMap_size];
+
+    PB_GainSchedule gain_schedule_ = {};
+    uint8_t gain_schedule_stream_buffer_[PB_GainSchedule_size];
+
     std::string knob_id;
 };
 class FatGuard
@@ -0,0 +1,342 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+// Allocation-free signal filters for the sensor paths. Each one keeps its whole state inline, so it can be a
+// member or a local of a task, and costs the same for every sample however long it runs. Hardware independent.
+//
+// Pick by what the signal needs:
+// - RunningAverage: exact mean of the last N samples, e.g. to tare on. Delays a step by N / 2 samples.
+// - Ewma: one multiply per sample, for slow drift and background values where a little lag doesn't matter.
+// - MedianFilter: drops up to (N - 1) / 2 outliers in a row without smearing them into the output.
+// - Biquad: second order low/high pass with a sharp corner, for a fixed sample rate.
+// - OneEuroFilter: smooths hard while the signal is still, and follows it with little lag once it moves.
+
+// Mean of the last N samples, kept as a running sum. Sum must hold N samples of T without overflowing (or, for
+// floats, without losing the precision that subtracting old samples back out relies on).
+template <typename T, uint16_t N, typename Sum = T>
+class RunningAverage
+{
+public:
+    static_assert(N > 0, "RunningAverage needs a window");
+
+    void add(T sample)
+    {
+        if (count_ == N)
+        {
+            sum_ -= window_[next_];
+        }
+        else
+        {
+            count_++;
+        }
+        window_[next_] = sample;
+        sum_ += sample;
+        next_ = next_ + 1 == N ? 0 : next_ + 1;
+    }
+
+    void clear()
+    {
+        sum_ = 0;
+        next_ = 0;
+        count_ = 0;
+    }
+
+    // Mean of the samples so far, up to the last N; 0 before the first one
+    float average() const
+    {
+        if (count_ == 0)
+        {
+            return 0;
+        }
+        // Divided in Sum before converting, so a wide integer sum isn't rounded to a float's 24 bits first
+        Sum mean = sum_ / count_;
+        return (float)mean + (float)(sum_ - mean * count_) / count_;
+    }
+
+    Sum sum() const
+    {
+        return sum_;
+    }
+
+    uint16_t count() const
+    {
+        return count_;
+    }
+
+    bool isFull() const
+    {
+        return count_ == N;
+    }
+
+private:
+    T window_[N] = {};
+    Sum sum_ = 0;
+    uint16_t next_ = 0;
+    uint16_t count_ = 0;
+};
+
+// Exponentially weighted moving average. The first sample after a reset is taken as is.
+class Ewma
+{
+public:
+    explicit Ewma(float alpha = 1) : alpha_(alpha)
+    {
+    }
+
+    // Weight of a new sample that gives the average time_constant, for samples dt apart (in the same unit)
+    static float alphaFor(float time_constant, float dt)
+    {
+        return dt / (time_constant + dt);
+    }
+
+    void setAlpha(float alpha)
+    {
+        alpha_ = alpha;
+    }
+
+    float add(float sample)
+    {
+        return add(sample, alpha_);
+    }
+
+    // For unevenly spaced samples: weighs this one by alpha instead of the configured weight
+    float add(float sample, float alpha)
+    {
+        if (!has_value_)
+        {
+            has_value_ = true;
+            value_ = sample;
+        }
+        else
+        {
+            value_ += alpha * (sample - value_);
+        }
+        return value_;
+    }
+
+    void reset()
+    {
+        has_value_ = false;
+        value_ = 0;
+    }
+
+    void reset(float value)
+    {
+        has_value_ = true;
+        value_ = value;
+    }
+
+    float value() const
+    {
+        return value_;
+    }
+
+    bool hasValue() const
+    {
+        return has_value_;
+    }
+
+private:
+    float alpha_;
+    bool has_value_ = false;
+    float value_ = 0;
+};
+
+// Median of the last N samples (N odd). The window is also kept sorted, so a sample costs one shift of at most N
+// entries out of it and one into it, with no sorting.
+template <typename T, uint8_t N>
+class MedianFilter
+{
+public:
+    static_assert(N % 2 == 1, "MedianFilter needs an odd window");
+
+    T add(T sample)
+    {
+        uint8_t i;
+        if (count_ == N)
+        {
+            // Close the gap the oldest sample leaves in the sorted window
+            T oldest = window_[next_];
+            // (the last slot if it isn't found, e.g. a NaN, so the window can't overrun)
+            i = 0;
+            while (i + 1 < count_ && sorted_[i] != oldest)
+            {
+                i++;
+            }
+            for (; i + 1 < count_; i++)
+            {
+                sorted_[i] = sorted_[i + 1];
+            }
+            count_--;
+        }
+        window_[next_] = sample;
+        next_ = next_ + 1 == N ? 0 : next_ + 1;
+
+        for (i = count_; i > 0 && sorted_[i - 1] > sample; i--)
+        {
+            sorted_[i] = sorted_[i - 1];
+        }
+        sorted_[i] = sample;
+        count_++;
+        return value();
+    }
+
+    void clear()
+    {
+        next_ = 0;
+        count_ = 0;
+    }
+
+    // Median of the samples so far, up to the last N (the upper one of an even count); 0 before the first one
+    T value() const
+    {
+        return count_ == 0 ? T() : sorted_[count_ / 2];
+    }
+
+    uint8_t count() const
+    {
+        return count_;
+    }
+
+private:
+    T window_[N] = {};
+    T sorted_[N] = {};
+    uint8_t next_ = 0;
+    uint8_t count_ = 0;
+};
+
+// Second order IIR section (transposed direct form II) with the RBJ cookbook low and high pass designs
+class Biquad
+{
+public:
+    struct Coefficients
+    {
+        float b0, b1, b2;
+        float a1, a2;
+    };
+
+    // cutoff_hz below sample_hz / 2; q of 0.7071 is Butterworth, the flattest without overshoot
+    static Coefficients lowPass(float cutoff_hz, float sample_hz, float q = 0.7071f)
+    {
+        float w0 = 2 * (float)M_PI * cutoff_hz / sample_hz;
+        float cos_w0 = cosf(w0);
+        float alpha = sinf(w0) / (2 * q);
+        float a0 = 1 + alpha;
+        return {
+            .b0 = (1 - cos_w0) / 2 / a0,
+            .b1 = (1 - cos_w0) / a0,
+            .b2 = (1 - cos_w0) / 2 / a0,
+            .a1 = -2 * cos_w0 / a0,
+            .a2 = (1 - alpha) / a0,
+        };
+    }
+
+    static Coefficients highPass(float cutoff_hz, float sample_hz, float q = 0.7071f)
+    {
+        float w0 = 2 * (float)M_PI * cutoff_hz / sample_hz;
+        float cos_w0 = cosf(w0);
+        float alpha = sinf(w0) / (2 * q);
+        float a0 = 1 + alpha;
+        return {
+            .b0 = (1 + cos_w0) / 2 / a0,
+            .b1 = -(1 + cos_w0) / a0,
+            .b2 = (1 + cos_w0) / 2 / a0,
+            .a1 = -2 * cos_w0 / a0,
+            .a2 = (1 - alpha) / a0,
+        };
+    }
+
+    Biquad() : c_{1, 0, 0, 0, 0}
+    {
+    }
+
+    explicit Biquad(const Coefficients &coefficients) : c_(coefficients)
+    {
+    }
+
+    void setCoefficients(const Coefficients &coefficients)
+    {
+        c_ = coefficients;
+    }
+
+    float add(float sample)
+    {
+        float out = c_.b0 * sample + z1_;
+        z1_ = c_.b1 * sample - c_.a1 * out + z2_;
+        z2_ = c_.b2 * sample - c_.a2 * out;
+        return out;
+    }
+
+    // Settles the state as if sample had been the input forever, so a low pass starts at it instead of ringing up
+    // from 0
+    void reset(float sample = 0)
+    {
+        float out = sample * (c_.b0 + c_.b1 + c_.b2) / (1 + c_.a1 + c_.a2);
+        z2_ = c_.b2 * sample - c_.a2 * out;
+        z1_ = c_.b1 * sample - c_.a1 * out + z2_;
+    }
+
+private:
+    Coefficients c_;
+    float z1_ = 0;
+    float z2_ = 0;
+};
+
+// One Euro filter (Casiez et al., CHI 2012): a first order low pass whose cutoff rises with the signal's speed.
+// min_cutoff_hz sets the smoothing (and lag) at rest, beta how quickly the cutoff opens up per unit/s of speed,
+// and derivative_cutoff_hz the smoothing of the speed estimate itself.
+class OneEuroFilter
+{
+public:
+    OneEuroFilter(float min_cutoff_hz, float beta, float derivative_cutoff_hz = 1)
+        : min_cutoff_hz_(min_cutoff_hz), beta_(beta), derivative_cutoff_hz_(derivative_cutoff_hz)
+    {
+    }
+
+    float add(float sample, uint32_t timestamp_us)
+    {
+        if (!value_.hasValue())
+        {
+            value_.reset(sample);
+            speed_.reset(0);
+            last_us_ = timestamp_us;
+            return sample;
+        }
+        float dt = (timestamp_us - last_us_) / 1e6f;
+        last_us_ = timestamp_us;
+        if (dt <= 0)
+        {
+            return value_.value();
+        }
+
+        float speed = speed_.add((sample - value_.value()) / dt, alphaFor(derivative_cutoff_hz_, dt));
+        float cutoff_hz = min_cutoff_hz_ + beta_ * fabsf(speed);
+        return value_.add(sample, alphaFor(cutoff_hz, dt));
+    }
+
+    void reset()
+    {
+        value_.reset();
+        speed_.reset();
+    }
+
+    float value() const
+    {
+        return value_.value();
+    }
+
+private:
+    static float alphaFor(float cutoff_hz, float dt)
+    {
+        return Ewma::alphaFor(1 / (2 * (float)M_PI * cutoff_hz), dt);
+    }
+
+    float min_cutoff_hz_;
+    float beta_;
+    float derivative_cutoff_hz_;
+    Ewma value_;
+    Ewma speed_;
+    uint32_t last_us_ = 0;
+};
@@ -0,0 +1,64 @@
+#include "angle_observer.h"
+
+#include <math.h>
+
+// Gaps longer than this (e.g. the loop was stopped) restart the observer instead of extrapolating across them
+static const uint32_t MAX_SAMPLE_GAP_US = 20 * 1000;
+
+ObserverGains ObserverGains::criticallyDamped(float bandwidth_hz, float sample_period_s)
+{
+    // Standard critically damped g-h-k filter with discount factor theta
+    float theta = expf(-2 * M_PI * bandwidth_hz * sample_period_s);
+    float one_minus_theta = 1 - theta;
+    return {
+        .alpha = 1 - theta * theta * theta,
+        .beta = 1.5f * one_minus_theta * one_minus_theta * (1 + theta),
+        .gamma = 0.5f * one_minus_theta * one_minus_theta * one_minus_theta,
+    };
+}
+
+AngleObserver::AngleObserver(const ObserverGains &gains) : gains_(gains)
+{
+}
+
+void AngleObserver::reset(MultiTurnAngle angle, uint32_t now_us)
+{
+    estimate_ = {
+        .angle = angle,
+        .velocity = 0,
+        .acceleration = 0,
+    };
+    last_update_us_ = now_us;
+}
+
+const ObserverEstimate &AngleObserver::update(MultiTurnAngle measured_angle, uint32_t now_us)
+{
+    uint32_t elapsed_us = now_us - last_update_us_;
+    if (elapsed_us == 0)
+    {
+        return estimate_;
+    }
+    if (elapsed_us > MAX_SAMPLE_GAP_US)
+    {
+        reset(measured_angle, now_us);
+        return estimate_;
+    }
+    last_update_us_ = now_us;
+    float dt = elapsed_us * 1e-6f;
+
+    // Predict
+    MultiTurnAngle angle = estimate_.angle.offsetBy(estimate_.velocity * dt + 0.5f * estimate_.acceleration * dt * dt);
+    float velocity = estimate_.velocity + estimate_.acceleration * dt;
+
+    // Correct with the residual
+    float residual = measured_angle.radiansFrom(angle);
+    estimate_.angle = angle.offsetBy(gains_.alpha * residual);
+    estimate_.velocity = velocity + gains_.beta * residual / dt;
+    estimate_.acceleration += 2 * gains_.gamma * residual / (dt * dt);
+    return estimate_;
+}
+
+const ObserverEstimate &AngleObserver::getEstimate() const
+{
+    return estimate_;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "fixed_angle.h"
+
+// Alpha-beta-gamma observer estimating knob angle, velocity and acceleration from timestamped angle samples.
+// It replaces the chain of fixed low-pass filters (sensor EWMA, SimpleFOC's angle/velocity LPFs) that each added
+// lag: the observer predicts forward with its velocity and acceleration estimates, so a steady rotation is
+// tracked without lag while sensor noise is still smoothed.
+//
+// Like HapticEngine it only consumes numbers, so it can be run on recorded or simulated traces on the host.
+
+struct ObserverGains
+{
+    float alpha; // angle correction per sample
+    float beta;  // velocity correction, per sample period
+    float gamma; // acceleration correction, per half sample period squared
+
+    // Critically damped gains (all three observer poles at the same place) for the given bandwidth, at a
+    // nominal sample period. Higher bandwidth follows quick moves more closely; lower smooths more noise.
+    static ObserverGains criticallyDamped(float bandwidth_hz, float sample_period_s);
+};
+
+struct ObserverEstimate
+{
+    MultiTurnAngle angle;
+    float velocity;     // rad/s
+    float acceleration; // rad/s^2
+};
+
+class AngleObserver
+{
+public:
+    AngleObserver(const ObserverGains &gains);
+
+    // Restarts the estimate at rest at the given angle
+    void reset(MultiTurnAngle angle, uint32_t now_us);
+
+    // Feeds a new angle sample taken at now_us
+    const ObserverEstimate &update(MultiTurnAngle measured_angle, uint32_t now_us);
+
+    const ObserverEstimate &getEstimate() const;
+
+private:
+    ObserverGains gains_;
+    ObserverEstimate estimate_ = {};
+    uint32_t last_update_us_ = 0;
+};
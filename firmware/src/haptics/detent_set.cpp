@@ -0,0 +1,18 @@
+#include "detent_set.h"
+
+bool detentSetContains(const PB_DetentSet &set, int32_t position)
+{
+    bool detent = false;
+    if (set.period > 0)
+    {
+        // 64-bit so the distance from period_offset can't overflow
+        detent = ((int64_t)position - set.period_offset) % set.period == 0;
+    }
+
+    int64_t bit = (int64_t)position - set.bitmap_start;
+    if (bit >= 0 && bit < set.bitmap.size * 8)
+    {
+        detent ^= (set.bitmap.bytes[bit >> 3] >> (bit & 7)) & 1;
+    }
+    return detent;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "../proto/proto_gen/smartknob.pb.h"
+
+// Magnetic detent positions uploaded as a PB_DetentSet: a periodic rule with a bitmap of exceptions. Membership
+// is a constant-time test, so the haptic loop can evaluate it every tick for any position the knob reaches.
+
+static const uint8_t DETENT_SET_SLOTS = 4;
+
+// True if the given position has a magnetic detent in the set
+bool detentSetContains(const PB_DetentSet &set, int32_t position);
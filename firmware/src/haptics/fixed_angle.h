@@ -0,0 +1,114 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+// Angle within one turn as an unsigned Q32 fraction of a full turn (0x40000000 = PI/2, 0x80000000 = PI). Unsigned
+// overflow wraps exactly like the angle does, so sums, differences and negation need no fmod and no range checks,
+// and the top bits index per-revolution lookup tables directly. Sensor readings enter as raw counts without a
+// float conversion; only the final result is turned into radians for SimpleFOC and the haptics.
+
+static const float FIXED_ANGLE_Q32_TO_RADIANS = 2 * M_PI / 4294967296.0;
+static const float FIXED_ANGLE_RADIANS_TO_Q32 = 4294967296.0 / (2 * M_PI);
+
+struct FixedAngle
+{
+    uint32_t turns;
+
+    // Raw reading of an absolute sensor with the given resolution, e.g. fromCounts(value, 14) for the MT6701
+    static FixedAngle fromCounts(uint32_t counts, uint8_t bits)
+    {
+        return {counts << (32 - bits)};
+    }
+
+    // Any angle, wrapped into one turn
+    static FixedAngle fromRadians(float radians)
+    {
+        // Converting through int64 wraps negative and multi-turn angles modulo 2^32 without fmodf
+        return {(uint32_t)(int64_t)(radians * FIXED_ANGLE_RADIANS_TO_Q32)};
+    }
+
+    // In [0, 2PI]; the upper end only through float rounding of angles just below a full turn
+    float toRadians() const
+    {
+        return turns * FIXED_ANGLE_Q32_TO_RADIANS;
+    }
+
+    // Shortest signed angle from other to this one, in [-PI, PI)
+    float radiansFrom(FixedAngle other) const
+    {
+        return (int32_t)(turns - other.turns) * FIXED_ANGLE_Q32_TO_RADIANS;
+    }
+
+    // Entry of a table with 2^bits entries over one turn that this angle falls into, and the position between
+    // that entry and the next as a Q16 fraction
+    uint32_t tableIndex(uint8_t bits) const
+    {
+        return turns >> (32 - bits);
+    }
+    uint32_t tableFractionQ16(uint8_t bits) const
+    {
+        return (turns << bits) >> 16;
+    }
+
+    FixedAngle operator+(FixedAngle other) const
+    {
+        return {turns + other.turns};
+    }
+    FixedAngle operator-(FixedAngle other) const
+    {
+        return {turns - other.turns};
+    }
+    FixedAngle operator-() const
+    {
+        return {0u - turns};
+    }
+};
+
+// Unbounded angle as a signed Q32 number of turns: whole turns in the upper 32 bits, a FixedAngle in the lower.
+// A float angle loses resolution as the knob keeps turning (at 10^4 rad one float step is already ~1 mrad);
+// this keeps the same 2^-32 turn resolution over +-2^31 turns. Work on differences between two of these
+// (radiansFrom), which are small and exact as floats, rather than on absolute values.
+struct MultiTurnAngle
+{
+    int64_t turns_q32;
+
+    // Whole turns plus an angle within that turn, as SimpleFOC's Sensor reports them. An angle of exactly 2PI
+    // (float rounding) simply lands on the next turn instead of wrapping back.
+    static MultiTurnAngle fromTurns(int32_t full_turns, float radians)
+    {
+        return {(int64_t)full_turns * 4294967296LL + llroundf(radians * FIXED_ANGLE_RADIANS_TO_Q32)};
+    }
+
+    static MultiTurnAngle fromRadians(float radians)
+    {
+        return fromTurns(0, radians);
+    }
+
+    // Only for display; loses resolution far from zero
+    float toRadians() const
+    {
+        return turns_q32 * FIXED_ANGLE_Q32_TO_RADIANS;
+    }
+
+    float radiansFrom(MultiTurnAngle other) const
+    {
+        return (turns_q32 - other.turns_q32) * FIXED_ANGLE_Q32_TO_RADIANS;
+    }
+
+    // Rounded to the nearest Q32 step, so moving by a float and back by the same float returns exactly here
+    MultiTurnAngle offsetBy(float radians) const
+    {
+        return {turns_q32 + llroundf(radians * FIXED_ANGLE_RADIANS_TO_Q32)};
+    }
+
+    FixedAngle withinTurn() const
+    {
+        return {(uint32_t)turns_q32};
+    }
+
+    MultiTurnAngle operator-() const
+    {
+        return {-turns_q32};
+    }
+};
@@ -0,0 +1,81 @@
+#include "flywheel.h"
+
+#include <math.h>
+
+#include "haptic_engine.h"
+
+static const uint32_t FLYWHEEL_MAX_STEP_US = 20 * 1000;
+
+// Kept clear of the engine's runaway guard, which would otherwise cut the torque of a fast flick mid-spin
+static const float FLYWHEEL_MAX_VELOCITY = 0.75 * RUNAWAY_VELOCITY_RAD_PER_SEC;
+
+void Flywheel::configure(float inertia, float friction)
+{
+    inertia_ = inertia;
+    friction_ = friction;
+}
+
+void Flywheel::reset(MultiTurnAngle angle)
+{
+    angle_ = angle;
+    velocity_ = 0;
+}
+
+float Flywheel::update(MultiTurnAngle angle, float velocity, float stiffness, float damping, uint32_t now_us)
+{
+    uint32_t step_us = now_us - last_update_us_;
+    last_update_us_ = now_us;
+    if (step_us == 0 || step_us > FLYWHEEL_MAX_STEP_US)
+    {
+        reset(angle);
+        return 0;
+    }
+    float dt = step_us * 1e-6f;
+
+    // Solve J * (v1 - v0) / dt = -k * (offset + (v1 - v) * dt) - c * (v1 - v) - friction for the new flywheel
+    // velocity v1, with the knob at angle and velocity v
+    float offset = angle_.radiansFrom(angle);
+    float resistance = inertia_ / dt + stiffness * dt + damping;
+    float new_velocity = (inertia_ / dt * velocity_ - stiffness * offset + (stiffness * dt + damping) * velocity) / resistance;
+
+    // Friction slows the flywheel down to a stop, but never reverses it
+    float friction_step = inertia_ * friction_ / resistance;
+    if (fabsf(new_velocity) <= friction_step)
+    {
+        new_velocity = 0;
+    }
+    else
+    {
+        new_velocity -= new_velocity > 0 ? friction_step : -friction_step;
+    }
+    if (new_velocity > FLYWHEEL_MAX_VELOCITY)
+    {
+        new_velocity = FLYWHEEL_MAX_VELOCITY;
+    }
+    else if (new_velocity < -FLYWHEEL_MAX_VELOCITY)
+    {
+        new_velocity = -FLYWHEEL_MAX_VELOCITY;
+    }
+
+    velocity_ = new_velocity;
+    angle_ = angle_.offsetBy(new_velocity * dt);
+
+    // The same spring-damper force, in the other direction, on the knob
+    float relative_velocity = new_velocity - velocity;
+    return stiffness * (offset + relative_velocity * dt) + damping * relative_velocity;
+}
+
+float Flywheel::getVelocity() const
+{
+    return velocity_;
+}
+
+MultiTurnAngle Flywheel::getAngle() const
+{
+    return angle_;
+}
+
+float Flywheel::getInertia() const
+{
+    return inertia_;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "fixed_angle.h"
+
+// Virtual flywheel for MOTION_FLYWHEEL: a spinning mass with friction, attached to the knob through a spring-damper
+// (a "virtual coupling"). Turning the knob spins it up, so the knob feels heavier; let go and the flywheel drags
+// the knob along until friction stops it.
+//
+// The flywheel is integrated with backward Euler against the knob's current state, so it can't gain energy on its
+// own however light it is next to the coupling stiffness. What is left is the one-sample delay of the coupling
+// torque reaching the knob, which the coupling's damping has to cover (see docs/Firmware/motor_control.md).
+class Flywheel
+{
+public:
+    // inertia in torque units per rad/s^2, friction as the deceleration it causes in rad/s^2
+    void configure(float inertia, float friction);
+
+    // Puts the flywheel at rest at the given angle
+    void reset(MultiTurnAngle angle);
+
+    // Advances the flywheel to now_us and returns the coupling torque on the knob. After a gap in updates (the
+    // motor idling, a blocking command) the flywheel restarts at rest at the knob instead.
+    float update(MultiTurnAngle angle, float velocity, float stiffness, float damping, uint32_t now_us);
+
+    float getVelocity() const;
+    MultiTurnAngle getAngle() const;
+    float getInertia() const;
+
+private:
+    float inertia_ = 0.01;
+    float friction_ = 0;
+
+    MultiTurnAngle angle_ = {};
+    float velocity_ = 0;
+    uint32_t last_update_us_ = 0;
+};
@@ -0,0 +1,147 @@
+#include "gain_schedule.h"
+
+#include <math.h>
+
+static const float DEFAULT_P_PER_STRENGTH = 4;
+static const float DEFAULT_FINE_D_PER_STRENGTH = 0.08;
+static const float DEFAULT_COARSE_D_PER_STRENGTH = 0.02;
+static const float DEFAULT_FINE_WIDTH_RAD = 3 * M_PI / 180;
+static const float DEFAULT_COARSE_WIDTH_RAD = 8 * M_PI / 180;
+
+static bool isEmpty(const PB_GainSchedule &schedule)
+{
+    return schedule.position_widths_radians_count == 0 && schedule.strengths_count == 0 && schedule.p_count == 0 &&
+           schedule.d_count == 0 && schedule.output_ramp_count == 0;
+}
+
+static bool isAscending(const float *values, pb_size_t count)
+{
+    for (pb_size_t i = 0; i < count; i++)
+    {
+        // Written as negations so NaNs are rejected too
+        if (!isfinite(values[i]) || !(values[i] >= 0) || (i > 0 && !(values[i] > values[i - 1])))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool isValidGains(const float *values, pb_size_t count, pb_size_t expected_count)
+{
+    if (count != expected_count)
+    {
+        return false;
+    }
+    for (pb_size_t i = 0; i < count; i++)
+    {
+        if (!isfinite(values[i]) || !(values[i] >= 0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Finds the interval of the axis containing x (clamped to the ends): returns its first index and the fraction
+// of the way to the next entry
+static pb_size_t locate(const float *axis, pb_size_t count, float x, float *fraction)
+{
+    *fraction = 0;
+    if (!(x > axis[0]))
+    {
+        return 0;
+    }
+    for (pb_size_t i = 1; i < count; i++)
+    {
+        if (x < axis[i])
+        {
+            *fraction = (x - axis[i - 1]) / (axis[i] - axis[i - 1]);
+            return i - 1;
+        }
+    }
+    return count - 1;
+}
+
+GainSchedule::GainSchedule(float output_ramp) : default_output_ramp_(output_ramp)
+{
+    set({});
+}
+
+bool GainSchedule::set(const PB_GainSchedule &schedule)
+{
+    if (!isValid(schedule))
+    {
+        return false;
+    }
+    if (!isEmpty(schedule))
+    {
+        schedule_ = schedule;
+        return true;
+    }
+
+    schedule_ = {};
+    schedule_.position_widths_radians_count = 2;
+    schedule_.position_widths_radians[0] = DEFAULT_FINE_WIDTH_RAD;
+    schedule_.position_widths_radians[1] = DEFAULT_COARSE_WIDTH_RAD;
+    schedule_.strengths_count = 1;
+    schedule_.strengths[0] = 1;
+    for (uint8_t mode = 0; mode < GAIN_SCHEDULE_MODES; mode++)
+    {
+        bool damped = mode != PB_GainScheduleMode_GAIN_MODE_MAGNETIC;
+        for (uint8_t width = 0; width < 2; width++)
+        {
+            uint8_t i = mode * 2 + width;
+            schedule_.p[i] = DEFAULT_P_PER_STRENGTH;
+            schedule_.d[i] = damped ? (width == 0 ? DEFAULT_FINE_D_PER_STRENGTH : DEFAULT_COARSE_D_PER_STRENGTH) : 0;
+            schedule_.output_ramp[i] = default_output_ramp_;
+        }
+    }
+    schedule_.p_count = schedule_.d_count = schedule_.output_ramp_count = GAIN_SCHEDULE_MODES * 2;
+    return true;
+}
+
+bool GainSchedule::isValid(const PB_GainSchedule &schedule)
+{
+    if (isEmpty(schedule))
+    {
+        return true;
+    }
+    pb_size_t widths = schedule.position_widths_radians_count;
+    pb_size_t strengths = schedule.strengths_count;
+    if (widths == 0 || widths > GAIN_SCHEDULE_MAX_WIDTHS || strengths == 0 || strengths > GAIN_SCHEDULE_MAX_STRENGTHS ||
+        !isAscending(schedule.position_widths_radians, widths) || !isAscending(schedule.strengths, strengths))
+    {
+        return false;
+    }
+    pb_size_t entries = GAIN_SCHEDULE_MODES * widths * strengths;
+    return isValidGains(schedule.p, schedule.p_count, entries) && isValidGains(schedule.d, schedule.d_count, entries) &&
+           isValidGains(schedule.output_ramp, schedule.output_ramp_count, entries);
+}
+
+ScheduledGains GainSchedule::lookup(PB_GainScheduleMode mode, float position_width_radians, float strength) const
+{
+    pb_size_t widths = schedule_.position_widths_radians_count;
+    pb_size_t strengths = schedule_.strengths_count;
+
+    float width_fraction;
+    float strength_fraction;
+    pb_size_t w0 = locate(schedule_.position_widths_radians, widths, position_width_radians, &width_fraction);
+    pb_size_t s0 = locate(schedule_.strengths, strengths, strength, &strength_fraction);
+    pb_size_t w1 = w0 + 1 < widths ? w0 + 1 : w0;
+    pb_size_t s1 = s0 + 1 < strengths ? s0 + 1 : s0;
+
+    pb_size_t base = mode * widths * strengths;
+    auto interpolate = [&](const float *table)
+    {
+        float low = table[base + w0 * strengths + s0] + (table[base + w0 * strengths + s1] - table[base + w0 * strengths + s0]) * strength_fraction;
+        float high = table[base + w1 * strengths + s0] + (table[base + w1 * strengths + s1] - table[base + w1 * strengths + s0]) * strength_fraction;
+        return low + (high - low) * width_fraction;
+    };
+
+    return {
+        .p = interpolate(schedule_.p) * strength,
+        .d = interpolate(schedule_.d) * strength,
+        .output_ramp = interpolate(schedule_.output_ramp),
+    };
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "../proto/proto_gen/smartknob.pb.h"
+
+// Detent controller gains as a function of the config, from a PB_GainSchedule table. Looking up is a bilinear
+// interpolation over (position width, strength) within the mode's rows; the engine does it once per config
+// change and the per-tick controller just uses the result.
+//
+// The built-in schedule reproduces the original hand-tuned rule: P = 4 per unit of strength, D per unit of
+// strength falling linearly from 0.08 at 3 degree detents to 0.02 at 8 degrees (fine detents need the extra
+// damping to click, coarse ones would amplify sensor noise), and no D with magnetic detents, where it adds
+// extra clicks when nearing a detent.
+
+static const uint8_t GAIN_SCHEDULE_MODES = _PB_GainScheduleMode_ARRAYSIZE;
+static const uint8_t GAIN_SCHEDULE_MAX_WIDTHS = sizeof(PB_GainSchedule::position_widths_radians) / sizeof(float);
+static const uint8_t GAIN_SCHEDULE_MAX_STRENGTHS = sizeof(PB_GainSchedule::strengths) / sizeof(float);
+
+struct ScheduledGains
+{
+    float p;
+    float d;
+    float output_ramp;
+};
+
+class GainSchedule
+{
+public:
+    // output_ramp is the motor profile's, used throughout the built-in schedule
+    GainSchedule(float output_ramp);
+
+    // Replaces the table; an empty schedule restores the built-in one. Returns false, keeping the current
+    // table, if the schedule is invalid.
+    bool set(const PB_GainSchedule &schedule);
+
+    // Axes ascending with matching table sizes, and every gain finite and non-negative
+    static bool isValid(const PB_GainSchedule &schedule);
+
+    // Gains for the given mode, already multiplied by the strength
+    ScheduledGains lookup(PB_GainScheduleMode mode, float position_width_radians, float strength) const;
+
+private:
+    PB_GainSchedule schedule_;
+    float default_output_ramp_;
+};
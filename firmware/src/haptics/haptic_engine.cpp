@@ -0,0 +1,457 @@
+#include "haptic_engine.h"
+
+#include <math.h>
+
+static const float DEAD_ZONE_DETENT_PERCENT = 0.2;
+static const float DEAD_ZONE_RAD = 1 * M_PI / 180;
+
+static const float IDLE_VELOCITY_EWMA_ALPHA = 0.001;
+static const float IDLE_VELOCITY_RAD_PER_SEC = 0.05;
+static const uint32_t IDLE_CORRECTION_DELAY_MICROS = 500 * 1000;
+static const float IDLE_CORRECTION_MAX_ANGLE_RAD = 5 * M_PI / 180;
+static const float IDLE_CORRECTION_RATE_ALPHA = 0.0005;
+
+static const float DETENT_TORQUE_LIMIT = 10;
+
+static const float FLYWHEEL_DEFAULT_INERTIA = 0.01;
+
+static float clampf(const float value, const float low, const float high)
+{
+    return value < low ? low : (value > high ? high : value);
+}
+
+const char *hapticConfigStatusToString(HapticConfigStatus status)
+{
+    switch (status)
+    {
+    case HapticConfigStatus::OK:
+        return "OK";
+    case HapticConfigStatus::NEGATIVE_DETENT_STRENGTH:
+        return "detent_strength_unit cannot be negative";
+    case HapticConfigStatus::NEGATIVE_ENDSTOP_STRENGTH:
+        return "endstop_strength_unit cannot be negative";
+    case HapticConfigStatus::SNAP_POINT_TOO_SMALL:
+        return "snap_point must be >= 0.5 for stability";
+    case HapticConfigStatus::TOO_MANY_DETENT_POSITIONS:
+        return "detent_positions_count is too large";
+    case HapticConfigStatus::NEGATIVE_SNAP_POINT_BIAS:
+        return "snap_point_bias cannot be negative or there is risk of instability";
+    case HapticConfigStatus::UNKNOWN_TORQUE_PROFILE:
+        return "torque_profile_id does not refer to an uploaded torque profile";
+    case HapticConfigStatus::INVALID_TORQUE_PROFILE:
+        return "torque profile cannot be used with this config";
+    case HapticConfigStatus::UNKNOWN_DETENT_SET:
+        return "detent_set_id does not refer to an uploaded detent set";
+    case HapticConfigStatus::UNKNOWN_MOTION_MODEL:
+        return "motion_model is not supported";
+    case HapticConfigStatus::NEGATIVE_FLYWHEEL_PARAMETER:
+        return "flywheel_inertia and flywheel_friction cannot be negative";
+    case HapticConfigStatus::NEGATIVE_SPRING_DEAD_BAND:
+        return "spring_dead_band_radians cannot be negative";
+    }
+    return "unknown";
+}
+
+HapticEngine::HapticEngine(const HapticGains &gains) : gain_schedule_(gains.output_ramp)
+{
+    controller_.P = gains.p;
+    controller_.I = gains.i;
+    controller_.D = gains.d;
+    controller_.output_ramp = gains.output_ramp;
+    controller_.limit = gains.limit;
+
+    config_ = {
+        .position_width_radians = 60 * M_PI / 180,
+        .endstop_strength_unit = 0,
+        .snap_point = 0.5,
+        .detent_positions_count = 0,
+        .detent_positions = {},
+    };
+    scheduleGains();
+}
+
+void HapticEngine::reset(MultiTurnAngle angle)
+{
+    current_detent_center_ = angle;
+    placeSpringHome();
+    flywheel_.reset(angle);
+}
+
+HapticConfigStatus HapticEngine::setConfig(const PB_SmartKnobConfig &new_config, MultiTurnAngle angle)
+{
+    // Check new config for validity
+    if (new_config.detent_strength_unit < 0)
+    {
+        return HapticConfigStatus::NEGATIVE_DETENT_STRENGTH;
+    }
+    if (new_config.endstop_strength_unit < 0)
+    {
+        return HapticConfigStatus::NEGATIVE_ENDSTOP_STRENGTH;
+    }
+    if (new_config.snap_point < 0.5)
+    {
+        return HapticConfigStatus::SNAP_POINT_TOO_SMALL;
+    }
+    if (new_config.detent_positions_count > sizeof(new_config.detent_positions) / sizeof(new_config.detent_positions[0]))
+    {
+        return HapticConfigStatus::TOO_MANY_DETENT_POSITIONS;
+    }
+    if (new_config.snap_point_bias < 0)
+    {
+        return HapticConfigStatus::NEGATIVE_SNAP_POINT_BIAS;
+    }
+    if (new_config.detent_set_id > 0 && (new_config.detent_set_id > DETENT_SET_SLOTS || detent_sets_[new_config.detent_set_id - 1].id == 0))
+    {
+        return HapticConfigStatus::UNKNOWN_DETENT_SET;
+    }
+    if (new_config.motion_model > PB_MotionModel_MOTION_RATCHET)
+    {
+        return HapticConfigStatus::UNKNOWN_MOTION_MODEL;
+    }
+    if (new_config.flywheel_inertia < 0 || new_config.flywheel_friction < 0)
+    {
+        return HapticConfigStatus::NEGATIVE_FLYWHEEL_PARAMETER;
+    }
+    if (new_config.spring_dead_band_radians < 0)
+    {
+        return HapticConfigStatus::NEGATIVE_SPRING_DEAD_BAND;
+    }
+    if (new_config.torque_profile_id > 0)
+    {
+        if (new_config.torque_profile_id > TORQUE_PROFILE_SLOTS || torque_profiles_[new_config.torque_profile_id - 1].id == 0)
+        {
+            return HapticConfigStatus::UNKNOWN_TORQUE_PROFILE;
+        }
+        if (!profile_table_.build(torque_profiles_[new_config.torque_profile_id - 1], new_config))
+        {
+            // Fall back to the default force of the config that stays active
+            if (config_.torque_profile_id == 0 || !profile_table_.build(torque_profiles_[config_.torque_profile_id - 1], config_))
+            {
+                profile_table_.clear();
+            }
+            return HapticConfigStatus::INVALID_TORQUE_PROFILE;
+        }
+    }
+    else
+    {
+        profile_table_.clear();
+    }
+
+    // Change haptic input mode
+    bool position_updated = false;
+    if (new_config.position != config_.position || new_config.sub_position_unit != config_.sub_position_unit || new_config.position_nonce != config_.position_nonce)
+    {
+        current_position_ = new_config.position;
+        position_updated = true;
+    }
+
+    if (new_config.min_position <= new_config.max_position)
+    {
+        // Only check bounds if min/max indicate bounds are active (min >= max)
+        if (current_position_ < new_config.min_position)
+        {
+            current_position_ = new_config.min_position;
+        }
+        else if (current_position_ > new_config.max_position)
+        {
+            current_position_ = new_config.max_position;
+        }
+    }
+
+    if (position_updated || new_config.position_width_radians != config_.position_width_radians)
+    {
+        float new_sub_position = position_updated ? new_config.sub_position_unit : latest_sub_position_unit_;
+        current_detent_center_ = angle.offsetBy(new_sub_position * new_config.position_width_radians);
+    }
+    if (new_config.motion_model == PB_MotionModel_MOTION_FLYWHEEL && config_.motion_model != PB_MotionModel_MOTION_FLYWHEEL)
+    {
+        flywheel_.reset(angle);
+    }
+    if (new_config.motion_model != config_.motion_model)
+    {
+        // Each model computes its own error (the flywheel zeroes it), so the last one's would kick the derivative
+        controller_.reset();
+    }
+    config_ = new_config;
+
+    scheduleGains();
+    placeSpringHome();
+    flywheel_.configure(config_.flywheel_inertia > 0 ? config_.flywheel_inertia : FLYWHEEL_DEFAULT_INERTIA, config_.flywheel_friction);
+
+    return HapticConfigStatus::OK;
+}
+
+const PB_SmartKnobConfig &HapticEngine::getConfig() const
+{
+    return config_;
+}
+
+bool HapticEngine::setTorqueProfile(const PB_TorqueProfile &profile)
+{
+    if (profile.id == 0 || profile.id > TORQUE_PROFILE_SLOTS)
+    {
+        return false;
+    }
+    torque_profiles_[profile.id - 1] = profile;
+    return true;
+}
+
+bool HapticEngine::setDetentSet(const PB_DetentSet &set)
+{
+    if (set.id == 0 || set.id > DETENT_SET_SLOTS)
+    {
+        return false;
+    }
+    detent_sets_[set.id - 1] = set;
+    return true;
+}
+
+bool HapticEngine::setGainSchedule(const PB_GainSchedule &schedule)
+{
+    if (!gain_schedule_.set(schedule))
+    {
+        return false;
+    }
+    scheduleGains();
+    return true;
+}
+
+HapticOutput HapticEngine::update(const HapticInput &input)
+{
+    // If we are not moving and we're close to the center (but not exactly there), slowly adjust the centerpoint to match the current position
+    idle_check_velocity_ewma_ = input.velocity * IDLE_VELOCITY_EWMA_ALPHA + idle_check_velocity_ewma_ * (1 - IDLE_VELOCITY_EWMA_ALPHA);
+    if (fabsf(idle_check_velocity_ewma_) > IDLE_VELOCITY_RAD_PER_SEC)
+    {
+        idle_ = false;
+    }
+    else if (!idle_)
+    {
+        idle_ = true;
+        idle_start_us_ = input.now_us;
+    }
+    float angle_to_detent_center = input.angle.radiansFrom(current_detent_center_);
+    if (idle_ && input.now_us - idle_start_us_ > IDLE_CORRECTION_DELAY_MICROS && fabsf(angle_to_detent_center) < IDLE_CORRECTION_MAX_ANGLE_RAD)
+    {
+        float correction = angle_to_detent_center * IDLE_CORRECTION_RATE_ALPHA;
+        current_detent_center_ = current_detent_center_.offsetBy(correction);
+        angle_to_detent_center -= correction;
+    }
+
+    // Check where we are relative to the current nearest detent; update our position if we've moved far enough to snap to another detent
+
+    float snap_point_radians = config_.position_width_radians * config_.snap_point;
+    float bias_radians = config_.position_width_radians * config_.snap_point_bias;
+    float snap_point_radians_decrease = snap_point_radians + (current_position_ <= 0 ? bias_radians : -bias_radians);
+    float snap_point_radians_increase = -snap_point_radians + (current_position_ >= 0 ? -bias_radians : bias_radians);
+
+    // A ratchet only lets the position move one way; turning it back runs into a wall at the current detent
+    bool ratchet = config_.motion_model == PB_MotionModel_MOTION_RATCHET;
+    bool can_decrease = !ratchet || config_.ratchet_decreasing;
+    bool can_increase = !ratchet || !config_.ratchet_decreasing;
+
+    int32_t num_positions = config_.max_position - config_.min_position + 1;
+    if (angle_to_detent_center > snap_point_radians_decrease && can_decrease && (num_positions <= 0 || current_position_ > config_.min_position))
+    {
+        current_detent_center_ = current_detent_center_.offsetBy(config_.position_width_radians);
+        angle_to_detent_center -= config_.position_width_radians;
+        current_position_--;
+    }
+    else if (angle_to_detent_center < snap_point_radians_increase && can_increase && (num_positions <= 0 || current_position_ < config_.max_position))
+    {
+        current_detent_center_ = current_detent_center_.offsetBy(-config_.position_width_radians);
+        angle_to_detent_center += config_.position_width_radians;
+        current_position_++;
+    }
+
+    latest_sub_position_unit_ = -angle_to_detent_center / config_.position_width_radians;
+
+    float dead_zone_adjustment = clampf(
+        angle_to_detent_center,
+        fmaxf(-config_.position_width_radians * DEAD_ZONE_DETENT_PERCENT, -DEAD_ZONE_RAD),
+        fminf(config_.position_width_radians * DEAD_ZONE_DETENT_PERCENT, DEAD_ZONE_RAD));
+
+    // The return spring replaces the endstops
+    bool out_of_bounds = config_.motion_model != PB_MotionModel_MOTION_SPRING_RETURN &&
+                         ((angle_to_detent_center > 0 && !can_decrease) || (angle_to_detent_center < 0 && !can_increase) ||
+                          (num_positions > 0 && ((angle_to_detent_center > 0 && current_position_ == config_.min_position) || (angle_to_detent_center < 0 && current_position_ == config_.max_position))));
+    controller_.limit = DETENT_TORQUE_LIMIT;
+    const ScheduledGains &gains = out_of_bounds ? endstop_gains_ : detent_gains_;
+    controller_.P = gains.p;
+    controller_.D = gains.d;
+    controller_.output_ramp = gains.output_ramp;
+
+    // Uploaded torque profiles replace the proportional term; the controller still provides damping
+    float profile_torque = 0;
+    if (out_of_bounds && profile_table_.hasEndstopCurve())
+    {
+        controller_.P = 0;
+        // Push back towards the bound: past min_position (or a ratchet's wall against decreasing) that's towards
+        // higher positions (negative torque)
+        float torque = profile_table_.endstopTorque(fabsf(latest_sub_position_unit_));
+        profile_torque = angle_to_detent_center > 0 ? -torque : torque;
+    }
+    else if (!out_of_bounds && profile_table_.hasDetentCurve())
+    {
+        controller_.P = 0;
+        profile_torque = profile_table_.detentTorque(current_position_, latest_sub_position_unit_);
+    }
+
+    float error = -angle_to_detent_center + dead_zone_adjustment;
+    float motion_torque = 0;
+    if (config_.motion_model == PB_MotionModel_MOTION_FLYWHEEL)
+    {
+        // Runs through every tick, even past the runaway velocity, so the flywheel keeps up with the knob.
+        // Hitting an endstop stops it.
+        if (out_of_bounds)
+        {
+            flywheel_.reset(input.angle);
+        }
+        else
+        {
+            motion_torque = flywheel_.update(input.angle, input.velocity, detent_gains_.p, detent_gains_.d, input.now_us);
+            error = 0;
+            profile_torque = 0;
+        }
+    }
+    else if (config_.motion_model == PB_MotionModel_MOTION_SPRING_RETURN)
+    {
+        // Pull back towards home from the edge of the dead band, with the detent gains (torque profiles don't apply)
+        float from_home = input.angle.radiansFrom(spring_home_);
+        error = -(from_home - clampf(from_home, -config_.spring_dead_band_radians, config_.spring_dead_band_radians));
+        controller_.P = detent_gains_.p;
+        profile_torque = 0;
+    }
+    else if (!out_of_bounds && hasMagneticDetents())
+    {
+        if (!isMagneticDetent(current_position_))
+        {
+            error = 0;
+            profile_torque = 0;
+        }
+    }
+
+    HapticOutput output = {
+        .torque = 0,
+        .current_position = current_position_,
+        .sub_position_unit = latest_sub_position_unit_,
+    };
+
+    // Don't apply torque if velocity is too high (helps avoid positive feedback loop/runaway)
+    if (fabsf(input.velocity) <= RUNAWAY_VELOCITY_RAD_PER_SEC)
+    {
+        output.torque = clampf(controller_(error, input.now_us) + profile_torque + motion_torque, -DETENT_TORQUE_LIMIT, DETENT_TORQUE_LIMIT);
+    }
+
+    return output;
+}
+
+bool HapticEngine::hasMagneticDetents() const
+{
+    return config_.detent_set_id > 0 || config_.detent_positions_count > 0;
+}
+
+void HapticEngine::scheduleGains()
+{
+    // The flywheel coupling and the return spring need the damping of the detent rows whatever detent_positions says
+    bool magnetic = hasMagneticDetents() && config_.motion_model != PB_MotionModel_MOTION_FLYWHEEL && config_.motion_model != PB_MotionModel_MOTION_SPRING_RETURN;
+    PB_GainScheduleMode detent_mode = magnetic ? PB_GainScheduleMode_GAIN_MODE_MAGNETIC : PB_GainScheduleMode_GAIN_MODE_DETENT;
+    detent_gains_ = gain_schedule_.lookup(detent_mode, config_.position_width_radians, config_.detent_strength_unit);
+    endstop_gains_ = gain_schedule_.lookup(PB_GainScheduleMode_GAIN_MODE_ENDSTOP, config_.position_width_radians, config_.endstop_strength_unit);
+}
+
+void HapticEngine::placeSpringHome()
+{
+    int32_t home = config_.position;
+    if (config_.min_position <= config_.max_position)
+    {
+        home = home < config_.min_position ? config_.min_position : (home > config_.max_position ? config_.max_position : home);
+    }
+    // Higher positions are at lower angles
+    spring_home_ = current_detent_center_.offsetBy(-(home - current_position_) * config_.position_width_radians);
+}
+
+bool HapticEngine::isMagneticDetent(int32_t position) const
+{
+    if (config_.detent_set_id > 0)
+    {
+        return detentSetContains(detent_sets_[config_.detent_set_id - 1], position);
+    }
+    for (uint8_t i = 0; i < config_.detent_positions_count; i++)
+    {
+        if (config_.detent_positions[i] == position)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+int32_t HapticEngine::getCurrentPosition() const
+{
+    return current_position_;
+}
+
+float HapticEngine::getSubPositionUnit() const
+{
+    return latest_sub_position_unit_;
+}
+
+const Flywheel &HapticEngine::getFlywheel() const
+{
+    return flywheel_;
+}
+
+MultiTurnAngle HapticEngine::getSpringHome() const
+{
+    return spring_home_;
+}
+
+const ScheduledGains &HapticEngine::getDetentGains() const
+{
+    return detent_gains_;
+}
+
+float HapticEngine::TorqueController::operator()(float error, uint32_t now_us)
+{
+    float Ts = (now_us - timestamp_prev_us_) * 1e-6f;
+    if (Ts <= 0 || Ts > 0.5f)
+    {
+        Ts = 1e-3f;
+    }
+
+    if (!has_error_prev_)
+    {
+        error_prev_ = error;
+        has_error_prev_ = true;
+    }
+
+    float proportional = P * error;
+    float integral = clampf(integral_prev_ + I * Ts * 0.5f * (error + error_prev_), -limit, limit);
+    float derivative = D * (error - error_prev_) / Ts;
+
+    float output = clampf(proportional + integral + derivative, -limit, limit);
+    if (output_ramp > 0)
+    {
+        float output_rate = (output - output_prev_) / Ts;
+        if (output_rate > output_ramp)
+        {
+            output = output_prev_ + output_ramp * Ts;
+        }
+        else if (output_rate < -output_ramp)
+        {
+            output = output_prev_ - output_ramp * Ts;
+        }
+    }
+
+    integral_prev_ = integral;
+    output_prev_ = output;
+    error_prev_ = error;
+    timestamp_prev_us_ = now_us;
+    return output;
+}
+
+void HapticEngine::TorqueController::reset()
+{
+    integral_prev_ = 0;
+    has_error_prev_ = false;
+}
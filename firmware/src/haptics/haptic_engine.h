@@ -0,0 +1,155 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "../proto/proto_gen/smartknob.pb.h"
+#include "detent_set.h"
+#include "fixed_angle.h"
+#include "flywheel.h"
+#include "gain_schedule.h"
+#include "torque_profile.h"
+
+// Hardware-independent detent/endstop control law, plus the motion models (flywheel, spring-return, ratchet) that
+// replace the detents when a config selects one. The engine only consumes shaft state and returns the torque
+// to apply, so it can run on the motor task as well as in a host-side simulation against a plant model.
+//
+// All angles are in "knob coordinates": callers are responsible for applying SK_INVERT_ROTATION to the shaft
+// angle/velocity going in and to the torque coming out.
+
+enum class HapticConfigStatus
+{
+    OK,
+    NEGATIVE_DETENT_STRENGTH,
+    NEGATIVE_ENDSTOP_STRENGTH,
+    SNAP_POINT_TOO_SMALL,
+    TOO_MANY_DETENT_POSITIONS,
+    NEGATIVE_SNAP_POINT_BIAS,
+    UNKNOWN_TORQUE_PROFILE,
+    INVALID_TORQUE_PROFILE,
+    UNKNOWN_DETENT_SET,
+    UNKNOWN_MOTION_MODEL,
+    NEGATIVE_FLYWHEEL_PARAMETER,
+    NEGATIVE_SPRING_DEAD_BAND,
+};
+
+const char *hapticConfigStatusToString(HapticConfigStatus status);
+
+// Above this knob velocity the engine applies no detent torque, to avoid a positive feedback runaway
+static const float RUNAWAY_VELOCITY_RAD_PER_SEC = 60;
+
+// Torque controller gains for the active motor profile (see motors/*.h)
+struct HapticGains
+{
+    float p;
+    float i;
+    float d;
+    float output_ramp;
+    float limit;
+};
+
+struct HapticInput
+{
+    MultiTurnAngle angle; // knob coordinates
+    float velocity;     // rad/s, knob coordinates
+    float acceleration; // rad/s^2, knob coordinates
+    uint32_t now_us;
+};
+
+struct HapticOutput
+{
+    float torque; // knob coordinates, same units as BLDCMotor::move() in torque mode
+    int32_t current_position;
+    float sub_position_unit;
+};
+
+class HapticEngine
+{
+public:
+    HapticEngine(const HapticGains &gains);
+
+    // Re-centers the current detent on the given angle without touching the position.
+    void reset(MultiTurnAngle angle);
+
+    // Validates and applies a new config. The current angle is needed to re-center the detent when the
+    // position or the detent width changes.
+    HapticConfigStatus setConfig(const PB_SmartKnobConfig &config, MultiTurnAngle angle);
+    const PB_SmartKnobConfig &getConfig() const;
+
+    // Stores a torque profile in its slot (id 1..TORQUE_PROFILE_SLOTS). Takes effect for configs applied
+    // afterwards; re-apply the config if it already refers to this id. Returns false for an invalid id.
+    bool setTorqueProfile(const PB_TorqueProfile &profile);
+
+    // Stores a detent set in its slot (id 1..DETENT_SET_SLOTS). Takes effect immediately if the active config
+    // refers to this id. Returns false for an invalid id.
+    bool setDetentSet(const PB_DetentSet &set);
+
+    // Replaces the gain schedule (an empty one restores the built-in schedule) and re-applies the active
+    // config's gains. Returns false, leaving everything unchanged, if the schedule is invalid.
+    bool setGainSchedule(const PB_GainSchedule &schedule);
+
+    HapticOutput update(const HapticInput &input);
+
+    int32_t getCurrentPosition() const;
+    float getSubPositionUnit() const;
+
+    // Motion model state, for simulations that check what the engine stores
+    const Flywheel &getFlywheel() const;
+    MultiTurnAngle getSpringHome() const;
+    const ScheduledGains &getDetentGains() const;
+
+private:
+    bool hasMagneticDetents() const;
+    void scheduleGains();
+    bool isMagneticDetent(int32_t position) const;
+    void placeSpringHome();
+
+    // Mirrors SimpleFOC's PIDController, but driven by the caller's timestamps instead of micros()
+    class TorqueController
+    {
+    public:
+        float operator()(float error, uint32_t now_us);
+        // Drops the integral and starts the derivative afresh from the next error, for when the meaning of the
+        // error changes. The output still ramps from where it was.
+        void reset();
+
+        float P;
+        float I;
+        float D;
+        float output_ramp;
+        float limit;
+
+    private:
+        float error_prev_ = 0;
+        float output_prev_ = 0;
+        float integral_prev_ = 0;
+        uint32_t timestamp_prev_us_ = 0;
+        bool has_error_prev_ = true;
+    };
+
+    TorqueController controller_;
+
+    GainSchedule gain_schedule_;
+    // Looked up from the gain schedule whenever the config changes
+    ScheduledGains detent_gains_ = {};
+    ScheduledGains endstop_gains_ = {};
+
+    PB_SmartKnobConfig config_;
+
+    PB_TorqueProfile torque_profiles_[TORQUE_PROFILE_SLOTS] = {};
+    TorqueProfileTable profile_table_;
+
+    PB_DetentSet detent_sets_[DETENT_SET_SLOTS] = {};
+
+    // Held as a multi-turn angle so detents stay exactly spaced however far the knob has been turned
+    MultiTurnAngle current_detent_center_ = {};
+    int32_t current_position_ = 0;
+    float latest_sub_position_unit_ = 0;
+
+    Flywheel flywheel_;
+    // Where MOTION_SPRING_RETURN pulls the knob back to: the center of the config's position
+    MultiTurnAngle spring_home_ = {};
+
+    float idle_check_velocity_ewma_ = 0;
+    bool idle_ = false;
+    uint32_t idle_start_us_ = 0;
+};
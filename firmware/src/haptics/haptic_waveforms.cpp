@@ -0,0 +1,125 @@
+#include "haptic_waveforms.h"
+
+#include <string.h>
+
+// A push in one direction followed by an equal push back, so the knob ends up where it started
+static const HapticWaveformTable CLICK = {
+    .length = 6,
+    .ticks_per_sample = 1,
+    .samples = {1, 1, 1, -1, -1, -1},
+};
+
+static const HapticWaveformTable DOUBLE_CLICK = {
+    .length = 26,
+    .ticks_per_sample = 1,
+    .samples = {1, 1, 1, -1, -1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, -1, -1, -1},
+};
+
+// ~250Hz vibration for 80ms
+static const HapticWaveformTable BUZZ = {
+    .length = 40,
+    .ticks_per_sample = 2,
+    .samples = {1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1,
+                1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1, 1, -1},
+};
+
+// Torque that builds up over 40ms and then lets go
+static const HapticWaveformTable RAMP = {
+    .length = 20,
+    .ticks_per_sample = 2,
+    .samples = {0.05, 0.1, 0.15, 0.2, 0.25, 0.3, 0.35, 0.4, 0.45, 0.5,
+                0.55, 0.6, 0.65, 0.7, 0.75, 0.8, 0.85, 0.9, 0.95, 1},
+};
+
+// Longer, heavier click used for long presses
+static const HapticWaveformTable THUD = {
+    .length = 6,
+    .ticks_per_sample = 2,
+    .samples = {1, 1, 1, -1, -1, -1},
+};
+
+static bool isUserSlot(PB_HapticWaveformId waveform)
+{
+    return waveform >= PB_HapticWaveformId_HAPTIC_USER_0 && waveform <= PB_HapticWaveformId_HAPTIC_USER_3;
+}
+
+bool HapticWaveformPlayer::play(PB_HapticWaveformId waveform, float strength)
+{
+    const HapticWaveformTable *table = lookup(waveform);
+    if (table == nullptr || table->length == 0)
+    {
+        return false;
+    }
+    current_ = table;
+    strength_ = strength;
+    sample_ = 0;
+    sample_tick_ = 0;
+    return true;
+}
+
+bool HapticWaveformPlayer::setUserWaveform(PB_HapticWaveformId waveform, const float *samples, uint8_t length, uint8_t ticks_per_sample)
+{
+    if (!isUserSlot(waveform) || length == 0 || length > HAPTIC_WAVEFORM_MAX_SAMPLES)
+    {
+        return false;
+    }
+
+    HapticWaveformTable &table = user_waveforms_[waveform - PB_HapticWaveformId_HAPTIC_USER_0];
+    if (current_ == &table)
+    {
+        // Don't continue playing a half-replaced waveform
+        current_ = nullptr;
+    }
+    table.length = length;
+    table.ticks_per_sample = ticks_per_sample > 0 ? ticks_per_sample : 1;
+    memcpy(table.samples, samples, length * sizeof(float));
+    return true;
+}
+
+float HapticWaveformPlayer::tick()
+{
+    if (current_ == nullptr)
+    {
+        return 0;
+    }
+
+    float torque = current_->samples[sample_] * strength_;
+    if (++sample_tick_ >= current_->ticks_per_sample)
+    {
+        sample_tick_ = 0;
+        if (++sample_ >= current_->length)
+        {
+            current_ = nullptr;
+        }
+    }
+    return torque;
+}
+
+bool HapticWaveformPlayer::isPlaying() const
+{
+    return current_ != nullptr;
+}
+
+const HapticWaveformTable *HapticWaveformPlayer::lookup(PB_HapticWaveformId waveform) const
+{
+    switch (waveform)
+    {
+    case PB_HapticWaveformId_HAPTIC_CLICK:
+        return &CLICK;
+    case PB_HapticWaveformId_HAPTIC_DOUBLE_CLICK:
+        return &DOUBLE_CLICK;
+    case PB_HapticWaveformId_HAPTIC_BUZZ:
+        return &BUZZ;
+    case PB_HapticWaveformId_HAPTIC_RAMP:
+        return &RAMP;
+    case PB_HapticWaveformId_HAPTIC_THUD:
+        return &THUD;
+    default:
+        break;
+    }
+    if (isUserSlot(waveform))
+    {
+        return &user_waveforms_[waveform - PB_HapticWaveformId_HAPTIC_USER_0];
+    }
+    return nullptr;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "../proto/proto_gen/smartknob.pb.h"
+
+// Plays short torque envelopes (clicks, buzzes, ...) on top of the detent torque. The player is stepped once
+// per haptic loop tick and never blocks, so detent control keeps running while a waveform plays.
+//
+// Waveforms are identified by PB_HapticWaveformId: the built-in ones are fixed tables, the HAPTIC_USER_*
+// slots can be replaced at runtime (see setUserWaveform).
+
+static const uint8_t HAPTIC_WAVEFORM_MAX_SAMPLES = 64;
+static const uint8_t HAPTIC_WAVEFORM_USER_SLOTS = PB_HapticWaveformId_HAPTIC_USER_3 - PB_HapticWaveformId_HAPTIC_USER_0 + 1;
+
+struct HapticWaveformTable
+{
+    uint8_t length;
+    uint8_t ticks_per_sample;
+    float samples[HAPTIC_WAVEFORM_MAX_SAMPLES];
+};
+
+class HapticWaveformPlayer
+{
+public:
+    // Starts playing the given waveform, replacing any waveform currently playing. Returns false if the id is
+    // unknown or refers to an empty user slot.
+    bool play(PB_HapticWaveformId waveform, float strength);
+
+    // Stores a waveform in one of the HAPTIC_USER_* slots. Returns false if the id is not a user slot or the
+    // waveform has no samples.
+    bool setUserWaveform(PB_HapticWaveformId waveform, const float *samples, uint8_t length, uint8_t ticks_per_sample);
+
+    // Returns the torque offset for this tick and advances playback; 0 when nothing is playing.
+    float tick();
+
+    bool isPlaying() const;
+
+private:
+    const HapticWaveformTable *lookup(PB_HapticWaveformId waveform) const;
+
+    HapticWaveformTable user_waveforms_[HAPTIC_WAVEFORM_USER_SLOTS] = {};
+
+    const HapticWaveformTable *current_ = nullptr;
+    float strength_ = 0;
+    uint8_t sample_ = 0;
+    uint8_t sample_tick_ = 0;
+};
@@ -0,0 +1,94 @@
+#include "torque_profile.h"
+
+// Per-detent curves span this many positions either side of the detent center
+static const float PER_DETENT_SPAN_UNITS = 1;
+
+bool TorqueProfileTable::build(const PB_TorqueProfile &profile, const PB_SmartKnobConfig &config)
+{
+    clear();
+
+    if (profile.detent_samples_count > 0)
+    {
+        float range_start = -PER_DETENT_SPAN_UNITS;
+        float range_end = PER_DETENT_SPAN_UNITS;
+        if (profile.mode == PB_TorqueProfileMode_TORQUE_PROFILE_FULL_RANGE)
+        {
+            if (config.max_position <= config.min_position)
+            {
+                return false;
+            }
+            range_start = config.min_position;
+            range_end = config.max_position;
+            full_range_ = true;
+        }
+        // Samples push towards higher positions, the engine's positive torque towards lower ones
+        detent_.fill(profile.detent_samples, profile.detent_samples_count, range_start, range_end, -config.detent_strength_unit);
+    }
+
+    if (profile.endstop_samples_count > 0)
+    {
+        if (profile.endstop_range_units <= 0)
+        {
+            clear();
+            return false;
+        }
+        endstop_.fill(profile.endstop_samples, profile.endstop_samples_count, 0, profile.endstop_range_units, config.endstop_strength_unit);
+    }
+
+    return true;
+}
+
+void TorqueProfileTable::clear()
+{
+    detent_.length = 0;
+    endstop_.length = 0;
+    full_range_ = false;
+}
+
+bool TorqueProfileTable::hasDetentCurve() const
+{
+    return detent_.length > 0;
+}
+
+bool TorqueProfileTable::hasEndstopCurve() const
+{
+    return endstop_.length > 0;
+}
+
+float TorqueProfileTable::detentTorque(int32_t position, float sub_position_unit) const
+{
+    return detent_.evaluate(full_range_ ? position + sub_position_unit : sub_position_unit);
+}
+
+float TorqueProfileTable::endstopTorque(float units_past_bound) const
+{
+    return endstop_.evaluate(units_past_bound);
+}
+
+void TorqueProfileTable::Curve::fill(const float *source, uint8_t count, float range_start, float range_end, float scale)
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        samples[i] = source[i] * scale;
+    }
+    length = count;
+    start = range_start;
+    inverse_step = count > 1 ? (count - 1) / (range_end - range_start) : 0;
+}
+
+float TorqueProfileTable::Curve::evaluate(float x) const
+{
+    // Linear interpolation between samples; values outside the sampled range hold the first/last sample
+    float index = (x - start) * inverse_step;
+    if (index <= 0)
+    {
+        return samples[0];
+    }
+    if (index >= length - 1)
+    {
+        return samples[length - 1];
+    }
+    uint8_t i = (uint8_t)index;
+    float t = index - i;
+    return samples[i] + (samples[i + 1] - samples[i]) * t;
+}
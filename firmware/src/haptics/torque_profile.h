@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "../proto/proto_gen/smartknob.pb.h"
+
+// Lookup tables built from an uploaded PB_TorqueProfile for the active config. Building scales the samples
+// by the config's strengths and converts them to the engine's torque sign convention, so evaluating the
+// profile each tick is only an interpolated table lookup.
+//
+// Profile samples are expressed in the direction of increasing position (a positive sample pushes the knob
+// towards higher positions), in motor torque units scaled by detent_strength_unit / endstop_strength_unit.
+
+static const uint8_t TORQUE_PROFILE_SLOTS = 4;
+static const uint8_t TORQUE_PROFILE_MAX_SAMPLES = sizeof(PB_TorqueProfile::detent_samples) / sizeof(float);
+
+class TorqueProfileTable
+{
+public:
+    // Returns false if the profile can't be used with this config (e.g. a full-range profile on an unbounded
+    // config); the table is left cleared in that case.
+    bool build(const PB_TorqueProfile &profile, const PB_SmartKnobConfig &config);
+    void clear();
+
+    bool hasDetentCurve() const;
+    bool hasEndstopCurve() const;
+
+    // Torque in engine convention at the given position; only valid if hasDetentCurve()
+    float detentTorque(int32_t position, float sub_position_unit) const;
+
+    // Restoring torque magnitude for the given distance (in positions) past a bound; only valid if hasEndstopCurve()
+    float endstopTorque(float units_past_bound) const;
+
+private:
+    struct Curve
+    {
+        float samples[TORQUE_PROFILE_MAX_SAMPLES];
+        uint8_t length;
+        float start;
+        float inverse_step;
+
+        void fill(const float *source, uint8_t count, float range_start, float range_end, float scale);
+        float evaluate(float x) const;
+    };
+
+    Curve detent_ = {};
+    Curve endstop_ = {};
+    bool full_range_ = false;
+};
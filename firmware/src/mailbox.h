@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+
+#include "semaphore_guard.h"
+
+// Latest-wins handoff of a large struct from any number of tasks to a single reader task. A burst of posts
+// keeps only the newest value, and posting never waits for the reader. Values are handed over by swapping
+// pointers between three buffers (one being written, one published, one held by the reader), so the reader
+// only takes a spinlock for the swap and reads its value in place.
+//
+// Writers are serialized by a mutex among themselves; only one task may call take().
+template <typename T>
+class Mailbox
+{
+public:
+    Mailbox()
+    {
+        writer_mutex_ = xSemaphoreCreateMutex();
+        assert(writer_mutex_ != NULL);
+    }
+
+    // Publishes value, stamped with the time it was posted. Returns true if it replaced a value the reader
+    // hadn't taken yet.
+    bool post(const T &value, uint32_t posted_us)
+    {
+        SemaphoreGuard lock(writer_mutex_);
+        back_->value = value;
+        back_->posted_us = posted_us;
+
+        portENTER_CRITICAL(&swap_mux_);
+        Slot *published = published_;
+        published_ = back_;
+        back_ = published;
+        bool replaced = fresh_;
+        fresh_ = true;
+        portEXIT_CRITICAL(&swap_mux_);
+        return replaced;
+    }
+
+    // True if a value was posted that the reader hasn't taken yet
+    bool pending()
+    {
+        portENTER_CRITICAL(&swap_mux_);
+        bool fresh = fresh_;
+        portEXIT_CRITICAL(&swap_mux_);
+        return fresh;
+    }
+
+    // Reader only. Returns the newest value if one was posted since the last call, or nullptr. The value stays
+    // valid until the next call.
+    const T *take(uint32_t &posted_us)
+    {
+        portENTER_CRITICAL(&swap_mux_);
+        if (!fresh_)
+        {
+            portEXIT_CRITICAL(&swap_mux_);
+            return nullptr;
+        }
+        Slot *front = front_;
+        front_ = published_;
+        published_ = front;
+        fresh_ = false;
+        portEXIT_CRITICAL(&swap_mux_);
+
+        posted_us = front_->posted_us;
+        return &front_->value;
+    }
+
+private:
+    struct Slot
+    {
+        T value;
+        uint32_t posted_us;
+    };
+
+    Slot slots_[3] = {};
+    Slot *back_ = &slots_[0];
+    Slot *published_ = &slots_[1];
+    Slot *front_ = &slots_[2];
+    bool fresh_ = false;
+
+    SemaphoreHandle_t writer_mutex_;
+    portMUX_TYPE swap_mux_ = portMUX_INITIALIZER_UNLOCKED;
+};
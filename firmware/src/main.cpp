@@ -112,6 +112,9 @@ void setup()
         config.saveSettingsToDisk();
     }
 
+    config.loadCoggingMapFromDisk();
+    config.loadGainScheduleFromDisk();
+
     root_task.loadConfiguration();
 
     motor_task.begin();
@@ -0,0 +1,81 @@
+#include "calibration_fit.h"
+
+#include <math.h>
+
+void CalibrationFit::add(float electrical, float mechanical)
+{
+    if (count_ == 0)
+    {
+        electrical_origin_ = electrical;
+        mechanical_origin_ = mechanical;
+    }
+    count_++;
+
+    double x = electrical - electrical_origin_;
+    double y = mechanical - mechanical_origin_;
+    sum_x_ += x;
+    sum_y_ += y;
+    sum_xx_ += x * x;
+    sum_xy_ += x * y;
+    sum_yy_ += y * y;
+
+    for (uint8_t d = 0; d < 2; d++)
+    {
+        float direction = d == 0 ? 1 : -1;
+        for (uint8_t i = 0; i < CANDIDATES; i++)
+        {
+            float offset = direction * (CALIBRATION_MIN_POLE_PAIRS + i) * mechanical - electrical;
+            offset_cos_[d][i] += cosf(offset);
+            offset_sin_[d][i] += sinf(offset);
+        }
+    }
+}
+
+uint32_t CalibrationFit::count() const
+{
+    return count_;
+}
+
+float CalibrationFit::slope() const
+{
+    if (count_ < 2)
+    {
+        return 0;
+    }
+    double sxx = sum_xx_ - sum_x_ * sum_x_ / count_;
+    double sxy = sum_xy_ - sum_x_ * sum_y_ / count_;
+    return sxx > 0 ? sxy / sxx : 0;
+}
+
+float CalibrationFit::residualRms() const
+{
+    if (count_ < 2)
+    {
+        return 0;
+    }
+    double sxx = sum_xx_ - sum_x_ * sum_x_ / count_;
+    double sxy = sum_xy_ - sum_x_ * sum_y_ / count_;
+    double syy = sum_yy_ - sum_y_ * sum_y_ / count_;
+    double sse = sxx > 0 ? syy - sxy * sxy / sxx : syy;
+    return sse > 0 ? sqrt(sse / count_) : 0;
+}
+
+float CalibrationFit::electricalOffset(bool direction_cw, uint8_t pole_pairs) const
+{
+    uint8_t i = pole_pairs - CALIBRATION_MIN_POLE_PAIRS;
+    uint8_t d = direction_cw ? 0 : 1;
+    return atan2f(offset_sin_[d][i], offset_cos_[d][i]);
+}
+
+float CalibrationFit::offsetSpread(bool direction_cw, uint8_t pole_pairs) const
+{
+    if (count_ == 0)
+    {
+        return 0;
+    }
+    uint8_t i = pole_pairs - CALIBRATION_MIN_POLE_PAIRS;
+    uint8_t d = direction_cw ? 0 : 1;
+    // Circular standard deviation from the mean resultant length
+    float r = sqrtf(offset_cos_[d][i] * offset_cos_[d][i] + offset_sin_[d][i] * offset_sin_[d][i]) / count_;
+    return r > 0 ? sqrtf(-2 * logf(fminf(r, 1))) : M_PI;
+}
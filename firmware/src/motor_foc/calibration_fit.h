@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+
+// Accumulates (electrical angle driven, mechanical angle measured) pairs from an open-loop calibration sweep
+// and fits the motor's direction, pole pairs and electrical zero offset from them, without storing samples.
+//
+// mechanical = slope * electrical + intercept, so slope = +/-1 / pole_pairs with the sign giving the sensor
+// direction. The electrical zero offset is accumulated for every candidate pole pair count and direction, as
+// the right one is only known once the sweep is done.
+
+static const uint8_t CALIBRATION_MIN_POLE_PAIRS = 3;
+static const uint8_t CALIBRATION_MAX_POLE_PAIRS = 12;
+
+class CalibrationFit
+{
+public:
+    void add(float electrical, float mechanical);
+
+    uint32_t count() const;
+
+    // Least-squares fit of the mechanical angle against the electrical angle
+    float slope() const;
+    float residualRms() const;
+
+    // Mean electrical offset (measured electrical angle minus driven electrical angle) and its circular standard
+    // deviation, for a pole pair count in [CALIBRATION_MIN_POLE_PAIRS, CALIBRATION_MAX_POLE_PAIRS]
+    float electricalOffset(bool direction_cw, uint8_t pole_pairs) const;
+    float offsetSpread(bool direction_cw, uint8_t pole_pairs) const;
+
+private:
+    static const uint8_t CANDIDATES = CALIBRATION_MAX_POLE_PAIRS - CALIBRATION_MIN_POLE_PAIRS + 1;
+
+    uint32_t count_ = 0;
+
+    // Sums are taken relative to the first sample and in double precision, since a sweep covers several
+    // radians and thousands of samples
+    float electrical_origin_ = 0;
+    float mechanical_origin_ = 0;
+    double sum_x_ = 0;
+    double sum_y_ = 0;
+    double sum_xx_ = 0;
+    double sum_xy_ = 0;
+    double sum_yy_ = 0;
+
+    // [direction (0 = CW, 1 = CCW)][pole pairs - CALIBRATION_MIN_POLE_PAIRS]
+    float offset_cos_[2][CANDIDATES] = {};
+    float offset_sin_[2][CANDIDATES] = {};
+};
@@ -0,0 +1,63 @@
+#include "cogging_compensation.h"
+
+#include <math.h>
+#include <string.h>
+
+void CoggingCompensation::build(const PB_CoggingMap &map)
+{
+    if (map.samples.size == 0 || map.scale == 0)
+    {
+        clear();
+        return;
+    }
+    memcpy(samples_, map.samples.bytes, map.samples.size);
+    count_ = map.samples.size;
+    scale_ = map.scale;
+}
+
+void CoggingCompensation::clear()
+{
+    count_ = 0;
+}
+
+bool CoggingCompensation::isEnabled() const
+{
+    return count_ > 0;
+}
+
+float CoggingCompensation::torque(FixedAngle mechanical_angle) const
+{
+    if (count_ == 0)
+    {
+        return 0;
+    }
+    // Sample count isn't necessarily a power of two: scale the Q32 angle to Q32 samples
+    uint64_t index = (uint64_t)mechanical_angle.turns * count_;
+    uint16_t i = index >> 32;
+    float t = (uint32_t)index * (1.0f / 4294967296.0f);
+    // The map covers exactly one revolution, so the last sample interpolates towards the first
+    uint16_t next = i + 1 < count_ ? i + 1 : 0;
+    return (samples_[i] + (samples_[next] - samples_[i]) * t) * scale_;
+}
+
+bool CoggingCompensation::encode(const float *torques, uint16_t count, PB_CoggingMap &map)
+{
+    map = {};
+    if (count == 0 || count > COGGING_MAP_MAX_SAMPLES)
+    {
+        return false;
+    }
+
+    float peak = 0;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        peak = fmaxf(peak, fabsf(torques[i]));
+    }
+    map.scale = peak / INT8_MAX;
+    map.samples.size = count;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        map.samples.bytes[i] = (uint8_t)(int8_t)(map.scale > 0 ? lroundf(torques[i] / map.scale) : 0);
+    }
+    return true;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "../haptics/fixed_angle.h"
+#include "../proto/proto_gen/smartknob.pb.h"
+
+// Cogging torque feed-forward. The motor's holding torque over one mechanical revolution is measured once
+// (MotorTask::calibrateCogging) and stored as a PB_CoggingMap; the motor loop adds the interpolated torque on
+// every FOC tick so the rotor feels smooth where the haptic engine asks for no torque.
+
+static const uint16_t COGGING_MAP_MAX_SAMPLES = sizeof(PB_CoggingMap_samples_t::bytes);
+
+class CoggingCompensation
+{
+public:
+    // Copies the map's samples; a map without samples disables compensation
+    void build(const PB_CoggingMap &map);
+    void clear();
+
+    bool isEnabled() const;
+
+    // Torque (motor direction, BLDCMotor::move() units) that cancels cogging at a mechanical angle
+    float torque(FixedAngle mechanical_angle) const;
+
+    // Quantizes measured holding torques (count evenly spaced samples over one revolution) into a map. Returns
+    // false if count is 0 or larger than COGGING_MAP_MAX_SAMPLES.
+    static bool encode(const float *torques, uint16_t count, PB_CoggingMap &map);
+
+private:
+    int8_t samples_[COGGING_MAP_MAX_SAMPLES] = {};
+    uint16_t count_ = 0;
+    float scale_ = 0;
+};
@@ -0,0 +1,137 @@
+#include "encoder_linearization.h"
+
+#include <math.h>
+
+static const float TWO_PI = 2 * M_PI;
+
+static float wrapAngle(float angle)
+{
+    angle = fmodf(angle, TWO_PI);
+    return angle < 0 ? angle + TWO_PI : angle;
+}
+
+void EncoderLinearizationTable::build(const PB_EncoderLinearization &linearization)
+{
+    uint8_t harmonics = linearization.harmonic_cos_count < linearization.harmonic_sin_count ? linearization.harmonic_cos_count : linearization.harmonic_sin_count;
+    if (harmonics == 0)
+    {
+        clear();
+        return;
+    }
+
+    for (uint16_t i = 0; i < TABLE_SIZE; i++)
+    {
+        float theta = i * TWO_PI / TABLE_SIZE;
+        float error = 0;
+        for (uint8_t k = 0; k < harmonics; k++)
+        {
+            error += linearization.harmonic_cos[k] * cosf((k + 1) * theta) + linearization.harmonic_sin[k] * sinf((k + 1) * theta);
+        }
+        error_[i] = (int32_t)(error * FIXED_ANGLE_RADIANS_TO_Q32);
+    }
+    error_[TABLE_SIZE] = error_[0];
+    enabled_ = true;
+}
+
+void EncoderLinearizationTable::clear()
+{
+    enabled_ = false;
+}
+
+bool EncoderLinearizationTable::isEnabled() const
+{
+    return enabled_;
+}
+
+FixedAngle EncoderLinearizationTable::apply(FixedAngle raw_angle) const
+{
+    if (!enabled_)
+    {
+        return raw_angle;
+    }
+    uint32_t i = raw_angle.tableIndex(TABLE_BITS);
+    int64_t step = (int64_t)error_[i + 1] - error_[i];
+    int32_t error = error_[i] + (int32_t)((step * raw_angle.tableFractionQ16(TABLE_BITS)) >> 16);
+    return {raw_angle.turns - (uint32_t)error};
+}
+
+void EncoderLinearizationFit::add(float reference, float measured)
+{
+    measured = wrapAngle(measured);
+    uint8_t bin = (uint8_t)(measured * (BINS / TWO_PI));
+    if (bin >= BINS)
+    {
+        bin = BINS - 1;
+    }
+    float difference = measured - reference;
+    difference_cos_[bin] += cosf(difference);
+    difference_sin_[bin] += sinf(difference);
+    count_[bin]++;
+}
+
+bool EncoderLinearizationFit::solve(PB_EncoderLinearization &linearization) const
+{
+    linearization = {};
+
+    float mean_cos = 0;
+    float mean_sin = 0;
+    float difference[BINS];
+    for (uint8_t b = 0; b < BINS; b++)
+    {
+        if (count_[b] == 0)
+        {
+            return false;
+        }
+        difference[b] = atan2f(difference_sin_[b], difference_cos_[b]);
+        mean_cos += cosf(difference[b]);
+        mean_sin += sinf(difference[b]);
+    }
+
+    // Error per bin relative to the circular mean offset, with any remaining constant part removed so the
+    // correction doesn't shift the electrical zero
+    float offset = atan2f(mean_sin, mean_cos);
+    float error[BINS];
+    float error_sum = 0;
+    for (uint8_t b = 0; b < BINS; b++)
+    {
+        error[b] = remainderf(difference[b] - offset, TWO_PI);
+        error_sum += error[b];
+    }
+    for (uint8_t b = 0; b < BINS; b++)
+    {
+        error[b] -= error_sum / BINS;
+    }
+
+    linearization.harmonic_cos_count = ENCODER_LINEARIZATION_HARMONICS;
+    linearization.harmonic_sin_count = ENCODER_LINEARIZATION_HARMONICS;
+    for (uint8_t k = 0; k < ENCODER_LINEARIZATION_HARMONICS; k++)
+    {
+        float cos_sum = 0;
+        float sin_sum = 0;
+        for (uint8_t b = 0; b < BINS; b++)
+        {
+            float theta = (b + 0.5f) * TWO_PI / BINS;
+            cos_sum += error[b] * cosf((k + 1) * theta);
+            sin_sum += error[b] * sinf((k + 1) * theta);
+        }
+        linearization.harmonic_cos[k] = 2 * cos_sum / BINS;
+        linearization.harmonic_sin[k] = 2 * sin_sum / BINS;
+    }
+
+    float before = 0;
+    float after = 0;
+    for (uint8_t b = 0; b < BINS; b++)
+    {
+        float theta = (b + 0.5f) * TWO_PI / BINS;
+        float model = 0;
+        for (uint8_t k = 0; k < ENCODER_LINEARIZATION_HARMONICS; k++)
+        {
+            model += linearization.harmonic_cos[k] * cosf((k + 1) * theta) + linearization.harmonic_sin[k] * sinf((k + 1) * theta);
+        }
+        before += error[b] * error[b];
+        after += (error[b] - model) * (error[b] - model);
+    }
+    linearization.residual_before_rad = sqrtf(before / BINS);
+    linearization.residual_after_rad = sqrtf(after / BINS);
+    return true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "../haptics/fixed_angle.h"
+#include "../proto/proto_gen/smartknob.pb.h"
+
+// Angle sensor nonlinearity (INL) correction. Magnet eccentricity and tilt make the measured mechanical angle
+// deviate from the true one by a smooth, mostly once/twice-per-revolution error. The error is learned during
+// motor calibration as a few harmonics (EncoderLinearizationFit) and stored in PB_EncoderLinearization; the
+// sensor read path then subtracts it with a fixed-cost table lookup (EncoderLinearizationTable).
+
+static const uint8_t ENCODER_LINEARIZATION_HARMONICS = sizeof(PB_EncoderLinearization::harmonic_cos) / sizeof(float);
+
+class EncoderLinearizationTable
+{
+public:
+    // Rebuilds the lookup table; a linearization without harmonics clears it
+    void build(const PB_EncoderLinearization &linearization);
+    void clear();
+
+    bool isEnabled() const;
+
+    // Corrected mechanical angle for a raw sensor angle; returns the raw angle if not enabled. Integer only.
+    FixedAngle apply(FixedAngle raw_angle) const;
+
+private:
+    static const uint8_t TABLE_BITS = 8;
+    static const uint16_t TABLE_SIZE = 1 << TABLE_BITS;
+
+    // Error (Q32 turns, signed) at TABLE_SIZE evenly spaced raw angles, plus a copy of the first entry so
+    // interpolation never wraps
+    int32_t error_[TABLE_SIZE + 1] = {};
+    bool enabled_ = false;
+};
+
+// Accumulates (reference mechanical angle, measured sensor angle) pairs from an open-loop sweep over at least one
+// full mechanical revolution, binned by measured angle. Sweeping in both directions at the same rate cancels the
+// rotor lag. Only the low harmonics are fitted, so the rotor's own cogging ripple (at multiples of the pole
+// count) stays out of the correction.
+class EncoderLinearizationFit
+{
+public:
+    void add(float reference, float measured);
+
+    // Fills in harmonics and residuals; returns false if the samples didn't cover every bin
+    bool solve(PB_EncoderLinearization &linearization) const;
+
+private:
+    static const uint8_t BINS = 64;
+
+    // Sum of unit vectors of (measured - reference) per bin; the constant offset between the two is unknown
+    float difference_cos_[BINS] = {};
+    float difference_sin_[BINS] = {};
+    uint16_t count_[BINS] = {};
+};
@@ -0,0 +1,125 @@
+#include "flight_recorder.h"
+
+#include <esp_heap_caps.h>
+#include <logging.h>
+
+static const uint32_t ALL_TELEMETRY_SIGNALS = (1 << _PB_TelemetrySignal_ARRAYSIZE) - 1;
+
+void FlightRecorder::begin()
+{
+    uint32_t capacity = FLIGHT_RECORDER_SAMPLES;
+    void *storage = heap_caps_malloc(capacity * sizeof(MotorTelemetrySample), MALLOC_CAP_SPIRAM);
+    if (storage == nullptr)
+    {
+        capacity = FLIGHT_RECORDER_SAMPLES_INTERNAL;
+        storage = heap_caps_malloc(capacity * sizeof(MotorTelemetrySample), MALLOC_CAP_8BIT);
+        if (storage == nullptr)
+        {
+            LOGE("Not enough memory for the flight recorder");
+            return;
+        }
+    }
+    storage_ = (MotorTelemetrySample *)storage;
+    mask_ = capacity - 1;
+    LOGI("Flight recorder: %u samples", capacity);
+}
+
+void FlightRecorder::record(const MotorTelemetrySample &sample)
+{
+    if (storage_ == nullptr)
+    {
+        return;
+    }
+    if (rearm_.exchange(false, std::memory_order_acquire))
+    {
+        generation_.store(generation_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        written_ = 0;
+        trigger_ = PB_FlightRecorderTrigger_FLIGHT_TRIGGER_NONE;
+        frozen_.store(false, std::memory_order_relaxed);
+    }
+    if (frozen_.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    MotorTelemetrySample &slot = storage_[written_ & mask_];
+    slot = sample;
+    if (host_trigger_.exchange(false, std::memory_order_relaxed))
+    {
+        slot.events |= 1 << PB_FlightRecorderTrigger_FLIGHT_TRIGGER_HOST;
+    }
+    written_++;
+
+    if (trigger_ == PB_FlightRecorderTrigger_FLIGHT_TRIGGER_NONE)
+    {
+        uint32_t fired = slot.events & (triggers_.load(std::memory_order_relaxed) | (1 << PB_FlightRecorderTrigger_FLIGHT_TRIGGER_HOST));
+        if (fired == 0)
+        {
+            return;
+        }
+        trigger_ = (PB_FlightRecorderTrigger)__builtin_ctz(fired);
+        trigger_index_ = written_ - 1;
+        uint32_t post_trigger_samples = post_trigger_samples_.load(std::memory_order_relaxed);
+        post_trigger_remaining_ = post_trigger_samples < mask_ ? post_trigger_samples : mask_;
+    }
+    if (post_trigger_remaining_ == 0)
+    {
+        frozen_.store(true, std::memory_order_release);
+        return;
+    }
+    post_trigger_remaining_--;
+}
+
+void FlightRecorder::configure(const PB_FlightRecorderConfig &config)
+{
+    triggers_.store(config.triggers, std::memory_order_relaxed);
+    post_trigger_samples_.store(config.post_trigger_samples, std::memory_order_relaxed);
+    rearm_.store(true, std::memory_order_release);
+}
+
+void FlightRecorder::trigger()
+{
+    host_trigger_.store(true, std::memory_order_relaxed);
+}
+
+uint32_t FlightRecorder::read(uint32_t first_sample, PB_FlightRecording &recording, uint32_t &window)
+{
+    recording = PB_FlightRecording_init_zero;
+    uint32_t generation = generation_.load(std::memory_order_acquire);
+    if (first_sample == 0)
+    {
+        window = generation;
+    }
+    if (generation != window || !frozen_.load(std::memory_order_acquire))
+    {
+        return 0;
+    }
+    uint32_t count = written_ <= mask_ ? written_ : mask_ + 1;
+    uint32_t start = written_ - count;
+
+    recording.trigger = trigger_;
+    recording.trigger_sample = trigger_index_ - start;
+    recording.total_samples = count;
+    if (first_sample >= count)
+    {
+        return 0;
+    }
+
+    recording.has_frame = true;
+    TelemetryFrameWriter writer(recording.frame, ALL_TELEMETRY_SIGNALS);
+    recording.frame.first_sample = first_sample;
+    for (uint32_t i = first_sample; i < count && !writer.isFull(); i++)
+    {
+        writer.append(storage_[(start + i) & mask_]);
+    }
+
+    // Re-armed while copying: the motor task may already be recording over the samples
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (generation_.load(std::memory_order_relaxed) != window)
+    {
+        recording = PB_FlightRecording_init_zero;
+        return 0;
+    }
+    return recording.frame.sample_count;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#include "../proto/proto_gen/smartknob.pb.h"
+#include "motor_telemetry.h"
+
+// Haptic ticks kept by the flight recorder: about 1s at 1kHz in PSRAM, or a small internal buffer if there is no
+// PSRAM. Must be powers of two.
+static const uint32_t FLIGHT_RECORDER_SAMPLES = 1024;
+static const uint32_t FLIGHT_RECORDER_SAMPLES_INTERNAL = 128;
+
+// Armed at boot with every device-side trigger, keeping a quarter of the window after the trigger
+static const uint32_t FLIGHT_RECORDER_DEFAULT_TRIGGERS = (1 << PB_FlightRecorderTrigger_FLIGHT_TRIGGER_VELOCITY_RUNAWAY) |
+                                                         (1 << PB_FlightRecorderTrigger_FLIGHT_TRIGGER_SENSOR_CRC) |
+                                                         (1 << PB_FlightRecorderTrigger_FLIGHT_TRIGGER_SENSOR_STATUS) |
+                                                         (1 << PB_FlightRecorderTrigger_FLIGHT_TRIGGER_LOOP_OVERRUN);
+
+// Always-on circular buffer of the most recent haptic ticks. When a sample's events match one of the configured
+// triggers (or the host asks), the recorder keeps recording for post_trigger_samples more ticks and then freezes,
+// holding the window around the event until the host uploads it and re-arms the recorder. Unlike MotorTelemetry
+// nothing is sent until asked for, so it can stay on in the field.
+class FlightRecorder
+{
+public:
+    // Motor task, before the first record()
+    void begin();
+
+    // Motor task, every haptic tick
+    void record(const MotorTelemetrySample &sample);
+
+    // Any task. Selects the triggers and re-arms, discarding the captured window.
+    void configure(const PB_FlightRecorderConfig &config);
+
+    // Any task. Freezes the recorder as if a trigger fired on the next tick.
+    void trigger();
+
+    // Any task. Fills recording with the part of the frozen window starting at first_sample and returns the number
+    // of samples in its frame, or 0 when there is nothing more to send. The read at first_sample 0 sets window to
+    // the captured window's generation, and later reads only continue that window. recording.trigger is
+    // FLIGHT_TRIGGER_NONE, with no frame, while the recorder hasn't frozen, and also when it was re-armed after
+    // window was set or while the frame was being copied: the upload ends there rather than mixing two windows.
+    uint32_t read(uint32_t first_sample, PB_FlightRecording &recording, uint32_t &window);
+
+private:
+    MotorTelemetrySample *storage_ = nullptr;
+    uint32_t mask_ = 0;
+
+    std::atomic<uint32_t> triggers_{FLIGHT_RECORDER_DEFAULT_TRIGGERS};
+    std::atomic<uint32_t> post_trigger_samples_{FLIGHT_RECORDER_SAMPLES / 4};
+    std::atomic<bool> host_trigger_{false};
+    std::atomic<bool> rearm_{false};
+    // Release: the window fields below are complete before a reader sees frozen_
+    std::atomic<bool> frozen_{false};
+    // Bumped on every re-arm, before the motor task touches the window again, so a reader can tell whether what it
+    // copied is still the window it started on (see SeqLock)
+    std::atomic<uint32_t> generation_{0};
+
+    // Motor task only, read by other tasks while frozen_
+    uint32_t written_ = 0;
+    uint32_t trigger_index_ = 0;
+    uint32_t post_trigger_remaining_ = 0;
+    PB_FlightRecorderTrigger trigger_ = PB_FlightRecorderTrigger_FLIGHT_TRIGGER_NONE;
+};
@@ -0,0 +1,171 @@
+#include "frequency_sweep.h"
+
+#include <math.h>
+
+static const float FREQUENCY_SWEEP_DEFAULT_START_HZ = 2;
+static const float FREQUENCY_SWEEP_DEFAULT_STOP_HZ = 200;
+static const uint8_t FREQUENCY_SWEEP_DEFAULT_POINTS = 24;
+static const float FREQUENCY_SWEEP_DEFAULT_AMPLITUDE = 0.3;
+static const uint32_t FREQUENCY_SWEEP_DEFAULT_CYCLES = 6;
+
+static const float FREQUENCY_SWEEP_MIN_HZ = 0.5;
+static const uint32_t FREQUENCY_SWEEP_MAX_CYCLES = 1000;
+
+// Each point settles for this many periods before measuring, and both settling and measuring take at least
+// the minimum time, so the loop's own transient has died down even at high frequencies
+static const float FREQUENCY_SWEEP_SETTLE_CYCLES = 2;
+static const float FREQUENCY_SWEEP_MIN_SETTLE_S = 0.05;
+static const float FREQUENCY_SWEEP_MIN_MEASURE_S = 0.05;
+
+bool FrequencySweep::start(const PB_FrequencySweepConfig &config, float sample_rate_hz, float max_amplitude)
+{
+    sample_rate_hz_ = sample_rate_hz;
+    start_hz_ = config.start_hz != 0 ? config.start_hz : FREQUENCY_SWEEP_DEFAULT_START_HZ;
+    stop_hz_ = config.stop_hz != 0 ? config.stop_hz : FREQUENCY_SWEEP_DEFAULT_STOP_HZ;
+    uint32_t points = config.points != 0 ? config.points : FREQUENCY_SWEEP_DEFAULT_POINTS;
+    amplitude_ = config.amplitude != 0 ? config.amplitude : FREQUENCY_SWEEP_DEFAULT_AMPLITUDE;
+    cycles_ = config.cycles != 0 ? config.cycles : FREQUENCY_SWEEP_DEFAULT_CYCLES;
+    total_points_ = 0;
+    point_count_ = 0;
+
+    // Written as negations so NaNs are rejected too
+    if (!(start_hz_ >= FREQUENCY_SWEEP_MIN_HZ && stop_hz_ >= start_hz_ && stop_hz_ <= sample_rate_hz / 4) ||
+        points > FREQUENCY_SWEEP_MAX_POINTS || !(amplitude_ > 0 && amplitude_ <= max_amplitude) ||
+        cycles_ > FREQUENCY_SWEEP_MAX_CYCLES)
+    {
+        state_ = PB_FrequencySweepState_FREQUENCY_SWEEP_ABORTED;
+        return false;
+    }
+    total_points_ = points;
+    state_ = PB_FrequencySweepState_FREQUENCY_SWEEP_RUNNING;
+    phase_ = 0;
+    excitation_ = 0;
+    startPoint();
+    return true;
+}
+
+void FrequencySweep::abort()
+{
+    if (state_ == PB_FrequencySweepState_FREQUENCY_SWEEP_RUNNING)
+    {
+        state_ = PB_FrequencySweepState_FREQUENCY_SWEEP_ABORTED;
+    }
+    excitation_ = 0;
+}
+
+PB_FrequencySweepState FrequencySweep::state() const
+{
+    return state_;
+}
+
+bool FrequencySweep::isRunning() const
+{
+    return state_ == PB_FrequencySweepState_FREQUENCY_SWEEP_RUNNING;
+}
+
+float FrequencySweep::excitation() const
+{
+    return excitation_;
+}
+
+bool FrequencySweep::add(float torque, MultiTurnAngle angle)
+{
+    if (!isRunning())
+    {
+        return false;
+    }
+
+    bool point_done = false;
+    if (settle_remaining_ > 0)
+    {
+        settle_remaining_--;
+    }
+    else
+    {
+        if (measured_ == 0)
+        {
+            origin_ = angle;
+        }
+        // Correlate with e^(-j*theta) at the phase the excitation was computed for
+        float theta = 2 * M_PI * phase_;
+        std::complex<float> rotation(cosf(theta), -sinf(theta));
+        d_ += excitation_ * rotation;
+        u_ += torque * rotation;
+        y_ += angle.radiansFrom(origin_) * rotation;
+        if (++measured_ == measure_samples_)
+        {
+            finishPoint();
+            point_done = true;
+        }
+    }
+
+    if (!isRunning())
+    {
+        excitation_ = 0;
+        return point_done;
+    }
+    phase_ += phase_step_;
+    phase_ -= floorf(phase_);
+    excitation_ = amplitude_ * sinf(2 * M_PI * phase_);
+    return point_done;
+}
+
+uint8_t FrequencySweep::pointCount() const
+{
+    return point_count_;
+}
+
+uint8_t FrequencySweep::totalPoints() const
+{
+    return total_points_;
+}
+
+const PB_FrequencyResponsePoint *FrequencySweep::points() const
+{
+    return points_;
+}
+
+void FrequencySweep::startPoint()
+{
+    float frequency_hz = start_hz_;
+    if (total_points_ > 1)
+    {
+        frequency_hz *= powf(stop_hz_ / start_hz_, (float)point_count_ / (total_points_ - 1));
+    }
+
+    // A whole number of periods in a whole number of samples; the point's frequency moves slightly to fit
+    uint32_t cycles = cycles_;
+    uint32_t min_cycles = (uint32_t)ceilf(frequency_hz * FREQUENCY_SWEEP_MIN_MEASURE_S);
+    if (cycles < min_cycles)
+    {
+        cycles = min_cycles;
+    }
+    measure_samples_ = (uint32_t)lroundf(cycles * sample_rate_hz_ / frequency_hz);
+    phase_step_ = (float)cycles / measure_samples_;
+    settle_remaining_ = (uint32_t)lroundf(fmaxf(FREQUENCY_SWEEP_SETTLE_CYCLES / frequency_hz, FREQUENCY_SWEEP_MIN_SETTLE_S) * sample_rate_hz_);
+
+    measured_ = 0;
+    d_ = 0;
+    u_ = 0;
+    y_ = 0;
+}
+
+void FrequencySweep::finishPoint()
+{
+    std::complex<float> plant = y_ / u_;
+    std::complex<float> loop = d_ / u_ - 1.0f;
+
+    PB_FrequencyResponsePoint &point = points_[point_count_];
+    point.frequency_hz = phase_step_ * sample_rate_hz_;
+    point.plant_gain = std::abs(plant);
+    point.plant_phase_deg = std::arg(plant) * (180 / M_PI);
+    point.loop_gain = std::abs(loop);
+    point.loop_phase_deg = std::arg(loop) * (180 / M_PI);
+
+    if (++point_count_ == total_points_)
+    {
+        state_ = PB_FrequencySweepState_FREQUENCY_SWEEP_DONE;
+        return;
+    }
+    startPoint();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <complex>
+#include <stdint.h>
+
+#include "../haptics/fixed_angle.h"
+#include "../proto/proto_gen/smartknob.pb.h"
+
+static const uint8_t FREQUENCY_SWEEP_MAX_POINTS = 48;
+
+// Stepped-sine frequency response measurement of the detent loop while it runs. For each point the caller adds
+// excitation() to the controller's torque output and feeds back the total torque and the sensor angle every
+// tick; after a settling time, the injected torque d, total torque u and angle y are correlated against the
+// excitation over a whole number of periods, which gives their phasors at that one frequency with everything
+// else (noise, the detent's static torque, other frequencies) averaging out. Plant and loop gain follow from
+// the ratios (see PB_FrequencyResponsePoint).
+//
+// Log-spaced points from start_hz to stop_hz; the excitation's phase runs on across points so stepping the
+// frequency doesn't kick the rotor.
+class FrequencySweep
+{
+public:
+    // Starts a sweep sampled at sample_rate_hz. Zero config fields take their defaults. Returns false, and
+    // leaves the sweep aborted, if the config is out of range.
+    bool start(const PB_FrequencySweepConfig &config, float sample_rate_hz, float max_amplitude);
+    void abort();
+
+    PB_FrequencySweepState state() const;
+    bool isRunning() const;
+
+    // Torque to add to the controller's output on this tick
+    float excitation() const;
+
+    // The tick's total torque (controller output plus excitation) and the sensor angle sampled at the start of
+    // the tick. Returns true when a point was completed.
+    bool add(float torque, MultiTurnAngle angle);
+
+    uint8_t pointCount() const;
+    uint8_t totalPoints() const;
+    const PB_FrequencyResponsePoint *points() const;
+
+private:
+    void startPoint();
+    void finishPoint();
+
+    PB_FrequencySweepState state_ = PB_FrequencySweepState_FREQUENCY_SWEEP_IDLE;
+    float sample_rate_hz_ = 0;
+    float start_hz_ = 0;
+    float stop_hz_ = 0;
+    float amplitude_ = 0;
+    uint32_t cycles_ = 0;
+    uint8_t total_points_ = 0;
+    uint8_t point_count_ = 0;
+
+    // Excitation phase in turns, and its step per sample (a whole number of periods over measure_samples_)
+    float phase_ = 0;
+    float phase_step_ = 0;
+    float excitation_ = 0;
+
+    uint32_t settle_remaining_ = 0;
+    uint32_t measure_samples_ = 0;
+    uint32_t measured_ = 0;
+    // Angles are taken relative to the first measured sample, so they are small and exact as floats
+    MultiTurnAngle origin_ = {};
+    std::complex<float> d_;
+    std::complex<float> u_;
+    std::complex<float> y_;
+
+    PB_FrequencyResponsePoint points_[FREQUENCY_SWEEP_MAX_POINTS] = {};
+};
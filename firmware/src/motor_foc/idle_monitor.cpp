@@ -0,0 +1,87 @@
+#include "idle_monitor.h"
+
+#include <math.h>
+
+static const uint32_t IDLE_DEFAULT_TIMEOUT_MS = MOTOR_IDLE_TIMEOUT_MS != 0 ? MOTOR_IDLE_TIMEOUT_MS : 30000;
+static const float IDLE_DEFAULT_VELOCITY_THRESHOLD = 0.5;
+static const float IDLE_DEFAULT_WAKE_ANGLE_RAD = 0.02;
+
+static const uint32_t IDLE_MIN_TIMEOUT_MS = 100;
+
+IdleMonitor::IdleMonitor() : enabled_(MOTOR_IDLE_TIMEOUT_MS != 0),
+                             timeout_ms_(IDLE_DEFAULT_TIMEOUT_MS),
+                             loop_hz_(MOTOR_IDLE_LOOP_HZ),
+                             velocity_threshold_(IDLE_DEFAULT_VELOCITY_THRESHOLD),
+                             wake_angle_radians_(IDLE_DEFAULT_WAKE_ANGLE_RAD)
+{
+}
+
+bool IdleMonitor::configure(const PB_MotorIdleConfig &config, uint32_t max_loop_hz)
+{
+    uint32_t timeout_ms = config.timeout_ms != 0 ? config.timeout_ms : IDLE_DEFAULT_TIMEOUT_MS;
+    uint32_t loop_hz = config.loop_hz != 0 ? config.loop_hz : MOTOR_IDLE_LOOP_HZ;
+    float velocity_threshold = config.velocity_threshold != 0 ? config.velocity_threshold : IDLE_DEFAULT_VELOCITY_THRESHOLD;
+    float wake_angle_radians = config.wake_angle_radians != 0 ? config.wake_angle_radians : IDLE_DEFAULT_WAKE_ANGLE_RAD;
+
+    // Written as negations so NaNs are rejected too
+    if (timeout_ms < IDLE_MIN_TIMEOUT_MS || loop_hz > max_loop_hz || !(velocity_threshold > 0) || !(wake_angle_radians > 0) ||
+        !isfinite(velocity_threshold) || !isfinite(wake_angle_radians))
+    {
+        return false;
+    }
+
+    enabled_ = config.enabled;
+    timeout_ms_ = timeout_ms;
+    loop_hz_ = loop_hz;
+    velocity_threshold_ = velocity_threshold;
+    wake_angle_radians_ = wake_angle_radians;
+    return true;
+}
+
+void IdleMonitor::reset(uint32_t now_ms)
+{
+    state_start_ms_ = now_ms;
+    last_activity_ms_ = now_ms;
+}
+
+bool IdleMonitor::isIdle() const
+{
+    return idle_;
+}
+
+uint32_t IdleMonitor::loopHz() const
+{
+    return loop_hz_;
+}
+
+bool IdleMonitor::update(float velocity, bool busy, uint32_t now_ms)
+{
+    if (busy || !enabled_ || !(fabsf(velocity) < velocity_threshold_))
+    {
+        last_activity_ms_ = now_ms;
+        return false;
+    }
+    return now_ms - last_activity_ms_ >= timeout_ms_;
+}
+
+uint32_t IdleMonitor::sleep(MultiTurnAngle angle, uint32_t now_ms)
+{
+    uint32_t active_ms = now_ms - state_start_ms_;
+    idle_ = true;
+    idle_angle_ = angle;
+    state_start_ms_ = now_ms;
+    return active_ms;
+}
+
+bool IdleMonitor::moved(MultiTurnAngle angle) const
+{
+    return fabsf(angle.radiansFrom(idle_angle_)) > wake_angle_radians_;
+}
+
+uint32_t IdleMonitor::wake(uint32_t now_ms)
+{
+    uint32_t idle_ms = now_ms - state_start_ms_;
+    idle_ = false;
+    reset(now_ms);
+    return idle_ms;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "../haptics/fixed_angle.h"
+#include "../proto/proto_gen/smartknob.pb.h"
+
+// Boot defaults of the idle mode (see PB_MotorIdleConfig); MOTOR_IDLE_TIMEOUT_MS=0 boots with it disabled
+#ifndef MOTOR_IDLE_TIMEOUT_MS
+#define MOTOR_IDLE_TIMEOUT_MS 30000
+#endif
+
+#ifndef MOTOR_IDLE_LOOP_HZ
+#define MOTOR_IDLE_LOOP_HZ 200
+#endif
+
+// Decides when the motor can drop to its low-power idle mode and when it has to wake. While active it times how
+// long the knob has been still (observer velocity below velocity_threshold) with nothing else needing the motor;
+// while idle it watches the sensor angle against where the knob was left. The motor task does the switching.
+class IdleMonitor
+{
+public:
+    IdleMonitor();
+
+    // Zero fields other than enabled take their defaults. Returns false, keeping the current settings, if the
+    // config is out of range. max_loop_hz is the rate the loop runs at while active.
+    bool configure(const PB_MotorIdleConfig &config, uint32_t max_loop_hz);
+
+    // Restarts the timeout, e.g. when the loop (re)starts
+    void reset(uint32_t now_ms);
+
+    bool isIdle() const;
+    uint32_t loopHz() const;
+
+    // Active, every haptic tick. busy is anything besides the knob turning that needs the motor: a command, a
+    // playing haptic waveform, a frequency sweep, someone near the knob. Returns true once the motor has been
+    // unneeded for the timeout.
+    bool update(float velocity, bool busy, uint32_t now_ms);
+
+    // Switches to idle, watching for the knob to turn away from angle. Returns the time spent active.
+    uint32_t sleep(MultiTurnAngle angle, uint32_t now_ms);
+
+    // Idle, every idle tick. True if the knob has turned far enough to wake the motor.
+    bool moved(MultiTurnAngle angle) const;
+
+    // Switches back to active, restarting the timeout. Returns the time spent idle.
+    uint32_t wake(uint32_t now_ms);
+
+private:
+    bool enabled_;
+    uint32_t timeout_ms_;
+    uint32_t loop_hz_;
+    float velocity_threshold_;
+    float wake_angle_radians_;
+
+    bool idle_ = false;
+    uint32_t state_start_ms_ = 0;
+    uint32_t last_activity_ms_ = 0;
+    MultiTurnAngle idle_angle_ = {};
+};
@@ -0,0 +1,38 @@
+#include "loop_timer.h"
+
+void LoopTimer::begin(esp_timer_cb_t callback, void *arg, const char *name)
+{
+    const esp_timer_create_args_t args = {
+        .callback = callback,
+        .arg = arg,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = name,
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&args, &timer_));
+}
+
+void LoopTimer::start(uint32_t hz)
+{
+    stop();
+    ESP_ERROR_CHECK(esp_timer_start_periodic(timer_, 1000000 / hz));
+    hz_ = hz;
+}
+
+void LoopTimer::stop()
+{
+    if (hz_ != 0)
+    {
+        ESP_ERROR_CHECK(esp_timer_stop(timer_));
+        hz_ = 0;
+    }
+}
+
+bool LoopTimer::isRunning() const
+{
+    return hz_ != 0;
+}
+
+uint32_t LoopTimer::getHz() const
+{
+    return hz_;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <esp_timer.h>
+#include <stdint.h>
+
+// The periodic esp_timer that paces the motor loop. The loop changes rate while running (active, idle, stopped
+// for calibration), and esp_timer_start_periodic() fails on a timer that is already running, so start() takes
+// the timer from whatever state it is in to the new rate.
+class LoopTimer
+{
+public:
+    // Creates the timer; callback runs on the esp_timer task once per period
+    void begin(esp_timer_cb_t callback, void *arg, const char *name);
+
+    // (Re)starts the timer at hz
+    void start(uint32_t hz);
+    void stop();
+
+    bool isRunning() const;
+    // 0 while stopped
+    uint32_t getHz() const;
+
+private:
+    esp_timer_handle_t timer_ = nullptr;
+    uint32_t hz_ = 0;
+};
@@ -9,22 +9,53 @@
 #include "maq430_sensor.h"
 #endif
 
-#include "../motors/motor_config.h"
-#include "../util.h"
+#include <memory>
 
-static const float DEAD_ZONE_DETENT_PERCENT = 0.2;
-static const float DEAD_ZONE_RAD = 1 * _PI / 180;
+#include "../motors/motor_config.h"
 
-static const float IDLE_VELOCITY_EWMA_ALPHA = 0.001;
-static const float IDLE_VELOCITY_RAD_PER_SEC = 0.05;
-static const uint32_t IDLE_CORRECTION_DELAY_MILLIS = 500;
-static const float IDLE_CORRECTION_MAX_ANGLE_RAD = 5 * PI / 180;
-static const float IDLE_CORRECTION_RATE_ALPHA = 0.0005;
+// Bandwidth of the knob angle observer; motor profiles may tune it (see AngleObserver)
+#ifndef FOC_OBSERVER_BANDWIDTH_HZ
+#define FOC_OBSERVER_BANDWIDTH_HZ 50
+#endif
 
-MotorTask::MotorTask(const uint8_t task_core, Configuration &configuration) : Task("Motor", 1024 * 8, 0, task_core), configuration_(configuration)
+// Calibration waits for the rotor to settle in windows of this many 1ms samples, until the standard deviation
+// within a window and the change from the previous window are both below CALIB_SETTLE_STDDEV_RAD
+static const uint8_t CALIB_SETTLE_WINDOW = 20;
+static const float CALIB_SETTLE_STDDEV_RAD = 0.002;
+
+// Fast calibration fails if the fitted pole pair count is further than this from an integer
+static const float CALIB_POLE_PAIRS_TOLERANCE = 0.15;
+
+// Cogging calibration holds the rotor at CALIB_COGGING_SAMPLES points per revolution, each until the position error
+// stays within CALIB_COGGING_TOLERANCE_RAD for CALIB_COGGING_WINDOW consecutive 1ms samples (or
+// CALIB_COGGING_MAX_HOLD_MS passes). The hold loop is stiffer than the detent controller and has an integral
+// term, so it settles at exactly the torque needed to hold the angle.
+static const uint16_t CALIB_COGGING_SAMPLES = COGGING_MAP_MAX_SAMPLES;
+static const uint8_t CALIB_COGGING_WINDOW = 20;
+static const uint16_t CALIB_COGGING_MAX_HOLD_MS = 300;
+static const float CALIB_COGGING_TOLERANCE_RAD = 0.002;
+static const float CALIB_COGGING_SLEW_RAD = 0.002;
+static const float CALIB_COGGING_PID_P = 4 * FOC_PID_P;
+static const float CALIB_COGGING_PID_I = 200;
+
+// Runs above the other (priority 0) tasks pinned to the motor core; the loop blocks on the loop timer between ticks
+MotorTask::MotorTask(const uint8_t task_core, Configuration &configuration) : Task("Motor", 1024 * 8, 2, task_core),
+                                                                            configuration_(configuration),
+                                                                            haptic_engine_({
+                                                                                .p = FOC_PID_P,
+                                                                                .i = FOC_PID_I,
+                                                                                .d = FOC_PID_D,
+                                                                                .output_ramp = FOC_PID_OUTPUT_RAMP,
+                                                                                .limit = FOC_PID_LIMIT,
+                                                                            }),
+                                                                            observer_(ObserverGains::criticallyDamped(FOC_OBSERVER_BANDWIDTH_HZ, 1.0f / MOTOR_FOC_LOOP_HZ))
 {
-    queue_ = xQueueCreate(5, sizeof(Command));
-    assert(queue_ != NULL);
+    command_queue_ = xQueueCreate(MOTOR_COMMAND_QUEUE_LENGTH, sizeof(Command));
+    assert(command_queue_ != NULL);
+    upload_queue_ = xQueueCreate(MOTOR_UPLOAD_QUEUE_LENGTH, sizeof(Upload));
+    assert(upload_queue_ != NULL);
+
+    resetLoopStats();
 }
 
 MotorTask::~MotorTask() {}
@@ -60,18 +91,6 @@ void MotorTask::run()
     motor.velocity_limit = 10000;
     motor.linkSensor(&encoder);
 
-    // Not actually using the velocity loop built into SimpleFOC; but I'm using those PID variables
-    // to run PID for torque (and SimpleFOC studio supports updating them easily over serial for tuning)
-    motor.PID_velocity.P = FOC_PID_P;
-    motor.PID_velocity.I = FOC_PID_I;
-    motor.PID_velocity.D = FOC_PID_D;
-    motor.PID_velocity.output_ramp = FOC_PID_OUTPUT_RAMP;
-    motor.PID_velocity.limit = FOC_PID_LIMIT;
-
-#ifdef FOC_LPF
-    motor.LPF_angle.Tf = FOC_LPF;
-#endif
-
     motor.init();
 
     encoder.update();
@@ -85,7 +104,7 @@ void MotorTask::run()
 #if DO_AUTOMATIC_MOTOR_CALIBRATION
     if (!c.motor.calibrated) // If the motor hasn't been calibrated, do it now
     {
-        calibrate();
+        calibrate(false);
         c = configuration_.get();
     }
 #else
@@ -96,47 +115,121 @@ void MotorTask::run()
 #endif
 
     motor.zero_electric_angle = c.motor.zero_electrical_offset;
+#if SENSOR_MT6701
+    encoder.setLinearization(c.motor.linearization);
+#endif
     motor.initFOC();
+    cogging_.build(configuration_.getCoggingMap());
+    if (!haptic_engine_.setGainSchedule(configuration_.getGainSchedule()))
+    {
+        LOGW("Stored gain schedule is invalid, using the built-in one");
+    }
 
     motor.monitor_downsample = 0; // disable monitor at first - optional
 
-    float current_detent_center = motor.shaft_angle;
-    PB_SmartKnobConfig config = {
-        .position_width_radians = 60 * M_PI / 180,
-        .endstop_strength_unit = 0,
-        .snap_point = 0.5,
-        .detent_positions_count = 0,
-        .detent_positions = {},
-    };
+    resetObserver();
+    haptic_engine_.reset(getKnobAngle());
 
-    PB_SmartKnobConfig last_discarded_config = config;
+    PB_SmartKnobConfig last_discarded_config = haptic_engine_.getConfig();
+    publishConfig();
 
-    int32_t current_position = 0;
-    float latest_sub_position_unit = 0;
+    uint32_t haptic_tick = 0;
+    flight_recorder_.begin();
 
-    float idle_check_velocity_ewma = 0;
-    uint32_t last_idle_start = 0;
-    uint32_t last_publish = 0;
+    loop_timer_.begin([](void *arg)
+                      { xTaskNotifyGive(static_cast<MotorTask *>(arg)->getHandle()); },
+                      this, "motor_loop");
+    startLoopTimer();
+    idle_monitor_.reset(millis());
 
     while (1)
     {
+        // Each timer tick increments the notification value, so anything above 1 means ticks were missed
+        uint32_t pending_ticks = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        int64_t wake_us = esp_timer_get_time();
+
+        // While idle, the timer runs at the idle loop rate and each tick only reads the sensor, until something
+        // wakes the motor. It then runs a haptic tick straight away, so the detent is back within this tick.
+        PB_MotorWakeReason wake_reason = PB_MotorWakeReason_MOTOR_WAKE_NONE;
+        uint32_t wake_start_us = 0;
+        uint32_t idle_ms = 0;
+        if (idle_monitor_.isIdle())
+        {
+            encoder.update();
+            wake_start_us = micros();
+            wake_reason = checkWake(wake_start_us);
+            if (wake_reason == PB_MotorWakeReason_MOTOR_WAKE_NONE)
+            {
+                continue;
+            }
+            idle_ms = idle_monitor_.wake(millis());
+            motor.enable();
+            resetObserver();
+            startLoopTimer();
+            haptic_tick = MOTOR_HAPTIC_LOOP_DIVIDER - 1;
+        }
+
+        uint32_t foc_start_cycles = ESP.getCycleCount();
         motor.loopFOC();
+        uint32_t foc_cycles = ESP.getCycleCount() - foc_start_cycles;
+        observer_.update(getEncoderAngle(), getEncoderSampleTimeUs());
+
+        if (++haptic_tick < MOTOR_HAPTIC_LOOP_DIVIDER)
+        {
+            if (cogging_.isEnabled())
+            {
+                // Keep the cogging feed-forward tracking the rotor between haptic ticks
+                applyTorque();
+            }
+            finishLoopIteration(wake_us, pending_ticks, foc_cycles);
+            continue;
+        }
+        haptic_tick = 0;
+
+        // Apply what other tasks sent since the last haptic tick: uploads first, so a config that refers to a
+        // just-uploaded torque profile or detent set finds it, then the newest config, then the commands
+        bool ignored = false;
+        bool received = false;
+        Upload upload;
+        for (uint8_t i = 0; i < MOTOR_UPLOAD_QUEUE_LENGTH && xQueueReceive(upload_queue_, &upload, 0) == pdTRUE; i++)
+        {
+            received = true;
+            if (!c.motor.calibrated)
+            {
+                ignored = true;
+                continue;
+            }
+            handleUpload(upload);
+        }
+
+        uint32_t config_posted_us;
+        const PB_SmartKnobConfig *config = config_mailbox_.take(config_posted_us);
+        if (config != nullptr)
+        {
+            received = true;
+            if (!c.motor.calibrated)
+            {
+                last_discarded_config = *config;
+                ignored = true;
+            }
+            else if (applyConfig(*config))
+            {
+                uint32_t latency_us = micros() - config_posted_us;
+                portENTER_CRITICAL(&loop_stats_mux_);
+                loop_stats_.configs_applied++;
+                loop_stats_.config_latency_max_us = max(loop_stats_.config_latency_max_us, latency_us);
+                loop_stats_.config_latency_total_us += latency_us;
+                portEXIT_CRITICAL(&loop_stats_mux_);
+            }
+        }
 
-        // Check queue for pending requests from other tasks
         Command command;
-        if (xQueueReceive(queue_, &command, 0) == pdTRUE)
+        for (uint8_t i = 0; i < MOTOR_COMMAND_QUEUE_LENGTH && xQueueReceive(command_queue_, &command, 0) == pdTRUE; i++)
         {
+            received = true;
             if (!c.motor.calibrated && command.command_type != CommandType::CALIBRATE)
             {
-                if (command.command_type == CommandType::CONFIG)
-                {
-                    last_discarded_config = command.data.config;
-                }
-                LOGI("Ignoring command, motor not calibrated!");
-                if (motor.enabled)
-                    motor.disable();
-
-                delay(1);
+                ignored = true;
                 continue;
             }
             switch (command.command_type)
@@ -144,303 +237,731 @@ void MotorTask::run()
             case CommandType::CALIBRATE:
                 if (!motor.enabled)
                     motor.enable();
+                abortFrequencySweep();
 
-                motor.PID_velocity.P = FOC_PID_P;
-                motor.PID_velocity.I = FOC_PID_I;
-                motor.PID_velocity.D = FOC_PID_D;
-                motor.PID_velocity.output_ramp = FOC_PID_OUTPUT_RAMP;
-                motor.PID_velocity.limit = FOC_PID_LIMIT;
+                // Calibration paces itself; don't count it against the loop timing
+                stopLoopTimer();
+                calibrate(command.data.fast_calibration);
+                c = configuration_.get(); // Pick up the new calibration so later commands aren't ignored
 
-                calibrate();
-
-                command.data.config = last_discarded_config; // Re-apply last received config after calibration
                 encoder.update();
                 motor.initFOC();
-            case CommandType::CONFIG:
-            {
-                // Check new config for validity
-                PB_SmartKnobConfig &new_config = command.data.config;
-                if (new_config.detent_strength_unit < 0)
-                {
-                    LOGD("Ignoring invalid config: detent_strength_unit cannot be negative");
-                    break;
-                }
-                if (new_config.endstop_strength_unit < 0)
-                {
-                    LOGD("Ignoring invalid config: endstop_strength_unit cannot be negative");
-                    break;
-                }
-                if (new_config.snap_point < 0.5)
-                {
-                    LOGD("Ignoring invalid config: snap_point must be >= 0.5 for stability");
-                    break;
-                }
-                if (new_config.detent_positions_count > COUNT_OF(new_config.detent_positions))
-                {
-                    LOGD("Ignoring invalid config: detent_positions_count is too large");
-                    break;
-                }
-                if (new_config.snap_point_bias < 0)
-                {
-                    LOGD("Ignoring invalid config: snap_point_bias cannot be negative or there is risk of instability");
-                    break;
-                }
+                resetObserver();
 
-                // Change haptic input mode
-                bool position_updated = false;
-                if (new_config.position != config.position || new_config.sub_position_unit != config.sub_position_unit || new_config.position_nonce != config.position_nonce)
-                {
-                    LOGV(LOG_LEVEL_DEBUG, "Applying position change");
-                    current_position = new_config.position;
-                    position_updated = true;
-                }
+                resetLoopStats();
+                startLoopTimer();
 
-                if (new_config.min_position <= new_config.max_position)
+                // Re-apply last received config after calibration
+                applyConfig(last_discarded_config);
+                break;
+            case CommandType::HAPTIC:
+                if (!haptic_player_.play(command.data.haptic.waveform, command.data.haptic.strength))
                 {
-                    // Only check bounds if min/max indicate bounds are active (min >= max)
-                    if (current_position < new_config.min_position)
-                    {
-                        current_position = new_config.min_position;
-                        LOGV(LOG_LEVEL_DEBUG, "Adjusting position to min");
-                    }
-                    else if (current_position > new_config.max_position)
-                    {
-                        current_position = new_config.max_position;
-                        LOGV(LOG_LEVEL_DEBUG, "Adjusting position to max");
-                    }
+                    LOGD("Ignoring unknown or empty haptic waveform %d", command.data.haptic.waveform);
                 }
+                break;
+            case CommandType::CALIBRATE_COGGING:
+                if (!motor.enabled)
+                    motor.enable();
+                abortFrequencySweep();
 
-                if (position_updated || new_config.position_width_radians != config.position_width_radians)
-                {
-                    LOGV(LOG_LEVEL_DEBUG, "Adjusting detent center");
-                    float new_sub_position = position_updated ? new_config.sub_position_unit : latest_sub_position_unit;
-#if SK_INVERT_ROTATION
-                    float shaft_angle = -motor.shaft_angle;
-#else
-                    float shaft_angle = motor.shaft_angle;
-#endif
-                    current_detent_center = shaft_angle + new_sub_position * new_config.position_width_radians;
-                }
-                config = new_config;
-                LOGV(LOG_LEVEL_DEBUG, "Got new config");
-
-                // Update derivative factor of torque controller based on detent width.
-                // If the D factor is large on coarse detents, the motor ends up making noise because the P&D factors amplify the noise from the sensor.
-                // This is a piecewise linear function so that fine detents (small width) get a higher D factor and coarse detents get a small D factor.
-                // Fine detents need a nonzero D factor to artificially create "clicks" each time a new value is reached (the P factor is small
-                // for fine detents due to the smaller angular errors, and the existing P factor doesn't work well for very small angle changes (easy to
-                // get runaway due to sensor noise & lag)).
-                // TODO: consider eliminating this D factor entirely and just "play" a hardcoded haptic "click" (e.g. a quick burst of torque in each
-                // direction) whenever the position changes when the detent width is too small for the P factor to work well.
-                const float derivative_lower_strength = config.detent_strength_unit * 0.08;
-                const float derivative_upper_strength = config.detent_strength_unit * 0.02;
-                const float derivative_position_width_lower = radians(3);
-                const float derivative_position_width_upper = radians(8);
-                const float raw = derivative_lower_strength + (derivative_upper_strength - derivative_lower_strength) / (derivative_position_width_upper - derivative_position_width_lower) * (config.position_width_radians - derivative_position_width_lower);
-                // When there are intermittent detents (set via detent_positions), disable derivative factor as this adds extra "clicks" when nearing
-                // a detent.
-                motor.PID_velocity.D = config.detent_positions_count > 0 ? 0 : CLAMP(raw, min(derivative_lower_strength, derivative_upper_strength), max(derivative_lower_strength, derivative_upper_strength));
+                stopLoopTimer();
+                calibrateCogging();
+                resetObserver();
+                haptic_engine_.reset(getKnobAngle()); // The knob has turned a full revolution
+
+                resetLoopStats();
+                startLoopTimer();
                 break;
-            }
-            case CommandType::HAPTIC:
-            {
-                int foc_ticks = 3;
-                // Play a hardcoded haptic "click"
-                float strength = command.data.haptic.press ? 5 : 1.5;
-                if (command.data.haptic.long_press)
+            case CommandType::FREQUENCY_SWEEP:
+                sweep_count_++;
+                if (!frequency_sweep_.start(command.data.frequency_sweep, (float)MOTOR_FOC_LOOP_HZ / MOTOR_HAPTIC_LOOP_DIVIDER, FOC_PID_LIMIT))
                 {
-                    strength = 20;
-                    foc_ticks = 6;
+                    LOGD("Ignoring invalid frequency sweep config");
                 }
-                motor.move(strength);
-                for (uint8_t i = 0; i < foc_ticks; i++)
+                publishFrequencySweep();
+                break;
+            case CommandType::FREQUENCY_SWEEP_STOP:
+                abortFrequencySweep();
+                break;
+            case CommandType::GAIN_SCHEDULE:
+                if (!haptic_engine_.setGainSchedule(configuration_.getGainSchedule()))
                 {
-                    motor.loopFOC();
-                    delay(1);
+                    LOGD("Ignoring invalid gain schedule");
                 }
-                motor.move(-strength);
-                for (uint8_t i = 0; i < foc_ticks; i++)
+                break;
+            case CommandType::IDLE_CONFIG:
+                if (!idle_monitor_.configure(command.data.idle_config, MOTOR_FOC_LOOP_HZ / MOTOR_HAPTIC_LOOP_DIVIDER))
                 {
-                    motor.loopFOC();
-                    delay(1);
+                    LOGD("Ignoring invalid idle config");
                 }
-                motor.move(0);
-                motor.loopFOC();
                 break;
             }
-            }
         }
 
-        // If we are not moving and we're close to the center (but not exactly there), slowly adjust the centerpoint to match the current position
-        idle_check_velocity_ewma = motor.shaft_velocity * IDLE_VELOCITY_EWMA_ALPHA + idle_check_velocity_ewma * (1 - IDLE_VELOCITY_EWMA_ALPHA);
-        if (fabsf(idle_check_velocity_ewma) > IDLE_VELOCITY_RAD_PER_SEC)
-        {
-            last_idle_start = 0;
-        }
-        else
-        {
-            if (last_idle_start == 0)
-            {
-                last_idle_start = millis();
-            }
-        }
-        if (last_idle_start > 0 && millis() - last_idle_start > IDLE_CORRECTION_DELAY_MILLIS && fabsf(motor.shaft_angle - current_detent_center) < IDLE_CORRECTION_MAX_ANGLE_RAD)
+        if (ignored && !c.motor.calibrated)
         {
-            current_detent_center = motor.shaft_angle * IDLE_CORRECTION_RATE_ALPHA + current_detent_center * (1 - IDLE_CORRECTION_RATE_ALPHA);
+            LOGI("Ignoring command, motor not calibrated!");
+            if (motor.enabled)
+                motor.disable();
+
+            finishLoopIteration(wake_us, pending_ticks, foc_cycles);
+            continue;
         }
 
-        // Check where we are relative to the current nearest detent; update our position if we've moved far enough to snap to another detent
-        float angle_to_detent_center = motor.shaft_angle - current_detent_center;
+        // Apply motor torque based on our angle to the nearest detent, with any haptic waveform superimposed
+        HapticInput input = {
+            .angle = getKnobAngle(),
+            .velocity = getKnobVelocity(),
+            .acceleration = getKnobAcceleration(),
+            .now_us = micros(),
+        };
+        HapticOutput output = haptic_engine_.update(input);
+        float torque = output.torque + haptic_player_.tick() + frequency_sweep_.excitation();
 #if SK_INVERT_ROTATION
-        angle_to_detent_center = -motor.shaft_angle - current_detent_center;
+        motor_torque_ = -torque;
+#else
+        motor_torque_ = torque;
 #endif
+        applyTorque();
+        if (wake_reason != PB_MotorWakeReason_MOTOR_WAKE_NONE)
+        {
+            publishPowerEvent(PB_MotorPowerState_MOTOR_POWER_ACTIVE, wake_reason, micros() - wake_start_us, idle_ms);
+        }
 
-        float snap_point_radians = config.position_width_radians * config.snap_point;
-        float bias_radians = config.position_width_radians * config.snap_point_bias;
-        float snap_point_radians_decrease = snap_point_radians + (current_position <= 0 ? bias_radians : -bias_radians);
-        float snap_point_radians_increase = -snap_point_radians + (current_position >= 0 ? -bias_radians : bias_radians);
+        publishState(output);
 
-        int32_t num_positions = config.max_position - config.min_position + 1;
-        if (angle_to_detent_center > snap_point_radians_decrease && (num_positions <= 0 || current_position > config.min_position))
+        if (frequency_sweep_.isRunning())
         {
-            current_detent_center += config.position_width_radians;
-            angle_to_detent_center -= config.position_width_radians;
-            current_position--;
+            // The raw sensor angle rather than the observer's estimate, whose lag isn't part of the plant
+#if SK_INVERT_ROTATION
+            MultiTurnAngle sensor_angle = -getEncoderAngle();
+#else
+            MultiTurnAngle sensor_angle = getEncoderAngle();
+#endif
+            if (fabsf(input.velocity) > RUNAWAY_VELOCITY_RAD_PER_SEC)
+            {
+                abortFrequencySweep();
+            }
+            else if (frequency_sweep_.add(torque, sensor_angle))
+            {
+                publishFrequencySweep();
+            }
         }
-        else if (angle_to_detent_center < snap_point_radians_increase && (num_positions <= 0 || current_position < config.max_position))
+
+        uint32_t events = pending_events_ | checkSensorError();
+        if (fabsf(input.velocity) > RUNAWAY_VELOCITY_RAD_PER_SEC)
         {
-            current_detent_center -= config.position_width_radians;
-            angle_to_detent_center += config.position_width_radians;
-            current_position++;
+            events |= 1 << PB_FlightRecorderTrigger_FLIGHT_TRIGGER_VELOCITY_RUNAWAY;
         }
+        pending_events_ = 0;
+        recordTelemetry(input, output, torque, events);
 
-        latest_sub_position_unit = -angle_to_detent_center / config.position_width_radians;
+        bool busy = received || presence_.exchange(false) || haptic_player_.isPlaying() || frequency_sweep_.isRunning() ||
+                    telemetry_.isSubscribed();
+        bool go_idle = idle_monitor_.update(input.velocity, busy, millis());
 
-        float dead_zone_adjustment = CLAMP(
-            angle_to_detent_center,
-            fmaxf(-config.position_width_radians * DEAD_ZONE_DETENT_PERCENT, -DEAD_ZONE_RAD),
-            fminf(config.position_width_radians * DEAD_ZONE_DETENT_PERCENT, DEAD_ZONE_RAD));
+        finishLoopIteration(wake_us, pending_ticks, foc_cycles);
+        if (go_idle)
+        {
+            enterIdle();
+        }
+    }
+}
 
-        bool out_of_bounds = num_positions > 0 && ((angle_to_detent_center > 0 && current_position == config.min_position) || (angle_to_detent_center < 0 && current_position == config.max_position));
-        motor.PID_velocity.limit = 10; // out_of_bounds ? 10 : 3;
-        motor.PID_velocity.P = out_of_bounds ? config.endstop_strength_unit * 4 : config.detent_strength_unit * 4;
+bool MotorTask::applyConfig(const PB_SmartKnobConfig &config)
+{
+    HapticConfigStatus status = haptic_engine_.setConfig(config, getKnobAngle());
+    if (status != HapticConfigStatus::OK)
+    {
+        LOGD("Ignoring invalid config: %s", hapticConfigStatusToString(status));
+        return false;
+    }
+    publishConfig();
+    LOGV(LOG_LEVEL_DEBUG, "Got new config");
+    return true;
+}
 
-        // Apply motor torque based on our angle to the nearest detent (detent strength, etc is handled by the PID_velocity parameters)
-        if (fabsf(motor.shaft_velocity) > 60)
+void MotorTask::handleUpload(const Upload &upload)
+{
+    switch (upload.upload_type)
+    {
+    case UploadType::HAPTIC_WAVEFORM:
+    {
+        const PB_HapticWaveform &waveform = upload.data.haptic_waveform;
+        if (!haptic_player_.setUserWaveform(waveform.waveform, waveform.samples, waveform.samples_count, waveform.ticks_per_sample))
         {
-            // Don't apply torque if velocity is too high (helps avoid positive feedback loop/runaway)
-            motor.move(0);
+            LOGD("Ignoring invalid haptic waveform upload for slot %d", waveform.waveform);
         }
-        else
+        break;
+    }
+    case UploadType::TORQUE_PROFILE:
+    {
+        const PB_TorqueProfile &profile = upload.data.torque_profile;
+        if (!haptic_engine_.setTorqueProfile(profile))
+        {
+            LOGD("Ignoring torque profile upload for invalid slot %d", profile.id);
+            break;
+        }
+        if (haptic_engine_.getConfig().torque_profile_id == profile.id)
         {
-            float input = -angle_to_detent_center + dead_zone_adjustment;
-            if (!out_of_bounds && config.detent_positions_count > 0)
+            // Rebuild the active profile from the new samples
+            HapticConfigStatus status = haptic_engine_.setConfig(haptic_engine_.getConfig(), getKnobAngle());
+            if (status != HapticConfigStatus::OK)
             {
-                bool in_detent = false;
-                for (uint8_t i = 0; i < config.detent_positions_count; i++)
-                {
-                    if (config.detent_positions[i] == current_position)
-                    {
-                        in_detent = true;
-                        break;
-                    }
-                }
-                if (!in_detent)
-                {
-                    input = 0;
-                }
+                LOGD("Uploaded torque profile not applied: %s", hapticConfigStatusToString(status));
+            }
+            else
+            {
+                publishConfig();
             }
-            float torque = motor.PID_velocity(input);
-#if SK_INVERT_ROTATION
-            torque = -torque;
-#endif
-            motor.move(torque);
         }
+        break;
+    }
+    case UploadType::DETENT_SET:
+        if (!haptic_engine_.setDetentSet(upload.data.detent_set))
+        {
+            LOGD("Ignoring detent set upload for invalid slot %d", upload.data.detent_set.id);
+        }
+        break;
+    }
+}
+
+void MotorTask::applyTorque()
+{
+    motor.move(motor_torque_ + cogging_.torque(FixedAngle::fromRadians(encoder.getMechanicalAngle())));
+}
+
+void MotorTask::enterIdle()
+{
+    // No torque and the driver off; the sensor keeps being read at the idle loop rate
+    motor_torque_ = 0;
+    motor.disable();
+    uint32_t active_ms = idle_monitor_.sleep(getEncoderAngle(), millis());
+
+    loop_timer_.start(idle_monitor_.loopHz());
 
-        // Publish current status to other registered tasks periodically
-        if (millis() - last_publish > 5)
+    publishPowerEvent(PB_MotorPowerState_MOTOR_POWER_IDLE, PB_MotorWakeReason_MOTOR_WAKE_NONE, 0, active_ms);
+    LOGD("Motor idle after %ums active", active_ms);
+}
+
+PB_MotorWakeReason MotorTask::checkWake(uint32_t &wake_start_us)
+{
+    if (presence_.exchange(false))
+    {
+        // Count from the proximity measurement rather than from this tick
+        wake_start_us = presence_us_.load(std::memory_order_relaxed);
+        return PB_MotorWakeReason_MOTOR_WAKE_PRESENCE;
+    }
+    if (idle_monitor_.moved(getEncoderAngle()))
+    {
+        return PB_MotorWakeReason_MOTOR_WAKE_MOTION;
+    }
+    if (uxQueueMessagesWaiting(command_queue_) > 0 || uxQueueMessagesWaiting(upload_queue_) > 0 || config_mailbox_.pending())
+    {
+        return PB_MotorWakeReason_MOTOR_WAKE_COMMAND;
+    }
+    return PB_MotorWakeReason_MOTOR_WAKE_NONE;
+}
+
+void MotorTask::publishPowerEvent(PB_MotorPowerState state, PB_MotorWakeReason wake_reason, uint32_t wake_latency_us, uint32_t previous_state_ms)
+{
+    power_snapshot_.write({
+        .sequence = ++power_sequence_,
+        .event = {
+            .state = state,
+            .wake_reason = wake_reason,
+            .wake_latency_us = wake_latency_us,
+            .previous_state_ms = previous_state_ms,
+        },
+    });
+}
+
+void MotorTask::startLoopTimer()
+{
+    // Drop any tick that arrived while the timer was being (re)started
+    ulTaskNotifyTake(pdTRUE, 0);
+    loop_timer_.start(MOTOR_FOC_LOOP_HZ);
+
+    // The first period after a (re)start spans the time the timer was stopped, so skip it and the
+    // iteration that was in flight
+    skip_loop_samples_ = 2;
+}
+
+void MotorTask::stopLoopTimer()
+{
+    loop_timer_.stop();
+}
+
+void MotorTask::finishLoopIteration(int64_t wake_us, uint32_t pending_ticks, uint32_t foc_cycles)
+{
+    last_loop_busy_us_ = esp_timer_get_time() - wake_us;
+    if (skip_loop_samples_ > 0)
+    {
+        skip_loop_samples_--;
+    }
+    else
+    {
+        recordLoopTiming(wake_us - last_loop_wake_us_, last_loop_busy_us_, pending_ticks - 1, foc_cycles);
+        if (pending_ticks > 1)
         {
-            publish({
-                .current_position = current_position,
-                .sub_position_unit = latest_sub_position_unit,
-                .has_config = true,
-                .config = config,
-            });
-            last_publish = millis();
+            pending_events_ |= 1 << PB_FlightRecorderTrigger_FLIGHT_TRIGGER_LOOP_OVERRUN;
         }
+    }
+    last_loop_wake_us_ = wake_us;
+}
 
-        delay(1);
+void MotorTask::recordLoopTiming(uint32_t period_us, uint32_t busy_us, uint32_t missed_ticks, uint32_t foc_cycles)
+{
+    portENTER_CRITICAL(&loop_stats_mux_);
+    loop_stats_.samples++;
+    loop_stats_.period_min_us = min(loop_stats_.period_min_us, period_us);
+    loop_stats_.period_max_us = max(loop_stats_.period_max_us, period_us);
+    loop_stats_.period_total_us += period_us;
+    loop_stats_.busy_max_us = max(loop_stats_.busy_max_us, busy_us);
+    loop_stats_.busy_total_us += busy_us;
+    loop_stats_.overruns += missed_ticks;
+    loop_stats_.foc_max_cycles = max(loop_stats_.foc_max_cycles, foc_cycles);
+    loop_stats_.foc_total_cycles += foc_cycles;
+    portEXIT_CRITICAL(&loop_stats_mux_);
+}
+
+void MotorTask::resetLoopStats()
+{
+    portENTER_CRITICAL(&loop_stats_mux_);
+    loop_stats_ = {};
+    loop_stats_.period_min_us = UINT32_MAX;
+    loop_stats_window_start_ms_ = millis();
+    portEXIT_CRITICAL(&loop_stats_mux_);
+}
+
+PB_MotorLoopStats MotorTask::getLoopStats()
+{
+    portENTER_CRITICAL(&loop_stats_mux_);
+    LoopTimingStats stats = loop_stats_;
+    uint32_t window_ms = millis() - loop_stats_window_start_ms_;
+    portEXIT_CRITICAL(&loop_stats_mux_);
+    resetLoopStats();
+
+    PB_MotorLoopStats pb_stats = {
+        .foc_loop_hz = MOTOR_FOC_LOOP_HZ,
+        .haptic_loop_divider = MOTOR_HAPTIC_LOOP_DIVIDER,
+        .samples = stats.samples,
+    };
+    if (stats.samples > 0)
+    {
+        pb_stats.period_min_us = stats.period_min_us;
+        pb_stats.period_avg_us = stats.period_total_us / stats.samples;
+        pb_stats.period_max_us = stats.period_max_us;
+        pb_stats.busy_avg_us = stats.busy_total_us / stats.samples;
+        pb_stats.busy_max_us = stats.busy_max_us;
+        pb_stats.foc_avg_cycles = stats.foc_total_cycles / stats.samples;
+        pb_stats.foc_max_cycles = stats.foc_max_cycles;
+    }
+    pb_stats.overruns = stats.overruns;
+    pb_stats.window_ms = window_ms;
+    pb_stats.configs_applied = stats.configs_applied;
+    pb_stats.configs_merged = stats.configs_merged;
+    pb_stats.commands_dropped = stats.commands_dropped;
+    if (stats.configs_applied > 0)
+    {
+        pb_stats.config_latency_avg_us = stats.config_latency_total_us / stats.configs_applied;
+        pb_stats.config_latency_max_us = stats.config_latency_max_us;
     }
+    return pb_stats;
+}
+
+MultiTurnAngle MotorTask::getEncoderAngle()
+{
+    // Not Sensor::getAngle(): that adds the turns as a float, which gets coarser the further the knob turns
+    return MultiTurnAngle::fromTurns(encoder.getFullRotations(), encoder.getMechanicalAngle());
+}
+
+MultiTurnAngle MotorTask::getKnobAngle()
+{
+#if SK_INVERT_ROTATION
+    return -observer_.getEstimate().angle;
+#else
+    return observer_.getEstimate().angle;
+#endif
+}
+
+float MotorTask::getKnobVelocity()
+{
+#if SK_INVERT_ROTATION
+    return -observer_.getEstimate().velocity;
+#else
+    return observer_.getEstimate().velocity;
+#endif
+}
+
+float MotorTask::getKnobAcceleration()
+{
+#if SK_INVERT_ROTATION
+    return -observer_.getEstimate().acceleration;
+#else
+    return observer_.getEstimate().acceleration;
+#endif
+}
+
+void MotorTask::resetObserver()
+{
+    // Anything that stopped the loop (calibration) leaves the estimate stale
+    encoder.update();
+    observer_.reset(getEncoderAngle(), getEncoderSampleTimeUs());
+}
+
+uint32_t MotorTask::getEncoderSampleTimeUs()
+{
+#if SENSOR_MT6701
+    // With background SPI reads the angle is from the previous tick's transfer, not from now
+    return encoder.getSampleTimeUs();
+#else
+    return (uint32_t)esp_timer_get_time();
+#endif
 }
 
 void MotorTask::setConfig(const PB_SmartKnobConfig config)
 {
-    Command command = {
-        .command_type = CommandType::CONFIG,
-        .data = {
-            .config = config,
-        }};
-    xQueueSend(queue_, &command, portMAX_DELAY);
+    if (config_mailbox_.post(config, micros()))
+    {
+        portENTER_CRITICAL(&loop_stats_mux_);
+        loop_stats_.configs_merged++;
+        portEXIT_CRITICAL(&loop_stats_mux_);
+    }
+}
+
+void MotorTask::sendCommand(const Command &command)
+{
+    if (xQueueSend(command_queue_, &command, 0) != pdTRUE)
+    {
+        portENTER_CRITICAL(&loop_stats_mux_);
+        loop_stats_.commands_dropped++;
+        portEXIT_CRITICAL(&loop_stats_mux_);
+    }
 }
 
 void MotorTask::playHaptic(bool press, bool long_press)
+{
+    if (long_press)
+    {
+        playHaptic(PB_HapticWaveformId_HAPTIC_THUD, 20);
+    }
+    else
+    {
+        playHaptic(PB_HapticWaveformId_HAPTIC_CLICK, press ? 5 : 1.5);
+    }
+}
+
+void MotorTask::playHaptic(PB_HapticWaveformId waveform, float strength)
 {
     Command command = {
         .command_type = CommandType::HAPTIC,
         .data = {
             .haptic = {
-                .press = press,
-                .long_press = long_press,
+                .waveform = waveform,
+                .strength = strength,
             },
         }};
-    xQueueSend(queue_, &command, portMAX_DELAY);
+    sendCommand(command);
 }
 
-void MotorTask::runCalibration()
+void MotorTask::setHapticWaveform(const PB_HapticWaveform &waveform)
+{
+    Upload upload = {
+        .upload_type = UploadType::HAPTIC_WAVEFORM,
+        .data = {
+            .haptic_waveform = waveform,
+        }};
+    xQueueSend(upload_queue_, &upload, portMAX_DELAY);
+}
+
+void MotorTask::setTorqueProfile(const PB_TorqueProfile &profile)
+{
+    Upload upload = {
+        .upload_type = UploadType::TORQUE_PROFILE,
+        .data = {
+            .torque_profile = profile,
+        }};
+    xQueueSend(upload_queue_, &upload, portMAX_DELAY);
+}
+
+void MotorTask::setDetentSet(const PB_DetentSet &set)
+{
+    Upload upload = {
+        .upload_type = UploadType::DETENT_SET,
+        .data = {
+            .detent_set = set,
+        }};
+    xQueueSend(upload_queue_, &upload, portMAX_DELAY);
+}
+
+void MotorTask::runCalibration(bool fast)
 {
     Command command = {
         .command_type = CommandType::CALIBRATE,
         .data = {
-            .unused = 0,
+            .fast_calibration = fast,
+        }};
+    sendCommand(command);
+}
+
+void MotorTask::runCoggingCalibration()
+{
+    Command command = {
+        .command_type = CommandType::CALIBRATE_COGGING,
+        .data = {},
+    };
+    sendCommand(command);
+}
+
+void MotorTask::runFrequencySweep(const PB_FrequencySweepConfig &config)
+{
+    Command command = {
+        .command_type = CommandType::FREQUENCY_SWEEP,
+        .data = {
+            .frequency_sweep = config,
+        }};
+    sendCommand(command);
+}
+
+void MotorTask::stopFrequencySweep()
+{
+    Command command = {
+        .command_type = CommandType::FREQUENCY_SWEEP_STOP,
+        .data = {},
+    };
+    sendCommand(command);
+}
+
+void MotorTask::reloadGainSchedule()
+{
+    Command command = {
+        .command_type = CommandType::GAIN_SCHEDULE,
+        .data = {},
+    };
+    sendCommand(command);
+}
+
+void MotorTask::configureIdle(const PB_MotorIdleConfig &config)
+{
+    Command command = {
+        .command_type = CommandType::IDLE_CONFIG,
+        .data = {
+            .idle_config = config,
         }};
-    xQueueSend(queue_, &command, portMAX_DELAY);
+    sendCommand(command);
+}
+
+void MotorTask::notifyPresence(uint32_t seen_at_us)
+{
+    presence_us_.store(seen_at_us, std::memory_order_relaxed);
+    // Release: the motor task sees the timestamp when it sees the flag
+    presence_.store(true, std::memory_order_release);
+}
+
+void MotorTask::subscribeTelemetry(const PB_TelemetrySubscribe &subscribe)
+{
+    telemetry_.subscribe(subscribe);
+}
+
+bool MotorTask::getTelemetryFrame(PB_TelemetryFrame &frame)
+{
+    return telemetry_.nextFrame(frame);
+}
+
+void MotorTask::configureFlightRecorder(const PB_FlightRecorderConfig &config)
+{
+    flight_recorder_.configure(config);
+}
+
+void MotorTask::triggerFlightRecorder()
+{
+    flight_recorder_.trigger();
+}
+
+uint32_t MotorTask::readFlightRecording(uint32_t first_sample, PB_FlightRecording &recording, uint32_t &window)
+{
+    return flight_recorder_.read(first_sample, recording, window);
+}
+
+bool MotorTask::getState(MotorStateSnapshot &state) const
+{
+    return state_snapshot_.tryRead(state);
+}
+
+bool MotorTask::getConfig(MotorConfigSnapshot &config) const
+{
+    return config_snapshot_.tryRead(config);
+}
+
+bool MotorTask::getCalibState(MotorCalibSnapshot &calib_state) const
+{
+    return calib_snapshot_.tryRead(calib_state);
+}
+
+bool MotorTask::getFrequencySweep(FrequencySweepSnapshot &sweep) const
+{
+    return sweep_snapshot_.tryRead(sweep);
+}
+
+bool MotorTask::getPowerEvent(MotorPowerSnapshot &event) const
+{
+    return power_snapshot_.tryRead(event);
+}
+
+void MotorTask::publishState(const HapticOutput &output)
+{
+    state_snapshot_.write({
+        .sequence = ++state_sequence_,
+        .timestamp_us = micros(),
+        .current_position = output.current_position,
+        .sub_position_unit = output.sub_position_unit,
+        .config_version = config_version_,
+    });
 }
 
-void MotorTask::addListener(QueueHandle_t queue)
+void MotorTask::recordTelemetry(const HapticInput &input, const HapticOutput &output, float torque, uint32_t events)
 {
-    listeners_.push_back(queue);
+    MotorTelemetrySample sample = {
+        .timestamp_us = input.now_us,
+        .angle = input.angle,
+        .velocity = input.velocity,
+        .acceleration = input.acceleration,
+        .detent_error = -output.sub_position_unit * haptic_engine_.getConfig().position_width_radians,
+        .torque = torque,
+        .current_position = output.current_position,
+        .loop_busy_us = last_loop_busy_us_,
+        .events = events,
+    };
+    flight_recorder_.record(sample);
+    telemetry_.record(sample);
 }
 
-void MotorTask::publish(const PB_SmartKnobState &state)
+void MotorTask::publishConfig()
 {
-    for (auto listener : listeners_)
+    // Publish the config before any state that refers to its version
+    config_snapshot_.write({
+        .version = ++config_version_,
+        .config = haptic_engine_.getConfig(),
+    });
+}
+
+void MotorTask::publishFrequencySweep()
+{
+    FrequencySweepSnapshot snapshot = {
+        .sequence = ++sweep_sequence_,
+        .sweep = sweep_count_,
+        .state = frequency_sweep_.state(),
+        .point_count = frequency_sweep_.pointCount(),
+        .total_points = frequency_sweep_.totalPoints(),
+    };
+    memcpy(snapshot.points, frequency_sweep_.points(), sizeof(snapshot.points));
+    sweep_snapshot_.write(snapshot);
+}
+
+void MotorTask::abortFrequencySweep()
+{
+    if (frequency_sweep_.isRunning())
     {
-        xQueueOverwrite(listener, &state);
+        frequency_sweep_.abort();
+        publishFrequencySweep();
     }
 }
 
-void MotorTask::calibrate()
+void MotorTask::calibrate(bool fast)
 {
     // SimpleFOC is supposed to be able to determine this automatically (if you omit params to initFOC), but
     // it seems to have a bug (or I've misconfigured it) that gets both the offset and direction very wrong!
     // So this value is based on experimentation.
     // TODO: dig into SimpleFOC calibration and find/fix the issue
 
-    LOGI("Starting calibration, please DO NOT TOUCH MOTOR until complete!");
+    calib_state_ = {};
+    calib_state_.fast = fast;
+    calib_start_ms_ = millis();
+    reportCalibration(PB_MotorCalibStep_MOTOR_CALIB_SETTLING, 0);
+
+    LOGI("Starting %scalibration, please DO NOT TOUCH MOTOR until complete!", fast ? "fast " : "");
     delay(1000);
 
     motor.controller = MotionControlType::angle_openloop;
     motor.pole_pairs = 1;
     motor.zero_electric_angle = 0;
     motor.sensor_direction = Direction::CW;
+#if SENSOR_MT6701
+    // Measure against the raw sensor angle
+    PB_EncoderLinearization linearization = PB_EncoderLinearization_init_zero;
+    encoder.setLinearization(linearization);
+#endif
     motor.initFOC();
 
+    if (!(fast ? calibrateSweep() : calibrateStepwise()))
+    {
+#if SENSOR_MT6701
+        encoder.setLinearization(configuration_.get().motor.linearization);
+#endif
+        reportCalibration(PB_MotorCalibStep_MOTOR_CALIB_FAILED, calib_state_.progress_percent);
+        return;
+    }
+
+#if SENSOR_MT6701
+    // The correction is optional; without it the knob works as before, just with less even detents
+    bool has_linearization = calibrateLinearity(linearization);
+#endif
+
+    // #### Apply settings
+    motor.pole_pairs = calib_state_.pole_pairs;
+    motor.zero_electric_angle = calib_state_.zero_electrical_offset;
+    motor.sensor_direction = calib_state_.direction_cw ? Direction::CW : Direction::CCW;
+    motor.voltage_limit = FOC_VOLTAGE_LIMIT;
+    motor.controller = MotionControlType::torque;
+
+    LOGI("RESULTS:");
+    snprintf(buf_, sizeof(buf_), "  ZERO_ELECTRICAL_OFFSET: %.2f", motor.zero_electric_angle);
+    LOGI(buf_);
+    if (motor.sensor_direction == Direction::CW)
+    {
+        LOGI("  FOC_DIRECTION: Direction::CW");
+    }
+    else
+    {
+        LOGI("  FOC_DIRECTION: Direction::CCW");
+    }
+    snprintf(buf_, sizeof(buf_), "  MOTOR_POLE_PAIRS: %d", motor.pole_pairs);
+    LOGI(buf_);
+    LOGI("  Took %lu ms", (unsigned long)(millis() - calib_start_ms_));
+
+    LOGI("Saving to persistent configuration...");
+    PB_MotorCalibration calibration = {
+        .calibrated = true,
+        .zero_electrical_offset = motor.zero_electric_angle,
+        .direction_cw = motor.sensor_direction == Direction::CW,
+        .pole_pairs = (uint32_t)motor.pole_pairs,
+    };
+#if SENSOR_MT6701
+    calibration.has_linearization = has_linearization;
+    calibration.linearization = linearization;
+#endif
+    if (configuration_.setMotorCalibrationAndSave(calibration))
+    {
+        LOGI("Success!");
+        calib_state_.calibrated = true;
+    }
+#if SENSOR_MT6701
+    encoder.setLinearization(configuration_.get().motor.linearization);
+#endif
+    reportCalibration(calib_state_.calibrated ? PB_MotorCalibStep_MOTOR_CALIB_DONE : PB_MotorCalibStep_MOTOR_CALIB_FAILED, 100);
+}
+
+bool MotorTask::calibrateStepwise()
+{
     float a = 0;
 
     motor.voltage_limit = FOC_VOLTAGE_LIMIT;
     motor.move(a);
 
     // #### Determine direction motor rotates relative to angle sensor
+    reportCalibration(PB_MotorCalibStep_MOTOR_CALIB_DIRECTION, 0);
     for (uint8_t i = 0; i < 200; i++)
     {
         encoder.update();
@@ -471,7 +992,7 @@ void MotorTask::calibrate()
     {
         snprintf(buf_, sizeof(buf_), "ERROR! Unexpected sensor change: start=%.2f end=%.2f", start_sensor, end_sensor);
         LOGE(buf_);
-        return;
+        return false;
     }
 
     LOGD("Sensor measures positive for positive motor rotation:");
@@ -491,9 +1012,11 @@ void MotorTask::calibrate()
     }
     snprintf(buf_, sizeof(buf_), "  (start was %.1f, end was %.1f)", start_sensor, end_sensor);
     LOGD(buf_);
+    calib_state_.direction_cw = motor.sensor_direction == Direction::CW;
 
     // #### Determine pole-pairs
     // Rotate 20 electrical revolutions and measure mechanical angle traveled, to calculate pole-pairs
+    reportCalibration(PB_MotorCalibStep_MOTOR_CALIB_POLE_PAIRS, 15);
     uint8_t electrical_revolutions = 20;
     snprintf(buf_, sizeof(buf_), "Going to measure %d electrical revolutions...", electrical_revolutions);
     LOGI(buf_);
@@ -508,27 +1031,20 @@ void MotorTask::calibrate()
         delay(1);
     }
     LOGI("Pause..."); // Let momentum settle...
-    for (uint16_t i = 0; i < 1000; i++)
-    {
-        encoder.update();
-        delay(1);
-    }
+    settleCalibration(a, 1000);
     LOGI("Measuring...");
 
     start_sensor = motor.sensor_direction * encoder.getAngle();
+    float start_a = a;
     destination = a + electrical_revolutions * _2PI;
     for (; a < destination; a += 0.03)
     {
         encoder.update();
         motor.move(a);
         delay(1);
+        reportCalibrationProgress(PB_MotorCalibStep_MOTOR_CALIB_POLE_PAIRS, 20 + 20 * (a - start_a) / (destination - start_a));
     }
-    for (uint16_t i = 0; i < 1000; i++)
-    {
-        encoder.update();
-        motor.move(a);
-        delay(1);
-    }
+    settleCalibration(a, 1000);
     end_sensor = motor.sensor_direction * encoder.getAngle();
     motor.voltage_limit = 0;
     motor.move(a);
@@ -536,125 +1052,389 @@ void MotorTask::calibrate()
     if (fabsf(motor.shaft_angle - motor.target) > 1 * PI / 180)
     {
         LOGE("ERROR: motor did not reach target!");
-        while (1)
-        {
-        }
+        return false;
     }
 
     float electrical_per_mechanical = electrical_revolutions * _2PI / (end_sensor - start_sensor);
     snprintf(buf_, sizeof(buf_), "Electrical angle / mechanical angle (i.e. pole pairs) = %.2f", electrical_per_mechanical);
     LOGD(buf_);
+    calib_state_.pole_pairs_estimate = electrical_per_mechanical;
 
-    if (electrical_per_mechanical < 3 || electrical_per_mechanical > 12)
+    if (electrical_per_mechanical < CALIBRATION_MIN_POLE_PAIRS || electrical_per_mechanical > CALIBRATION_MAX_POLE_PAIRS)
     {
         snprintf(buf_, sizeof(buf_), "ERROR! Unexpected calculated pole pairs: %.2f", electrical_per_mechanical);
         LOGE(buf_);
-        return;
+        return false;
     }
 
     int measured_pole_pairs = (int)round(electrical_per_mechanical);
     snprintf(buf_, sizeof(buf_), "Pole pairs set to %d", measured_pole_pairs);
     LOGD(buf_);
-
-    delay(1000);
+    calib_state_.pole_pairs = measured_pole_pairs;
 
     // #### Determine mechanical offset to electrical zero
     // Measure mechanical angle at every electrical zero for several revolutions
+    reportCalibration(PB_MotorCalibStep_MOTOR_CALIB_ELECTRICAL_ZERO, 40);
     motor.voltage_limit = FOC_VOLTAGE_LIMIT;
     motor.move(a);
     float offset_x = 0;
     float offset_y = 0;
+    uint16_t offset_samples = 0;
     float destination1 = (floor(a / _2PI) + measured_pole_pairs / 2.) * _2PI;
     float destination2 = (floor(a / _2PI)) * _2PI;
+    // Out to destination1 and back down to destination2, which is below where the pass starts
+    const float offset_pass_length = (destination1 - a) + (destination1 - destination2);
+    float offset_pass_start = a;
     for (; a < destination1; a += 0.4)
     {
         motor.move(a);
-        delay(100);
-        for (uint8_t i = 0; i < 100; i++)
-        {
-            encoder.update();
-            delay(1);
-        }
+        settleCalibration(a, 200);
         float real_electrical_angle = _normalizeAngle(a);
         float measured_electrical_angle = _normalizeAngle((float)(motor.sensor_direction * measured_pole_pairs) * encoder.getMechanicalAngle() - 0);
 
         float offset_angle = measured_electrical_angle - real_electrical_angle;
         offset_x += cosf(offset_angle);
         offset_y += sinf(offset_angle);
+        offset_samples++;
 
         snprintf(buf_, sizeof(buf_), "%.2f, %.2f, %.2f", degrees(real_electrical_angle), degrees(measured_electrical_angle), degrees(_normalizeAngle(offset_angle)));
         LOGD(buf_);
+        reportCalibrationProgress(PB_MotorCalibStep_MOTOR_CALIB_ELECTRICAL_ZERO, 40 + 55 * (a - offset_pass_start) / offset_pass_length);
     }
+    float offset_pass_turn = a;
     for (; a > destination2; a -= 0.4)
     {
         motor.move(a);
-        delay(100);
-        for (uint8_t i = 0; i < 100; i++)
-        {
-            encoder.update();
-            delay(1);
-        }
+        settleCalibration(a, 200);
         float real_electrical_angle = _normalizeAngle(a);
         float measured_electrical_angle = _normalizeAngle((float)(motor.sensor_direction * measured_pole_pairs) * encoder.getMechanicalAngle() - 0);
 
         float offset_angle = measured_electrical_angle - real_electrical_angle;
         offset_x += cosf(offset_angle);
         offset_y += sinf(offset_angle);
+        offset_samples++;
 
         snprintf(buf_, sizeof(buf_), "%.2f, %.2f, %.2f", degrees(real_electrical_angle), degrees(measured_electrical_angle), degrees(_normalizeAngle(offset_angle)));
         LOGD(buf_);
+        // The last step out may have overshot destination1, so capped where calibrateLinearity() picks up
+        float travelled = (offset_pass_turn - offset_pass_start) + (offset_pass_turn - a);
+        reportCalibrationProgress(PB_MotorCalibStep_MOTOR_CALIB_ELECTRICAL_ZERO, fminf(95, 40 + 55 * travelled / offset_pass_length));
     }
     motor.voltage_limit = 0;
     motor.move(a);
 
     float avg_offset_angle = atan2f(offset_y, offset_x);
+    float resultant = sqrtf(offset_x * offset_x + offset_y * offset_y) / offset_samples;
+    calib_state_.offset_spread_rad = resultant > 0 ? sqrtf(-2 * logf(fminf(resultant, 1))) : PI;
+    calib_state_.zero_electrical_offset = avg_offset_angle + _3PI_2;
+    return true;
+}
 
-    // #### Apply settings
-    motor.pole_pairs = measured_pole_pairs;
-    motor.zero_electric_angle = avg_offset_angle + _3PI_2;
+bool MotorTask::calibrateSweep()
+{
+    // Drive a few electrical revolutions forward and back at a constant rate, sampling the encoder every
+    // millisecond, and fit direction, pole pairs and electrical zero from the samples (see CalibrationFit). The
+    // rotor lags the drive angle by about the same amount in both directions, so the lag cancels out of the fit.
+    const float sweep_electrical_revolutions = 4;
+    const float sweep_step_rad = 0.02;
+
+    float a = 0;
     motor.voltage_limit = FOC_VOLTAGE_LIMIT;
-    motor.controller = MotionControlType::torque;
+    motor.move(a);
+    settleCalibration(a, 1000);
+    reportCalibration(PB_MotorCalibStep_MOTOR_CALIB_SWEEP, 5);
 
-    LOGI("RESULTS:");
-    snprintf(buf_, sizeof(buf_), "  ZERO_ELECTRICAL_OFFSET: %.2f", motor.zero_electric_angle);
+    CalibrationFit fit;
+    const float destination = sweep_electrical_revolutions * _2PI;
+    for (; a < destination; a += sweep_step_rad)
+    {
+        motor.move(a);
+        delay(1);
+        encoder.update();
+        fit.add(a, encoder.getAngle());
+        reportCalibrationProgress(PB_MotorCalibStep_MOTOR_CALIB_SWEEP, 5 + 40 * a / destination);
+    }
+    settleCalibration(a, 500);
+    for (; a > 0; a -= sweep_step_rad)
+    {
+        motor.move(a);
+        delay(1);
+        encoder.update();
+        fit.add(a, encoder.getAngle());
+        reportCalibrationProgress(PB_MotorCalibStep_MOTOR_CALIB_SWEEP, 95 - 45 * a / destination);
+    }
+    motor.voltage_limit = 0;
+    motor.move(a);
+
+    float slope = fit.slope();
+    float electrical_per_mechanical = slope != 0 ? 1 / fabsf(slope) : 0;
+    calib_state_.direction_cw = slope > 0;
+    calib_state_.pole_pairs_estimate = electrical_per_mechanical;
+    calib_state_.fit_residual_rad = fit.residualRms();
+    snprintf(buf_, sizeof(buf_), "Sweep fit: slope=%.4f, residual=%.4f rad, %u samples", slope, fit.residualRms(), fit.count());
+    LOGD(buf_);
+
+    if (electrical_per_mechanical < CALIBRATION_MIN_POLE_PAIRS - 0.5 || electrical_per_mechanical > CALIBRATION_MAX_POLE_PAIRS + 0.5)
+    {
+        snprintf(buf_, sizeof(buf_), "ERROR! Unexpected calculated pole pairs: %.2f", electrical_per_mechanical);
+        LOGE(buf_);
+        return false;
+    }
+    uint8_t measured_pole_pairs = (uint8_t)roundf(electrical_per_mechanical);
+    if (fabsf(electrical_per_mechanical - measured_pole_pairs) > CALIB_POLE_PAIRS_TOLERANCE)
+    {
+        snprintf(buf_, sizeof(buf_), "ERROR! Calculated pole pairs %.2f too far from an integer, was the knob moved?", electrical_per_mechanical);
+        LOGE(buf_);
+        return false;
+    }
+    calib_state_.pole_pairs = measured_pole_pairs;
+    calib_state_.offset_spread_rad = fit.offsetSpread(calib_state_.direction_cw, measured_pole_pairs);
+    calib_state_.zero_electrical_offset = fit.electricalOffset(calib_state_.direction_cw, measured_pole_pairs) + _3PI_2;
+    return true;
+}
+
+bool MotorTask::calibrateLinearity(PB_EncoderLinearization &linearization)
+{
+    // Drive one mechanical revolution forward and back at a constant rate using the direction and pole pairs
+    // just measured. The driven mechanical angle is the reference the sensor's error is measured against; the
+    // rotor lag cancels out between the two directions (see EncoderLinearizationFit).
+    const float sweep_step_rad = 0.02;
+    const float direction = calib_state_.direction_cw ? 1 : -1;
+    const float pole_pairs = calib_state_.pole_pairs;
+    const float destination = pole_pairs * _2PI;
+
+    float a = 0;
+    motor.voltage_limit = FOC_VOLTAGE_LIMIT;
+    motor.move(a);
+    settleCalibration(a, 1000);
+    reportCalibration(PB_MotorCalibStep_MOTOR_CALIB_LINEARITY, 95);
+
+    EncoderLinearizationFit fit;
+    for (; a < destination; a += sweep_step_rad)
+    {
+        motor.move(a);
+        delay(1);
+        encoder.update();
+        fit.add(direction * a / pole_pairs, encoder.getMechanicalAngle());
+        reportCalibrationProgress(PB_MotorCalibStep_MOTOR_CALIB_LINEARITY, 95 + 2 * a / destination);
+    }
+    settleCalibration(a, 500);
+    for (; a > 0; a -= sweep_step_rad)
+    {
+        motor.move(a);
+        delay(1);
+        encoder.update();
+        fit.add(direction * a / pole_pairs, encoder.getMechanicalAngle());
+        reportCalibrationProgress(PB_MotorCalibStep_MOTOR_CALIB_LINEARITY, 99 - 2 * a / destination);
+    }
+    motor.voltage_limit = 0;
+    motor.move(a);
+
+    if (!fit.solve(linearization))
+    {
+        LOGW("Linearity sweep didn't cover a full revolution, was the knob moved? Continuing without sensor correction");
+        return false;
+    }
+    calib_state_.linearity_residual_before_rad = linearization.residual_before_rad;
+    calib_state_.linearity_residual_after_rad = linearization.residual_after_rad;
+    snprintf(buf_, sizeof(buf_), "Sensor linearity: RMS error %.2f deg, %.2f deg after correction", degrees(linearization.residual_before_rad), degrees(linearization.residual_after_rad));
     LOGI(buf_);
-    if (motor.sensor_direction == Direction::CW)
+    return true;
+}
+
+void MotorTask::calibrateCogging()
+{
+    // Hold the rotor at evenly spaced angles over one revolution and record the torque needed. Every angle is held
+    // once approaching from below and once from above: static friction reads as extra torque against the
+    // direction of travel, and averaging the two passes cancels it.
+    calib_state_ = {};
+    calib_start_ms_ = millis();
+    reportCalibration(PB_MotorCalibStep_MOTOR_CALIB_COGGING, 0);
+    LOGI("Measuring cogging torque, please DO NOT TOUCH MOTOR until complete!");
+
+    // Measure the bare motor, without the previous compensation
+    cogging_.clear();
+    motor_torque_ = 0;
+
+    std::unique_ptr<float[]> torques(new float[CALIB_COGGING_SAMPLES]);
+    PIDController pid(CALIB_COGGING_PID_P, CALIB_COGGING_PID_I, FOC_PID_D, FOC_PID_OUTPUT_RAMP, FOC_VOLTAGE_LIMIT);
+    const float step = _2PI / CALIB_COGGING_SAMPLES;
+
+    // Sample 0 is at mechanical angle 0; start from the closest such angle below the current one
+    motor.loopFOC();
+    const float start = encoder.getAngle() - encoder.getMechanicalAngle();
+    for (float target = encoder.getAngle(); target > start; target -= CALIB_COGGING_SLEW_RAD)
     {
-        LOGI("  FOC_DIRECTION: Direction::CW");
+        coggingControlTick(pid, target);
     }
-    else
+
+    uint16_t unsettled = 0;
+    float torque;
+    for (uint16_t i = 0; i < CALIB_COGGING_SAMPLES; i++)
     {
-        LOGI("  FOC_DIRECTION: Direction::CCW");
+        if (!holdCogging(pid, start + i * step, torque))
+        {
+            unsettled++;
+        }
+        torques[i] = torque;
+        reportCalibrationProgress(PB_MotorCalibStep_MOTOR_CALIB_COGGING, 50.0f * i / CALIB_COGGING_SAMPLES);
     }
-    snprintf(buf_, sizeof(buf_), "  MOTOR_POLE_PAIRS: %d", motor.pole_pairs);
+    // Approach the last sample from above too
+    holdCogging(pid, start + _2PI, torque);
+    for (int32_t i = CALIB_COGGING_SAMPLES - 1; i >= 0; i--)
+    {
+        if (!holdCogging(pid, start + i * step, torque))
+        {
+            unsettled++;
+        }
+        torques[i] = (torques[i] + torque) / 2;
+        reportCalibrationProgress(PB_MotorCalibStep_MOTOR_CALIB_COGGING, 100 - 50.0f * i / CALIB_COGGING_SAMPLES);
+    }
+    motor.move(0);
+
+    // unsettled counts the holds of both passes
+    if (unsettled > 2 * CALIB_COGGING_SAMPLES / 10)
+    {
+        snprintf(buf_, sizeof(buf_), "ERROR! Rotor didn't settle at %u of %u points", unsettled, 2 * CALIB_COGGING_SAMPLES);
+        LOGE(buf_);
+        cogging_.build(configuration_.getCoggingMap());
+        reportCalibration(PB_MotorCalibStep_MOTOR_CALIB_FAILED, calib_state_.progress_percent);
+        return;
+    }
+
+    // Cogging averages out over a revolution; any constant part left is friction imbalance, not cogging
+    float mean = 0;
+    for (uint16_t i = 0; i < CALIB_COGGING_SAMPLES; i++)
+    {
+        mean += torques[i];
+    }
+    mean /= CALIB_COGGING_SAMPLES;
+    for (uint16_t i = 0; i < CALIB_COGGING_SAMPLES; i++)
+    {
+        torques[i] -= mean;
+    }
+
+    PB_CoggingMap map;
+    CoggingCompensation::encode(torques.get(), CALIB_COGGING_SAMPLES, map);
+    calib_state_.cogging_peak = map.scale * INT8_MAX;
+    snprintf(buf_, sizeof(buf_), "Cogging: peak torque %.3f, %u unsettled points", calib_state_.cogging_peak, unsettled);
     LOGI(buf_);
+    LOGI("  Took %lu ms", (unsigned long)(millis() - calib_start_ms_));
 
-    LOGI("Saving to persistent configuration...");
-    PB_MotorCalibration calibration = {
-        .calibrated = true,
-        .zero_electrical_offset = motor.zero_electric_angle,
-        .direction_cw = motor.sensor_direction == Direction::CW,
-        .pole_pairs = (uint32_t)motor.pole_pairs,
-    };
-    if (configuration_.setMotorCalibrationAndSave(calibration))
+    if (configuration_.setCoggingMapAndSave(map))
     {
         LOGI("Success!");
+        calib_state_.calibrated = true;
     }
+    cogging_.build(configuration_.getCoggingMap());
+    reportCalibration(calib_state_.calibrated ? PB_MotorCalibStep_MOTOR_CALIB_DONE : PB_MotorCalibStep_MOTOR_CALIB_FAILED, 100);
 }
 
-void MotorTask::checkSensorError()
+bool MotorTask::holdCogging(PIDController &pid, float target, float &torque)
 {
+    // Averages the output over the first window in which the rotor stays at the target
+    uint8_t settled_samples = 0;
+    float sum = 0;
+    for (uint16_t elapsed = 0; elapsed < CALIB_COGGING_MAX_HOLD_MS; elapsed++)
+    {
+        torque = coggingControlTick(pid, target);
+        if (fabsf(target - encoder.getAngle()) > CALIB_COGGING_TOLERANCE_RAD)
+        {
+            settled_samples = 0;
+            sum = 0;
+            continue;
+        }
+        sum += torque;
+        if (++settled_samples == CALIB_COGGING_WINDOW)
+        {
+            torque = sum / CALIB_COGGING_WINDOW;
+            return true;
+        }
+    }
+    return false;
+}
+
+float MotorTask::coggingControlTick(PIDController &pid, float target)
+{
+    motor.loopFOC();
+    float torque = pid(target - encoder.getAngle());
+    motor.move(torque);
+    delay(1);
+    return torque;
+}
+
+void MotorTask::settleCalibration(float drive_angle, uint16_t max_ms)
+{
+    // Holds the drive angle until the encoder reading stops changing (or max_ms passes), instead of always
+    // waiting for the worst-case settling time
+    float previous_mean = NAN;
+    for (uint16_t elapsed = 0; elapsed < max_ms; elapsed += CALIB_SETTLE_WINDOW)
+    {
+        encoder.update();
+        float origin = encoder.getAngle();
+        float sum = 0;
+        float sum_sq = 0;
+        for (uint8_t i = 0; i < CALIB_SETTLE_WINDOW; i++)
+        {
+            motor.move(drive_angle);
+            delay(1);
+            encoder.update();
+            float x = encoder.getAngle() - origin;
+            sum += x;
+            sum_sq += x * x;
+        }
+        float mean = sum / CALIB_SETTLE_WINDOW;
+        float variance = sum_sq / CALIB_SETTLE_WINDOW - mean * mean;
+        mean += origin;
+        if (variance < CALIB_SETTLE_STDDEV_RAD * CALIB_SETTLE_STDDEV_RAD && fabsf(mean - previous_mean) < CALIB_SETTLE_STDDEV_RAD)
+        {
+            return;
+        }
+        previous_mean = mean;
+    }
+}
+
+void MotorTask::reportCalibration(PB_MotorCalibStep step, uint8_t progress_percent)
+{
+    calib_state_.step = step;
+    calib_state_.progress_percent = progress_percent;
+    calib_state_.elapsed_ms = millis() - calib_start_ms_;
+    calib_snapshot_.write({
+        .sequence = ++calib_sequence_,
+        .state = calib_state_,
+    });
+}
+
+void MotorTask::reportCalibrationProgress(PB_MotorCalibStep step, float progress_percent)
+{
+    // Called from the measurement loops; only publish when the percentage changes
+    uint8_t percent = progress_percent < 0 ? 0 : (progress_percent > 99 ? 99 : (uint8_t)progress_percent);
+    if (percent != calib_state_.progress_percent)
+    {
+        reportCalibration(step, percent);
+    }
+}
+
+// Returns the FlightRecorder events for sensor errors since the previous call. Called every haptic tick, so it
+// doesn't log; the flight recorder keeps the context instead.
+uint32_t MotorTask::checkSensorError()
+{
+    uint32_t events = 0;
 #if SENSOR_TLV
     if (encoder.getAndClearError())
     {
-        LOGD("LOCKED!");
+        events |= 1 << PB_FlightRecorderTrigger_FLIGHT_TRIGGER_SENSOR_STATUS;
     }
 #elif SENSOR_MT6701
     MT6701Error error = encoder.getAndClearError();
     if (error.error)
     {
-        snprintf(buf_, sizeof(buf_), "CRC error. Received %d; calculated %d", error.received_crc, error.calculated_crc);
-        LOGD(buf_);
+        events |= 1 << PB_FlightRecorderTrigger_FLIGHT_TRIGGER_SENSOR_CRC;
+    }
+    if (error.status != 0)
+    {
+        events |= 1 << PB_FlightRecorderTrigger_FLIGHT_TRIGGER_SENSOR_STATUS;
     }
 #endif
+    return events;
 }
@@ -2,23 +2,123 @@
 
 #include <Arduino.h>
 #include <SimpleFOC.h>
-#include <vector>
+#include <atomic>
+#include <esp_timer.h>
 
 #include "../configuration.h"
+#include "../haptics/angle_observer.h"
+#include "../haptics/haptic_engine.h"
+#include "../haptics/haptic_waveforms.h"
+#include "../mailbox.h"
 #include "../proto/proto_gen/smartknob.pb.h"
+#include "../seqlock.h"
+#include "calibration_fit.h"
+#include "cogging_compensation.h"
+#include "encoder_linearization.h"
+#include "flight_recorder.h"
+#include "frequency_sweep.h"
+#include "idle_monitor.h"
+#include "loop_timer.h"
+#include "motor_telemetry.h"
 #include "../task.h"
 
+// Rate of the loopFOC() inner loop, paced by an esp_timer
+#ifndef MOTOR_FOC_LOOP_HZ
+#define MOTOR_FOC_LOOP_HZ 5000
+#endif
+
+// The haptic (detent) outer loop and command processing run once every MOTOR_HAPTIC_LOOP_DIVIDER FOC ticks
+#ifndef MOTOR_HAPTIC_LOOP_DIVIDER
+#define MOTOR_HAPTIC_LOOP_DIVIDER 5
+#endif
+
+// Depth of the command queue. Commands are small and never block the sender: if the motor task falls behind
+// (e.g. while it calibrates) further commands are dropped and counted in the loop stats.
+#ifndef MOTOR_COMMAND_QUEUE_LENGTH
+#define MOTOR_COMMAND_QUEUE_LENGTH 16
+#endif
+
+// Depth of the upload queue. Uploads are large, rare and paced by the host, and a lost one would break the
+// configs that refer to it, so senders wait for room.
+#ifndef MOTOR_UPLOAD_QUEUE_LENGTH
+#define MOTOR_UPLOAD_QUEUE_LENGTH 2
+#endif
+
 enum class CommandType
 {
     CALIBRATE,
-    CONFIG,
     HAPTIC,
+    CALIBRATE_COGGING,
+    FREQUENCY_SWEEP,
+    FREQUENCY_SWEEP_STOP,
+    GAIN_SCHEDULE,
+    IDLE_CONFIG,
+};
+
+enum class UploadType
+{
+    HAPTIC_WAVEFORM,
+    TORQUE_PROFILE,
+    DETENT_SET,
+};
+
+struct LoopTimingStats
+{
+    uint32_t samples;
+    uint32_t period_min_us;
+    uint32_t period_max_us;
+    uint64_t period_total_us;
+    uint32_t busy_max_us;
+    uint64_t busy_total_us;
+    uint32_t overruns;
+    uint32_t foc_max_cycles;
+    uint64_t foc_total_cycles;
+    uint32_t configs_applied;
+    uint32_t configs_merged;
+    uint32_t commands_dropped;
+    uint32_t config_latency_max_us;
+    uint64_t config_latency_total_us;
 };
 
-struct HapticData
+// Latest knob state, published every haptic tick. The config is only referenced by version; fetch it with
+// MotorTask::getConfig() when the version changes.
+struct MotorStateSnapshot
 {
-    bool press;
-    bool long_press;
+    uint32_t sequence;     // incremented for every published sample
+    uint32_t timestamp_us; // micros() when the sample was taken
+    int32_t current_position;
+    float sub_position_unit;
+    uint32_t config_version;
+};
+
+struct MotorConfigSnapshot
+{
+    uint32_t version;
+    PB_SmartKnobConfig config;
+};
+
+struct MotorCalibSnapshot
+{
+    uint32_t sequence; // incremented for every update
+    PB_MotorCalibState state;
+};
+
+// The motor's latest power state transition (see IdleMonitor)
+struct MotorPowerSnapshot
+{
+    uint32_t sequence; // incremented for every transition
+    PB_MotorPowerEvent event;
+};
+
+// Progress and results of the running (or last) frequency sweep. Rewritten once per measured point.
+struct FrequencySweepSnapshot
+{
+    uint32_t sequence; // incremented for every update
+    uint32_t sweep;    // incremented for every started sweep
+    PB_FrequencySweepState state;
+    uint8_t point_count;
+    uint8_t total_points;
+    PB_FrequencyResponsePoint points[FREQUENCY_SWEEP_MAX_POINTS];
 };
 
 struct Command
@@ -26,13 +126,26 @@ struct Command
     CommandType command_type;
     union CommandData
     {
-        uint8_t unused;
-        PB_SmartKnobConfig config;
-        HapticData haptic;
+        bool fast_calibration;
+        PB_PlayHaptic haptic;
+        PB_FrequencySweepConfig frequency_sweep;
+        PB_MotorIdleConfig idle_config;
     };
     CommandData data;
 };
 
+struct Upload
+{
+    UploadType upload_type;
+    union UploadData
+    {
+        PB_HapticWaveform haptic_waveform;
+        PB_TorqueProfile torque_profile;
+        PB_DetentSet detent_set;
+    };
+    UploadData data;
+};
+
 class MotorTask : public Task<MotorTask>
 {
     friend class Task<MotorTask>; // Allow base Task to invoke protected run()
@@ -41,26 +154,143 @@ public:
     MotorTask(const uint8_t task_core, Configuration &configuration);
     ~MotorTask();
 
+    // Latest wins: configs sent faster than the haptic loop applies them replace each other, and the motor task
+    // applies only the newest. Never waits for the motor task.
     void setConfig(const PB_SmartKnobConfig config);
     void playHaptic(bool press, bool long_press);
-    void runCalibration();
+    void playHaptic(PB_HapticWaveformId waveform, float strength);
+    void setHapticWaveform(const PB_HapticWaveform &waveform);
+    void setTorqueProfile(const PB_TorqueProfile &profile);
+    void setDetentSet(const PB_DetentSet &set);
+    // Runs the stepwise calibration, or the faster single-sweep calibration if fast is set
+    void runCalibration(bool fast = false);
+    // Measures cogging torque and enables feed-forward compensation; the motor must already be calibrated
+    void runCoggingCalibration();
+    // Measures the frequency response of the detent loop with the current config (see FrequencySweep)
+    void runFrequencySweep(const PB_FrequencySweepConfig &config);
+    void stopFrequencySweep();
+    // Applies the gain schedule currently held by the Configuration to the active and future configs
+    void reloadGainSchedule();
+    // Configures the low-power idle mode (see IdleMonitor)
+    void configureIdle(const PB_MotorIdleConfig &config);
+    // Someone is near the knob, as seen at seen_at_us (micros()): keeps the motor active, or wakes it if idle. Safe to
+    // call from any task.
+    void notifyPresence(uint32_t seen_at_us);
+
+    // Returns loop timing since the previous call and starts a new measurement window
+    PB_MotorLoopStats getLoopStats();
+
+    // Telemetry stream (see MotorTelemetry); both must be called from the same task, i.e. the root task
+    void subscribeTelemetry(const PB_TelemetrySubscribe &subscribe);
+    bool getTelemetryFrame(PB_TelemetryFrame &frame);
+
+    // Flight recorder (see FlightRecorder); safe to call from any task
+    void configureFlightRecorder(const PB_FlightRecorderConfig &config);
+    void triggerFlightRecorder();
+    uint32_t readFlightRecording(uint32_t first_sample, PB_FlightRecording &recording, uint32_t &window);
 
-    void addListener(QueueHandle_t queue);
+    // Latest state/config published by the motor task. Safe to call from any task without blocking; returns
+    // false if the read raced with an update, in which case the caller should keep its previous value.
+    bool getState(MotorStateSnapshot &state) const;
+    bool getConfig(MotorConfigSnapshot &config) const;
+    // Progress of the running (or last) calibration; same semantics as getState()
+    bool getCalibState(MotorCalibSnapshot &calib_state) const;
+    // Progress and results of the running (or last) frequency sweep; same semantics as getState()
+    bool getFrequencySweep(FrequencySweepSnapshot &sweep) const;
+    // Latest power state transition; same semantics as getState()
+    bool getPowerEvent(MotorPowerSnapshot &event) const;
 
 protected:
     void run();
 
 private:
     Configuration &configuration_;
-    QueueHandle_t queue_;
-    std::vector<QueueHandle_t> listeners_;
+    Mailbox<PB_SmartKnobConfig> config_mailbox_;
+    QueueHandle_t command_queue_;
+    QueueHandle_t upload_queue_;
     char buf_[72];
 
+    HapticEngine haptic_engine_;
+    HapticWaveformPlayer haptic_player_;
+
+    // Knob angle/velocity estimate fed to the haptics, updated every FOC tick
+    AngleObserver observer_;
+
+    CoggingCompensation cogging_;
+    // Torque from the last haptic tick, in motor direction, before cogging compensation
+    float motor_torque_ = 0;
+
+    SeqLock<MotorStateSnapshot> state_snapshot_;
+    SeqLock<MotorConfigSnapshot> config_snapshot_;
+    uint32_t state_sequence_ = 0;
+    uint32_t config_version_ = 0;
+
+    SeqLock<MotorCalibSnapshot> calib_snapshot_;
+    uint32_t calib_sequence_ = 0;
+    PB_MotorCalibState calib_state_ = {};
+    uint32_t calib_start_ms_ = 0;
+
+    FrequencySweep frequency_sweep_;
+    SeqLock<FrequencySweepSnapshot> sweep_snapshot_;
+    uint32_t sweep_sequence_ = 0;
+    uint32_t sweep_count_ = 0;
+
+    IdleMonitor idle_monitor_;
+    // Set by notifyPresence(), with the time the presence was seen
+    std::atomic<bool> presence_{false};
+    std::atomic<uint32_t> presence_us_{0};
+    SeqLock<MotorPowerSnapshot> power_snapshot_;
+    uint32_t power_sequence_ = 0;
+
+    LoopTimer loop_timer_;
+    portMUX_TYPE loop_stats_mux_ = portMUX_INITIALIZER_UNLOCKED;
+    LoopTimingStats loop_stats_;
+    uint32_t loop_stats_window_start_ms_;
+    int64_t last_loop_wake_us_ = 0;
+    uint32_t last_loop_busy_us_ = 0;
+    uint8_t skip_loop_samples_ = 0;
+    // FlightRecorder events from FOC ticks since the last haptic tick
+    uint32_t pending_events_ = 0;
+
+    MotorTelemetry telemetry_;
+    FlightRecorder flight_recorder_;
+
     // BLDC motor & driver instance
     BLDCMotor motor = BLDCMotor(1);
     BLDCDriver6PWM driver = BLDCDriver6PWM(PIN_UH, PIN_UL, PIN_VH, PIN_VL, PIN_WH, PIN_WL);
 
-    void publish(const PB_SmartKnobState &state);
-    void calibrate();
-    void checkSensorError();
+    void startLoopTimer();
+    void stopLoopTimer();
+    void finishLoopIteration(int64_t wake_us, uint32_t pending_ticks, uint32_t foc_cycles);
+    void recordLoopTiming(uint32_t period_us, uint32_t busy_us, uint32_t missed_ticks, uint32_t foc_cycles);
+    uint32_t getEncoderSampleTimeUs();
+    void resetLoopStats();
+    MultiTurnAngle getEncoderAngle();
+    MultiTurnAngle getKnobAngle();
+    float getKnobVelocity();
+    float getKnobAcceleration();
+    void resetObserver();
+    void publishState(const HapticOutput &output);
+    void recordTelemetry(const HapticInput &input, const HapticOutput &output, float torque, uint32_t events);
+    bool applyConfig(const PB_SmartKnobConfig &config);
+    void handleUpload(const Upload &upload);
+    void sendCommand(const Command &command);
+    void publishConfig();
+    void publishFrequencySweep();
+    void abortFrequencySweep();
+    void enterIdle();
+    PB_MotorWakeReason checkWake(uint32_t &wake_start_us);
+    void publishPowerEvent(PB_MotorPowerState state, PB_MotorWakeReason wake_reason, uint32_t wake_latency_us, uint32_t previous_state_ms);
+    void applyTorque();
+    void calibrate(bool fast);
+    bool calibrateStepwise();
+    bool calibrateSweep();
+    bool calibrateLinearity(PB_EncoderLinearization &linearization);
+    void calibrateCogging();
+    bool holdCogging(PIDController &pid, float target, float &torque);
+    float coggingControlTick(PIDController &pid, float target);
+    void settleCalibration(float drive_angle, uint16_t max_ms);
+    void reportCalibration(PB_MotorCalibStep step, uint8_t progress_percent);
+    void reportCalibrationProgress(PB_MotorCalibStep step, float progress_percent);
+    uint32_t checkSensorError();
 };
@@ -0,0 +1,172 @@
+#include "motor_telemetry.h"
+
+#include <esp_heap_caps.h>
+#include <logging.h>
+#include <math.h>
+
+static const uint8_t TELEMETRY_MAX_VALUES = sizeof(PB_TelemetryFrame::values) / sizeof(PB_TelemetryFrame::values[0]);
+
+// Value of one signal in the integer unit documented on PB_TelemetrySignal
+static int32_t quantize(const MotorTelemetrySample &sample, uint8_t signal)
+{
+    switch (signal)
+    {
+    case PB_TelemetrySignal_TELEMETRY_ANGLE:
+        return (int32_t)(sample.angle.turns_q32 >> 16);
+    case PB_TelemetrySignal_TELEMETRY_VELOCITY:
+        return lroundf(sample.velocity * 1e3f);
+    case PB_TelemetrySignal_TELEMETRY_ACCELERATION:
+        return lroundf(sample.acceleration);
+    case PB_TelemetrySignal_TELEMETRY_DETENT_ERROR:
+        return lroundf(sample.detent_error * 1e6f);
+    case PB_TelemetrySignal_TELEMETRY_TORQUE:
+        return lroundf(sample.torque * 1e4f);
+    case PB_TelemetrySignal_TELEMETRY_POSITION:
+        return sample.current_position;
+    case PB_TelemetrySignal_TELEMETRY_LOOP_BUSY:
+        return sample.loop_busy_us;
+    case PB_TelemetrySignal_TELEMETRY_EVENTS:
+        return sample.events;
+    }
+    return 0;
+}
+
+TelemetryFrameWriter::TelemetryFrameWriter(PB_TelemetryFrame &frame, uint32_t signals) : frame_(frame)
+{
+    uint8_t columns = 1;
+    for (uint8_t signal = 0; signal < _PB_TelemetrySignal_ARRAYSIZE; signal++)
+    {
+        columns += (signals >> signal) & 1;
+    }
+    max_samples_ = TELEMETRY_MAX_VALUES / columns;
+
+    frame_ = PB_TelemetryFrame_init_zero;
+    frame_.signals = signals;
+}
+
+bool TelemetryFrameWriter::append(const MotorTelemetrySample &sample)
+{
+    if (isFull())
+    {
+        return false;
+    }
+    // Each value is sent as the difference to the previous row; the subtraction wraps like the counters do
+    uint8_t column = 0;
+    uint32_t value = sample.timestamp_us;
+    frame_.values[frame_.values_count++] = (int32_t)(value - previous_[column]);
+    previous_[column++] = value;
+    for (uint8_t signal = 0; signal < _PB_TelemetrySignal_ARRAYSIZE; signal++)
+    {
+        if (frame_.signals & (1 << signal))
+        {
+            value = (uint32_t)quantize(sample, signal);
+            frame_.values[frame_.values_count++] = (int32_t)(value - previous_[column]);
+            previous_[column++] = value;
+        }
+    }
+    frame_.sample_count++;
+    return true;
+}
+
+bool MotorTelemetry::allocate()
+{
+    if (ring_.isInitialized())
+    {
+        return true;
+    }
+    uint32_t capacity = TELEMETRY_BUFFER_SAMPLES;
+    void *storage = heap_caps_malloc(capacity * sizeof(MotorTelemetrySample), MALLOC_CAP_SPIRAM);
+    if (storage == nullptr)
+    {
+        capacity = TELEMETRY_BUFFER_SAMPLES_INTERNAL;
+        storage = heap_caps_malloc(capacity * sizeof(MotorTelemetrySample), MALLOC_CAP_8BIT);
+        if (storage == nullptr)
+        {
+            return false;
+        }
+    }
+    ring_.init((MotorTelemetrySample *)storage, capacity);
+    LOGI("Telemetry buffer: %u samples", capacity);
+    return true;
+}
+
+void MotorTelemetry::subscribe(const PB_TelemetrySubscribe &subscribe)
+{
+    uint32_t signals = subscribe.signals & ((1 << _PB_TelemetrySignal_ARRAYSIZE) - 1);
+
+    // Stop the motor task from recording before touching the buffer. A sample it was already pushing can still
+    // land after clear(); nextFrame() skips it by its generation.
+    signals_.store(0, std::memory_order_relaxed);
+    if (signals == 0)
+    {
+        return;
+    }
+    if (!allocate())
+    {
+        LOGE("Not enough memory for telemetry");
+        return;
+    }
+    ring_.clear();
+    ring_.takeDropped();
+
+    decimation_.store(subscribe.decimation > 1 ? subscribe.decimation : 1, std::memory_order_relaxed);
+    generation_.fetch_add(1, std::memory_order_relaxed);
+    // Release: the motor task sees the initialized buffer before it sees the new signals
+    signals_.store(signals, std::memory_order_release);
+}
+
+bool MotorTelemetry::isSubscribed() const
+{
+    return signals_.load(std::memory_order_relaxed) != 0;
+}
+
+void MotorTelemetry::record(MotorTelemetrySample &sample)
+{
+    if (signals_.load(std::memory_order_acquire) == 0)
+    {
+        return;
+    }
+    uint32_t generation = generation_.load(std::memory_order_relaxed);
+    if (generation != recorded_generation_)
+    {
+        recorded_generation_ = generation;
+        decimation_count_ = 0;
+        sequence_ = 0;
+    }
+    if (decimation_count_++ % decimation_.load(std::memory_order_relaxed) != 0)
+    {
+        return;
+    }
+    // Dropped samples still take a sequence number, so the host sees exactly where the gap is
+    sample.sequence = sequence_++;
+    sample.generation = generation;
+    ring_.push(sample);
+}
+
+bool MotorTelemetry::nextFrame(PB_TelemetryFrame &frame)
+{
+    uint32_t signals = signals_.load(std::memory_order_acquire);
+    if (signals == 0)
+    {
+        return false;
+    }
+    uint32_t generation = generation_.load(std::memory_order_relaxed);
+
+    TelemetryFrameWriter writer(frame, signals);
+    MotorTelemetrySample sample;
+    while (!writer.isFull() && ring_.pop(sample))
+    {
+        if (sample.generation != generation)
+        {
+            continue;
+        }
+        if (frame.sample_count == 0)
+        {
+            frame.first_sample = sample.sequence;
+        }
+        writer.append(sample);
+    }
+    frame.dropped = ring_.takeDropped();
+
+    return frame.sample_count > 0 || frame.dropped > 0;
+}
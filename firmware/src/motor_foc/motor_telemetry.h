@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+#include "../haptics/fixed_angle.h"
+#include "../proto/proto_gen/smartknob.pb.h"
+#include "../spsc_ring.h"
+
+// Samples buffered between the motor task and the serial link: ~200kB in PSRAM, or a small internal buffer if
+// there is no PSRAM. Must be powers of two.
+static const uint32_t TELEMETRY_BUFFER_SAMPLES = 4096;
+static const uint32_t TELEMETRY_BUFFER_SAMPLES_INTERNAL = 256;
+
+// Frames the root task sends per 10ms loop at most, enough for every signal at the 1kHz haptic rate
+static const uint8_t TELEMETRY_MAX_FRAMES_PER_LOOP = 4;
+
+// One haptic loop tick, in knob coordinates
+struct MotorTelemetrySample
+{
+    uint32_t timestamp_us; // micros()
+    MultiTurnAngle angle;
+    float velocity;     // rad/s
+    float acceleration; // rad/s^2
+    float detent_error; // rad from the current detent center to the knob
+    float torque;       // BLDCMotor::move() units
+    int32_t current_position;
+    uint32_t loop_busy_us; // previous FOC loop iteration
+    uint32_t events;       // bitmask of (1 << PB_FlightRecorderTrigger) conditions seen since the previous sample
+    // Set by MotorTelemetry::record()
+    uint32_t sequence;
+    uint32_t generation;
+};
+
+// Appends samples to a PB_TelemetryFrame, storing each selected signal as the difference to the previous sample
+class TelemetryFrameWriter
+{
+public:
+    // Clears the frame
+    TelemetryFrameWriter(PB_TelemetryFrame &frame, uint32_t signals);
+
+    bool isFull() const
+    {
+        return frame_.sample_count >= max_samples_;
+    }
+
+    // Returns false, leaving the frame unchanged, if the frame is full
+    bool append(const MotorTelemetrySample &sample);
+
+private:
+    PB_TelemetryFrame &frame_;
+    uint8_t max_samples_;
+    uint32_t previous_[1 + _PB_TelemetrySignal_ARRAYSIZE] = {};
+};
+
+// Streams the motor loop signals selected with a PB_TelemetrySubscribe as PB_TelemetryFrames. The motor task
+// records a sample every (decimated) haptic tick into a ring buffer; the task owning the serial link drains it into
+// delta-encoded frames at its own pace. When the link can't keep up, samples are dropped and reported in the next
+// frame rather than ever stalling the motor loop.
+class MotorTelemetry
+{
+public:
+    // Serial task. Starts recording (allocating the buffer on first use), changes the selection, or stops with
+    // signals = 0. Samples still buffered from a previous subscription are discarded.
+    void subscribe(const PB_TelemetrySubscribe &subscribe);
+
+    // Any task. True while a host is subscribed.
+    bool isSubscribed() const;
+
+    // Motor task. A single atomic load while nobody is subscribed.
+    void record(MotorTelemetrySample &sample);
+
+    // Serial task. Fills a frame with as many buffered samples as fit. Returns false if there is nothing to
+    // send, i.e. no samples and none dropped since the previous frame.
+    bool nextFrame(PB_TelemetryFrame &frame);
+
+private:
+    SpscRing<MotorTelemetrySample> ring_;
+    std::atomic<uint32_t> signals_{0};
+    std::atomic<uint32_t> decimation_{1};
+    // Incremented for every subscription, so the motor task restarts its counters and samples recorded for a
+    // previous subscription are never sent
+    std::atomic<uint32_t> generation_{0};
+
+    // Motor task only
+    uint32_t decimation_count_ = 0;
+    uint32_t sequence_ = 0;
+    uint32_t recorded_generation_ = 0;
+
+    bool allocate();
+};
@@ -1,7 +1,24 @@
 #include "mt6701_sensor.h"
 #include "driver/spi_master.h"
+#include "esp_timer.h"
 
-static const float ALPHA = 0.4;
+// Read the sensor in the background: each getSensorAngle() takes the last completed SPI transfer and queues the
+// next one instead of waiting for the bus. The returned angle is then up to one call old, see getSampleTimeUs().
+#ifndef MT6701_SPI_ASYNC
+#define MT6701_SPI_ASYNC 1
+#endif
+
+// SSI clock; the MT6701 supports up to 15.625 MHz, but long sensor cables may need less
+#ifndef MT6701_SPI_CLOCK_HZ
+#define MT6701_SPI_CLOCK_HZ 4000000
+#endif
+#if MT6701_SPI_CLOCK_HZ > 15625000
+#error "MT6701_SPI_CLOCK_HZ exceeds the MT6701's maximum SSI clock of 15.625 MHz"
+#endif
+
+// A completed background read older than this (nobody asked for an angle for a while, e.g. during calibration
+// pauses) is discarded and a fresh one is waited for
+static const uint32_t MAX_SAMPLE_AGE_US = 1000;
 
 static uint8_t tableCRC6[64] = {
     0x00, 0x03, 0x06, 0x05, 0x0C, 0x0F, 0x0A, 0x09,
@@ -67,13 +84,13 @@ void MT6701Sensor::init()
         .duty_cycle_pos = 0,
         .cs_ena_pretrans = 4,
         .cs_ena_posttrans = 0,
-        .clock_speed_hz = 4000000,
+        .clock_speed_hz = MT6701_SPI_CLOCK_HZ,
         .input_delay_ns = 0,
         .spics_io_num = PIN_MT_CSN,
         .flags = 0,
         .queue_size = 1,
         .pre_cb = NULL,
-        .post_cb = NULL,
+        .post_cb = onReadDone,
     };
 #ifdef CONFIG_IDF_TARGET_ESP32S3
     ret = spi_bus_add_device(SPI2_HOST, &tx_device_config, &spi_device_);
@@ -88,52 +105,91 @@ void MT6701Sensor::init()
     spi_transaction_.rxlength = 24;
     spi_transaction_.tx_buffer = NULL;
     spi_transaction_.rx_buffer = NULL;
+    spi_transaction_.user = this;
+
+    // First reading synchronously, so the angle is valid as soon as init() returns
+    esp_err_t read_ret = spi_device_polling_transmit(spi_device_, &spi_transaction_);
+    assert(read_ret == ESP_OK);
+    decodeReading(micros());
+#if MT6701_SPI_ASYNC
+    queueRead();
+#endif
 }
 
 float MT6701Sensor::getSensorAngle()
 {
+#if MT6701_SPI_ASYNC
+    spi_transaction_t *done;
+    if (spi_device_get_trans_result(spi_device_, &done, 0) == ESP_OK)
+    {
+        if (micros() - read_done_us_ > MAX_SAMPLE_AGE_US)
+        {
+            queueRead();
+            esp_err_t ret = spi_device_get_trans_result(spi_device_, &done, portMAX_DELAY);
+            assert(ret == ESP_OK);
+        }
+        decodeReading(read_done_us_);
+        queueRead();
+    }
+    // Otherwise the queued read is still on the bus; keep returning the previous angle
+#else
     uint32_t now = micros();
     if (now - last_update_ > 100)
     {
-
         esp_err_t ret = spi_device_polling_transmit(spi_device_, &spi_transaction_);
         assert(ret == ESP_OK);
+        decodeReading(now);
+        last_update_ = now;
+    }
+#endif
+    // The sensor counts the other way round
+    return linearization_.apply(-angle_).toRadians();
+}
+
+uint32_t MT6701Sensor::getSampleTimeUs()
+{
+    return sample_us_;
+}
 
-        uint32_t spi_32 = (spi_transaction_.rx_data[0] << 16) | (spi_transaction_.rx_data[1] << 8) | spi_transaction_.rx_data[2];
-        uint32_t angle_spi = spi_32 >> 10;
+void MT6701Sensor::queueRead()
+{
+    esp_err_t ret = spi_device_queue_trans(spi_device_, &spi_transaction_, 0);
+    assert(ret == ESP_OK);
+}
 
-        uint8_t field_status = (spi_32 >> 6) & 0x3;
-        uint8_t push_status = (spi_32 >> 8) & 0x1;
-        uint8_t loss_status = (spi_32 >> 9) & 0x1;
+void IRAM_ATTR MT6701Sensor::onReadDone(spi_transaction_t *transaction)
+{
+    // SPI interrupt context. A transfer only takes a few microseconds, so its end is a close enough sample time.
+    static_cast<MT6701Sensor *>(transaction->user)->read_done_us_ = (uint32_t)esp_timer_get_time();
+}
 
-        uint8_t received_crc = spi_32 & 0x3F;
-        uint8_t calculated_crc = CRC6_43_18bit(spi_32 >> 6);
+void MT6701Sensor::decodeReading(uint32_t sample_us)
+{
+    uint32_t spi_32 = (spi_transaction_.rx_data[0] << 16) | (spi_transaction_.rx_data[1] << 8) | spi_transaction_.rx_data[2];
+    uint32_t angle_spi = spi_32 >> 10;
 
-        if (received_crc == calculated_crc)
-        {
-            float new_angle = (float)angle_spi * 2 * PI / 16384;
-            float new_x = cosf(new_angle);
-            float new_y = sinf(new_angle);
-            x_ = new_x * ALPHA + x_ * (1 - ALPHA);
-            y_ = new_y * ALPHA + y_ * (1 - ALPHA);
-        }
-        else
+    uint8_t field_status = (spi_32 >> 6) & 0x3;
+    uint8_t loss_status = (spi_32 >> 9) & 0x1;
+
+    uint8_t received_crc = spi_32 & 0x3F;
+    uint8_t calculated_crc = CRC6_43_18bit(spi_32 >> 6);
+
+    if (received_crc == calculated_crc)
+    {
+        // Unfiltered; MotorTask's AngleObserver does the smoothing for the haptics
+        angle_ = FixedAngle::fromCounts(angle_spi, 14);
+        sample_us_ = sample_us;
+        if (field_status != 0 || loss_status != 0)
         {
-            error_ = {
-                .error = true,
-                .received_crc = received_crc,
-                .calculated_crc = calculated_crc,
-            };
+            error_.status = (loss_status << 2) | field_status;
         }
-
-        last_update_ = now;
     }
-    float rad = -atan2f(y_, x_);
-    if (rad < 0)
+    else
     {
-        rad += 2 * PI;
+        error_.error = true;
+        error_.received_crc = received_crc;
+        error_.calculated_crc = calculated_crc;
     }
-    return rad;
 }
 
 MT6701Error MT6701Sensor::getAndClearError()
@@ -143,4 +199,9 @@ MT6701Error MT6701Sensor::getAndClearError()
     return out;
 }
 
+void MT6701Sensor::setLinearization(const PB_EncoderLinearization &linearization)
+{
+    linearization_.build(linearization);
+}
+
 #endif
\ No newline at end of file
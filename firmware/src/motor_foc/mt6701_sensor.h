@@ -3,10 +3,14 @@
 #include <SimpleFOC.h>
 #include "driver/spi_master.h"
 
+#include "encoder_linearization.h"
+
 struct MT6701Error {
     bool error;
     uint8_t received_crc;
     uint8_t calculated_crc;
+    // Field and track-loss status bits of the last valid reading that reported a problem, 0 if none did
+    uint8_t status;
 };
 
 class MT6701Sensor : public Sensor {
@@ -24,14 +28,26 @@ class MT6701Sensor : public Sensor {
         float getSensorAngle();
 
         MT6701Error getAndClearError();
+
+        // micros() at which the angle last returned by getSensorAngle() was read from the sensor
+        uint32_t getSampleTimeUs();
+
+        // Correction applied to every angle returned by getSensorAngle(); an empty linearization disables it
+        void setLinearization(const PB_EncoderLinearization &linearization);
     private:
+        void decodeReading(uint32_t sample_us);
+        void queueRead();
+        static void onReadDone(spi_transaction_t *transaction);
 
         spi_device_handle_t spi_device_;
         spi_transaction_t spi_transaction_ = {};
 
-        float x_;
-        float y_;
+        FixedAngle angle_ = {};
         uint32_t last_update_;
+        uint32_t sample_us_ = 0;
+        volatile uint32_t read_done_us_ = 0; // set from the SPI completion interrupt
 
         MT6701Error error_ = {};
+
+        EncoderLinearizationTable linearization_;
 };
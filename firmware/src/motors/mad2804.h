@@ -9,4 +9,4 @@
 #define FOC_PID_LIMIT 3
 
 #define FOC_VOLTAGE_LIMIT 3
-#define FOC_LPF 0.0075
+#define FOC_OBSERVER_BANDWIDTH_HZ 30
@@ -10,3 +10,4 @@
 #define FOC_PID_LIMIT 10
 
 #define FOC_VOLTAGE_LIMIT 5
+#define FOC_OBSERVER_BANDWIDTH_HZ 50
@@ -21,6 +21,48 @@ PB_BIND(PB_MotorCalibState, PB_MotorCalibState, AUTO)
 PB_BIND(PB_StrainCalibState, PB_StrainCalibState, AUTO)
 
 
+PB_BIND(PB_MotorLoopStats, PB_MotorLoopStats, AUTO)
+
+
+PB_BIND(PB_TelemetrySubscribe, PB_TelemetrySubscribe, AUTO)
+
+
+PB_BIND(PB_TelemetryFrame, PB_TelemetryFrame, AUTO)
+
+
+PB_BIND(PB_FlightRecorderConfig, PB_FlightRecorderConfig, AUTO)
+
+
+PB_BIND(PB_FlightRecording, PB_FlightRecording, 2)
+
+
+PB_BIND(PB_FrequencySweepConfig, PB_FrequencySweepConfig, AUTO)
+
+
+PB_BIND(PB_FrequencyResponsePoint, PB_FrequencyResponsePoint, AUTO)
+
+
+PB_BIND(PB_FrequencyResponse, PB_FrequencyResponse, AUTO)
+
+
+PB_BIND(PB_MotorIdleConfig, PB_MotorIdleConfig, AUTO)
+
+
+PB_BIND(PB_MotorPowerEvent, PB_MotorPowerEvent, AUTO)
+
+
+PB_BIND(PB_SensorJobStats, PB_SensorJobStats, AUTO)
+
+
+PB_BIND(PB_SensorSchedulerStats, PB_SensorSchedulerStats, AUTO)
+
+
+PB_BIND(PB_PressDetectorConfig, PB_PressDetectorConfig, AUTO)
+
+
+PB_BIND(PB_PressDetectorStats, PB_PressDetectorStats, AUTO)
+
+
 PB_BIND(PB_Ack, PB_Ack, AUTO)
 
 
@@ -42,12 +84,33 @@ PB_BIND(PB_PersistentConfiguration, PB_PersistentConfiguration, AUTO)
 PB_BIND(PB_MotorCalibration, PB_MotorCalibration, AUTO)
 
 
+PB_BIND(PB_EncoderLinearization, PB_EncoderLinearization, AUTO)
+
+
+PB_BIND(PB_CoggingMap, PB_CoggingMap, 2)
+
+
+PB_BIND(PB_GainSchedule, PB_GainSchedule, 2)
+
+
 PB_BIND(PB_StrainState, PB_StrainState, AUTO)
 
 
 PB_BIND(PB_StrainCalibration, PB_StrainCalibration, AUTO)
 
 
+PB_BIND(PB_TorqueProfile, PB_TorqueProfile, 2)
+
+
+PB_BIND(PB_DetentSet, PB_DetentSet, AUTO)
+
+
+PB_BIND(PB_PlayHaptic, PB_PlayHaptic, AUTO)
+
+
+PB_BIND(PB_HapticWaveform, PB_HapticWaveform, 2)
+
+
 PB_BIND(PB_AppComponent, PB_AppComponent, 2)
 
 
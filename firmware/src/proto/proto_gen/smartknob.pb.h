@@ -11,6 +11,90 @@
 #endif
 
 /* Enum definitions */
+typedef enum _PB_MotorCalibStep
+{
+    PB_MotorCalibStep_MOTOR_CALIB_IDLE = 0,
+    /* * Waiting for the rotor to come to rest. */
+    PB_MotorCalibStep_MOTOR_CALIB_SETTLING = 1,
+    PB_MotorCalibStep_MOTOR_CALIB_DIRECTION = 2,
+    PB_MotorCalibStep_MOTOR_CALIB_POLE_PAIRS = 3,
+    PB_MotorCalibStep_MOTOR_CALIB_ELECTRICAL_ZERO = 4,
+    /* * Fast calibration: bidirectional sweep measuring direction, pole pairs and electrical zero at once. */
+    PB_MotorCalibStep_MOTOR_CALIB_SWEEP = 5,
+    PB_MotorCalibStep_MOTOR_CALIB_DONE = 6,
+    PB_MotorCalibStep_MOTOR_CALIB_FAILED = 7,
+    /* * Sweep over one mechanical revolution measuring the angle sensor's nonlinearity. */
+    PB_MotorCalibStep_MOTOR_CALIB_LINEARITY = 8,
+    /* * Holding the rotor at points around one revolution measuring cogging torque (MOTOR_CALIBRATE_COGGING). */
+    PB_MotorCalibStep_MOTOR_CALIB_COGGING = 9
+} PB_MotorCalibStep;
+
+/* *
+ Motor loop signals that can be streamed with TelemetrySubscribe, selected as a bitmask of (1 << signal).
+ Each is sent as an integer in the unit given here. */
+typedef enum _PB_TelemetrySignal
+{
+    /* * Knob angle in 1/65536 turn; wraps around every 32768 turns. */
+    PB_TelemetrySignal_TELEMETRY_ANGLE = 0,
+    /* * Knob velocity, mrad/s. */
+    PB_TelemetrySignal_TELEMETRY_VELOCITY = 1,
+    /* * Knob acceleration, rad/s^2. */
+    PB_TelemetrySignal_TELEMETRY_ACCELERATION = 2,
+    /* * Angle from the current detent center to the knob, urad. */
+    PB_TelemetrySignal_TELEMETRY_DETENT_ERROR = 3,
+    /* * Torque command in knob coordinates, 1/10000 of BLDCMotor::move() units. */
+    PB_TelemetrySignal_TELEMETRY_TORQUE = 4,
+    /* * Current position. */
+    PB_TelemetrySignal_TELEMETRY_POSITION = 5,
+    /* * Busy time of the previous FOC loop iteration, us. */
+    PB_TelemetrySignal_TELEMETRY_LOOP_BUSY = 6,
+    /* * Bitmask of (1 << FlightRecorderTrigger) conditions seen since the previous sample. */
+    PB_TelemetrySignal_TELEMETRY_EVENTS = 7
+} PB_TelemetrySignal;
+
+/* * Conditions that freeze the flight recorder, selected as a bitmask of (1 << FlightRecorderTrigger). */
+typedef enum _PB_FlightRecorderTrigger
+{
+    PB_FlightRecorderTrigger_FLIGHT_TRIGGER_NONE = 0,
+    /* * Knob velocity above the limit where the haptic engine stops applying detent torque. */
+    PB_FlightRecorderTrigger_FLIGHT_TRIGGER_VELOCITY_RUNAWAY = 1,
+    /* * MT6701 reading with a bad CRC. */
+    PB_FlightRecorderTrigger_FLIGHT_TRIGGER_SENSOR_CRC = 2,
+    /* * MT6701 reporting a magnetic field that is too strong or too weak, or a locked-up TLV493D. */
+    PB_FlightRecorderTrigger_FLIGHT_TRIGGER_SENSOR_STATUS = 3,
+    /* * FOC timer ticks that fired while the previous loop iteration was still running. */
+    PB_FlightRecorderTrigger_FLIGHT_TRIGGER_LOOP_OVERRUN = 4,
+    /* * SmartKnobCommand.FLIGHT_RECORDER_TRIGGER. */
+    PB_FlightRecorderTrigger_FLIGHT_TRIGGER_HOST = 5
+} PB_FlightRecorderTrigger;
+
+typedef enum _PB_FrequencySweepState
+{
+    PB_FrequencySweepState_FREQUENCY_SWEEP_IDLE = 0,
+    PB_FrequencySweepState_FREQUENCY_SWEEP_RUNNING = 1,
+    PB_FrequencySweepState_FREQUENCY_SWEEP_DONE = 2,
+    /* * Stopped by SmartKnobCommand.FREQUENCY_SWEEP_STOP, a runaway knob velocity or an invalid config. */
+    PB_FrequencySweepState_FREQUENCY_SWEEP_ABORTED = 3
+} PB_FrequencySweepState;
+
+typedef enum _PB_MotorPowerState
+{
+    PB_MotorPowerState_MOTOR_POWER_ACTIVE = 0,
+    PB_MotorPowerState_MOTOR_POWER_IDLE = 1
+} PB_MotorPowerState;
+
+typedef enum _PB_MotorWakeReason
+{
+    /* * Not a wake: the motor went idle. */
+    PB_MotorWakeReason_MOTOR_WAKE_NONE = 0,
+    /* * The knob turned more than wake_angle_radians. */
+    PB_MotorWakeReason_MOTOR_WAKE_MOTION = 1,
+    /* * The proximity sensor saw someone near the knob. */
+    PB_MotorWakeReason_MOTOR_WAKE_PRESENCE = 2,
+    /* * A config, upload or command for the motor arrived. */
+    PB_MotorWakeReason_MOTOR_WAKE_COMMAND = 3
+} PB_MotorWakeReason;
+
 typedef enum _PB_LogLevel
 {
     PB_LogLevel_INFO = 0,
@@ -19,14 +103,88 @@ typedef enum _PB_LogLevel
     PB_LogLevel_DEBUG = 3,
     PB_LogLevel_VERBOSE = 4
 } PB_LogLevel;
+
+typedef enum _PB_MotionModel
+{
+    /* * Detents at every position (or only the magnetic ones), endstops at the bounds. */
+    PB_MotionModel_MOTION_DETENTS = 0,
+    /* *
+ No detents: the knob is attached to a virtual flywheel through a spring-damper as stiff as
+ detent_strength_unit's detents. Turning the knob spins the flywheel up, and when it is let go the
+ flywheel keeps it turning, and the position counting, until friction stops it. Endstops still apply,
+ and stop the flywheel. */
+    PB_MotionModel_MOTION_FLYWHEEL = 1,
+    /* *
+ The knob springs back to `position` with detent_strength_unit's stiffness once it is turned past
+ spring_dead_band_radians; the position counts how far it is held away from there. The spring replaces
+ the endstops: past min_position/max_position the position stops changing but the spring keeps pulling. */
+    PB_MotionModel_MOTION_SPRING_RETURN = 2,
+    /* *
+ Detents that can only be advanced one way (see ratchet_decreasing): turning back runs into a wall at the
+ current position with endstop_strength_unit's stiffness. */
+    PB_MotionModel_MOTION_RATCHET = 3
+} PB_MotionModel;
+
+/* * Which rows of a GainSchedule apply. */
+typedef enum _PB_GainScheduleMode
+{
+    /* * A detent at every position; strength is detent_strength_unit. */
+    PB_GainScheduleMode_GAIN_MODE_DETENT = 0,
+    /* * Detents only at some positions (detent_positions or a DetentSet); strength is detent_strength_unit. */
+    PB_GainScheduleMode_GAIN_MODE_MAGNETIC = 1,
+    /* * Past min_position or max_position; strength is endstop_strength_unit. */
+    PB_GainScheduleMode_GAIN_MODE_ENDSTOP = 2
+} PB_GainScheduleMode;
  
 typedef enum _PB_SmartKnobCommand
 {
     PB_SmartKnobCommand_GET_KNOB_INFO = 0,
     PB_SmartKnobCommand_MOTOR_CALIBRATE = 1,
-    PB_SmartKnobCommand_STRAIN_CALIBRATE = 2
+    PB_SmartKnobCommand_STRAIN_CALIBRATE = 2,
+    PB_SmartKnobCommand_GET_MOTOR_LOOP_STATS = 3,
+    /* *
+ Calibrates the motor from a single bidirectional sweep with adaptive settling, in a few
+ seconds instead of the tens of seconds MOTOR_CALIBRATE needs. */
+    PB_SmartKnobCommand_MOTOR_CALIBRATE_FAST = 4,
+    /* *
+ Measures the motor's cogging torque over one revolution and stores it as a CoggingMap, which the
+ motor loop then cancels with feed-forward torque. Requires a calibrated motor; takes about a minute. */
+    PB_SmartKnobCommand_MOTOR_CALIBRATE_COGGING = 5,
+    /* * Freezes the flight recorder as if one of its triggers fired. */
+    PB_SmartKnobCommand_FLIGHT_RECORDER_TRIGGER = 6,
+    /* * Sends the captured flight recorder window as FlightRecording messages. */
+    PB_SmartKnobCommand_FLIGHT_RECORDER_UPLOAD = 7,
+    /* * Stops a running FrequencySweepConfig sweep. */
+    PB_SmartKnobCommand_FREQUENCY_SWEEP_STOP = 8,
+    /* * Replies with the SensorSchedulerStats of the window since the previous request. */
+    PB_SmartKnobCommand_GET_SENSOR_SCHEDULER_STATS = 9,
+    /* * Replies with the PressDetectorStats of the window since the previous request. */
+    PB_SmartKnobCommand_GET_PRESS_DETECTOR_STATS = 10
 } PB_SmartKnobCommand;
 
+typedef enum _PB_TorqueProfileMode
+{
+    /* * detent_samples describe a single detent and are repeated for every position. */
+    PB_TorqueProfileMode_TORQUE_PROFILE_PER_DETENT = 0,
+    /* * detent_samples span the whole range from min_position to max_position (bounded configs only). */
+    PB_TorqueProfileMode_TORQUE_PROFILE_FULL_RANGE = 1
+} PB_TorqueProfileMode;
+
+/* * Haptic waveforms that can be played with PlayHaptic. */
+typedef enum _PB_HapticWaveformId
+{
+    PB_HapticWaveformId_HAPTIC_CLICK = 0,
+    PB_HapticWaveformId_HAPTIC_DOUBLE_CLICK = 1,
+    PB_HapticWaveformId_HAPTIC_BUZZ = 2,
+    PB_HapticWaveformId_HAPTIC_RAMP = 3,
+    PB_HapticWaveformId_HAPTIC_THUD = 4,
+    /* * Slots for waveforms uploaded with HapticWaveform. */
+    PB_HapticWaveformId_HAPTIC_USER_0 = 16,
+    PB_HapticWaveformId_HAPTIC_USER_1 = 17,
+    PB_HapticWaveformId_HAPTIC_USER_2 = 18,
+    PB_HapticWaveformId_HAPTIC_USER_3 = 19
+} PB_HapticWaveformId;
+
 /* *
  Component system for remote app configuration
 
@@ -40,10 +198,34 @@ typedef enum _PB_ComponentType
 } PB_ComponentType;
 
 /* Struct definitions */
-/* * Motor calibration state information */
+/* *
+ Motor calibration progress, streamed while a calibration started with MOTOR_CALIBRATE or
+ MOTOR_CALIBRATE_FAST runs. Result and quality fields are filled in as they become known. */
 typedef struct _PB_MotorCalibState
 {
-    bool calibrated; /* * PLACEHOLDER */
+    /* * True once the calibration succeeded and was saved. */
+    bool calibrated;
+    PB_MotorCalibStep step;
+    /* * Overall progress, 0-100. */
+    uint8_t progress_percent;
+    /* * Time since the calibration started. */
+    uint32_t elapsed_ms;
+    /* * True for the fast calibration path (MOTOR_CALIBRATE_FAST). */
+    bool fast;
+    bool direction_cw;
+    /* * Measured electrical / mechanical angle ratio before rounding; should be close to an integer. */
+    float pole_pairs_estimate;
+    uint8_t pole_pairs;
+    float zero_electrical_offset;
+    /* * RMS deviation (mechanical radians) of the sweep from the fitted line. Fast calibration only. */
+    float fit_residual_rad;
+    /* * Circular standard deviation (electrical radians) of the electrical zero measurements. */
+    float offset_spread_rad;
+    /* * RMS angle sensor error (mechanical radians) before and after the learned linearization. */
+    float linearity_residual_before_rad;
+    float linearity_residual_after_rad;
+    /* * Largest holding torque measured by MOTOR_CALIBRATE_COGGING, in motor torque units. */
+    float cogging_peak;
 } PB_MotorCalibState;
 
 /* * Strain calibration state information */
@@ -53,6 +235,231 @@ typedef struct _PB_StrainCalibState
     float strain_scale;
 } PB_StrainCalibState;
 
+/* *
+ Timing of the motor control loop, accumulated since the previous MotorLoopStats report
+ (or since boot / motor calibration). Requested with SmartKnobCommand.GET_MOTOR_LOOP_STATS. */
+typedef struct _PB_MotorLoopStats
+{
+    /* * Configured rate of the FOC (loopFOC) inner loop. */
+    uint32_t foc_loop_hz;
+    /* * The haptic (detent) outer loop runs once every haptic_loop_divider FOC ticks. */
+    uint32_t haptic_loop_divider;
+    /* * Number of FOC loop iterations in this window. */
+    uint32_t samples;
+    /* * Wake-to-wake period of the FOC loop. */
+    uint32_t period_min_us;
+    uint32_t period_avg_us;
+    uint32_t period_max_us;
+    /* * Time spent doing work in each FOC loop iteration. */
+    uint32_t busy_avg_us;
+    uint32_t busy_max_us;
+    /* * Timer ticks that fired while the previous iteration was still running. */
+    uint32_t overruns;
+    /* * Length of this window. */
+    uint32_t window_ms;
+    /* * CPU cycles spent in loopFOC() (sensor read and commutation) per FOC loop iteration. */
+    uint32_t foc_avg_cycles;
+    uint32_t foc_max_cycles;
+    /* * Configs applied by the haptic loop in this window. */
+    uint32_t configs_applied;
+    /* * Configs replaced by a newer one before the haptic loop got to them (only the newest is applied). */
+    uint32_t configs_merged;
+    /* * Haptic, calibration and sweep commands dropped because the motor task's command queue was full. */
+    uint32_t commands_dropped;
+    /* * Time from MotorTask::setConfig() to the config taking effect, over the applied configs. */
+    uint32_t config_latency_avg_us;
+    uint32_t config_latency_max_us;
+} PB_MotorLoopStats;
+
+/* * Starts, changes or (with signals = 0) stops the telemetry stream of TelemetryFrames. */
+typedef struct _PB_TelemetrySubscribe
+{
+    /* * Bitmask of (1 << TelemetrySignal). */
+    uint32_t signals;
+    /* * Record every decimation-th haptic loop tick; 0 and 1 record every tick. */
+    uint32_t decimation;
+} PB_TelemetrySubscribe;
+
+/* *
+ Batch of telemetry samples. Each sample is a timestamp (micros()) followed by the selected signals in
+ ascending TelemetrySignal order. Every value is stored as the difference to the same column of the previous
+ sample in this frame (the first sample as the difference to 0), so slowly changing signals take one byte. */
+typedef struct _PB_TelemetryFrame
+{
+    uint32_t signals;
+    /* * Index of the first sample in this frame, counting every recorded sample since subscribing. */
+    uint32_t first_sample;
+    /* * Samples that were dropped because the device buffer was full since the previous frame. */
+    uint32_t dropped;
+    uint32_t sample_count;
+    pb_size_t values_count;
+    int32_t values[128];
+} PB_TelemetryFrame;
+
+/* * Selects the flight recorder triggers and re-arms it, discarding any captured window. */
+typedef struct _PB_FlightRecorderConfig
+{
+    /* * Bitmask of (1 << FlightRecorderTrigger); the host trigger always works. */
+    uint32_t triggers;
+    /* * Samples recorded after the trigger before the recorder freezes; the rest of the window precedes it. */
+    uint32_t post_trigger_samples;
+} PB_FlightRecorderConfig;
+
+/* *
+ Part of the captured flight recorder window, sent in response to SmartKnobCommand.FLIGHT_RECORDER_UPLOAD as
+ consecutive frames with every TelemetrySignal. frame.first_sample counts from the oldest sample in the window. */
+typedef struct _PB_FlightRecording
+{
+    /* * What froze the recorder, or FLIGHT_TRIGGER_NONE (and no frame) if it hasn't triggered. */
+    PB_FlightRecorderTrigger trigger;
+    /* * Index of the sample in which the trigger fired. */
+    uint32_t trigger_sample;
+    uint32_t total_samples;
+    bool has_frame;
+    PB_TelemetryFrame frame;
+} PB_FlightRecording;
+
+/* *
+ Starts a frequency response measurement: the motor task adds a sine torque to the detent controller's output,
+ stepping through log-spaced frequencies, and demodulates the torque and sensor angle at each one. Set up the
+ SmartKnobConfig to measure first; the knob must not be touched while the sweep runs. Zero fields use defaults. */
+typedef struct _PB_FrequencySweepConfig
+{
+    /* * Default 2Hz, at least 0.5Hz. */
+    float start_hz;
+    /* * Default 200Hz, at most a quarter of the 1kHz haptic loop rate. */
+    float stop_hz;
+    /* * Default 24, at most 48. */
+    uint32_t points;
+    /* * Peak injected torque, in the same units as the detent controller's output. Default 0.3. */
+    float amplitude;
+    /* * Sine periods measured per point (more at high frequencies so each point takes at least 50ms). Default 6. */
+    uint32_t cycles;
+} PB_FrequencySweepConfig;
+
+/* *
+ One frequency of a sweep. With d the injected torque, u the total torque (d plus the controller's output) and y
+ the sensor angle, all as phasors at frequency_hz: the plant is y/u and the loop gain (controller times plant) is
+ d/u - 1, so the phase margin is 180 + loop_phase_deg where loop_gain crosses 1. */
+typedef struct _PB_FrequencyResponsePoint
+{
+    float frequency_hz;
+    /* * |y/u|, radians per torque unit. */
+    float plant_gain;
+    float plant_phase_deg;
+    float loop_gain;
+    float loop_phase_deg;
+} PB_FrequencyResponsePoint;
+
+/* * Sent for every measured point, and once without a point when the sweep finishes or is aborted. */
+typedef struct _PB_FrequencyResponse
+{
+    PB_FrequencySweepState state;
+    uint32_t point_index;
+    uint32_t point_count;
+    bool has_point;
+    PB_FrequencyResponsePoint point;
+} PB_FrequencyResponse;
+
+/* *
+ Low-power idle mode of the motor. After timeout_ms without the knob turning, anyone near it (proximity sensor)
+ or any motor command, the motor loop drops to loop_hz with the driver off, so the knob has no detents until it
+ wakes. Turning the knob, the proximity sensor or a command wakes it within one idle loop period. Not stored;
+ the defaults come from the MOTOR_IDLE_* build flags. Zero fields (other than enabled) use defaults. */
+typedef struct _PB_MotorIdleConfig
+{
+    /* * Off keeps the motor loop at full rate. */
+    bool enabled;
+    /* * Default 30s, at least 100ms. */
+    uint32_t timeout_ms;
+    /* * Loop rate while idle, bounding how long a touch takes to wake the motor. Default 200Hz, at most 1kHz. */
+    uint32_t loop_hz;
+    /* * Knob velocity (rad/s) below which the knob counts as untouched. Default 0.5. */
+    float velocity_threshold;
+    /* * Rotation (radians) from where the knob was left that wakes the motor. Default 0.02. */
+    float wake_angle_radians;
+} PB_MotorIdleConfig;
+
+/* * Sent whenever the motor enters or leaves its idle mode (see MotorIdleConfig). */
+typedef struct _PB_MotorPowerEvent
+{
+    PB_MotorPowerState state;
+    PB_MotorWakeReason wake_reason;
+    /* *
+ For wakes: from the motor task seeing the wake reason (or, for presence, from the proximity reading
+ arriving) to the detent torque being applied again. The motor task sees motion and commands at most one
+ idle loop period after they happen. */
+    uint32_t wake_latency_us;
+    /* * Time spent in the previous state. */
+    uint32_t previous_state_ms;
+} PB_MotorPowerEvent;
+
+/* * Timing of one of the sensors task's jobs (a sensor or bus it polls). */
+typedef struct _PB_SensorJobStats
+{
+    char name[16];
+    uint32_t period_us;
+    /* * The job should be done this long after it is due. */
+    uint32_t deadline_us;
+    /* * Number of times the job ran in this window. */
+    uint32_t runs;
+    /* * Time spent in the job's step. */
+    uint32_t run_avg_us;
+    uint32_t run_max_us;
+    /* * From the job being due to it starting, i.e. time spent waiting for the other jobs (and the task tick). */
+    uint32_t lateness_avg_us;
+    uint32_t lateness_max_us;
+    /* * Runs that finished after their deadline. */
+    uint32_t misses;
+    /* * Periods that came due before the previous run had ended, skipped rather than run late back to back. */
+    uint32_t skipped;
+} PB_SensorJobStats;
+
+/* *
+ Timing of the sensors task's jobs, accumulated since the previous SensorSchedulerStats report (or since boot).
+ Requested with SmartKnobCommand.GET_SENSOR_SCHEDULER_STATS. */
+typedef struct _PB_SensorSchedulerStats
+{
+    pb_size_t jobs_count;
+    PB_SensorJobStats jobs[8];
+    /* * Length of this window. */
+    uint32_t window_ms;
+} PB_SensorSchedulerStats;
+
+/* *
+ Tunes the strain press detector's latency against ghost presses. Not stored; the defaults come from the
+ PRESS_CUSUM_THRESHOLD and PRESS_BASELINE_TIME_CONSTANT_MS build flags. Zero fields use defaults. */
+typedef struct _PB_PressDetectorConfig
+{
+    /* *
+ Alarm level of the onset detector, in full presses summed over samples. A full press is detected on the
+ 2 * threshold-th sample; higher thresholds take longer but need a bigger disturbance for a ghost press. */
+    float threshold;
+    /* * How fast the idle baseline follows the strain gauge's drift. */
+    uint32_t baseline_time_constant_ms;
+} PB_PressDetectorConfig;
+
+/* *
+ Presses detected since the previous PressDetectorStats report (or since boot), with the latency from the
+ estimated start of each press to its event being published. Requested with
+ SmartKnobCommand.GET_PRESS_DETECTOR_STATS. */
+typedef struct _PB_PressDetectorStats
+{
+    uint32_t presses;
+    /* * Width of each latency_histogram bucket. */
+    uint32_t bucket_us;
+    /* * Presses per latency bucket; the last bucket also counts the slower ones. */
+    pb_size_t latency_histogram_count;
+    uint32_t latency_histogram[16];
+    uint32_t latency_avg_us;
+    uint32_t latency_max_us;
+    /* * The config in use. */
+    float threshold;
+    uint32_t baseline_time_constant_ms;
+    /* * Length of this window. */
+    uint32_t window_ms;
+} PB_PressDetectorStats;
+
 /* * Lets the host know that a ToSmartknob message was received and should not be retried. */
 typedef struct _PB_Ack
 {
@@ -143,15 +550,9 @@ typedef struct _PB_SmartKnobConfig
  is "magnetically" attracted to those positions, and will rotate smoothy past all
  other positions.
 
- If you want to have more than 5 magnetic detent positions, you will need to dynamically
- update this list as the knob is rotated. A recommended approach is to always send the
- _nearest_ 5 detent positions, and send a new Config message whenever the list of
- positions nearest the current position (as reported via State messages) changes.
-
- This approach enables effectively unbounded detent positions while keeping Config
- bounded in size, and is resilient against tightly-packed detents with fast rotation
- since multiple detent positions can be sent in advance; a full round-trip Config-State
- isn't needed between each detent in order to keep up. */
+ For more than 5 magnetic detent positions, upload a DetentSet once and select it with
+ detent_set_id instead; the knob then evaluates it locally, so no Config updates are
+ needed while the knob is rotated. Ignored when detent_set_id is set. */
     pb_size_t detent_positions_count;
     int32_t detent_positions[5];
     /* *
@@ -165,6 +566,30 @@ typedef struct _PB_SmartKnobConfig
  Hue (0-255) for all 8 ring LEDs, if supported. Note: this will likely be replaced
  with more configurability in a future protocol version. */
     int16_t led_hue;
+    /* *
+ Id (1-4) of a TorqueProfile previously uploaded to the knob, used instead of the
+ default detent and/or endstop force. 0 uses the default force. */
+    uint8_t torque_profile_id;
+    /* *
+ Id (1-4) of a DetentSet previously uploaded to the knob that specifies which positions
+ have magnetic detents, replacing detent_positions. 0 uses detent_positions. */
+    uint8_t detent_set_id;
+    /* *
+ How the knob moves between positions. The other models run on the knob at the haptic loop rate, so
+ momentum or a return spring don't have to be emulated by streaming position updates from the host. */
+    PB_MotionModel motion_model;
+    /* *
+ MOTION_FLYWHEEL: inertia of the virtual flywheel, in torque units per rad/s^2. The knob's own rotor is
+ about 0.001; typical range: [0.002, 0.05]. 0 uses 0.01. */
+    float flywheel_inertia;
+    /* *
+ MOTION_FLYWHEEL: how quickly friction slows the flywheel, in rad/s^2. A flick at 20 rad/s with a
+ friction of 10 coasts for about 2 seconds. 0 leaves only the knob's own friction. */
+    float flywheel_friction;
+    /* * MOTION_SPRING_RETURN: angle either side of the home position where the spring applies no torque. */
+    float spring_dead_band_radians;
+    /* * MOTION_RATCHET: advance towards lower positions instead of higher ones. */
+    bool ratchet_decreasing;
 } PB_SmartKnobConfig;
 
 typedef struct _PB_SmartKnobState
@@ -208,12 +633,29 @@ typedef struct _PB_RequestState
     char dummy_field;
 } PB_RequestState;
 
+/* * Correction for the angle sensor's once/twice-per-revolution error (magnet eccentricity and tilt), learned
+ during motor calibration. The error (measured minus true mechanical angle, in radians) as a function of the
+ measured angle theta is sum over k of harmonic_cos[k-1] * cos(k * theta) + harmonic_sin[k-1] * sin(k * theta).
+ No harmonics means no correction. */
+typedef struct _PB_EncoderLinearization
+{
+    pb_size_t harmonic_cos_count;
+    float harmonic_cos[4];
+    pb_size_t harmonic_sin_count;
+    float harmonic_sin[4];
+    /* * RMS error (mechanical radians) measured during calibration, and what remains after the correction. */
+    float residual_before_rad;
+    float residual_after_rad;
+} PB_EncoderLinearization;
+
 typedef struct _PB_MotorCalibration
 {
     bool calibrated;
     float zero_electrical_offset;
     bool direction_cw;
     uint32_t pole_pairs;
+    bool has_linearization;
+    PB_EncoderLinearization linearization;
 } PB_MotorCalibration;
 
 typedef struct _PB_PersistentConfiguration
@@ -248,9 +690,56 @@ typedef struct _PB_FromSmartKnob
         PB_SmartKnobState smartknob_state;
         PB_MotorCalibState motor_calib_state;
         PB_StrainCalibState strain_calib_state;
+        PB_MotorLoopStats motor_loop_stats;
+        PB_TelemetryFrame telemetry_frame;
+        PB_FlightRecording flight_recording;
+        PB_FrequencyResponse frequency_response;
+        PB_MotorPowerEvent motor_power_event;
+        PB_SensorSchedulerStats sensor_scheduler_stats;
+        PB_PressDetectorStats press_detector_stats;
     } payload;
 } PB_FromSmartKnob;
 
+typedef PB_BYTES_ARRAY_T(512) PB_CoggingMap_samples_t;
+/* *
+ Holding torque needed at evenly spaced mechanical angles over one revolution of the motor, starting at
+ sensor angle 0, measured by MOTOR_CALIBRATE_COGGING. Sample i stands for samples[i] * scale, in motor torque
+ units in the motor's direction (not the knob's). Stored on the device separately from the
+ PersistentConfiguration; no samples means no compensation. */
+typedef struct _PB_CoggingMap
+{
+    float scale;
+    PB_CoggingMap_samples_t samples;
+} PB_CoggingMap;
+
+/* *
+ Detent controller gains by position width and strength, for each GainScheduleMode. When a config is applied
+ the device interpolates the table (bilinearly, clamped to its edges) at the config's width and strengths;
+ the controller doesn't recompute anything per tick. Tables are indexed [mode][width][strength], so each
+ holds 3 * position_widths_radians_count * strengths_count values.
+
+ Uploaded schedules are stored on the device separately from the PersistentConfiguration. An empty schedule
+ restores the built-in one (P = 4 per unit of strength, D = 0.08 per unit at widths up to 3 degrees falling
+ to 0.02 at 8 degrees and above, no D with magnetic detents). */
+typedef struct _PB_GainSchedule
+{
+    /* * Ascending. */
+    pb_size_t position_widths_radians_count;
+    float position_widths_radians[6];
+    /* * Ascending. */
+    pb_size_t strengths_count;
+    float strengths[4];
+    /* * Proportional gain per unit of strength. */
+    pb_size_t p_count;
+    float p[72];
+    /* * Derivative gain per unit of strength. */
+    pb_size_t d_count;
+    float d[72];
+    /* * Limit on the torque's rate of change in units per second; 0 for no limit. */
+    pb_size_t output_ramp_count;
+    float output_ramp[72];
+} PB_GainSchedule;
+
 typedef struct _PB_StrainState
 {
     int32_t press_weight;
@@ -262,6 +751,77 @@ typedef struct _PB_StrainCalibration
     float calibration_weight;
 } PB_StrainCalibration;
 
+/* *
+ Sampled torque-vs-position curves that replace the default proportional detent and/or
+ endstop force. Upload once, then select with SmartKnobConfig.torque_profile_id. Profiles
+ are kept in RAM only; re-uploading a profile that is in use takes effect immediately.
+
+ Samples are in motor torque units (roughly volts), scaled by the config's
+ detent_strength_unit / endstop_strength_unit, and linearly interpolated. */
+typedef struct _PB_TorqueProfile
+{
+    /* * Slot to store the profile in, 1-4. */
+    uint8_t id;
+    PB_TorqueProfileMode mode;
+    /* *
+ Detent torque, positive values pushing towards higher positions. In PER_DETENT mode the
+ samples are evenly spaced over sub_position_unit -1 to +1 (0 is the detent center); in
+ FULL_RANGE mode over min_position to max_position. Asymmetric curves are allowed. Leave
+ empty to keep the default detent force. */
+    pb_size_t detent_samples_count;
+    float detent_samples[64];
+    /* *
+ Restoring torque past min/max_position, evenly spaced from 0 to endstop_range_units
+ positions past the bound and held at the last value beyond that. Use a sublinear curve for
+ a rubber-band feel. Leave empty to keep the default endstop force. */
+    pb_size_t endstop_samples_count;
+    float endstop_samples[16];
+    float endstop_range_units;
+} PB_TorqueProfile;
+
+typedef PB_BYTES_ARRAY_T(128) PB_DetentSet_bitmap_t;
+/* *
+ A large set of magnetic detent positions, uploaded once and selected with
+ SmartKnobConfig.detent_set_id. Sets are kept in RAM only; re-uploading a set that is in
+ use takes effect immediately.
+
+ A position has a detent if it matches the periodic rule, with the bitmap toggling
+ individual positions within its window: a set bit adds a detent where the rule has none
+ and removes it where the rule has one. Either part can be left empty. */
+typedef struct _PB_DetentSet
+{
+    /* * Slot to store the set in, 1-4. */
+    uint8_t id;
+    /* * If non-zero, every period-th position (counting from period_offset) has a detent. */
+    uint32_t period;
+    int32_t period_offset;
+    /* * Position of bit 0 of the bitmap (least significant bit of the first byte). */
+    int32_t bitmap_start;
+    /* * One bit per position, covering up to 1024 positions from bitmap_start. */
+    PB_DetentSet_bitmap_t bitmap;
+} PB_DetentSet;
+
+/* *
+ Plays a haptic waveform on top of the current detent torque. Playing a new waveform
+ replaces any waveform that is still playing. */
+typedef struct _PB_PlayHaptic
+{
+    PB_HapticWaveformId waveform;
+    /* * Scale applied to the waveform samples, in motor torque units (roughly volts). */
+    float strength;
+} PB_PlayHaptic;
+
+/* * Stores a waveform in one of the HAPTIC_USER_* slots. Slots are not persisted across reboots. */
+typedef struct _PB_HapticWaveform
+{
+    PB_HapticWaveformId waveform;
+    /* * Number of haptic loop ticks (1ms each) each sample is held for. 0 is treated as 1. */
+    uint8_t ticks_per_sample;
+    /* * Torque samples, normally in [-1, 1]; scaled by PlayHaptic.strength. */
+    pb_size_t samples_count;
+    float samples[64];
+} PB_HapticWaveform;
+
 /* *
  Configuration for toggle-style components (on/off switches).
 
@@ -334,6 +894,16 @@ typedef struct _PB_ToSmartknob
         PB_StrainCalibration strain_calibration;
         SETTINGS_Settings settings;
         PB_AppComponent app_component;
+        PB_PlayHaptic play_haptic;
+        PB_HapticWaveform haptic_waveform;
+        PB_TorqueProfile torque_profile;
+        PB_DetentSet detent_set;
+        PB_TelemetrySubscribe telemetry_subscribe;
+        PB_FlightRecorderConfig flight_recorder_config;
+        PB_FrequencySweepConfig frequency_sweep;
+        PB_GainSchedule gain_schedule;
+        PB_MotorIdleConfig motor_idle_config;
+        PB_PressDetectorConfig press_detector_config;
     } payload;
 } PB_ToSmartknob;
 
@@ -343,13 +913,53 @@ extern "C"
 #endif
 
 /* Helper constants for enums */
+#define _PB_MotorCalibStep_MIN PB_MotorCalibStep_MOTOR_CALIB_IDLE
+#define _PB_MotorCalibStep_MAX PB_MotorCalibStep_MOTOR_CALIB_COGGING
+#define _PB_MotorCalibStep_ARRAYSIZE ((PB_MotorCalibStep)(PB_MotorCalibStep_MOTOR_CALIB_COGGING + 1))
+
+#define _PB_TelemetrySignal_MIN PB_TelemetrySignal_TELEMETRY_ANGLE
+#define _PB_TelemetrySignal_MAX PB_TelemetrySignal_TELEMETRY_EVENTS
+#define _PB_TelemetrySignal_ARRAYSIZE ((PB_TelemetrySignal)(PB_TelemetrySignal_TELEMETRY_EVENTS + 1))
+
+#define _PB_FlightRecorderTrigger_MIN PB_FlightRecorderTrigger_FLIGHT_TRIGGER_NONE
+#define _PB_FlightRecorderTrigger_MAX PB_FlightRecorderTrigger_FLIGHT_TRIGGER_HOST
+#define _PB_FlightRecorderTrigger_ARRAYSIZE ((PB_FlightRecorderTrigger)(PB_FlightRecorderTrigger_FLIGHT_TRIGGER_HOST + 1))
+
+#define _PB_FrequencySweepState_MIN PB_FrequencySweepState_FREQUENCY_SWEEP_IDLE
+#define _PB_FrequencySweepState_MAX PB_FrequencySweepState_FREQUENCY_SWEEP_ABORTED
+#define _PB_FrequencySweepState_ARRAYSIZE ((PB_FrequencySweepState)(PB_FrequencySweepState_FREQUENCY_SWEEP_ABORTED + 1))
+
+#define _PB_MotorPowerState_MIN PB_MotorPowerState_MOTOR_POWER_ACTIVE
+#define _PB_MotorPowerState_MAX PB_MotorPowerState_MOTOR_POWER_IDLE
+#define _PB_MotorPowerState_ARRAYSIZE ((PB_MotorPowerState)(PB_MotorPowerState_MOTOR_POWER_IDLE + 1))
+
+#define _PB_MotorWakeReason_MIN PB_MotorWakeReason_MOTOR_WAKE_NONE
+#define _PB_MotorWakeReason_MAX PB_MotorWakeReason_MOTOR_WAKE_COMMAND
+#define _PB_MotorWakeReason_ARRAYSIZE ((PB_MotorWakeReason)(PB_MotorWakeReason_MOTOR_WAKE_COMMAND + 1))
+
 #define _PB_LogLevel_MIN PB_LogLevel_INFO
 #define _PB_LogLevel_MAX PB_LogLevel_VERBOSE
 #define _PB_LogLevel_ARRAYSIZE ((PB_LogLevel)(PB_LogLevel_VERBOSE + 1))
 
+#define _PB_MotionModel_MIN PB_MotionModel_MOTION_DETENTS
+#define _PB_MotionModel_MAX PB_MotionModel_MOTION_RATCHET
+#define _PB_MotionModel_ARRAYSIZE ((PB_MotionModel)(PB_MotionModel_MOTION_RATCHET + 1))
+
+#define _PB_GainScheduleMode_MIN PB_GainScheduleMode_GAIN_MODE_DETENT
+#define _PB_GainScheduleMode_MAX PB_GainScheduleMode_GAIN_MODE_ENDSTOP
+#define _PB_GainScheduleMode_ARRAYSIZE ((PB_GainScheduleMode)(PB_GainScheduleMode_GAIN_MODE_ENDSTOP + 1))
+
 #define _PB_SmartKnobCommand_MIN PB_SmartKnobCommand_GET_KNOB_INFO
-#define _PB_SmartKnobCommand_MAX PB_SmartKnobCommand_STRAIN_CALIBRATE
-#define _PB_SmartKnobCommand_ARRAYSIZE ((PB_SmartKnobCommand)(PB_SmartKnobCommand_STRAIN_CALIBRATE + 1))
+#define _PB_SmartKnobCommand_MAX PB_SmartKnobCommand_GET_PRESS_DETECTOR_STATS
+#define _PB_SmartKnobCommand_ARRAYSIZE ((PB_SmartKnobCommand)(PB_SmartKnobCommand_GET_PRESS_DETECTOR_STATS + 1))
+
+#define _PB_TorqueProfileMode_MIN PB_TorqueProfileMode_TORQUE_PROFILE_PER_DETENT
+#define _PB_TorqueProfileMode_MAX PB_TorqueProfileMode_TORQUE_PROFILE_FULL_RANGE
+#define _PB_TorqueProfileMode_ARRAYSIZE ((PB_TorqueProfileMode)(PB_TorqueProfileMode_TORQUE_PROFILE_FULL_RANGE + 1))
+
+#define _PB_HapticWaveformId_MIN PB_HapticWaveformId_HAPTIC_CLICK
+#define _PB_HapticWaveformId_MAX PB_HapticWaveformId_HAPTIC_USER_3
+#define _PB_HapticWaveformId_ARRAYSIZE ((PB_HapticWaveformId)(PB_HapticWaveformId_HAPTIC_USER_3 + 1))
 
 #define _PB_ComponentType_MIN PB_ComponentType_TOGGLE
 #define _PB_ComponentType_MAX PB_ComponentType_MULTI_CHOICE
@@ -357,8 +967,25 @@ extern "C"
 
 #define PB_ToSmartknob_payload_smartknob_command_ENUMTYPE PB_SmartKnobCommand
 
+#define PB_MotorCalibState_step_ENUMTYPE PB_MotorCalibStep
+
+#define PB_FlightRecording_trigger_ENUMTYPE PB_FlightRecorderTrigger
+
+#define PB_FrequencyResponse_state_ENUMTYPE PB_FrequencySweepState
+
+#define PB_MotorPowerEvent_state_ENUMTYPE PB_MotorPowerState
+#define PB_MotorPowerEvent_wake_reason_ENUMTYPE PB_MotorWakeReason
+
 #define PB_Log_level_ENUMTYPE PB_LogLevel
 
+#define PB_SmartKnobConfig_motion_model_ENUMTYPE PB_MotionModel
+
+#define PB_TorqueProfile_mode_ENUMTYPE PB_TorqueProfileMode
+
+#define PB_PlayHaptic_waveform_ENUMTYPE PB_HapticWaveformId
+
+#define PB_HapticWaveform_waveform_ENUMTYPE PB_HapticWaveformId
+
 #define PB_AppComponent_type_ENUMTYPE PB_ComponentType
 
 /* Initializer values for message structs */
@@ -371,17 +998,38 @@ extern "C"
         0, 0, 0, { PB_RequestState_init_default } \
     }
 #define PB_Knob_init_default {"", "", false, PB_PersistentConfiguration_init_default, false, SETTINGS_Settings_init_default}
-#define PB_MotorCalibState_init_default {0}
+#define PB_MotorCalibState_init_default {0, _PB_MotorCalibStep_MIN, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
 #define PB_StrainCalibState_init_default {0, 0}
+#define PB_MotorLoopStats_init_default {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+#define PB_TelemetrySubscribe_init_default {0, 0}
+#define PB_TelemetryFrame_init_default {0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}
+#define PB_FlightRecorderConfig_init_default {0, 0}
+#define PB_FlightRecording_init_default {_PB_FlightRecorderTrigger_MIN, 0, 0, false, PB_TelemetryFrame_init_default}
+#define PB_FrequencySweepConfig_init_default {0, 0, 0, 0, 0}
+#define PB_FrequencyResponsePoint_init_default {0, 0, 0, 0, 0}
+#define PB_FrequencyResponse_init_default {_PB_FrequencySweepState_MIN, 0, 0, false, PB_FrequencyResponsePoint_init_default}
+#define PB_MotorIdleConfig_init_default {0, 0, 0, 0, 0}
+#define PB_MotorPowerEvent_init_default {_PB_MotorPowerState_MIN, _PB_MotorWakeReason_MIN, 0, 0}
+#define PB_SensorJobStats_init_default {"", 0, 0, 0, 0, 0, 0, 0, 0, 0}
+#define PB_SensorSchedulerStats_init_default {0, {PB_SensorJobStats_init_default, PB_SensorJobStats_init_default, PB_SensorJobStats_init_default, PB_SensorJobStats_init_default, PB_SensorJobStats_init_default, PB_SensorJobStats_init_default, PB_SensorJobStats_init_default, PB_SensorJobStats_init_default}, 0}
+#define PB_PressDetectorConfig_init_default {0, 0}
+#define PB_PressDetectorStats_init_default {0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, 0, 0, 0, 0}
 #define PB_Ack_init_default {0}
 #define PB_Log_init_default {"", _PB_LogLevel_MIN, "", 0}
 #define PB_SmartKnobState_init_default {0, 0, false, PB_SmartKnobConfig_init_default, 0}
-#define PB_SmartKnobConfig_init_default {0, 0, 0, 0, 0, 0, 0, 0, 0, "", 0, {0, 0, 0, 0, 0}, 0, 0}
+#define PB_SmartKnobConfig_init_default {0, 0, 0, 0, 0, 0, 0, 0, 0, "", 0, {0, 0, 0, 0, 0}, 0, 0, 0, 0, _PB_MotionModel_MIN, 0, 0, 0, 0}
 #define PB_RequestState_init_default {0}
 #define PB_PersistentConfiguration_init_default {0, false, PB_MotorCalibration_init_default, 0}
-#define PB_MotorCalibration_init_default {0, 0, 0, 0}
+#define PB_MotorCalibration_init_default {0, 0, 0, 0, false, PB_EncoderLinearization_init_default}
+#define PB_EncoderLinearization_init_default {0, {0, 0, 0, 0}, 0, {0, 0, 0, 0}, 0, 0}
+#define PB_CoggingMap_init_default {0, {0, {0}}}
+#define PB_GainSchedule_init_default {0, {0, 0, 0, 0, 0, 0}, 0, {0, 0, 0, 0}, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}
 #define PB_StrainState_init_default {0, 0}
 #define PB_StrainCalibration_init_default {0}
+#define PB_TorqueProfile_init_default {0, _PB_TorqueProfileMode_MIN, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0}
+#define PB_DetentSet_init_default {0, 0, 0, 0, {0, {0}}}
+#define PB_PlayHaptic_init_default {_PB_HapticWaveformId_MIN, 0}
+#define PB_HapticWaveform_init_default {_PB_HapticWaveformId_MIN, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}
 #define PB_AppComponent_init_default                                       \
     {                                                                      \
         "", _PB_ComponentType_MIN, "", 0, { PB_ToggleConfig_init_default } \
@@ -397,17 +1045,38 @@ extern "C"
         0, 0, 0, { PB_RequestState_init_zero } \
     }
 #define PB_Knob_init_zero {"", "", false, PB_PersistentConfiguration_init_zero, false, SETTINGS_Settings_init_zero}
-#define PB_MotorCalibState_init_zero {0}
+#define PB_MotorCalibState_init_zero {0, _PB_MotorCalibStep_MIN, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
 #define PB_StrainCalibState_init_zero {0, 0}
+#define PB_MotorLoopStats_init_zero {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}
+#define PB_TelemetrySubscribe_init_zero {0, 0}
+#define PB_TelemetryFrame_init_zero {0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}
+#define PB_FlightRecorderConfig_init_zero {0, 0}
+#define PB_FlightRecording_init_zero {_PB_FlightRecorderTrigger_MIN, 0, 0, false, PB_TelemetryFrame_init_zero}
+#define PB_FrequencySweepConfig_init_zero {0, 0, 0, 0, 0}
+#define PB_FrequencyResponsePoint_init_zero {0, 0, 0, 0, 0}
+#define PB_FrequencyResponse_init_zero {_PB_FrequencySweepState_MIN, 0, 0, false, PB_FrequencyResponsePoint_init_zero}
+#define PB_MotorIdleConfig_init_zero {0, 0, 0, 0, 0}
+#define PB_MotorPowerEvent_init_zero {_PB_MotorPowerState_MIN, _PB_MotorWakeReason_MIN, 0, 0}
+#define PB_SensorJobStats_init_zero {"", 0, 0, 0, 0, 0, 0, 0, 0, 0}
+#define PB_SensorSchedulerStats_init_zero {0, {PB_SensorJobStats_init_zero, PB_SensorJobStats_init_zero, PB_SensorJobStats_init_zero, PB_SensorJobStats_init_zero, PB_SensorJobStats_init_zero, PB_SensorJobStats_init_zero, PB_SensorJobStats_init_zero, PB_SensorJobStats_init_zero}, 0}
+#define PB_PressDetectorConfig_init_zero {0, 0}
+#define PB_PressDetectorStats_init_zero {0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, 0, 0, 0, 0}
 #define PB_Ack_init_zero {0}
 #define PB_Log_init_zero {"", _PB_LogLevel_MIN, "", 0}
 #define PB_SmartKnobState_init_zero {0, 0, false, PB_SmartKnobConfig_init_zero, 0}
-#define PB_SmartKnobConfig_init_zero {0, 0, 0, 0, 0, 0, 0, 0, 0, "", 0, {0, 0, 0, 0, 0}, 0, 0}
+#define PB_SmartKnobConfig_init_zero {0, 0, 0, 0, 0, 0, 0, 0, 0, "", 0, {0, 0, 0, 0, 0}, 0, 0, 0, 0, _PB_MotionModel_MIN, 0, 0, 0, 0}
 #define PB_RequestState_init_zero {0}
 #define PB_PersistentConfiguration_init_zero {0, false, PB_MotorCalibration_init_zero, 0}
-#define PB_MotorCalibration_init_zero {0, 0, 0, 0}
+#define PB_MotorCalibration_init_zero {0, 0, 0, 0, false, PB_EncoderLinearization_init_zero}
+#define PB_EncoderLinearization_init_zero {0, {0, 0, 0, 0}, 0, {0, 0, 0, 0}, 0, 0}
+#define PB_CoggingMap_init_zero {0, {0, {0}}}
+#define PB_GainSchedule_init_zero {0, {0, 0, 0, 0, 0, 0}, 0, {0, 0, 0, 0}, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}
 #define PB_StrainState_init_zero {0, 0}
 #define PB_StrainCalibration_init_zero {0}
+#define PB_TorqueProfile_init_zero {0, _PB_TorqueProfileMode_MIN, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, 0}
+#define PB_DetentSet_init_zero {0, 0, 0, 0, {0, {0}}}
+#define PB_PlayHaptic_init_zero {_PB_HapticWaveformId_MIN, 0}
+#define PB_HapticWaveform_init_zero {_PB_HapticWaveformId_MIN, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}
 #define PB_AppComponent_init_zero                                       \
     {                                                                   \
         "", _PB_ComponentType_MIN, "", 0, { PB_ToggleConfig_init_zero } \
@@ -417,8 +1086,96 @@ extern "C"
 
 /* Field tags (for use in manual encoding/decoding) */
 #define PB_MotorCalibState_calibrated_tag 1
+#define PB_MotorCalibState_step_tag 2
+#define PB_MotorCalibState_progress_percent_tag 3
+#define PB_MotorCalibState_elapsed_ms_tag 4
+#define PB_MotorCalibState_fast_tag 5
+#define PB_MotorCalibState_direction_cw_tag 6
+#define PB_MotorCalibState_pole_pairs_estimate_tag 7
+#define PB_MotorCalibState_pole_pairs_tag 8
+#define PB_MotorCalibState_zero_electrical_offset_tag 9
+#define PB_MotorCalibState_fit_residual_rad_tag 10
+#define PB_MotorCalibState_offset_spread_rad_tag 11
+#define PB_MotorCalibState_linearity_residual_before_rad_tag 12
+#define PB_MotorCalibState_linearity_residual_after_rad_tag 13
+#define PB_MotorCalibState_cogging_peak_tag 14
 #define PB_StrainCalibState_step_tag 1
 #define PB_StrainCalibState_strain_scale_tag 2
+#define PB_MotorLoopStats_foc_loop_hz_tag 1
+#define PB_MotorLoopStats_haptic_loop_divider_tag 2
+#define PB_MotorLoopStats_samples_tag 3
+#define PB_MotorLoopStats_period_min_us_tag 4
+#define PB_MotorLoopStats_period_avg_us_tag 5
+#define PB_MotorLoopStats_period_max_us_tag 6
+#define PB_MotorLoopStats_busy_avg_us_tag 7
+#define PB_MotorLoopStats_busy_max_us_tag 8
+#define PB_MotorLoopStats_overruns_tag 9
+#define PB_MotorLoopStats_window_ms_tag 10
+#define PB_MotorLoopStats_foc_avg_cycles_tag 11
+#define PB_MotorLoopStats_foc_max_cycles_tag 12
+#define PB_MotorLoopStats_configs_applied_tag 13
+#define PB_MotorLoopStats_configs_merged_tag 14
+#define PB_MotorLoopStats_commands_dropped_tag 15
+#define PB_MotorLoopStats_config_latency_avg_us_tag 16
+#define PB_MotorLoopStats_config_latency_max_us_tag 17
+#define PB_TelemetrySubscribe_signals_tag 1
+#define PB_TelemetrySubscribe_decimation_tag 2
+#define PB_TelemetryFrame_signals_tag 1
+#define PB_TelemetryFrame_first_sample_tag 2
+#define PB_TelemetryFrame_dropped_tag 3
+#define PB_TelemetryFrame_sample_count_tag 4
+#define PB_TelemetryFrame_values_tag 5
+#define PB_FlightRecorderConfig_triggers_tag 1
+#define PB_FlightRecorderConfig_post_trigger_samples_tag 2
+#define PB_FlightRecording_trigger_tag 1
+#define PB_FlightRecording_trigger_sample_tag 2
+#define PB_FlightRecording_total_samples_tag 3
+#define PB_FlightRecording_frame_tag 4
+#define PB_FrequencySweepConfig_start_hz_tag 1
+#define PB_FrequencySweepConfig_stop_hz_tag 2
+#define PB_FrequencySweepConfig_points_tag 3
+#define PB_FrequencySweepConfig_amplitude_tag 4
+#define PB_FrequencySweepConfig_cycles_tag 5
+#define PB_FrequencyResponsePoint_frequency_hz_tag 1
+#define PB_FrequencyResponsePoint_plant_gain_tag 2
+#define PB_FrequencyResponsePoint_plant_phase_deg_tag 3
+#define PB_FrequencyResponsePoint_loop_gain_tag 4
+#define PB_FrequencyResponsePoint_loop_phase_deg_tag 5
+#define PB_FrequencyResponse_state_tag 1
+#define PB_FrequencyResponse_point_index_tag 2
+#define PB_FrequencyResponse_point_count_tag 3
+#define PB_FrequencyResponse_point_tag 4
+#define PB_MotorIdleConfig_enabled_tag 1
+#define PB_MotorIdleConfig_timeout_ms_tag 2
+#define PB_MotorIdleConfig_loop_hz_tag 3
+#define PB_MotorIdleConfig_velocity_threshold_tag 4
+#define PB_MotorIdleConfig_wake_angle_radians_tag 5
+#define PB_MotorPowerEvent_state_tag 1
+#define PB_MotorPowerEvent_wake_reason_tag 2
+#define PB_MotorPowerEvent_wake_latency_us_tag 3
+#define PB_MotorPowerEvent_previous_state_ms_tag 4
+#define PB_SensorJobStats_name_tag 1
+#define PB_SensorJobStats_period_us_tag 2
+#define PB_SensorJobStats_deadline_us_tag 3
+#define PB_SensorJobStats_runs_tag 4
+#define PB_SensorJobStats_run_avg_us_tag 5
+#define PB_SensorJobStats_run_max_us_tag 6
+#define PB_SensorJobStats_lateness_avg_us_tag 7
+#define PB_SensorJobStats_lateness_max_us_tag 8
+#define PB_SensorJobStats_misses_tag 9
+#define PB_SensorJobStats_skipped_tag 10
+#define PB_SensorSchedulerStats_jobs_tag 1
+#define PB_SensorSchedulerStats_window_ms_tag 2
+#define PB_PressDetectorConfig_threshold_tag 1
+#define PB_PressDetectorConfig_baseline_time_constant_ms_tag 2
+#define PB_PressDetectorStats_presses_tag 1
+#define PB_PressDetectorStats_bucket_us_tag 2
+#define PB_PressDetectorStats_latency_histogram_tag 3
+#define PB_PressDetectorStats_latency_avg_us_tag 4
+#define PB_PressDetectorStats_latency_max_us_tag 5
+#define PB_PressDetectorStats_threshold_tag 6
+#define PB_PressDetectorStats_baseline_time_constant_ms_tag 7
+#define PB_PressDetectorStats_window_ms_tag 8
 #define PB_Ack_nonce_tag 1
 #define PB_Log_msg_tag 1
 #define PB_Log_level_tag 2
@@ -437,6 +1194,13 @@ extern "C"
 #define PB_SmartKnobConfig_detent_positions_tag 11
 #define PB_SmartKnobConfig_snap_point_bias_tag 12
 #define PB_SmartKnobConfig_led_hue_tag 13
+#define PB_SmartKnobConfig_torque_profile_id_tag 14
+#define PB_SmartKnobConfig_detent_set_id_tag 15
+#define PB_SmartKnobConfig_motion_model_tag 16
+#define PB_SmartKnobConfig_flywheel_inertia_tag 17
+#define PB_SmartKnobConfig_flywheel_friction_tag 18
+#define PB_SmartKnobConfig_spring_dead_band_radians_tag 19
+#define PB_SmartKnobConfig_ratchet_decreasing_tag 20
 #define PB_SmartKnobState_current_position_tag 1
 #define PB_SmartKnobState_sub_position_unit_tag 2
 #define PB_SmartKnobState_config_tag 3
@@ -445,6 +1209,11 @@ extern "C"
 #define PB_MotorCalibration_zero_electrical_offset_tag 2
 #define PB_MotorCalibration_direction_cw_tag 3
 #define PB_MotorCalibration_pole_pairs_tag 4
+#define PB_MotorCalibration_linearization_tag 5
+#define PB_EncoderLinearization_harmonic_cos_tag 1
+#define PB_EncoderLinearization_harmonic_sin_tag 2
+#define PB_EncoderLinearization_residual_before_rad_tag 3
+#define PB_EncoderLinearization_residual_after_rad_tag 4
 #define PB_PersistentConfiguration_version_tag 1
 #define PB_PersistentConfiguration_motor_tag 2
 #define PB_PersistentConfiguration_strain_scale_tag 3
@@ -459,9 +1228,35 @@ extern "C"
 #define PB_FromSmartKnob_smartknob_state_tag 6
 #define PB_FromSmartKnob_motor_calib_state_tag 7
 #define PB_FromSmartKnob_strain_calib_state_tag 8
+#define PB_FromSmartKnob_motor_loop_stats_tag 9
+#define PB_FromSmartKnob_telemetry_frame_tag 10
+#define PB_FromSmartKnob_flight_recording_tag 11
+#define PB_FromSmartKnob_frequency_response_tag 12
+#define PB_CoggingMap_scale_tag 1
+#define PB_CoggingMap_samples_tag 2
+#define PB_GainSchedule_position_widths_radians_tag 1
+#define PB_GainSchedule_strengths_tag 2
+#define PB_GainSchedule_p_tag 3
+#define PB_GainSchedule_d_tag 4
+#define PB_GainSchedule_output_ramp_tag 5
 #define PB_StrainState_press_weight_tag 1
 #define PB_StrainState_press_value_tag 2
 #define PB_StrainCalibration_calibration_weight_tag 1
+#define PB_TorqueProfile_id_tag 1
+#define PB_TorqueProfile_mode_tag 2
+#define PB_TorqueProfile_detent_samples_tag 3
+#define PB_TorqueProfile_endstop_samples_tag 4
+#define PB_TorqueProfile_endstop_range_units_tag 5
+#define PB_DetentSet_id_tag 1
+#define PB_DetentSet_period_tag 2
+#define PB_DetentSet_period_offset_tag 3
+#define PB_DetentSet_bitmap_start_tag 4
+#define PB_DetentSet_bitmap_tag 5
+#define PB_PlayHaptic_waveform_tag 1
+#define PB_PlayHaptic_strength_tag 2
+#define PB_HapticWaveform_waveform_tag 1
+#define PB_HapticWaveform_ticks_per_sample_tag 2
+#define PB_HapticWaveform_samples_tag 3
 #define PB_ToggleConfig_off_label_tag 1
 #define PB_ToggleConfig_on_label_tag 2
 #define PB_ToggleConfig_snap_point_tag 3
@@ -490,16 +1285,32 @@ extern "C"
 #define PB_ToSmartknob_strain_calibration_tag 6
 #define PB_ToSmartknob_settings_tag 7
 #define PB_ToSmartknob_app_component_tag 8
+#define PB_ToSmartknob_play_haptic_tag 9
+#define PB_ToSmartknob_haptic_waveform_tag 10
+#define PB_ToSmartknob_torque_profile_tag 11
+#define PB_ToSmartknob_detent_set_tag 12
+#define PB_ToSmartknob_telemetry_subscribe_tag 13
+#define PB_ToSmartknob_flight_recorder_config_tag 14
+#define PB_ToSmartknob_frequency_sweep_tag 15
+#define PB_ToSmartknob_gain_schedule_tag 16
+#define PB_ToSmartknob_motor_idle_config_tag 17
 
 /* Struct field encoding specification for nanopb */
-#define PB_FromSmartKnob_FIELDLIST(X, a)                                                     \
-    X(a, STATIC, SINGULAR, UINT32, protocol_version, 1)                                      \
-    X(a, STATIC, ONEOF, MESSAGE, (payload, knob, payload.knob), 3)                           \
-    X(a, STATIC, ONEOF, MESSAGE, (payload, ack, payload.ack), 4)                             \
-    X(a, STATIC, ONEOF, MESSAGE, (payload, log, payload.log), 5)                             \
-    X(a, STATIC, ONEOF, MESSAGE, (payload, smartknob_state, payload.smartknob_state), 6)     \
-    X(a, STATIC, ONEOF, MESSAGE, (payload, motor_calib_state, payload.motor_calib_state), 7) \
-    X(a, STATIC, ONEOF, MESSAGE, (payload, strain_calib_state, payload.strain_calib_state), 8)
+#define PB_FromSmartKnob_FIELDLIST(X, a)                                                                \
+    X(a, STATIC, SINGULAR, UINT32, protocol_version, 1)                                                 \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, knob, payload.knob), 3)                                      \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, ack, payload.ack), 4)                                        \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, log, payload.log), 5)                                        \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, smartknob_state, payload.smartknob_state), 6)                \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, motor_calib_state, payload.motor_calib_state), 7)            \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, strain_calib_state, payload.strain_calib_state), 8)          \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, motor_loop_stats, payload.motor_loop_stats), 9)              \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, telemetry_frame, payload.telemetry_frame), 10)               \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, flight_recording, payload.flight_recording), 11)             \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, frequency_response, payload.frequency_response), 12)         \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, motor_power_event, payload.motor_power_event), 13)           \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, sensor_scheduler_stats, payload.sensor_scheduler_stats), 14) \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, press_detector_stats, payload.press_detector_stats), 15)
 #define PB_FromSmartKnob_CALLBACK NULL
 #define PB_FromSmartKnob_DEFAULT NULL
 #define PB_FromSmartKnob_payload_knob_MSGTYPE PB_Knob
@@ -508,16 +1319,33 @@ extern "C"
 #define PB_FromSmartKnob_payload_smartknob_state_MSGTYPE PB_SmartKnobState
 #define PB_FromSmartKnob_payload_motor_calib_state_MSGTYPE PB_MotorCalibState
 #define PB_FromSmartKnob_payload_strain_calib_state_MSGTYPE PB_StrainCalibState
-
-#define PB_ToSmartknob_FIELDLIST(X, a)                                                         \
-    X(a, STATIC, SINGULAR, UINT32, protocol_version, 1)                                        \
-    X(a, STATIC, SINGULAR, UINT32, nonce, 2)                                                   \
-    X(a, STATIC, ONEOF, MESSAGE, (payload, request_state, payload.request_state), 3)           \
-    X(a, STATIC, ONEOF, MESSAGE, (payload, smartknob_config, payload.smartknob_config), 4)     \
-    X(a, STATIC, ONEOF, UENUM, (payload, smartknob_command, payload.smartknob_command), 5)     \
-    X(a, STATIC, ONEOF, MESSAGE, (payload, strain_calibration, payload.strain_calibration), 6) \
-    X(a, STATIC, ONEOF, MESSAGE, (payload, settings, payload.settings), 7)                     \
-    X(a, STATIC, ONEOF, MESSAGE, (payload, app_component, payload.app_component), 8)
+#define PB_FromSmartKnob_payload_motor_loop_stats_MSGTYPE PB_MotorLoopStats
+#define PB_FromSmartKnob_payload_telemetry_frame_MSGTYPE PB_TelemetryFrame
+#define PB_FromSmartKnob_payload_flight_recording_MSGTYPE PB_FlightRecording
+#define PB_FromSmartKnob_payload_frequency_response_MSGTYPE PB_FrequencyResponse
+#define PB_FromSmartKnob_payload_motor_power_event_MSGTYPE PB_MotorPowerEvent
+#define PB_FromSmartKnob_payload_sensor_scheduler_stats_MSGTYPE PB_SensorSchedulerStats
+#define PB_FromSmartKnob_payload_press_detector_stats_MSGTYPE PB_PressDetectorStats
+
+#define PB_ToSmartknob_FIELDLIST(X, a)                                                                  \
+    X(a, STATIC, SINGULAR, UINT32, protocol_version, 1)                                                 \
+    X(a, STATIC, SINGULAR, UINT32, nonce, 2)                                                            \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, request_state, payload.request_state), 3)                    \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, smartknob_config, payload.smartknob_config), 4)              \
+    X(a, STATIC, ONEOF, UENUM, (payload, smartknob_command, payload.smartknob_command), 5)              \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, strain_calibration, payload.strain_calibration), 6)          \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, settings, payload.settings), 7)                              \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, app_component, payload.app_component), 8)                    \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, play_haptic, payload.play_haptic), 9)                        \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, haptic_waveform, payload.haptic_waveform), 10)               \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, torque_profile, payload.torque_profile), 11)                 \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, detent_set, payload.detent_set), 12)                         \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, telemetry_subscribe, payload.telemetry_subscribe), 13)       \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, flight_recorder_config, payload.flight_recorder_config), 14) \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, frequency_sweep, payload.frequency_sweep), 15)               \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, gain_schedule, payload.gain_schedule), 16)                   \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, motor_idle_config, payload.motor_idle_config), 17)           \
+    X(a, STATIC, ONEOF, MESSAGE, (payload, press_detector_config, payload.press_detector_config), 18)
 #define PB_ToSmartknob_CALLBACK NULL
 #define PB_ToSmartknob_DEFAULT NULL
 #define PB_ToSmartknob_payload_request_state_MSGTYPE PB_RequestState
@@ -525,6 +1353,16 @@ extern "C"
 #define PB_ToSmartknob_payload_strain_calibration_MSGTYPE PB_StrainCalibration
 #define PB_ToSmartknob_payload_settings_MSGTYPE SETTINGS_Settings
 #define PB_ToSmartknob_payload_app_component_MSGTYPE PB_AppComponent
+#define PB_ToSmartknob_payload_play_haptic_MSGTYPE PB_PlayHaptic
+#define PB_ToSmartknob_payload_haptic_waveform_MSGTYPE PB_HapticWaveform
+#define PB_ToSmartknob_payload_torque_profile_MSGTYPE PB_TorqueProfile
+#define PB_ToSmartknob_payload_detent_set_MSGTYPE PB_DetentSet
+#define PB_ToSmartknob_payload_telemetry_subscribe_MSGTYPE PB_TelemetrySubscribe
+#define PB_ToSmartknob_payload_flight_recorder_config_MSGTYPE PB_FlightRecorderConfig
+#define PB_ToSmartknob_payload_frequency_sweep_MSGTYPE PB_FrequencySweepConfig
+#define PB_ToSmartknob_payload_gain_schedule_MSGTYPE PB_GainSchedule
+#define PB_ToSmartknob_payload_motor_idle_config_MSGTYPE PB_MotorIdleConfig
+#define PB_ToSmartknob_payload_press_detector_config_MSGTYPE PB_PressDetectorConfig
 
 #define PB_Knob_FIELDLIST(X, a)                           \
     X(a, STATIC, SINGULAR, STRING, mac_address, 1)        \
@@ -536,8 +1374,21 @@ extern "C"
 #define PB_Knob_persistent_config_MSGTYPE PB_PersistentConfiguration
 #define PB_Knob_settings_MSGTYPE SETTINGS_Settings
 
-#define PB_MotorCalibState_FIELDLIST(X, a) \
-    X(a, STATIC, SINGULAR, BOOL, calibrated, 1)
+#define PB_MotorCalibState_FIELDLIST(X, a)                 \
+    X(a, STATIC, SINGULAR, BOOL, calibrated, 1)             \
+    X(a, STATIC, SINGULAR, UENUM, step, 2)                  \
+    X(a, STATIC, SINGULAR, UINT32, progress_percent, 3)     \
+    X(a, STATIC, SINGULAR, UINT32, elapsed_ms, 4)           \
+    X(a, STATIC, SINGULAR, BOOL, fast, 5)                   \
+    X(a, STATIC, SINGULAR, BOOL, direction_cw, 6)           \
+    X(a, STATIC, SINGULAR, FLOAT, pole_pairs_estimate, 7)   \
+    X(a, STATIC, SINGULAR, UINT32, pole_pairs, 8)           \
+    X(a, STATIC, SINGULAR, FLOAT, zero_electrical_offset, 9) \
+    X(a, STATIC, SINGULAR, FLOAT, fit_residual_rad, 10)     \
+    X(a, STATIC, SINGULAR, FLOAT, offset_spread_rad, 11)    \
+    X(a, STATIC, SINGULAR, FLOAT, linearity_residual_before_rad, 12) \
+    X(a, STATIC, SINGULAR, FLOAT, linearity_residual_after_rad, 13) \
+    X(a, STATIC, SINGULAR, FLOAT, cogging_peak, 14)
 #define PB_MotorCalibState_CALLBACK NULL
 #define PB_MotorCalibState_DEFAULT NULL
 
@@ -547,6 +1398,140 @@ extern "C"
 #define PB_StrainCalibState_CALLBACK NULL
 #define PB_StrainCalibState_DEFAULT NULL
 
+#define PB_MotorLoopStats_FIELDLIST(X, a)                     \
+    X(a, STATIC, SINGULAR, UINT32, foc_loop_hz, 1)            \
+    X(a, STATIC, SINGULAR, UINT32, haptic_loop_divider, 2)    \
+    X(a, STATIC, SINGULAR, UINT32, samples, 3)                \
+    X(a, STATIC, SINGULAR, UINT32, period_min_us, 4)          \
+    X(a, STATIC, SINGULAR, UINT32, period_avg_us, 5)          \
+    X(a, STATIC, SINGULAR, UINT32, period_max_us, 6)          \
+    X(a, STATIC, SINGULAR, UINT32, busy_avg_us, 7)            \
+    X(a, STATIC, SINGULAR, UINT32, busy_max_us, 8)            \
+    X(a, STATIC, SINGULAR, UINT32, overruns, 9)               \
+    X(a, STATIC, SINGULAR, UINT32, window_ms, 10)             \
+    X(a, STATIC, SINGULAR, UINT32, foc_avg_cycles, 11)        \
+    X(a, STATIC, SINGULAR, UINT32, foc_max_cycles, 12)        \
+    X(a, STATIC, SINGULAR, UINT32, configs_applied, 13)       \
+    X(a, STATIC, SINGULAR, UINT32, configs_merged, 14)        \
+    X(a, STATIC, SINGULAR, UINT32, commands_dropped, 15)      \
+    X(a, STATIC, SINGULAR, UINT32, config_latency_avg_us, 16) \
+    X(a, STATIC, SINGULAR, UINT32, config_latency_max_us, 17)
+#define PB_MotorLoopStats_CALLBACK NULL
+#define PB_MotorLoopStats_DEFAULT NULL
+
+#define PB_TelemetrySubscribe_FIELDLIST(X, a)     \
+    X(a, STATIC, SINGULAR, UINT32, signals, 1)    \
+    X(a, STATIC, SINGULAR, UINT32, decimation, 2)
+#define PB_TelemetrySubscribe_CALLBACK NULL
+#define PB_TelemetrySubscribe_DEFAULT NULL
+
+#define PB_TelemetryFrame_FIELDLIST(X, a)           \
+    X(a, STATIC, SINGULAR, UINT32, signals, 1)      \
+    X(a, STATIC, SINGULAR, UINT32, first_sample, 2) \
+    X(a, STATIC, SINGULAR, UINT32, dropped, 3)      \
+    X(a, STATIC, SINGULAR, UINT32, sample_count, 4) \
+    X(a, STATIC, REPEATED, SINT32, values, 5)
+#define PB_TelemetryFrame_CALLBACK NULL
+#define PB_TelemetryFrame_DEFAULT NULL
+
+#define PB_FlightRecorderConfig_FIELDLIST(X, a)             \
+    X(a, STATIC, SINGULAR, UINT32, triggers, 1)             \
+    X(a, STATIC, SINGULAR, UINT32, post_trigger_samples, 2)
+#define PB_FlightRecorderConfig_CALLBACK NULL
+#define PB_FlightRecorderConfig_DEFAULT NULL
+
+#define PB_FlightRecording_FIELDLIST(X, a)            \
+    X(a, STATIC, SINGULAR, UENUM, trigger, 1)         \
+    X(a, STATIC, SINGULAR, UINT32, trigger_sample, 2) \
+    X(a, STATIC, SINGULAR, UINT32, total_samples, 3)  \
+    X(a, STATIC, OPTIONAL, MESSAGE, frame, 4)
+#define PB_FlightRecording_CALLBACK NULL
+#define PB_FlightRecording_DEFAULT NULL
+#define PB_FlightRecording_frame_MSGTYPE PB_TelemetryFrame
+
+#define PB_FrequencySweepConfig_FIELDLIST(X, a) \
+    X(a, STATIC, SINGULAR, FLOAT, start_hz, 1)  \
+    X(a, STATIC, SINGULAR, FLOAT, stop_hz, 2)   \
+    X(a, STATIC, SINGULAR, UINT32, points, 3)   \
+    X(a, STATIC, SINGULAR, FLOAT, amplitude, 4) \
+    X(a, STATIC, SINGULAR, UINT32, cycles, 5)
+#define PB_FrequencySweepConfig_CALLBACK NULL
+#define PB_FrequencySweepConfig_DEFAULT NULL
+
+#define PB_FrequencyResponsePoint_FIELDLIST(X, a)     \
+    X(a, STATIC, SINGULAR, FLOAT, frequency_hz, 1)    \
+    X(a, STATIC, SINGULAR, FLOAT, plant_gain, 2)      \
+    X(a, STATIC, SINGULAR, FLOAT, plant_phase_deg, 3) \
+    X(a, STATIC, SINGULAR, FLOAT, loop_gain, 4)       \
+    X(a, STATIC, SINGULAR, FLOAT, loop_phase_deg, 5)
+#define PB_FrequencyResponsePoint_CALLBACK NULL
+#define PB_FrequencyResponsePoint_DEFAULT NULL
+
+#define PB_FrequencyResponse_FIELDLIST(X, a)       \
+    X(a, STATIC, SINGULAR, UENUM, state, 1)        \
+    X(a, STATIC, SINGULAR, UINT32, point_index, 2) \
+    X(a, STATIC, SINGULAR, UINT32, point_count, 3) \
+    X(a, STATIC, OPTIONAL, MESSAGE, point, 4)
+#define PB_FrequencyResponse_CALLBACK NULL
+#define PB_FrequencyResponse_DEFAULT NULL
+#define PB_FrequencyResponse_point_MSGTYPE PB_FrequencyResponsePoint
+
+#define PB_MotorIdleConfig_FIELDLIST(X, a)               \
+    X(a, STATIC, SINGULAR, BOOL, enabled, 1)             \
+    X(a, STATIC, SINGULAR, UINT32, timeout_ms, 2)        \
+    X(a, STATIC, SINGULAR, UINT32, loop_hz, 3)           \
+    X(a, STATIC, SINGULAR, FLOAT, velocity_threshold, 4) \
+    X(a, STATIC, SINGULAR, FLOAT, wake_angle_radians, 5)
+#define PB_MotorIdleConfig_CALLBACK NULL
+#define PB_MotorIdleConfig_DEFAULT NULL
+
+#define PB_MotorPowerEvent_FIELDLIST(X, a)               \
+    X(a, STATIC, SINGULAR, UENUM, state, 1)              \
+    X(a, STATIC, SINGULAR, UENUM, wake_reason, 2)        \
+    X(a, STATIC, SINGULAR, UINT32, wake_latency_us, 3)   \
+    X(a, STATIC, SINGULAR, UINT32, previous_state_ms, 4)
+#define PB_MotorPowerEvent_CALLBACK NULL
+#define PB_MotorPowerEvent_DEFAULT NULL
+
+#define PB_SensorJobStats_FIELDLIST(X, a)              \
+    X(a, STATIC, SINGULAR, STRING, name, 1)            \
+    X(a, STATIC, SINGULAR, UINT32, period_us, 2)       \
+    X(a, STATIC, SINGULAR, UINT32, deadline_us, 3)     \
+    X(a, STATIC, SINGULAR, UINT32, runs, 4)            \
+    X(a, STATIC, SINGULAR, UINT32, run_avg_us, 5)      \
+    X(a, STATIC, SINGULAR, UINT32, run_max_us, 6)      \
+    X(a, STATIC, SINGULAR, UINT32, lateness_avg_us, 7) \
+    X(a, STATIC, SINGULAR, UINT32, lateness_max_us, 8) \
+    X(a, STATIC, SINGULAR, UINT32, misses, 9)          \
+    X(a, STATIC, SINGULAR, UINT32, skipped, 10)
+#define PB_SensorJobStats_CALLBACK NULL
+#define PB_SensorJobStats_DEFAULT NULL
+
+#define PB_SensorSchedulerStats_FIELDLIST(X, a)  \
+    X(a, STATIC, REPEATED, MESSAGE, jobs, 1)     \
+    X(a, STATIC, SINGULAR, UINT32, window_ms, 2)
+#define PB_SensorSchedulerStats_CALLBACK NULL
+#define PB_SensorSchedulerStats_DEFAULT NULL
+#define PB_SensorSchedulerStats_jobs_MSGTYPE PB_SensorJobStats
+
+#define PB_PressDetectorConfig_FIELDLIST(X, a)                   \
+    X(a, STATIC, SINGULAR, FLOAT, threshold, 1)                  \
+    X(a, STATIC, SINGULAR, UINT32, baseline_time_constant_ms, 2)
+#define PB_PressDetectorConfig_CALLBACK NULL
+#define PB_PressDetectorConfig_DEFAULT NULL
+
+#define PB_PressDetectorStats_FIELDLIST(X, a)                    \
+    X(a, STATIC, SINGULAR, UINT32, presses, 1)                   \
+    X(a, STATIC, SINGULAR, UINT32, bucket_us, 2)                 \
+    X(a, STATIC, REPEATED, UINT32, latency_histogram, 3)         \
+    X(a, STATIC, SINGULAR, UINT32, latency_avg_us, 4)            \
+    X(a, STATIC, SINGULAR, UINT32, latency_max_us, 5)            \
+    X(a, STATIC, SINGULAR, FLOAT, threshold, 6)                  \
+    X(a, STATIC, SINGULAR, UINT32, baseline_time_constant_ms, 7) \
+    X(a, STATIC, SINGULAR, UINT32, window_ms, 8)
+#define PB_PressDetectorStats_CALLBACK NULL
+#define PB_PressDetectorStats_DEFAULT NULL
+
 #define PB_Ack_FIELDLIST(X, a) \
     X(a, STATIC, SINGULAR, UINT32, nonce, 1)
 #define PB_Ack_CALLBACK NULL
@@ -569,20 +1554,27 @@ extern "C"
 #define PB_SmartKnobState_DEFAULT NULL
 #define PB_SmartKnobState_config_MSGTYPE PB_SmartKnobConfig
 
-#define PB_SmartKnobConfig_FIELDLIST(X, a)                   \
-    X(a, STATIC, SINGULAR, INT32, position, 1)               \
-    X(a, STATIC, SINGULAR, FLOAT, sub_position_unit, 2)      \
-    X(a, STATIC, SINGULAR, UINT32, position_nonce, 3)        \
-    X(a, STATIC, SINGULAR, INT32, min_position, 4)           \
-    X(a, STATIC, SINGULAR, INT32, max_position, 5)           \
-    X(a, STATIC, SINGULAR, FLOAT, position_width_radians, 6) \
-    X(a, STATIC, SINGULAR, FLOAT, detent_strength_unit, 7)   \
-    X(a, STATIC, SINGULAR, FLOAT, endstop_strength_unit, 8)  \
-    X(a, STATIC, SINGULAR, FLOAT, snap_point, 9)             \
-    X(a, STATIC, SINGULAR, STRING, id, 10)                   \
-    X(a, STATIC, REPEATED, INT32, detent_positions, 11)      \
-    X(a, STATIC, SINGULAR, FLOAT, snap_point_bias, 12)       \
-    X(a, STATIC, SINGULAR, INT32, led_hue, 13)
+#define PB_SmartKnobConfig_FIELDLIST(X, a)                      \
+    X(a, STATIC, SINGULAR, INT32, position, 1)                  \
+    X(a, STATIC, SINGULAR, FLOAT, sub_position_unit, 2)         \
+    X(a, STATIC, SINGULAR, UINT32, position_nonce, 3)           \
+    X(a, STATIC, SINGULAR, INT32, min_position, 4)              \
+    X(a, STATIC, SINGULAR, INT32, max_position, 5)              \
+    X(a, STATIC, SINGULAR, FLOAT, position_width_radians, 6)    \
+    X(a, STATIC, SINGULAR, FLOAT, detent_strength_unit, 7)      \
+    X(a, STATIC, SINGULAR, FLOAT, endstop_strength_unit, 8)     \
+    X(a, STATIC, SINGULAR, FLOAT, snap_point, 9)                \
+    X(a, STATIC, SINGULAR, STRING, id, 10)                      \
+    X(a, STATIC, REPEATED, INT32, detent_positions, 11)         \
+    X(a, STATIC, SINGULAR, FLOAT, snap_point_bias, 12)          \
+    X(a, STATIC, SINGULAR, INT32, led_hue, 13)                  \
+    X(a, STATIC, SINGULAR, UINT32, torque_profile_id, 14)       \
+    X(a, STATIC, SINGULAR, UINT32, detent_set_id, 15)           \
+    X(a, STATIC, SINGULAR, UENUM, motion_model, 16)             \
+    X(a, STATIC, SINGULAR, FLOAT, flywheel_inertia, 17)         \
+    X(a, STATIC, SINGULAR, FLOAT, flywheel_friction, 18)        \
+    X(a, STATIC, SINGULAR, FLOAT, spring_dead_band_radians, 19) \
+    X(a, STATIC, SINGULAR, BOOL, ratchet_decreasing, 20)
 #define PB_SmartKnobConfig_CALLBACK NULL
 #define PB_SmartKnobConfig_DEFAULT NULL
 
@@ -603,9 +1595,34 @@ extern "C"
     X(a, STATIC, SINGULAR, BOOL, calibrated, 1)              \
     X(a, STATIC, SINGULAR, FLOAT, zero_electrical_offset, 2) \
     X(a, STATIC, SINGULAR, BOOL, direction_cw, 3)            \
-    X(a, STATIC, SINGULAR, UINT32, pole_pairs, 4)
+    X(a, STATIC, SINGULAR, UINT32, pole_pairs, 4)            \
+    X(a, STATIC, OPTIONAL, MESSAGE, linearization, 5)
 #define PB_MotorCalibration_CALLBACK NULL
 #define PB_MotorCalibration_DEFAULT NULL
+#define PB_MotorCalibration_linearization_MSGTYPE PB_EncoderLinearization
+
+#define PB_EncoderLinearization_FIELDLIST(X, a)            \
+    X(a, STATIC, REPEATED, FLOAT, harmonic_cos, 1)          \
+    X(a, STATIC, REPEATED, FLOAT, harmonic_sin, 2)          \
+    X(a, STATIC, SINGULAR, FLOAT, residual_before_rad, 3)   \
+    X(a, STATIC, SINGULAR, FLOAT, residual_after_rad, 4)
+#define PB_EncoderLinearization_CALLBACK NULL
+#define PB_EncoderLinearization_DEFAULT NULL
+
+#define PB_CoggingMap_FIELDLIST(X, a)    \
+    X(a, STATIC, SINGULAR, FLOAT, scale, 1) \
+    X(a, STATIC, SINGULAR, BYTES, samples, 2)
+#define PB_CoggingMap_CALLBACK NULL
+#define PB_CoggingMap_DEFAULT NULL
+
+#define PB_GainSchedule_FIELDLIST(X, a)                       \
+    X(a, STATIC, REPEATED, FLOAT, position_widths_radians, 1) \
+    X(a, STATIC, REPEATED, FLOAT, strengths, 2)               \
+    X(a, STATIC, REPEATED, FLOAT, p, 3)                       \
+    X(a, STATIC, REPEATED, FLOAT, d, 4)                       \
+    X(a, STATIC, REPEATED, FLOAT, output_ramp, 5)
+#define PB_GainSchedule_CALLBACK NULL
+#define PB_GainSchedule_DEFAULT NULL
 
 #define PB_StrainState_FIELDLIST(X, a)             \
     X(a, STATIC, SINGULAR, INT32, press_weight, 1) \
@@ -618,6 +1635,37 @@ extern "C"
 #define PB_StrainCalibration_CALLBACK NULL
 #define PB_StrainCalibration_DEFAULT NULL
 
+#define PB_TorqueProfile_FIELDLIST(X, a)                 \
+    X(a, STATIC, SINGULAR, UINT32, id, 1)                 \
+    X(a, STATIC, SINGULAR, UENUM, mode, 2)                \
+    X(a, STATIC, REPEATED, FLOAT, detent_samples, 3)      \
+    X(a, STATIC, REPEATED, FLOAT, endstop_samples, 4)     \
+    X(a, STATIC, SINGULAR, FLOAT, endstop_range_units, 5)
+#define PB_TorqueProfile_CALLBACK NULL
+#define PB_TorqueProfile_DEFAULT NULL
+
+#define PB_DetentSet_FIELDLIST(X, a)               \
+    X(a, STATIC, SINGULAR, UINT32, id, 1)           \
+    X(a, STATIC, SINGULAR, UINT32, period, 2)       \
+    X(a, STATIC, SINGULAR, INT32, period_offset, 3) \
+    X(a, STATIC, SINGULAR, INT32, bitmap_start, 4)  \
+    X(a, STATIC, SINGULAR, BYTES, bitmap, 5)
+#define PB_DetentSet_CALLBACK NULL
+#define PB_DetentSet_DEFAULT NULL
+
+#define PB_PlayHaptic_FIELDLIST(X, a)         \
+    X(a, STATIC, SINGULAR, UENUM, waveform, 1) \
+    X(a, STATIC, SINGULAR, FLOAT, strength, 2)
+#define PB_PlayHaptic_CALLBACK NULL
+#define PB_PlayHaptic_DEFAULT NULL
+
+#define PB_HapticWaveform_FIELDLIST(X, a)              \
+    X(a, STATIC, SINGULAR, UENUM, waveform, 1)          \
+    X(a, STATIC, SINGULAR, UINT32, ticks_per_sample, 2) \
+    X(a, STATIC, REPEATED, FLOAT, samples, 3)
+#define PB_HapticWaveform_CALLBACK NULL
+#define PB_HapticWaveform_DEFAULT NULL
+
 #define PB_AppComponent_FIELDLIST(X, a)                                                  \
     X(a, STATIC, SINGULAR, STRING, component_id, 1)                                      \
     X(a, STATIC, SINGULAR, UENUM, type, 2)                                               \
@@ -657,6 +1705,20 @@ extern "C"
     extern const pb_msgdesc_t PB_Knob_msg;
     extern const pb_msgdesc_t PB_MotorCalibState_msg;
     extern const pb_msgdesc_t PB_StrainCalibState_msg;
+    extern const pb_msgdesc_t PB_MotorLoopStats_msg;
+    extern const pb_msgdesc_t PB_TelemetrySubscribe_msg;
+    extern const pb_msgdesc_t PB_TelemetryFrame_msg;
+    extern const pb_msgdesc_t PB_FlightRecorderConfig_msg;
+    extern const pb_msgdesc_t PB_FlightRecording_msg;
+    extern const pb_msgdesc_t PB_FrequencySweepConfig_msg;
+    extern const pb_msgdesc_t PB_FrequencyResponsePoint_msg;
+    extern const pb_msgdesc_t PB_FrequencyResponse_msg;
+    extern const pb_msgdesc_t PB_MotorIdleConfig_msg;
+    extern const pb_msgdesc_t PB_MotorPowerEvent_msg;
+    extern const pb_msgdesc_t PB_SensorJobStats_msg;
+    extern const pb_msgdesc_t PB_SensorSchedulerStats_msg;
+    extern const pb_msgdesc_t PB_PressDetectorConfig_msg;
+    extern const pb_msgdesc_t PB_PressDetectorStats_msg;
     extern const pb_msgdesc_t PB_Ack_msg;
     extern const pb_msgdesc_t PB_Log_msg;
     extern const pb_msgdesc_t PB_SmartKnobState_msg;
@@ -664,8 +1726,15 @@ extern "C"
     extern const pb_msgdesc_t PB_RequestState_msg;
     extern const pb_msgdesc_t PB_PersistentConfiguration_msg;
     extern const pb_msgdesc_t PB_MotorCalibration_msg;
+    extern const pb_msgdesc_t PB_EncoderLinearization_msg;
+    extern const pb_msgdesc_t PB_CoggingMap_msg;
+    extern const pb_msgdesc_t PB_GainSchedule_msg;
     extern const pb_msgdesc_t PB_StrainState_msg;
     extern const pb_msgdesc_t PB_StrainCalibration_msg;
+    extern const pb_msgdesc_t PB_TorqueProfile_msg;
+    extern const pb_msgdesc_t PB_DetentSet_msg;
+    extern const pb_msgdesc_t PB_PlayHaptic_msg;
+    extern const pb_msgdesc_t PB_HapticWaveform_msg;
     extern const pb_msgdesc_t PB_AppComponent_msg;
     extern const pb_msgdesc_t PB_ToggleConfig_msg;
     extern const pb_msgdesc_t PB_MultiChoiceConfig_msg;
@@ -676,6 +1745,20 @@ extern "C"
 #define PB_Knob_fields &PB_Knob_msg
 #define PB_MotorCalibState_fields &PB_MotorCalibState_msg
 #define PB_StrainCalibState_fields &PB_StrainCalibState_msg
+#define PB_MotorLoopStats_fields &PB_MotorLoopStats_msg
+#define PB_TelemetrySubscribe_fields &PB_TelemetrySubscribe_msg
+#define PB_TelemetryFrame_fields &PB_TelemetryFrame_msg
+#define PB_FlightRecorderConfig_fields &PB_FlightRecorderConfig_msg
+#define PB_FlightRecording_fields &PB_FlightRecording_msg
+#define PB_FrequencySweepConfig_fields &PB_FrequencySweepConfig_msg
+#define PB_FrequencyResponsePoint_fields &PB_FrequencyResponsePoint_msg
+#define PB_FrequencyResponse_fields &PB_FrequencyResponse_msg
+#define PB_MotorIdleConfig_fields &PB_MotorIdleConfig_msg
+#define PB_MotorPowerEvent_fields &PB_MotorPowerEvent_msg
+#define PB_SensorJobStats_fields &PB_SensorJobStats_msg
+#define PB_SensorSchedulerStats_fields &PB_SensorSchedulerStats_msg
+#define PB_PressDetectorConfig_fields &PB_PressDetectorConfig_msg
+#define PB_PressDetectorStats_fields &PB_PressDetectorStats_msg
 #define PB_Ack_fields &PB_Ack_msg
 #define PB_Log_fields &PB_Log_msg
 #define PB_SmartKnobState_fields &PB_SmartKnobState_msg
@@ -683,8 +1766,15 @@ extern "C"
 #define PB_RequestState_fields &PB_RequestState_msg
 #define PB_PersistentConfiguration_fields &PB_PersistentConfiguration_msg
 #define PB_MotorCalibration_fields &PB_MotorCalibration_msg
+#define PB_EncoderLinearization_fields &PB_EncoderLinearization_msg
+#define PB_CoggingMap_fields &PB_CoggingMap_msg
+#define PB_GainSchedule_fields &PB_GainSchedule_msg
 #define PB_StrainState_fields &PB_StrainState_msg
 #define PB_StrainCalibration_fields &PB_StrainCalibration_msg
+#define PB_TorqueProfile_fields &PB_TorqueProfile_msg
+#define PB_DetentSet_fields &PB_DetentSet_msg
+#define PB_PlayHaptic_fields &PB_PlayHaptic_msg
+#define PB_HapticWaveform_fields &PB_HapticWaveform_msg
 #define PB_AppComponent_fields &PB_AppComponent_msg
 #define PB_ToggleConfig_fields &PB_ToggleConfig_msg
 #define PB_MultiChoiceConfig_fields &PB_MultiChoiceConfig_msg
@@ -692,22 +1782,43 @@ extern "C"
 /* Maximum encoded size of messages (where known) */
 #define PB_Ack_size 6
 #define PB_AppComponent_size 685
-#define PB_FromSmartKnob_size 399
-#define PB_Knob_size 252
+#define PB_CoggingMap_size 520
+#define PB_DetentSet_size 162
+#define PB_EncoderLinearization_size 46
+#define PB_FlightRecorderConfig_size 12
+#define PB_FlightRecording_size 684
+#define PB_FrequencyResponsePoint_size 25
+#define PB_FrequencyResponse_size 41
+#define PB_FrequencySweepConfig_size 27
+#define PB_FromSmartKnob_size 690
+#define PB_GainSchedule_size 917
+#define PB_HapticWaveform_size 264
+#define PB_Knob_size 300
 #define PB_Log_size 393
-#define PB_MotorCalibState_size 2
-#define PB_MotorCalibration_size 15
+#define PB_MotorCalibState_size 55
+#define PB_MotorCalibration_size 63
+#define PB_MotorIdleConfig_size 24
+#define PB_MotorLoopStats_size 104
+#define PB_MotorPowerEvent_size 16
 #define PB_MultiChoiceConfig_size 580
-#define PB_PersistentConfiguration_size 28
+#define PB_PersistentConfiguration_size 76
+#define PB_PlayHaptic_size 7
+#define PB_PressDetectorConfig_size 11
+#define PB_PressDetectorStats_size 123
 #define PB_RequestState_size 0
 #define PB_SMARTKNOB_PB_H_MAX_SIZE PB_ToSmartknob_size
-#define PB_SmartKnobConfig_size 198
-#define PB_SmartKnobState_size 220
+#define PB_SensorJobStats_size 71
+#define PB_SensorSchedulerStats_size 590
+#define PB_SmartKnobConfig_size 228
+#define PB_SmartKnobState_size 250
 #define PB_StrainCalibState_size 11
 #define PB_StrainCalibration_size 5
 #define PB_StrainState_size 16
-#define PB_ToSmartknob_size 697
+#define PB_TelemetryFrame_size 667
+#define PB_TelemetrySubscribe_size 12
+#define PB_ToSmartknob_size 929
 #define PB_ToggleConfig_size 107
+#define PB_TorqueProfile_size 335
 
 #ifdef __cplusplus
 } /* extern "C" */
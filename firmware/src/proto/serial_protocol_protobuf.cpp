@@ -65,6 +65,70 @@ void SerialProtocolProtobuf::sendKnobState(PB_SmartKnobState state)
     sendPBTxBuffer();
 }
 
+void SerialProtocolProtobuf::sendMotorLoopStats(PB_MotorLoopStats stats)
+{
+    pb_tx_buffer_ = {};
+    pb_tx_buffer_.which_payload = PB_FromSmartKnob_motor_loop_stats_tag;
+    pb_tx_buffer_.payload.motor_loop_stats = stats;
+    sendPBTxBuffer();
+}
+
+void SerialProtocolProtobuf::sendSensorSchedulerStats(const PB_SensorSchedulerStats &stats)
+{
+    pb_tx_buffer_ = {};
+    pb_tx_buffer_.which_payload = PB_FromSmartKnob_sensor_scheduler_stats_tag;
+    pb_tx_buffer_.payload.sensor_scheduler_stats = stats;
+    sendPBTxBuffer();
+}
+
+void SerialProtocolProtobuf::sendPressDetectorStats(const PB_PressDetectorStats &stats)
+{
+    pb_tx_buffer_ = {};
+    pb_tx_buffer_.which_payload = PB_FromSmartKnob_press_detector_stats_tag;
+    pb_tx_buffer_.payload.press_detector_stats = stats;
+    sendPBTxBuffer();
+}
+
+void SerialProtocolProtobuf::sendMotorCalibState(PB_MotorCalibState state)
+{
+    pb_tx_buffer_ = {};
+    pb_tx_buffer_.which_payload = PB_FromSmartKnob_motor_calib_state_tag;
+    pb_tx_buffer_.payload.motor_calib_state = state;
+    sendPBTxBuffer();
+}
+
+void SerialProtocolProtobuf::sendTelemetryFrame(const PB_TelemetryFrame &frame)
+{
+    pb_tx_buffer_ = {};
+    pb_tx_buffer_.which_payload = PB_FromSmartKnob_telemetry_frame_tag;
+    pb_tx_buffer_.payload.telemetry_frame = frame;
+    sendPBTxBuffer();
+}
+
+void SerialProtocolProtobuf::sendFlightRecording(const PB_FlightRecording &recording)
+{
+    pb_tx_buffer_ = {};
+    pb_tx_buffer_.which_payload = PB_FromSmartKnob_flight_recording_tag;
+    pb_tx_buffer_.payload.flight_recording = recording;
+    sendPBTxBuffer();
+}
+
+void SerialProtocolProtobuf::sendFrequencyResponse(const PB_FrequencyResponse &response)
+{
+    pb_tx_buffer_ = {};
+    pb_tx_buffer_.which_payload = PB_FromSmartKnob_frequency_response_tag;
+    pb_tx_buffer_.payload.frequency_response = response;
+    sendPBTxBuffer();
+}
+
+void SerialProtocolProtobuf::sendMotorPowerEvent(const PB_MotorPowerEvent &event)
+{
+    pb_tx_buffer_ = {};
+    pb_tx_buffer_.which_payload = PB_FromSmartKnob_motor_power_event_tag;
+    pb_tx_buffer_.payload.motor_power_event = event;
+    sendPBTxBuffer();
+}
+
 void SerialProtocolProtobuf::handlePacket(const uint8_t *buffer, size_t size)
 {
     // LOGI(" packet received!");
@@ -35,6 +35,14 @@ public:
 
     void sendKnobInfo(PB_Knob knob);
     void sendKnobState(PB_SmartKnobState state);
+    void sendMotorLoopStats(PB_MotorLoopStats stats);
+    void sendSensorSchedulerStats(const PB_SensorSchedulerStats &stats);
+    void sendPressDetectorStats(const PB_PressDetectorStats &stats);
+    void sendMotorCalibState(PB_MotorCalibState state);
+    void sendTelemetryFrame(const PB_TelemetryFrame &frame);
+    void sendFlightRecording(const PB_FlightRecording &recording);
+    void sendFrequencyResponse(const PB_FrequencyResponse &response);
+    void sendMotorPowerEvent(const PB_MotorPowerEvent &event);
     // void sendStrainCalibState(const uint8_t step);
     // void sendConfigState(const uint8_t step);
 
@@ -50,12 +50,15 @@ RootTask::RootTask(
     app_sync_queue_ = xQueueCreate(2, sizeof(cJSON *));
     assert(app_sync_queue_ != NULL);
 
-    knob_state_queue_ = xQueueCreate(1, sizeof(PB_SmartKnobState));
-    assert(knob_state_queue_ != NULL);
-
     sensors_status_queue_ = xQueueCreate(100, sizeof(SensorsState));
     assert(sensors_status_queue_ != NULL);
 
+    telemetry_subscribe_queue_ = xQueueCreate(1, sizeof(PB_TelemetrySubscribe));
+    assert(telemetry_subscribe_queue_ != NULL);
+
+    command_reply_queue_ = xQueueCreate(4, sizeof(PB_SmartKnobCommand));
+    assert(command_reply_queue_ != NULL);
+
     mutex_ = xSemaphoreCreateMutex();
     assert(mutex_ != NULL);
 }
@@ -82,17 +85,45 @@ void RootTask::run()
     LOGI("Component system enabled: ComponentManager integration");
     LOGI("RootTask: Starting run() method at %d ms", task_started_at);
 
-    motor_task_.addListener(knob_state_queue_);
-
     serial_protocol_protobuf_->registerTagCallback(PB_ToSmartknob_settings_tag, [this](PB_ToSmartknob to_smartknob)
                                                    { configuration_->setSettings(to_smartknob.payload.settings); });
 
     serial_protocol_protobuf_->registerTagCallback(PB_ToSmartknob_strain_calibration_tag, [this](PB_ToSmartknob to_smartknob)
                                                    { sensors_task_->factoryStrainCalibrationCallback(to_smartknob.payload.strain_calibration.calibration_weight); });
+    serial_protocol_protobuf_->registerTagCallback(PB_ToSmartknob_press_detector_config_tag, [this](PB_ToSmartknob to_smartknob)
+                                                   { sensors_task_->configurePressDetector(to_smartknob.payload.press_detector_config); });
 
     serial_protocol_protobuf_->registerTagCallback(PB_ToSmartknob_request_state_tag, [this](PB_ToSmartknob to_smartknob)
                                                    { sendCurrentKnobState(); });
 
+    serial_protocol_protobuf_->registerTagCallback(PB_ToSmartknob_play_haptic_tag, [this](PB_ToSmartknob to_smartknob)
+                                                   { motor_task_.playHaptic(to_smartknob.payload.play_haptic.waveform, to_smartknob.payload.play_haptic.strength); });
+
+    serial_protocol_protobuf_->registerTagCallback(PB_ToSmartknob_haptic_waveform_tag, [this](PB_ToSmartknob to_smartknob)
+                                                   { motor_task_.setHapticWaveform(to_smartknob.payload.haptic_waveform); });
+    serial_protocol_protobuf_->registerTagCallback(PB_ToSmartknob_torque_profile_tag, [this](PB_ToSmartknob to_smartknob)
+                                                   { motor_task_.setTorqueProfile(to_smartknob.payload.torque_profile); });
+    serial_protocol_protobuf_->registerTagCallback(PB_ToSmartknob_detent_set_tag, [this](PB_ToSmartknob to_smartknob)
+                                                   { motor_task_.setDetentSet(to_smartknob.payload.detent_set); });
+    serial_protocol_protobuf_->registerTagCallback(PB_ToSmartknob_telemetry_subscribe_tag, [this](PB_ToSmartknob to_smartknob)
+                                                   { xQueueOverwrite(telemetry_subscribe_queue_, &to_smartknob.payload.telemetry_subscribe); });
+    serial_protocol_protobuf_->registerTagCallback(PB_ToSmartknob_flight_recorder_config_tag, [this](PB_ToSmartknob to_smartknob)
+                                                   { motor_task_.configureFlightRecorder(to_smartknob.payload.flight_recorder_config); });
+    serial_protocol_protobuf_->registerTagCallback(PB_ToSmartknob_frequency_sweep_tag, [this](PB_ToSmartknob to_smartknob)
+                                                   { motor_task_.runFrequencySweep(to_smartknob.payload.frequency_sweep); });
+    serial_protocol_protobuf_->registerTagCallback(PB_ToSmartknob_gain_schedule_tag, [this](PB_ToSmartknob to_smartknob)
+                                                   {
+                                                       if (!GainSchedule::isValid(to_smartknob.payload.gain_schedule))
+                                                       {
+                                                           LOGW("Ignoring invalid gain schedule");
+                                                           return;
+                                                       }
+                                                       // Applied even if saving fails; the Configuration keeps it in memory
+                                                       configuration_->setGainScheduleAndSave(to_smartknob.payload.gain_schedule);
+                                                       motor_task_.reloadGainSchedule(); });
+    serial_protocol_protobuf_->registerTagCallback(PB_ToSmartknob_motor_idle_config_tag, [this](PB_ToSmartknob to_smartknob)
+                                                   { motor_task_.configureIdle(to_smartknob.payload.motor_idle_config); });
+
     // Component system protocol handler
     serial_protocol_protobuf_->registerTagCallback(PB_ToSmartknob_app_component_tag, [this](PB_ToSmartknob to_smartknob)
                                                    {
@@ -132,6 +163,24 @@ void RootTask::run()
 
     serial_protocol_protobuf_->registerCommandCallback(PB_SmartKnobCommand_MOTOR_CALIBRATE, [this]()
                                                        { motor_task_.runCalibration(); });
+    serial_protocol_protobuf_->registerCommandCallback(PB_SmartKnobCommand_MOTOR_CALIBRATE_FAST, [this]()
+                                                       { motor_task_.runCalibration(true); });
+    serial_protocol_protobuf_->registerCommandCallback(PB_SmartKnobCommand_MOTOR_CALIBRATE_COGGING, [this]()
+                                                       { motor_task_.runCoggingCalibration(); });
+
+    serial_protocol_protobuf_->registerCommandCallback(PB_SmartKnobCommand_GET_MOTOR_LOOP_STATS, [this]()
+                                                       { queueCommandReply(PB_SmartKnobCommand_GET_MOTOR_LOOP_STATS); });
+    serial_protocol_protobuf_->registerCommandCallback(PB_SmartKnobCommand_GET_SENSOR_SCHEDULER_STATS, [this]()
+                                                       { queueCommandReply(PB_SmartKnobCommand_GET_SENSOR_SCHEDULER_STATS); });
+    serial_protocol_protobuf_->registerCommandCallback(PB_SmartKnobCommand_GET_PRESS_DETECTOR_STATS, [this]()
+                                                       { queueCommandReply(PB_SmartKnobCommand_GET_PRESS_DETECTOR_STATS); });
+
+    serial_protocol_protobuf_->registerCommandCallback(PB_SmartKnobCommand_FLIGHT_RECORDER_TRIGGER, [this]()
+                                                       { motor_task_.triggerFlightRecorder(); });
+    serial_protocol_protobuf_->registerCommandCallback(PB_SmartKnobCommand_FLIGHT_RECORDER_UPLOAD, [this]()
+                                                       { queueCommandReply(PB_SmartKnobCommand_FLIGHT_RECORDER_UPLOAD); });
+    serial_protocol_protobuf_->registerCommandCallback(PB_SmartKnobCommand_FREQUENCY_SWEEP_STOP, [this]()
+                                                       { motor_task_.stopFrequencySweep(); });
 
     auto callbackGetKnobInfo = [this]()
     {
@@ -279,6 +328,8 @@ void RootTask::run()
             // Add motor encoder detection? or disable motor if not "enaged detected presence"
             if (app_state.proximiti_state.RangeStatus < 3 && app_state.proximiti_state.RangeMilliMeter < 200)
             {
+                // Keeps the motor out of its idle mode, or brings the detents back before the knob is touched
+                motor_task_.notifyPresence(latest_sensors_state_.proximity.measured_at_us);
                 app_state.screen_state.has_been_engaged = true;
                 if (app_state.screen_state.awake_until < millis() + KNOB_ENGAGED_TIMEOUT_NONE_PHYSICAL) // If half of the time of the last interaction has passed, reset allow for engage to be detected again.
                 {
@@ -294,7 +345,91 @@ void RootTask::run()
             // Does nothing currently. MQTT functionality removed for serial-only mode
         }
 
-        if (xQueueReceive(knob_state_queue_, &latest_state_, 0) == pdTRUE)
+        // Stream motor calibration progress to the host
+        MotorCalibSnapshot calib_state;
+        if (motor_task_.getCalibState(calib_state) && calib_state.sequence != last_calib_state_sent_)
+        {
+            if (serial_protocol_protobuf_)
+            {
+                serial_protocol_protobuf_->sendMotorCalibState(calib_state.state);
+            }
+            last_calib_state_sent_ = calib_state.sequence;
+        }
+
+        // Report the motor entering and leaving its idle mode
+        MotorPowerSnapshot power_event;
+        if (motor_task_.getPowerEvent(power_event) && power_event.sequence != last_power_event_sent_)
+        {
+            if (serial_protocol_protobuf_)
+            {
+                serial_protocol_protobuf_->sendMotorPowerEvent(power_event.event);
+            }
+            last_power_event_sent_ = power_event.sequence;
+        }
+
+        // Stream frequency sweep points to the host as they are measured, then the final state
+        if (motor_task_.getFrequencySweep(frequency_sweep_) && frequency_sweep_.sequence != last_sweep_sequence_sent_)
+        {
+            if (frequency_sweep_.sweep != last_sweep_sent_)
+            {
+                last_sweep_sent_ = frequency_sweep_.sweep;
+                sweep_points_sent_ = 0;
+            }
+            PB_FrequencyResponse response = PB_FrequencyResponse_init_zero;
+            response.state = frequency_sweep_.state;
+            response.point_count = frequency_sweep_.total_points;
+            for (; sweep_points_sent_ < frequency_sweep_.point_count; sweep_points_sent_++)
+            {
+                response.point_index = sweep_points_sent_;
+                response.has_point = true;
+                response.point = frequency_sweep_.points[sweep_points_sent_];
+                if (serial_protocol_protobuf_)
+                {
+                    serial_protocol_protobuf_->sendFrequencyResponse(response);
+                }
+            }
+            if (frequency_sweep_.state != PB_FrequencySweepState_FREQUENCY_SWEEP_RUNNING && serial_protocol_protobuf_)
+            {
+                response.point_index = frequency_sweep_.point_count;
+                response.has_point = false;
+                serial_protocol_protobuf_->sendFrequencyResponse(response);
+            }
+            last_sweep_sequence_sent_ = frequency_sweep_.sequence;
+        }
+
+        // Replies to host commands go out from here, so they can't interleave with the frames below
+        PB_SmartKnobCommand command;
+        while (xQueueReceive(command_reply_queue_, &command, 0) == pdTRUE)
+        {
+            replyToCommand(command);
+        }
+
+        // Stream motor telemetry to the host, a bounded number of frames per loop so a slow link drops samples
+        // on the device rather than stalling this task
+        PB_TelemetrySubscribe telemetry_subscribe;
+        if (xQueueReceive(telemetry_subscribe_queue_, &telemetry_subscribe, 0) == pdTRUE)
+        {
+            motor_task_.subscribeTelemetry(telemetry_subscribe);
+        }
+        for (uint8_t i = 0; i < TELEMETRY_MAX_FRAMES_PER_LOOP && motor_task_.getTelemetryFrame(telemetry_frame_); i++)
+        {
+            if (serial_protocol_protobuf_)
+            {
+                serial_protocol_protobuf_->sendTelemetryFrame(telemetry_frame_);
+            }
+        }
+
+        // Flight recorder uploads go out the same way. They always answer at least once, with FLIGHT_TRIGGER_NONE if
+        // nothing was captured.
+        for (uint8_t i = 0; i < TELEMETRY_MAX_FRAMES_PER_LOOP && flight_upload_active_; i++)
+        {
+            uint32_t samples = motor_task_.readFlightRecording(flight_upload_next_sample_, flight_recording_, flight_upload_window_);
+            serial_protocol_protobuf_->sendFlightRecording(flight_recording_);
+            flight_upload_next_sample_ += samples;
+            flight_upload_active_ = samples > 0 && flight_upload_next_sample_ < flight_recording_.total_samples;
+        }
+
+        if (readMotorState())
         {
 
             // The following is a smoothing filter (rounding) on the sub position unit (to avoid flakiness).
@@ -700,6 +835,33 @@ void RootTask::publish(const AppState &state)
     }
 }
 
+bool RootTask::readMotorState()
+{
+    MotorStateSnapshot snapshot;
+    if (!motor_task_.getState(snapshot) || snapshot.sequence == latest_motor_state_sequence_)
+    {
+        return false;
+    }
+
+    if (snapshot.config_version != latest_motor_config_version_)
+    {
+        MotorConfigSnapshot config;
+        if (!motor_task_.getConfig(config))
+        {
+            // Raced with a config update; pick up both on the next loop
+            return false;
+        }
+        latest_state_.has_config = true;
+        latest_state_.config = config.config;
+        latest_motor_config_version_ = config.version;
+    }
+
+    latest_state_.current_position = snapshot.current_position;
+    latest_state_.sub_position_unit = snapshot.sub_position_unit;
+    latest_motor_state_sequence_ = snapshot.sequence;
+    return true;
+}
+
 void RootTask::publishState()
 {
     // Apply local state before publishing to serial
@@ -727,6 +889,42 @@ void RootTask::sendCurrentKnobState()
     }
 }
 
+// Command handler tasks
+void RootTask::queueCommandReply(PB_SmartKnobCommand command)
+{
+    if (xQueueSend(command_reply_queue_, &command, 0) != pdTRUE)
+    {
+        LOGW("Dropping command %d, too many replies pending", command);
+    }
+}
+
+void RootTask::replyToCommand(PB_SmartKnobCommand command)
+{
+    if (!serial_protocol_protobuf_)
+    {
+        return;
+    }
+    switch (command)
+    {
+    case PB_SmartKnobCommand_GET_MOTOR_LOOP_STATS:
+        serial_protocol_protobuf_->sendMotorLoopStats(motor_task_.getLoopStats());
+        break;
+    case PB_SmartKnobCommand_GET_SENSOR_SCHEDULER_STATS:
+        serial_protocol_protobuf_->sendSensorSchedulerStats(sensors_task_->getSchedulerStats());
+        break;
+    case PB_SmartKnobCommand_GET_PRESS_DETECTOR_STATS:
+        serial_protocol_protobuf_->sendPressDetectorStats(sensors_task_->getPressDetectorStats());
+        break;
+    case PB_SmartKnobCommand_FLIGHT_RECORDER_UPLOAD:
+        // Restarts an upload that is still going
+        flight_upload_active_ = true;
+        flight_upload_next_sample_ = 0;
+        break;
+    default:
+        break;
+    }
+}
+
 // Auto-broadcasting method implementations
 void RootTask::enableAutoBroadcast(bool enabled)
 {
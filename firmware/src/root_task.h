@@ -85,6 +85,8 @@ private:
     uint8_t last_strain_pressed_played_ = VIRTUAL_BUTTON_IDLE;
 
     PB_SmartKnobState latest_state_ = {};
+    uint32_t latest_motor_state_sequence_ = 0;
+    uint32_t latest_motor_config_version_ = 0;
     PB_SmartKnobConfig latest_config_ = {};
 
     SensorsState latest_sensors_state_ = {};
@@ -98,12 +100,17 @@ private:
 
     cJSON *apps_ = NULL;
 
-    QueueHandle_t knob_state_queue_;
-
     QueueHandle_t sensors_status_queue_;
 
     QueueHandle_t app_sync_queue_;
 
+    // Telemetry subscriptions arrive in a tag handler task but are applied by this task, which drains the frames
+    QueueHandle_t telemetry_subscribe_queue_;
+
+    // Commands answered over the protobuf link arrive in a command handler task but are answered by this task, the
+    // only one that fills the link's tx buffer
+    QueueHandle_t command_reply_queue_;
+
     OSConfigNotifier os_config_notifier_;
 
     // SerialProtocolPlaintext plaintext_protocol_;
@@ -114,12 +121,26 @@ private:
     bool component_mode_; // true when using components, false when using traditional apps
 
     uint32_t last_calib_state_sent_ = 0;
+    uint32_t last_power_event_sent_ = 0;
+    PB_TelemetryFrame telemetry_frame_;
+    PB_FlightRecording flight_recording_;
+    // A FLIGHT_RECORDER_UPLOAD in progress, sent a few frames per loop like the telemetry stream
+    bool flight_upload_active_ = false;
+    uint32_t flight_upload_next_sample_ = 0;
+    uint32_t flight_upload_window_ = 0;
+    FrequencySweepSnapshot frequency_sweep_;
+    uint32_t last_sweep_sequence_sent_ = 0;
+    uint32_t last_sweep_sent_ = 0;
+    uint8_t sweep_points_sent_ = 0;
 
     void updateHardware(AppState *app_state);
+    bool readMotorState();
     void publishState();
     void applyConfig(PB_SmartKnobConfig config, bool from_remote);
     void publish(const AppState &state);
     void sendCurrentKnobState();
+    void queueCommandReply(PB_SmartKnobCommand command);
+    void replyToCommand(PB_SmartKnobCommand command);
 
     // Auto-broadcasting methods
     void enableAutoBroadcast(bool enabled = true);
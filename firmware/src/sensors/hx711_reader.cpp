@@ -0,0 +1,163 @@
+#include "hx711_reader.h"
+
+#include "driver/gpio.h"
+#include "esp_ipc.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "hal/gpio_ll.h"
+
+#include "strain_filter.h"
+
+// With no sample for this long while DOUT is low, the ready edge was missed (e.g. it came while powering up) and
+// the HX711 is waiting to be read before it signals again. Longer than a conversion at the slow 10 SPS rate.
+static const uint32_t STALL_TIMEOUT_US = 250 * 1000;
+
+void Hx711Reader::begin(uint8_t dout_pin, uint8_t sck_pin, uint8_t gain)
+{
+    dout_pin_ = dout_pin;
+    sck_pin_ = sck_pin;
+    // Pulses after the 24 data bits select the gain of the next conversion
+    gain_pulses_ = gain == 64 ? 3 : (gain == 32 ? 2 : 1);
+
+    ring_.init(ring_storage_, RING_SIZE);
+
+    pinMode(sck_pin_, OUTPUT);
+    pinMode(dout_pin_, INPUT);
+    digitalWrite(sck_pin_, LOW);
+    settle_samples_ = 1;
+    powered_.store(true);
+
+    esp_ipc_call_blocking(STRAIN_ISR_CORE, installInterrupt, this);
+}
+
+void Hx711Reader::installInterrupt(void *arg)
+{
+    Hx711Reader *reader = static_cast<Hx711Reader *>(arg);
+
+    // The GPIO interrupt is allocated on the core that first installs the ISR service (Arduino's attachInterrupt
+    // installs the same one), so this has to come before any attachInterrupt() on another core
+    esp_err_t ret = gpio_install_isr_service(0);
+    assert(ret == ESP_OK || ret == ESP_ERR_INVALID_STATE);
+    gpio_set_intr_type((gpio_num_t)reader->dout_pin_, GPIO_INTR_NEGEDGE);
+    ret = gpio_isr_handler_add((gpio_num_t)reader->dout_pin_, onDataReady, reader);
+    assert(ret == ESP_OK);
+}
+
+bool Hx711Reader::pop(StrainSample &sample)
+{
+    StrainSample latest;
+    if (powered_.load() && gpio_get_level((gpio_num_t)dout_pin_) == 0 && latest_.tryRead(latest) &&
+        (uint32_t)esp_timer_get_time() - latest.timestamp_us > STALL_TIMEOUT_US)
+    {
+        // Clock the waiting conversion out on the interrupt's core, as the edge would have
+        esp_ipc_call(STRAIN_ISR_CORE, onDataReady, this);
+    }
+    return ring_.pop(sample);
+}
+
+uint32_t Hx711Reader::takeDropped()
+{
+    return ring_.takeDropped();
+}
+
+bool Hx711Reader::averageCounts(uint8_t count, uint32_t timeout_ms, float *average)
+{
+    StrainSample sample;
+    while (!latest_.tryRead(sample))
+    {
+    }
+    uint32_t last_us = sample.timestamp_us;
+
+    float sum = 0;
+    uint8_t received = 0;
+    uint32_t start_ms = millis();
+    while (received < count)
+    {
+        if (millis() - start_ms > timeout_ms)
+        {
+            return false;
+        }
+        delay(1);
+        if (!latest_.tryRead(sample) || sample.timestamp_us == last_us)
+        {
+            continue;
+        }
+        last_us = sample.timestamp_us;
+        sum += hx711DecodeCounts(sample.raw);
+        received++;
+    }
+    *average = sum / count;
+    return true;
+}
+
+void Hx711Reader::powerDown()
+{
+    portENTER_CRITICAL(&mux_);
+    powered_.store(false);
+    gpio_ll_set_level(&GPIO, (gpio_num_t)sck_pin_, 1);
+    portEXIT_CRITICAL(&mux_);
+}
+
+void Hx711Reader::powerUp()
+{
+    portENTER_CRITICAL(&mux_);
+    gpio_ll_set_level(&GPIO, (gpio_num_t)sck_pin_, 0);
+    // The HX711 wakes up at its default gain; the pulses after the first read switch it back
+    settle_samples_ = 1;
+    powered_.store(true);
+    portEXIT_CRITICAL(&mux_);
+}
+
+bool Hx711Reader::isPowered() const
+{
+    return powered_.load();
+}
+
+void IRAM_ATTR Hx711Reader::onDataReady(void *arg)
+{
+    static_cast<Hx711Reader *>(arg)->readSample();
+}
+
+void IRAM_ATTR Hx711Reader::readSample()
+{
+    portENTER_CRITICAL_ISR(&mux_);
+    // Clocking the word out toggles DOUT, which queues more edges; they find DOUT back high (until the next
+    // conversion) and end here
+    if (!powered_.load(std::memory_order_relaxed) || gpio_ll_get_level(&GPIO, (gpio_num_t)dout_pin_) != 0)
+    {
+        portEXIT_CRITICAL_ISR(&mux_);
+        return;
+    }
+
+    uint32_t timestamp_us = (uint32_t)esp_timer_get_time();
+    uint32_t raw = 0;
+    // Each bit is valid 0.1 us after the rising edge; SCK must not stay high for 60 us or the HX711 powers down,
+    // which is why this runs with interrupts off
+    for (uint8_t i = 0; i < 24 + gain_pulses_; i++)
+    {
+        gpio_ll_set_level(&GPIO, (gpio_num_t)sck_pin_, 1);
+        esp_rom_delay_us(1);
+        if (i < 24)
+        {
+            raw = (raw << 1) | gpio_ll_get_level(&GPIO, (gpio_num_t)dout_pin_);
+        }
+        gpio_ll_set_level(&GPIO, (gpio_num_t)sck_pin_, 0);
+        esp_rom_delay_us(1);
+    }
+    bool settling = settle_samples_ > 0;
+    if (settling)
+    {
+        settle_samples_--;
+    }
+    portEXIT_CRITICAL_ISR(&mux_);
+
+    if (!settling)
+    {
+        StrainSample sample = {
+            .timestamp_us = timestamp_us,
+            .raw = raw,
+        };
+        ring_.push(sample);
+        latest_.write(sample);
+    }
+}
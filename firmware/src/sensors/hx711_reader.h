@@ -0,0 +1,70 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+#include "../seqlock.h"
+#include "../spsc_ring.h"
+
+// Core the DOUT-ready interrupt (and so the bit-banged read) runs on; keep it off the motor task's core
+#ifndef STRAIN_ISR_CORE
+#define STRAIN_ISR_CORE 0
+#endif
+
+// One HX711 conversion as clocked out of the chip
+struct StrainSample
+{
+    uint32_t timestamp_us; // micros() when DOUT signalled the conversion was ready
+    uint32_t raw;          // 24-bit two's complement word, see hx711DecodeCounts()
+};
+
+// Interrupt-driven HX711 reader. The HX711 pulls DOUT low when a conversion is ready; the falling edge interrupt
+// clocks the 24 data bits (plus the gain selection pulses for the next conversion) out right away and pushes the
+// timestamped word into a ring buffer, so no task ever waits for the chip or bit-bangs with interrupts disabled.
+// The read takes ~60 us per conversion on STRAIN_ISR_CORE.
+//
+// One task consumes the samples with pop(); any task can look at the latest one, e.g. to average a few for
+// calibration while the consumer ignores them.
+class Hx711Reader
+{
+public:
+    // gain is 128 or 64 (channel A) or 32 (channel B). Samples start arriving right away; the first conversion
+    // after power up is at the chip's default gain and is dropped.
+    void begin(uint8_t dout_pin, uint8_t sck_pin, uint8_t gain);
+
+    // Next sample in order, false if there is none. Also recovers from a missed ready edge, so call it regularly.
+    // Only one task may pop().
+    bool pop(StrainSample &sample);
+
+    // Samples lost because the consumer fell behind, since the previous call
+    uint32_t takeDropped();
+
+    // Blocks until count new samples have arrived, for at most timeout_ms, and returns their average in raw
+    // counts. Returns false if the samples didn't arrive in time.
+    bool averageCounts(uint8_t count, uint32_t timeout_ms, float *average);
+
+    // SCK held high for more than 60 us powers the HX711 down
+    void powerDown();
+    void powerUp();
+    bool isPowered() const;
+
+private:
+    static void onDataReady(void *arg);
+    static void installInterrupt(void *arg);
+    void readSample();
+
+    static const uint32_t RING_SIZE = 32;
+
+    uint8_t dout_pin_ = 0;
+    uint8_t sck_pin_ = 0;
+    uint8_t gain_pulses_ = 1;
+
+    // Guards the clock line between the interrupt and powerDown()/powerUp() on other cores
+    portMUX_TYPE mux_ = portMUX_INITIALIZER_UNLOCKED;
+    std::atomic<bool> powered_{false};
+    uint8_t settle_samples_ = 0;
+
+    StrainSample ring_storage_[RING_SIZE] = {};
+    SpscRing<StrainSample> ring_;
+    SeqLock<StrainSample> latest_;
+};
@@ -0,0 +1,106 @@
+#include "press_detector.h"
+
+void PressDetector::configure(float press_level, float release_level, float threshold, uint32_t baseline_time_constant_ms)
+{
+    press_level_ = press_level;
+    release_level_ = release_level;
+    threshold_ = threshold;
+    baseline_time_constant_ms_ = baseline_time_constant_ms;
+}
+
+void PressDetector::reset()
+{
+    baseline_.reset();
+    cusum_ = 0;
+    pressed_ = false;
+    press_value_ = 0;
+}
+
+PressDetector::Edge PressDetector::addSample(float value, uint32_t timestamp_us)
+{
+    uint32_t dt_us = timestamp_us - last_us_;
+    last_us_ = timestamp_us;
+    if (!baseline_.hasValue())
+    {
+        baseline_.reset(value);
+        return Edge::NONE;
+    }
+
+    press_value_ = (value - baseline_.value()) / press_level_;
+
+    if (pressed_)
+    {
+        if (press_value_ < release_level_)
+        {
+            pressed_ = false;
+            return Edge::RELEASED;
+        }
+        return Edge::NONE;
+    }
+
+    // Each sample adds its excess over half a full press, so noise and drift below that never add up, while a
+    // press does within a few samples
+    float excess = press_value_ - 0.5f;
+    if (cusum_ == 0 && excess > 0)
+    {
+        onset_us_ = timestamp_us;
+    }
+    cusum_ += excess;
+    if (cusum_ >= threshold_)
+    {
+        cusum_ = 0;
+        pressed_ = true;
+        return Edge::PRESSED;
+    }
+    if (cusum_ <= 0)
+    {
+        cusum_ = 0;
+        // Only follow the signal while nothing is building up, so the start of a press doesn't lift the baseline
+        baseline_.add(value, Ewma::alphaFor(baseline_time_constant_ms_, dt_us / 1000.0f));
+    }
+    return Edge::NONE;
+}
+
+bool PressDetector::isPressed() const
+{
+    return pressed_;
+}
+
+float PressDetector::getPressValue() const
+{
+    return press_value_;
+}
+
+float PressDetector::getBaseline() const
+{
+    return baseline_.value();
+}
+
+float PressDetector::getThreshold() const
+{
+    return threshold_;
+}
+
+uint32_t PressDetector::getBaselineTimeConstantMs() const
+{
+    return baseline_time_constant_ms_;
+}
+
+uint32_t PressDetector::getOnsetUs() const
+{
+    return onset_us_;
+}
+
+void PressLatencyHistogram::add(uint32_t latency_us)
+{
+    uint32_t bucket = latency_us / BUCKET_US;
+    buckets[bucket < BUCKETS ? bucket : BUCKETS - 1]++;
+    count++;
+    max_us = latency_us > max_us ? latency_us : max_us;
+    total_us += latency_us;
+}
+
+void PressLatencyHistogram::clear()
+{
+    *this = {};
+}
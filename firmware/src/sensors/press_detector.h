@@ -0,0 +1,78 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "../filters.h"
+
+// CUSUM alarm level, in full presses summed over samples: a press of the full press level is detected on the
+// 2 * threshold-th sample above the baseline, a harder one sooner. Larger thresholds take longer to detect a press
+// but need a larger or longer disturbance to trigger a ghost one.
+#ifndef PRESS_CUSUM_THRESHOLD
+#define PRESS_CUSUM_THRESHOLD 1.5
+#endif
+
+// Time constant of the idle baseline following the strain gauge's drift
+#ifndef PRESS_BASELINE_TIME_CONSTANT_MS
+#define PRESS_BASELINE_TIME_CONSTANT_MS 5000
+#endif
+
+// Detects presses on the raw (unaveraged) strain signal. A slow baseline tracker follows the gauge's drift while
+// the knob is untouched, and a one-sided CUSUM on the signal above it catches the rise of a press within a sample
+// or two, instead of waiting for a moving average to settle over a fixed threshold. Hardware independent.
+class PressDetector
+{
+public:
+    enum class Edge
+    {
+        NONE,
+        PRESSED,
+        RELEASED,
+    };
+
+    // press_level is the signal over the baseline of a full press and release_level the fraction of it a press
+    // has to drop below to end; see PRESS_CUSUM_THRESHOLD and PRESS_BASELINE_TIME_CONSTANT_MS for the others
+    void configure(float press_level, float release_level, float threshold, uint32_t baseline_time_constant_ms);
+
+    // Forgets the baseline; the next sample starts a new one, as if the knob was untouched
+    void reset();
+
+    Edge addSample(float value, uint32_t timestamp_us);
+
+    bool isPressed() const;
+    // Signal over the baseline, in full presses
+    float getPressValue() const;
+    float getBaseline() const;
+    float getThreshold() const;
+    uint32_t getBaselineTimeConstantMs() const;
+    // Estimated start of the latest press: the first sample of the rise that set it off
+    uint32_t getOnsetUs() const;
+
+private:
+    float press_level_ = 1;
+    float release_level_ = 0.3;
+    float threshold_ = PRESS_CUSUM_THRESHOLD;
+    uint32_t baseline_time_constant_ms_ = PRESS_BASELINE_TIME_CONSTANT_MS;
+
+    Ewma baseline_;
+    uint32_t last_us_ = 0;
+    float cusum_ = 0;
+    bool pressed_ = false;
+    float press_value_ = 0;
+    uint32_t onset_us_ = 0;
+};
+
+// Onset-to-event latencies of detected presses
+struct PressLatencyHistogram
+{
+    static const uint8_t BUCKETS = 16;
+    static const uint32_t BUCKET_US = 5 * 1000;
+
+    // Latencies past the last bucket are counted in it
+    void add(uint32_t latency_us);
+    void clear();
+
+    uint32_t buckets[BUCKETS] = {};
+    uint32_t count = 0;
+    uint32_t max_us = 0;
+    uint64_t total_us = 0;
+};
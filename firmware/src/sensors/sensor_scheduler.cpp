@@ -0,0 +1,123 @@
+#include "sensor_scheduler.h"
+
+bool SensorScheduler::addJob(const char *name, uint32_t period_us, uint32_t deadline_us, Step step)
+{
+    if (job_count_ >= MAX_JOBS || period_us == 0)
+    {
+        return false;
+    }
+    Job &job = jobs_[job_count_];
+    job.name = name;
+    job.period_us = period_us;
+    job.deadline_us = deadline_us == 0 ? period_us : deadline_us;
+    job.step = step;
+    job.due_us = micros();
+    job.stats = {};
+    job_count_++;
+    return true;
+}
+
+uint32_t SensorScheduler::runDue(uint32_t now_us)
+{
+    // Each job due at now_us runs once, earliest deadline first; jobs that come due meanwhile wait for the next call
+    bool ran[MAX_JOBS] = {};
+    while (true)
+    {
+        int8_t next = -1;
+        for (uint8_t i = 0; i < job_count_; i++)
+        {
+            const Job &job = jobs_[i];
+            if (ran[i] || (int32_t)(now_us - job.due_us) < 0)
+            {
+                continue;
+            }
+            if (next < 0 || (int32_t)((job.due_us + job.deadline_us) - (jobs_[next].due_us + jobs_[next].deadline_us)) < 0)
+            {
+                next = i;
+            }
+        }
+        if (next < 0)
+        {
+            break;
+        }
+        ran[next] = true;
+        runJob(jobs_[next], micros());
+    }
+
+    uint32_t after_us = micros();
+    uint32_t wait_us = UINT32_MAX;
+    for (uint8_t i = 0; i < job_count_; i++)
+    {
+        int32_t until_due_us = (int32_t)(jobs_[i].due_us - after_us);
+        if (until_due_us <= 0)
+        {
+            return 0;
+        }
+        wait_us = min(wait_us, (uint32_t)until_due_us);
+    }
+    return wait_us;
+}
+
+void SensorScheduler::runJob(Job &job, uint32_t start_us)
+{
+    uint32_t lateness_us = start_us - job.due_us;
+    job.step();
+    uint32_t end_us = micros();
+    uint32_t run_us = end_us - start_us;
+    bool missed = end_us - job.due_us > job.deadline_us;
+
+    // Periods that already came due are skipped rather than run back to back to catch up
+    job.due_us += job.period_us;
+    uint32_t skipped = 0;
+    if ((int32_t)(end_us - job.due_us) >= 0)
+    {
+        skipped = (end_us - job.due_us) / job.period_us + 1;
+        job.due_us += skipped * job.period_us;
+    }
+
+    portENTER_CRITICAL(&stats_mux_);
+    job.stats.runs++;
+    job.stats.run_max_us = max(job.stats.run_max_us, run_us);
+    job.stats.run_total_us += run_us;
+    job.stats.lateness_max_us = max(job.stats.lateness_max_us, lateness_us);
+    job.stats.lateness_total_us += lateness_us;
+    job.stats.misses += missed ? 1 : 0;
+    job.stats.skipped += skipped;
+    portEXIT_CRITICAL(&stats_mux_);
+}
+
+PB_SensorSchedulerStats SensorScheduler::getStats()
+{
+    JobStats stats[MAX_JOBS];
+    portENTER_CRITICAL(&stats_mux_);
+    uint32_t window_ms = millis() - stats_window_start_ms_;
+    stats_window_start_ms_ = millis();
+    for (uint8_t i = 0; i < job_count_; i++)
+    {
+        stats[i] = jobs_[i].stats;
+        jobs_[i].stats = {};
+    }
+    portEXIT_CRITICAL(&stats_mux_);
+
+    PB_SensorSchedulerStats pb_stats = {};
+    pb_stats.window_ms = window_ms;
+    pb_stats.jobs_count = job_count_;
+    for (uint8_t i = 0; i < job_count_; i++)
+    {
+        PB_SensorJobStats &pb_job = pb_stats.jobs[i];
+        strlcpy(pb_job.name, jobs_[i].name, sizeof(pb_job.name));
+        pb_job.period_us = jobs_[i].period_us;
+        pb_job.deadline_us = jobs_[i].deadline_us;
+        pb_job.runs = stats[i].runs;
+        if (stats[i].runs > 0)
+        {
+            pb_job.run_avg_us = stats[i].run_total_us / stats[i].runs;
+            pb_job.run_max_us = stats[i].run_max_us;
+            pb_job.lateness_avg_us = stats[i].lateness_total_us / stats[i].runs;
+            pb_job.lateness_max_us = stats[i].lateness_max_us;
+        }
+        pb_job.misses = stats[i].misses;
+        pb_job.skipped = stats[i].skipped;
+    }
+    return pb_stats;
+}
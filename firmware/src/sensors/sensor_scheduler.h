@@ -0,0 +1,58 @@
+#pragma once
+
+#include <Arduino.h>
+#include <functional>
+
+#include "proto/proto_gen/smartknob.pb.h"
+
+// Cooperative scheduler for the sensors task. Each sensor is a job with a period and a step function that polls or
+// advances its device without blocking. Due jobs run earliest deadline first, so a slow job can only delay the
+// others by its own run time, and that shows up in the per-job statistics.
+class SensorScheduler
+{
+public:
+    static const uint8_t MAX_JOBS = 8;
+
+    typedef std::function<void()> Step;
+
+    // Adds a job that runs every period_us (not 0), starting right away, and should be done within deadline_us of
+    // being due (0 for its period). The task sleeps in whole ticks, so jobs start up to a tick late; short deadlines
+    // have to allow for that. name must outlive the scheduler. Returns false if there is no room left.
+    bool addJob(const char *name, uint32_t period_us, uint32_t deadline_us, Step step);
+
+    // Runs every job that is due at now_us once, and returns how long until the next one is due
+    uint32_t runDue(uint32_t now_us);
+
+    // Returns job timing since the previous call and starts a new window. Safe to call from any task.
+    PB_SensorSchedulerStats getStats();
+
+private:
+    struct JobStats
+    {
+        uint32_t runs;
+        uint32_t run_max_us;
+        uint64_t run_total_us;
+        uint32_t lateness_max_us;
+        uint64_t lateness_total_us;
+        uint32_t misses;
+        uint32_t skipped;
+    };
+
+    struct Job
+    {
+        const char *name;
+        uint32_t period_us;
+        uint32_t deadline_us;
+        Step step;
+        uint32_t due_us;
+        JobStats stats;
+    };
+
+    void runJob(Job &job, uint32_t start_us);
+
+    Job jobs_[MAX_JOBS];
+    uint8_t job_count_ = 0;
+
+    portMUX_TYPE stats_mux_ = portMUX_INITIALIZER_UNLOCKED;
+    uint32_t stats_window_start_ms_ = 0;
+};
@@ -1,6 +1,6 @@
 #include "sensors_task.h"
 #include "semaphore_guard.h"
-#include "util.h"
+#include "filters.h"
 
 // todo: think on thise compilation flags
 
@@ -10,6 +10,9 @@
 
 static const char *TAG = "sensors_task";
 
+// Fraction of a full press (PRESS_WEIGHT) a press has to drop below to be released
+static const float STRAIN_RELEASED = 0.3;
+
 SensorsTask::SensorsTask(const uint8_t task_core, Configuration *configuration) : Task{"Sensors", 1024 * 8, 0, task_core}, configuration_(configuration)
 {
     mutex_ = xSemaphoreCreateMutex();
@@ -36,14 +39,8 @@ void SensorsTask::run()
     Adafruit_VL53L0X lox = Adafruit_VL53L0X();
 
 #if SK_STRAIN
-    strain.begin(PIN_STRAIN_DO, PIN_STRAIN_SCK);
-    while (!strain.is_ready())
-    {
-        LOGV(LOG_LEVEL_DEBUG, "Strain sensor not ready, waiting...");
-        delay(100);
-    }
     // UPDATE: 2021-09-15: scale is set to larger range because of inbalance in the strain sensor.
-    strain.set_gain(64);
+    strain.begin(PIN_STRAIN_DO, PIN_STRAIN_SCK, 64);
     if (configuration_->get().strain_scale == 0)
     {
         calibration_scale_ = 1.0f;
@@ -53,22 +50,15 @@ void SensorsTask::run()
         calibration_scale_ = configuration_->get().strain_scale;
     }
     LOGV(LOG_LEVEL_DEBUG, "Strain scale set at boot, %f", calibration_scale_);
-    strain.set_scale(calibration_scale_);
-    delay(100);
-    strain.set_offset(0);
-    strain.tare();
-    delay(100);
-
-    strain_powered = true;
-    raw_initial_value_ = strain.get_units(10);
+    strain_filter_.setScale(calibration_scale_);
+    strain_filter_.setOffset(0);
+    strain_filter_.reset();
+    press_detector_.configure(PRESS_WEIGHT, STRAIN_RELEASED, PRESS_CUSUM_THRESHOLD, PRESS_BASELINE_TIME_CONSTANT_MS);
 #endif
 
 #if SK_ALS
     Adafruit_VEML7700 veml = Adafruit_VEML7700();
     float luminosity_adjustment = 1.00;
-    const float LUX_ALPHA = 0.005;
-
-    float sum = 0.0;
     float lux_avg;
     float lux = 0.0;
 
@@ -84,264 +74,282 @@ void SensorsTask::run()
 
     delay(1000); // Wait for VEML7700 to boot 500ms seems to not be enough...
     lux = veml.readLux();
-    MovingAverage lux_filter(10);
-    for (uint8_t i = 0; i < 10; i++)
-    {
-        lux_filter.addSample(lux);
-    }
+    // Ambient light changes slowly; a hand passing over the sensor or a flickering lamp only lasts a reading or two,
+    // which the median drops instead of dimming the display for them
+    MedianFilter<float, 5> lux_filter;
+    lux_filter.add(lux);
 #endif
+    // The VL53L0X ranges on its own at PROXIMITY_PERIOD_MS; the loop only checks whether a result is waiting, so
+    // it never sits out an integration time
+    bool proximity_ranging = false;
     if (lox.begin())
     {
-        VL53L0X_RangingMeasurementData_t measure;
-        lox.rangingTest(&measure, false);
-        LOGV(LOG_LEVEL_DEBUG, "Proximity range %d, distance %dmm", measure.RangeStatus, measure.RangeMilliMeter);
+        proximity_ranging = lox.setMeasurementTimingBudgetMicroSeconds(PROXIMITY_TIMING_BUDGET_US) &&
+                            lox.startRangeContinuous(PROXIMITY_PERIOD_MS);
+        LOGV(LOG_LEVEL_DEBUG, "Proximity ranging every %dms, timing budget %dus", PROXIMITY_PERIOD_MS, PROXIMITY_TIMING_BUDGET_US);
     }
-    else
+    if (!proximity_ranging)
     {
         LOGE("Failed to boot VL53L0X");
     }
 
-    VL53L0X_RangingMeasurementData_t measure;
-    lox.rangingTest(&measure, false);
     unsigned long last_proximity_check_ms = 0;
-    unsigned long last_strain_check_ms = 0;
-    unsigned long last_tare_ms = 0;
-    unsigned long last_illumination_check_ms = 0;
+    unsigned long last_strain_sample_ms = 0;
 
     unsigned long log_ms_calib = 10000;
 
-    unsigned long log_ms = 0;
     unsigned long log_ms_strain = 0;
 
-    const uint8_t proximity_poling_rate_hz = 20;
-    const uint8_t strain_poling_rate_hz = 120;
-    const uint8_t illumination_poling_rate_hz = 1;
-
-    // How far button is pressed, in range [0, 1]
-    float press_value_unit = 0;
-    float strain_reading_raw = 0;
+    // No result is due before this; checking earlier would only cost I2C traffic
+    const unsigned long proximity_interval_ms = max(PROXIMITY_PERIOD_MS, PROXIMITY_TIMING_BUDGET_US / 1000);
 
     char buf_[128];
 
-    // strain sensor and buttons
-    unsigned long short_pressed_triggered_at_ms = 0;
-    const unsigned long long_press_timeout_ms = 500;
+    // strain sensor and buttons, timed by when the samples were taken
+    StrainSample strain_sample;
+    uint32_t short_pressed_triggered_at_us = 0;
+    const uint32_t long_press_timeout_us = 500 * 1000;
 
-    // strain breaking points
-    const float strain_released = 0.3;
-    const float strain_pressed = 1.0;
 
-    // strain value filtering
-    double strain_filtered;
-    MovingAverage strain_filter(10);
-
-    // system temperature
-    long last_system_temperature_check = 0;
+    // system temperature, read every second; the on-die sensor jitters by about a degree, so it is averaged over
+    // ~10 s
     float last_system_temperature = 0;
+    Ewma temperature_filter(Ewma::alphaFor(10, 1));
 
-    uint8_t discarded_strain_reading_count = 0;
+    // Valid ranges are smoothed while the hand holds still, but followed closely while it approaches, so presence
+    // isn't detected any later
+    OneEuroFilter proximity_filter(1, 0.05, 1);
 
-    while (1)
+    // Every sensor is a job stepped by the scheduler below; none of them may block
+    auto readTemperature = [&]()
     {
-        if (millis() - last_system_temperature_check > 1000)
-        {
-            temp_sensor_read_celsius(&last_system_temperature);
+        temp_sensor_read_celsius(&last_system_temperature);
+
+        sensors_state.system.esp32_temperature = temperature_filter.add(last_system_temperature);
+    };
 
-            sensors_state.system.esp32_temperature = last_system_temperature;
+    auto pollProximity = [&]()
+    {
+        if (millis() - last_proximity_check_ms < proximity_interval_ms || !lox.isRangeComplete())
+        {
+            return;
+        }
+        // Reading the result also clears the data-ready flag for the next one
+        uint16_t range_mm = lox.readRangeResult();
+        uint8_t range_status = lox.readRangeStatus();
+        uint32_t measured_at_us = micros();
 
-            last_system_temperature_check = millis();
+        // Same cut as the root task's presence check; statuses from 3 up are out of range or failed measurements
+        if (range_status < 3)
+        {
+            range_mm = (uint16_t)lroundf(proximity_filter.add(range_mm, measured_at_us));
+        }
+        else
+        {
+            // Start over from the next usable one
+            proximity_filter.reset();
         }
 
-        if (millis() - last_proximity_check_ms > 1000 / proximity_poling_rate_hz)
+        sensors_state.proximity.RangeMilliMeter = range_mm - PROXIMITY_SENSOR_OFFSET_MM;
+        sensors_state.proximity.RangeStatus = range_status;
+        sensors_state.proximity.measured_at_us = measured_at_us;
+        // todo: call this once per tick
+        publishState(sensors_state);
+        last_proximity_check_ms = millis();
+    };
+
+#if SK_STRAIN
+    auto pollStrain = [&]()
+    {
+        if (strain_reset_requested_.exchange(false))
         {
+            strain_filter_.reset();
+        }
 
-            lox.rangingTest(&measure, false);
+        uint32_t press_config_posted_us;
+        const PB_PressDetectorConfig *press_config = press_config_mailbox_.take(press_config_posted_us);
+        if (press_config != nullptr)
+        {
+            press_detector_.configure(PRESS_WEIGHT, STRAIN_RELEASED,
+                                      press_config->threshold > 0 ? press_config->threshold : PRESS_CUSUM_THRESHOLD,
+                                      press_config->baseline_time_constant_ms > 0 ? press_config->baseline_time_constant_ms : PRESS_BASELINE_TIME_CONSTANT_MS);
+            LOGI("Press detector threshold %.2f, baseline time constant %dms", press_detector_.getThreshold(), (int)press_detector_.getBaselineTimeConstantMs());
+        }
 
-            sensors_state.proximity.RangeMilliMeter = measure.RangeMilliMeter - PROXIMITY_SENSOR_OFFSET_MM;
-            sensors_state.proximity.RangeStatus = measure.RangeStatus;
-            // todo: call this once per tick
-            publishState(sensors_state);
-            last_proximity_check_ms = millis();
+        uint32_t dropped_strain_samples = strain.takeDropped();
+        if (dropped_strain_samples > 0)
+        {
+            LOGV(LOG_LEVEL_WARNING, "Dropped %d strain samples.", (int)dropped_strain_samples);
         }
-#if SK_STRAIN
-        if (millis() - last_strain_check_ms > 1000 / strain_poling_rate_hz)
+
+        // Samples come in from the HX711 interrupt on the other core; take everything that arrived since last time
+        while (strain.pop(strain_sample))
         {
-            if (strain_powered && strain.wait_ready_timeout(100))
+            last_strain_sample_ms = millis();
+
+            if (calibration_scale_ == 1.0f && strain_filter_.getScale() == 1.0f && factory_strain_calibration_step_ == 0)
             {
-                if (calibration_scale_ == 1.0f && strain.get_scale() == 1.0f && factory_strain_calibration_step_ == 0)
+                if (millis() - log_ms_calib > 10000)
                 {
-                    if (millis() - log_ms_calib > 10000)
-                    {
-                        LOGW("Strain sensor needs Factory Calibration, press 'Y' to begin!");
-                        log_ms_calib = millis();
-                    }
-                    do_strain = false;
-                }
-                else if (weight_measurement_step_ != 0 || factory_strain_calibration_step_ != 0)
-                {
-                    delay(1);
-                    do_strain = false;
+                    LOGW("Strain sensor needs Factory Calibration, press 'Y' to begin!");
+                    log_ms_calib = millis();
                 }
+                continue;
+            }
+            if (weight_measurement_step_ != 0 || factory_strain_calibration_step_ != 0)
+            {
+                // The calibration reads the sensor itself
+                continue;
+            }
 
-                if (do_strain)
-                {
+            int32_t strain_counts = hx711DecodeCounts(strain_sample.raw);
+            StrainSampleStatus strain_status = strain_filter_.addSample(strain_counts);
+            if (strain_status == StrainSampleStatus::RESET_NEEDED)
+            {
+                LOGV(LOG_LEVEL_WARNING, "Resetting strain sensor. 20 consecutive readings discarded.");
+                strain.powerDown();
+                delayMicroseconds(100);
+                strain.powerUp();
+                strain_filter_.reset();
+                continue;
+            }
+            if (strain_status == StrainSampleStatus::DISCARDED)
+            {
+                // LOGW("Discarding strain reading, too big difference from last reading.");
+                LOGV(LOG_LEVEL_WARNING, "Current raw strain reading: %f", strain_filter_.toUnits(strain_counts));
+                continue;
+            }
+            if (strain_status == StrainSampleStatus::TARING)
+            {
+                // The offset is about to jump; start the baseline over after it
+                press_detector_.reset();
+                continue;
+            }
 
-                    strain_reading_raw = strain.get_units(1);
+            sensors_state.strain.raw_value = strain_filter_.getValue();
 
-                    if (abs(last_strain_reading_raw_ - strain_reading_raw) > 2000)
-                    {
-                        discarded_strain_reading_count++;
-                        if (discarded_strain_reading_count > 20)
-                        {
-                            LOGV(LOG_LEVEL_WARNING, "Resetting strain sensor. 20 consecutive readings discarded.");
-                            strain.power_down();
-                            delay(100);
-                            strain.power_up();
-                            delay(100);
-                            strain.set_offset(0);
-                            strain.tare();
-                            delay(100);
-                            discarded_strain_reading_count = 0;
-                        }
-
-                        // LOGW("Discarding strain reading, too big difference from last reading.");
-                        LOGV(LOG_LEVEL_WARNING, "Current raw strain reading: %f", strain_reading_raw);
-                        LOGV(LOG_LEVEL_WARNING, "Last raw strain reading: %f", last_strain_reading_raw_);
-                    }
-                    else
+            // LOGD("Strain raw reading: %f", sensors_state.strain.raw_value);
+
+            // Each sample goes to the detector as is; the window average above would delay the press by half a window
+            PressDetector::Edge press_edge = press_detector_.addSample(strain_filter_.toUnits(strain_counts), strain_sample.timestamp_us);
+            sensors_state.strain.press_value = press_detector_.getPressValue();
+
+            if (!press_detector_.isPressed())
+            {
+                // released
+                switch (sensors_state.strain.virtual_button_code)
+                {
+                case VIRTUAL_BUTTON_SHORT_PRESSED:
+                    short_pressed_triggered_at_us = 0;
+                    sensors_state.strain.virtual_button_code = VIRTUAL_BUTTON_SHORT_RELEASED;
+                    break;
+                case VIRTUAL_BUTTON_LONG_PRESSED:
+                    short_pressed_triggered_at_us = 0;
+                    sensors_state.strain.virtual_button_code = VIRTUAL_BUTTON_LONG_RELEASED;
+                    break;
+                default:
+                    short_pressed_triggered_at_us = 0;
+                    sensors_state.strain.virtual_button_code = VIRTUAL_BUTTON_IDLE;
+                    break;
+                }
+            }
+            else
+            {
+                switch (sensors_state.strain.virtual_button_code)
+                {
+                case VIRTUAL_BUTTON_SHORT_PRESSED:
+                    if (short_pressed_triggered_at_us > 0 && strain_sample.timestamp_us - short_pressed_triggered_at_us > long_press_timeout_us)
                     {
-                        discarded_strain_reading_count = 0;
-                        sensors_state.strain.raw_value = strain_filter.addSample(strain_reading_raw);
-
-                        // LOGD("Strain raw reading: %f", sensors_state.strain.raw_value);
-
-                        // TODO: calibrate and track (long term moving average) idle point (lower)
-                        sensors_state.strain.press_value = lerp(sensors_state.strain.raw_value, 0, PRESS_WEIGHT, 0, 1);
-
-                        if (sensors_state.strain.press_value < strain_released)
-                        {
-                            // released
-                            switch (sensors_state.strain.virtual_button_code)
-                            {
-                            case VIRTUAL_BUTTON_SHORT_PRESSED:
-                                short_pressed_triggered_at_ms = 0;
-                                sensors_state.strain.virtual_button_code = VIRTUAL_BUTTON_SHORT_RELEASED;
-                                break;
-                            case VIRTUAL_BUTTON_LONG_PRESSED:
-                                short_pressed_triggered_at_ms = 0;
-                                sensors_state.strain.virtual_button_code = VIRTUAL_BUTTON_LONG_RELEASED;
-                                break;
-                            default:
-                                short_pressed_triggered_at_ms = 0;
-                                sensors_state.strain.virtual_button_code = VIRTUAL_BUTTON_IDLE;
-                                delay(20);
-                                break;
-                            }
-                        }
-                        else if (strain_released < sensors_state.strain.press_value && sensors_state.strain.press_value < strain_pressed)
-                        {
-                            switch (sensors_state.strain.virtual_button_code)
-                            {
-
-                            case VIRTUAL_BUTTON_SHORT_PRESSED:
-                                if (short_pressed_triggered_at_ms > 0 && millis() - short_pressed_triggered_at_ms > long_press_timeout_ms)
-                                {
-                                    sensors_state.strain.virtual_button_code = VIRTUAL_BUTTON_LONG_PRESSED;
-                                }
-                                break;
-
-                            default:
-                                break;
-                            }
-                        }
-                        else if (sensors_state.strain.press_value > strain_pressed)
-                        {
-
-                            switch (sensors_state.strain.virtual_button_code)
-                            {
-                            case VIRTUAL_BUTTON_IDLE:
-                                LOGV(LOG_LEVEL_DEBUG, "Strain sensor short press.");
-                                LOGV(LOG_LEVEL_DEBUG, "Press value: %f", sensors_state.strain.press_value);
-                                LOGV(LOG_LEVEL_DEBUG, "Raw value: %f", sensors_state.strain.raw_value);
-                                LOGV(LOG_LEVEL_DEBUG, "Last press value: %f", last_press_value_);
-                                sensors_state.strain.virtual_button_code = VIRTUAL_BUTTON_SHORT_PRESSED;
-                                short_pressed_triggered_at_ms = millis();
-                                break;
-                            case VIRTUAL_BUTTON_SHORT_PRESSED:
-                                if (short_pressed_triggered_at_ms > 0 && millis() - short_pressed_triggered_at_ms > long_press_timeout_ms)
-                                {
-                                    sensors_state.strain.virtual_button_code = VIRTUAL_BUTTON_LONG_PRESSED;
-                                }
-                                break;
-                            default:
-                                break;
-                            }
-                        }
-
-                        publishState(sensors_state);
-
-                        if (sensors_state.strain.virtual_button_code == VIRTUAL_BUTTON_IDLE && millis() - short_pressed_triggered_at_ms > 100 && press_value_unit < strain_released && 0.025 < abs(sensors_state.strain.press_value - last_press_value_) < 0.1 && millis() - last_tare_ms > 10000)
-                        {
-                            LOGV(LOG_LEVEL_DEBUG, "Strain sensor tare.");
-                            strain.tare();
-                            last_tare_ms = millis();
-                        }
-
-                        last_strain_reading_raw_ = strain_reading_raw;
-                        last_press_value_ = sensors_state.strain.press_value;
-                        last_strain_check_ms = millis();
+                        sensors_state.strain.virtual_button_code = VIRTUAL_BUTTON_LONG_PRESSED;
                     }
+                    break;
+                case VIRTUAL_BUTTON_LONG_PRESSED:
+                    break;
+                default:
+                    LOGV(LOG_LEVEL_DEBUG, "Strain sensor short press.");
+                    LOGV(LOG_LEVEL_DEBUG, "Press value: %f", sensors_state.strain.press_value);
+                    LOGV(LOG_LEVEL_DEBUG, "Raw value: %f", sensors_state.strain.raw_value);
+                    LOGV(LOG_LEVEL_DEBUG, "Last press value: %f", last_press_value_);
+                    sensors_state.strain.virtual_button_code = VIRTUAL_BUTTON_SHORT_PRESSED;
+                    short_pressed_triggered_at_us = strain_sample.timestamp_us;
+                    break;
                 }
+            }
 
-                do_strain = true;
+            publishState(sensors_state);
+
+            if (press_edge == PressDetector::Edge::PRESSED)
+            {
+                uint32_t latency_us = micros() - press_detector_.getOnsetUs();
+                portENTER_CRITICAL(&press_stats_mux_);
+                press_latency_.add(latency_us);
+                portEXIT_CRITICAL(&press_stats_mux_);
+            }
+
+            last_press_value_ = sensors_state.strain.press_value;
+        }
+
+        if (millis() - last_strain_sample_ms > 1000 && millis() - log_ms_strain > 4000)
+        {
+            if (strain.isPowered())
+            {
+                LOGV(LOG_LEVEL_DEBUG, "Strain sensor not ready, waiting...");
             }
             else
             {
-                if (do_strain && strain_powered && millis() - log_ms_strain > 4000)
-                {
-                    LOGV(LOG_LEVEL_DEBUG, "Strain sensor not ready, waiting...");
-                    log_ms_strain = millis();
-                }
-                else if (millis() - log_ms_strain > 4000)
-                {
-                    LOGV(LOG_LEVEL_DEBUG, "Strain sensor is disabled. (Might be because of factory calib or its powered off because no engagement of knob)");
-                    log_ms_strain = millis();
-                }
+                LOGV(LOG_LEVEL_DEBUG, "Strain sensor is disabled. (Might be because of factory calib or its powered off because no engagement of knob)");
             }
+            log_ms_strain = millis();
         }
+    };
 #endif
 
 #if SK_ALS
-        if (millis() - last_illumination_check_ms > 1000 / illumination_poling_rate_hz)
-        {
-
-            lux = veml.readLux();
+    auto readIllumination = [&]()
+    {
+        lux = veml.readLux();
 
-            lux_avg = lux_filter.addSample(lux);
+        lux_avg = lux_filter.add(lux);
 
-            luminosity_adjustment = min(1.0f, lux_avg);
+        luminosity_adjustment = min(1.0f, lux_avg);
 
-            sensors_state.illumination.lux = lux;
-            sensors_state.illumination.lux_avg = lux_avg;
-            sensors_state.illumination.lux_adj = luminosity_adjustment;
+        sensors_state.illumination.lux = lux;
+        sensors_state.illumination.lux_avg = lux_avg;
+        sensors_state.illumination.lux_adj = luminosity_adjustment;
+    };
+#endif
 
-            last_illumination_check_ms = millis();
-        }
+    auto logSensors = [&]()
+    {
+        LOGV(LOG_LEVEL_DEBUG, "System temp %0.2f °C, avg %0.2f °C", last_system_temperature, sensors_state.system.esp32_temperature);
+        LOGV(LOG_LEVEL_DEBUG, "Proximity sensor:  range %d, distance %dmm", sensors_state.proximity.RangeStatus, sensors_state.proximity.RangeMilliMeter);
+#if SK_STRAIN
+        LOGV(LOG_LEVEL_DEBUG, "Strain: reading:\n        Virtual button code: %d\n        Strain value: %f\n        Press value: %f", sensors_state.strain.virtual_button_code, sensors_state.strain.raw_value, sensors_state.strain.press_value);
+#endif
+#if SK_ALS
+        LOGV(LOG_LEVEL_DEBUG, "Illumination sensor: millilux: %.2f, avg %.2f, adj %.2f", lux * 1000, lux_avg * 1000, luminosity_adjustment);
 #endif
+    };
 
-        if (millis() - log_ms > 1000)
-        {
-            LOGV(LOG_LEVEL_DEBUG, "System temp %0.2f °C", last_system_temperature);
-            LOGV(LOG_LEVEL_DEBUG, "Proximity sensor:  range %d, distance %dmm", measure.RangeStatus, measure.RangeMilliMeter);
+    scheduler_.addJob("temperature", 1000 * 1000, 0, readTemperature);
+    if (proximity_ranging)
+    {
+        scheduler_.addJob("proximity", 5 * 1000, 0, pollProximity);
+    }
 #if SK_STRAIN
-            LOGV(LOG_LEVEL_DEBUG, "Strain: reading:\n        Virtual button code: %d\n        Strain value: %f\n        Press value: %f", sensors_state.strain.virtual_button_code, sensors_state.strain.raw_value, press_value_unit);
+    // Drains the HX711 ring; the extra millisecond of deadline is the tick the task may sleep past the due time
+    scheduler_.addJob("strain", 1000, 2 * 1000, pollStrain);
 #endif
 #if SK_ALS
-            LOGV(LOG_LEVEL_DEBUG, "Illumination sensor: millilux: %.2f, avg %.2f, adj %.2f", lux * 1000, lux_avg * 1000, luminosity_adjustment);
+    scheduler_.addJob("illumination", 1000 * 1000, 0, readIllumination);
 #endif
-            log_ms = millis();
-        }
-        delay(1);
+    scheduler_.addJob("log", 1000 * 1000, 0, logSensors);
+
+    while (1)
+    {
+        uint32_t idle_us = scheduler_.runDue(micros());
+        // Sleep at least a tick, so the lower priority tasks on this core get to run
+        delay(max(1UL, (unsigned long)(idle_us / 1000)));
     }
 }
 
@@ -361,14 +369,10 @@ void SensorsTask::factoryStrainCalibrationCallback(float calibration_weight)
 
         delay(200);
 
-        strain.set_scale();
-        delay(200);
-
-        strain.set_offset(0);
-        strain.tare();
-        delay(200);
+        strain_filter_.setScale(1.0f);
+        strain_filter_.setOffset(readStrainCounts(10));
 
-        raw_initial_value_ = strain.get_units(10);
+        raw_initial_value_ = readStrainUnits(10);
 
         LOGI("Place calibration weight on the knob and press 'Y' again");
 
@@ -380,7 +384,7 @@ void SensorsTask::factoryStrainCalibrationCallback(float calibration_weight)
     float calibration_scale_validation[3];
 
     LOGI("Factory strain calibration step 2, try: %d", factory_strain_calibration_step_);
-    float raw_value = strain.get_units(10);
+    float raw_value = readStrainUnits(10);
 
     LOGD("Raw value: %0.2f", raw_value);
     LOGD("Raw initial value: %0.2f", raw_initial_value_);
@@ -397,11 +401,8 @@ void SensorsTask::factoryStrainCalibrationCallback(float calibration_weight)
             calibration_scale_ = configuration_->get().strain_scale;
         }
         LOGV(LOG_LEVEL_DEBUG, "Strain scale set at boot, %f", calibration_scale_);
-        strain.set_scale(calibration_scale_);
-        delay(100);
-        strain.set_offset(0);
-        strain.tare();
-        delay(100);
+        strain_filter_.setScale(calibration_scale_);
+        strain_reset_requested_ = true;
 
         factory_strain_calibration_step_ = 0;
         return;
@@ -411,15 +412,13 @@ void SensorsTask::factoryStrainCalibrationCallback(float calibration_weight)
 
     for (size_t i = 0; i < 3; i++)
     {
-        strain.set_scale();
-        delay(100);
-        raw_value = strain.get_units(10);
+        strain_filter_.setScale(1.0f);
+        raw_value = readStrainUnits(10);
         LOGD("Raw value during calibration: %0.2f", raw_value);
         calibration_scale_ = raw_value / calibration_weight;
 
-        strain.set_scale(calibration_scale_);
-        delay(200);
-        float calibrated_weight = strain.get_units(10);
+        strain_filter_.setScale(calibration_scale_);
+        float calibrated_weight = readStrainUnits(10);
 
         while (abs(calibrated_weight - calibration_weight) > 20)
         {
@@ -427,7 +426,7 @@ void SensorsTask::factoryStrainCalibrationCallback(float calibration_weight)
             {
                 LOGE("Calibrated weight is more than 100g off from the calibration weight. Restart calibration by pressing 'Y' again.");
                 delay(2000);
-                strain.set_scale(1.0f);
+                strain_filter_.setScale(1.0f);
                 calibration_scale_ = 1.0f;
                 factory_strain_calibration_step_ = 0;
                 return;
@@ -442,16 +441,15 @@ void SensorsTask::factoryStrainCalibrationCallback(float calibration_weight)
                 calibration_scale_ += abs((calibrated_weight - calibration_weight));
             }
 
-            strain.set_scale(calibration_scale_);
-            delay(200);
-            calibrated_weight = strain.get_units(10);
+            strain_filter_.setScale(calibration_scale_);
+            calibrated_weight = readStrainUnits(10);
             LOGD("Measured weight during calibration: %0.2fg", calibrated_weight); // MAKE VERBOSE LATER
         }
         LOGD("Validation run %d, result: %0.2fg", i + 1, calibrated_weight);
         calibration_scale_validation[i] = calibration_scale_;
     }
 
-    strain.set_scale((calibration_scale_validation[0] + calibration_scale_validation[1] + calibration_scale_validation[2]) / 3.0f);
+    strain_filter_.setScale((calibration_scale_validation[0] + calibration_scale_validation[1] + calibration_scale_validation[2]) / 3.0f);
 
     configuration_->saveFactoryStrainCalibration((calibration_scale_validation[0] + calibration_scale_validation[1] + calibration_scale_validation[2]) / 3.0f);
 
@@ -460,13 +458,12 @@ void SensorsTask::factoryStrainCalibrationCallback(float calibration_weight)
     for (size_t i = 0; i < 3; i++)
     {
         delay(1000);
-        LOGD("Verify calibrated weight: %0.0fg", strain.get_units(10));
+        LOGD("Verify calibrated weight: %0.0fg", readStrainUnits(10));
     }
     LOGI("\nRemove calibration weight.\n");
     delay(8000);
     LOGI("Factory strain calibration complete!");
-    strain.set_offset(0);
-    strain.tare();
+    strain_reset_requested_ = true;
     factory_strain_calibration_step_ = 0;
 }
 
@@ -477,20 +474,37 @@ void SensorsTask::weightMeasurementCallback()
         weight_measurement_step_ = 1;
         LOGI("Weight measurement step 1: Place weight on KNOB and press 'w' again");
         delay(1000);
-        strain.set_offset(0);
-        strain.tare();
+        strain_filter_.setOffset(readStrainCounts(10));
     }
     else if (weight_measurement_step_ == 1)
     {
-        LOGD("Measured weight: %0.0fg", strain.get_units(10));
+        LOGD("Measured weight: %0.0fg", readStrainUnits(10));
+        strain_reset_requested_ = true;
         weight_measurement_step_ = 0;
     }
 }
 
+float SensorsTask::readStrainCounts(uint8_t times)
+{
+    // A conversion takes 100 ms at the HX711's slow rate
+    float counts;
+    if (!strain.averageCounts(times, times * 100 + 500, &counts))
+    {
+        LOGE("Strain sensor not ready!!!");
+        return strain_filter_.getOffset();
+    }
+    return counts;
+}
+
+float SensorsTask::readStrainUnits(uint8_t times)
+{
+    return strain_filter_.toUnits(readStrainCounts(times));
+}
+
 bool SensorsTask::powerDownAllowed()
 {
     // If strain sensor isnt calibrated dont allow power down.
-    if (calibration_scale_ == 1.0f && strain.get_scale() == 1.0f)
+    if (calibration_scale_ == 1.0f && strain_filter_.getScale() == 1.0f)
     {
         return false;
     }
@@ -512,37 +526,67 @@ void SensorsTask::strainPowerDown()
         return;
     }
 
-    if (strain.wait_ready_timeout(10)) // Make sure sensor is on before powering down.
+    if (strain.isPowered())
     {
         LOGV(LOG_LEVEL_DEBUG, "Strain sensor power down.");
 
-        strain_powered = false;
-        strain.power_down();
+        strain.powerDown();
     }
 }
 
-void SensorsTask::strainPowerUp() // Delays caused a perceived delay in the activation of strain.
+void SensorsTask::strainPowerUp()
 {
-    if (!strain.wait_ready_timeout(10)) // Make sure sensor is off before powering up.
+    if (!strain.isPowered())
     {
         LOGV(LOG_LEVEL_DEBUG, "Strain sensor power up.");
 
-        strain.power_up();
-        if (strain.wait_ready_timeout(500))
-        {
-            strain.set_offset(0);
-            strain.tare();
-            last_strain_reading_raw_ = strain.get_units(10);
-            strain_powered = true;
-        }
-        else
-        {
-            LOGE("Strain sensor not ready after power up!!!");
-        }
+        // Samples resume on their own; the sensors task tares on the first few
+        strain.powerUp();
+        strain_reset_requested_ = true;
     }
 }
 #endif
 
+#if SK_STRAIN
+void SensorsTask::configurePressDetector(const PB_PressDetectorConfig &config)
+{
+    press_config_mailbox_.post(config, micros());
+}
+
+PB_PressDetectorStats SensorsTask::getPressDetectorStats()
+{
+    portENTER_CRITICAL(&press_stats_mux_);
+    PressLatencyHistogram latency = press_latency_;
+    press_latency_.clear();
+    uint32_t window_ms = millis() - press_stats_window_start_ms_;
+    press_stats_window_start_ms_ = millis();
+    portEXIT_CRITICAL(&press_stats_mux_);
+
+    PB_PressDetectorStats stats = {};
+    stats.presses = latency.count;
+    stats.bucket_us = PressLatencyHistogram::BUCKET_US;
+    stats.latency_histogram_count = PressLatencyHistogram::BUCKETS;
+    for (uint8_t i = 0; i < PressLatencyHistogram::BUCKETS; i++)
+    {
+        stats.latency_histogram[i] = latency.buckets[i];
+    }
+    if (latency.count > 0)
+    {
+        stats.latency_avg_us = latency.total_us / latency.count;
+        stats.latency_max_us = latency.max_us;
+    }
+    stats.threshold = press_detector_.getThreshold();
+    stats.baseline_time_constant_ms = press_detector_.getBaselineTimeConstantMs();
+    stats.window_ms = window_ms;
+    return stats;
+}
+#endif
+
+PB_SensorSchedulerStats SensorsTask::getSchedulerStats()
+{
+    return scheduler_.getStats();
+}
+
 void SensorsTask::addStateListener(QueueHandle_t queue)
 {
     state_listeners_.push_back(queue);
@@ -4,17 +4,34 @@
 #include "app_config.h"
 #include "configuration.h"
 #include "events/events.h"
+#include "sensor_scheduler.h"
+#include <atomic>
 #include <vector>
 #include <Adafruit_VL53L0X.h>
 
 #if SK_STRAIN
-#include <HX711.h>
+#include "hx711_reader.h"
+#include "press_detector.h"
+#include "strain_filter.h"
 #endif
 
+#include "../mailbox.h"
+
 #include "driver/temp_sensor.h"
 
 const uint16_t PROXIMITY_SENSOR_OFFSET_MM = 10;
 
+// Time between VL53L0X ranging measurements; 0 ranges back to back
+#ifndef PROXIMITY_PERIOD_MS
+#define PROXIMITY_PERIOD_MS 50
+#endif
+
+// Integration time of each measurement. Longer is more accurate and reaches further; it no longer holds up the
+// other sensors, but must fit in PROXIMITY_PERIOD_MS to keep that rate.
+#ifndef PROXIMITY_TIMING_BUDGET_US
+#define PROXIMITY_TIMING_BUDGET_US 33000
+#endif
+
 class SensorsTask : public Task<SensorsTask>
 {
     friend class Task<SensorsTask>; // Allow base Task to invoke protected run()
@@ -35,6 +52,14 @@ public:
     void strainPowerDown();
     void strainPowerUp();
 
+    // Returns the sensor jobs' timing since the previous call and starts a new window
+    PB_SensorSchedulerStats getSchedulerStats();
+
+    // Safe to call from any task
+    void configurePressDetector(const PB_PressDetectorConfig &config);
+    // Returns the presses since the previous call and starts a new window
+    PB_PressDetectorStats getPressDetectorStats();
+
 protected:
     void run();
 
@@ -42,17 +67,28 @@ private:
     SensorsState sensors_state = {};
     QueueHandle_t sensors_state_queue_;
 
-    bool do_strain = false;
-    bool strain_powered = false;
-
     QueueHandle_t shared_events_queue;
 
     std::vector<QueueHandle_t> state_listeners_;
 
     SemaphoreHandle_t mutex_;
+    SensorScheduler scheduler_;
     void publishState(const SensorsState &state);
 #if SK_STRAIN
-    HX711 strain;
+    Hx711Reader strain;
+    // Only touched by the sensors task, except while a calibration holds it off
+    StrainFilter strain_filter_;
+    // Set by other tasks to have the sensors task start the filter over and re-tare
+    std::atomic<bool> strain_reset_requested_{false};
+
+    PressDetector press_detector_;
+    Mailbox<PB_PressDetectorConfig> press_config_mailbox_;
+    portMUX_TYPE press_stats_mux_ = portMUX_INITIALIZER_UNLOCKED;
+    PressLatencyHistogram press_latency_;
+    uint32_t press_stats_window_start_ms_ = 0;
+
+    float readStrainCounts(uint8_t times);
+    float readStrainUnits(uint8_t times);
 #endif
 
     Configuration *configuration_;
@@ -61,7 +97,6 @@ private:
     uint8_t weight_measurement_step_ = 0;
 
     float last_press_value_ = 0;
-    float last_strain_reading_raw_ = 0;
 
     float raw_initial_value_ = 0;
 
@@ -0,0 +1,94 @@
+#include "strain_filter.h"
+
+#include <math.h>
+
+int32_t hx711DecodeCounts(uint32_t raw)
+{
+    raw &= 0xFFFFFF;
+    if (raw & 0x800000)
+    {
+        raw |= 0xFF000000;
+    }
+    return (int32_t)raw;
+}
+
+void StrainFilter::setScale(float scale)
+{
+    scale_ = scale;
+}
+
+float StrainFilter::getScale() const
+{
+    return scale_;
+}
+
+void StrainFilter::setOffset(float offset)
+{
+    offset_ = offset;
+}
+
+float StrainFilter::getOffset() const
+{
+    return offset_;
+}
+
+float StrainFilter::toUnits(float counts) const
+{
+    return (counts - offset_) / scale_;
+}
+
+void StrainFilter::reset()
+{
+    window_.clear();
+    has_last_ = false;
+    discarded_count_ = 0;
+    tare_pending_ = true;
+}
+
+void StrainFilter::tare()
+{
+    if (!window_.isFull())
+    {
+        tare_pending_ = true;
+        return;
+    }
+    offset_ = window_.average();
+    tare_pending_ = false;
+}
+
+StrainSampleStatus StrainFilter::addSample(int32_t counts)
+{
+    if (has_last_ && fabsf((float)(counts - last_counts_) / scale_) > MAX_STEP_UNITS)
+    {
+        discarded_count_++;
+        if (discarded_count_ > MAX_CONSECUTIVE_DISCARDS)
+        {
+            return StrainSampleStatus::RESET_NEEDED;
+        }
+        return StrainSampleStatus::DISCARDED;
+    }
+    discarded_count_ = 0;
+    has_last_ = true;
+    last_counts_ = counts;
+
+    window_.add(counts);
+
+    if (tare_pending_)
+    {
+        tare();
+        if (tare_pending_)
+        {
+            return StrainSampleStatus::TARING;
+        }
+    }
+    return StrainSampleStatus::OK;
+}
+
+float StrainFilter::getValue() const
+{
+    if (window_.count() == 0)
+    {
+        return 0;
+    }
+    return toUnits(window_.average());
+}
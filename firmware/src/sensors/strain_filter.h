@@ -0,0 +1,60 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "../filters.h"
+
+// Sign extends the 24-bit two's complement word the HX711 shifts out
+int32_t hx711DecodeCounts(uint32_t raw);
+
+enum class StrainSampleStatus
+{
+    OK,
+    // Collecting the samples to tare on after reset(); the value isn't zeroed yet
+    TARING,
+    // Too far off the last accepted reading to be real
+    DISCARDED,
+    // Too many readings in a row discarded; power cycle the HX711 and reset()
+    RESET_NEEDED,
+};
+
+// Turns decoded HX711 counts into a filtered strain value: glitched readings are dropped, the rest are averaged
+// over a short window and scaled to calibrated units. Hardware independent, so it can be exercised off target.
+class StrainFilter
+{
+public:
+    // units = (counts - offset) / scale
+    void setScale(float scale);
+    float getScale() const;
+    void setOffset(float offset);
+    float getOffset() const;
+    float toUnits(float counts) const;
+
+    // Forgets the readings so far and tares on the next full window, e.g. after the sensor was powered up
+    void reset();
+
+    // Zeroes the value on the current window, or on the next full one if there isn't one yet
+    void tare();
+
+    StrainSampleStatus addSample(int32_t counts);
+
+    // Average of the window, in units
+    float getValue() const;
+
+private:
+    static const uint8_t WINDOW = 10;
+    // A reading further than this many units from the last accepted one is discarded
+    static constexpr float MAX_STEP_UNITS = 2000;
+    static const uint8_t MAX_CONSECUTIVE_DISCARDS = 20;
+
+    float scale_ = 1;
+    float offset_ = 0;
+
+    // Exact, so taring on it lands on the counts the window held
+    RunningAverage<int32_t, WINDOW, int64_t> window_;
+
+    bool has_last_ = false;
+    int32_t last_counts_ = 0;
+    uint8_t discarded_count_ = 0;
+    bool tare_pending_ = true;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <string.h>
+
+// Single-writer, multi-reader sequence lock for handing the latest value of a small struct to other tasks
+// (and the other core) without queues, critical sections or kernel calls. The writer never blocks; a reader
+// that races with a write gets false and simply keeps its previous value until the next attempt.
+//
+// T must be trivially copyable, and only one task may call write().
+template <typename T>
+class SeqLock
+{
+public:
+    void write(const T &value)
+    {
+        uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+        // Odd sequence marks a write in progress
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&value_, &value, sizeof(T));
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    bool tryRead(T &value) const
+    {
+        uint32_t before = sequence_.load(std::memory_order_acquire);
+        if (before & 1)
+        {
+            return false;
+        }
+        memcpy(&value, &value_, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return sequence_.load(std::memory_order_relaxed) == before;
+    }
+
+private:
+    std::atomic<uint32_t> sequence_{0};
+    T value_ = {};
+};
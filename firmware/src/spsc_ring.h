@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+// Single-producer, single-consumer ring buffer for streaming samples from one task to another (and the other
+// core) without locks or kernel calls. Storage is provided by the caller, so it can live in PSRAM. push() never
+// blocks: when the consumer falls behind, new samples are dropped and counted instead.
+//
+// T must be trivially copyable; only one task may push() and only one (other) task may pop(), clear() or
+// takeDropped().
+template <typename T>
+class SpscRing
+{
+public:
+    // capacity must be a power of two
+    void init(T *storage, uint32_t capacity)
+    {
+        storage_ = storage;
+        mask_ = capacity - 1;
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+        dropped_.store(0, std::memory_order_relaxed);
+    }
+
+    bool isInitialized() const
+    {
+        return storage_ != nullptr;
+    }
+
+    bool push(const T &value)
+    {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) > mask_)
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        storage_[head & mask_] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &value)
+    {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        value = storage_[tail & mask_];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint32_t size() const
+    {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_relaxed);
+    }
+
+    // Discards everything pushed so far
+    void clear()
+    {
+        tail_.store(head_.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    // Number of samples push() dropped since the previous call
+    uint32_t takeDropped()
+    {
+        return dropped_.exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    T *storage_ = nullptr;
+    uint32_t mask_ = 0;
+    std::atomic<uint32_t> head_{0};
+    std::atomic<uint32_t> tail_{0};
+    std::atomic<uint32_t> dropped_{0};
+};
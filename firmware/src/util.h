@@ -47,23 +47,4 @@ int sgn(T val)
     return (T(0) < val) - (val < T(0));
 }
 
-// source: https://github.com/careyi3/MovingAverage/blob/master/src/MovingAverage.cpp
-class MovingAverage
-{
-public:
-    MovingAverage(int filterLength);
-    float addSample(float newValue);
-    float getValue();
-    void dumpFilter();
-
-private:
-    float *filterPointer;
-    int filterLength;
-    float lastValue;
-
-    void initFilter();
-    void shiftFilter(float nextValue);
-    void computeAverage();
-};
-
 lv_color_t kelvinToLvColor(int16_t kelvin);
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+// Host stand-in for the parts of Arduino.h, and the FreeRTOS API it brings in, that code built for the native
+// tests uses. Mutexes and critical sections map onto std::mutex, so the real threading behavior is exercised.
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <mutex>
+
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define portMAX_DELAY 0xffffffffu
+
+typedef std::mutex *SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex()
+{
+    return new std::mutex;
+}
+
+// Always waits, whatever the timeout
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks_to_wait)
+{
+    semaphore->lock();
+    return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore)
+{
+    semaphore->unlock();
+    return pdTRUE;
+}
+
+struct portMUX_TYPE
+{
+    std::mutex mutex;
+};
+
+#define portMUX_INITIALIZER_UNLOCKED {}
+#define portENTER_CRITICAL(mux) (mux)->mutex.lock()
+#define portEXIT_CRITICAL(mux) (mux)->mutex.unlock()
@@ -0,0 +1,31 @@
+#pragma once
+
+// Host stand-in for ESP-IDF's esp_err.h. A failed ESP_ERROR_CHECK aborts on the device; here it is reported and
+// counted instead, so a test can assert that none failed.
+
+#include <stdint.h>
+#include <stdio.h>
+
+typedef int esp_err_t;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+
+inline uint32_t &espErrorCheckFailures()
+{
+    static uint32_t failures = 0;
+    return failures;
+}
+
+#define ESP_ERROR_CHECK(x)                                                                          \
+    do                                                                                              \
+    {                                                                                               \
+        esp_err_t err_rc_ = (x);                                                                    \
+        if (err_rc_ != ESP_OK)                                                                      \
+        {                                                                                           \
+            printf("ESP_ERROR_CHECK failed: 0x%x at %s:%d: %s\n", err_rc_, __FILE__, __LINE__, #x); \
+            espErrorCheckFailures()++;                                                              \
+        }                                                                                           \
+    } while (0)
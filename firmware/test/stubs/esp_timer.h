@@ -0,0 +1,77 @@
+#pragma once
+
+// Host stand-in for ESP-IDF's esp_timer.h. The timers never fire: they only keep the state the real ones check,
+// so starting a running timer or stopping a stopped one fails with ESP_ERR_INVALID_STATE as it does on the
+// device.
+
+#include <stdint.h>
+
+#include "esp_err.h"
+
+typedef void (*esp_timer_cb_t)(void *arg);
+
+typedef enum
+{
+    ESP_TIMER_TASK,
+} esp_timer_dispatch_t;
+
+typedef struct
+{
+    esp_timer_cb_t callback;
+    void *arg;
+    esp_timer_dispatch_t dispatch_method;
+    const char *name;
+    bool skip_unhandled_events;
+} esp_timer_create_args_t;
+
+struct esp_timer
+{
+    esp_timer_create_args_t args;
+    uint64_t period_us;
+    bool running;
+};
+typedef struct esp_timer *esp_timer_handle_t;
+
+inline esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle)
+{
+    if (create_args == nullptr || create_args->callback == nullptr || out_handle == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_handle = new esp_timer{*create_args, 0, false};
+    return ESP_OK;
+}
+
+inline esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period_us)
+{
+    if (timer == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (timer->running)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->period_us = period_us;
+    timer->running = true;
+    return ESP_OK;
+}
+
+inline esp_err_t esp_timer_stop(esp_timer_handle_t timer)
+{
+    if (timer == nullptr)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!timer->running)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->running = false;
+    return ESP_OK;
+}
+
+inline bool esp_timer_is_active(esp_timer_handle_t timer)
+{
+    return timer->running;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <chrono>
+
+#include <unity.h>
+
+// Wall-clock timing for the host benchmarks. The figures are for comparing implementations on the same machine;
+// they say little about the ESP32.
+
+// Keeps a benchmarked result alive so the compiler can't drop the work that produced it
+inline void benchmarkSink(float value)
+{
+    static volatile float sink;
+    sink = value;
+    (void)sink;
+}
+
+// Nanoseconds per call of fn(i) for i in [0, calls), after one untimed pass to warm the caches
+template <typename Fn>
+double nanosPerCall(uint32_t calls, Fn fn)
+{
+    for (uint32_t i = 0; i < calls; i++)
+    {
+        fn(i);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < calls; i++)
+    {
+        fn(i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / calls;
+}
+
+// printf into the test output (shown by pio test -v)
+inline void report(const char *format, ...)
+{
+    char line[160];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    TEST_MESSAGE(line);
+}
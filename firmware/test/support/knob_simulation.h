@@ -0,0 +1,120 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+#include "haptics/angle_observer.h"
+#include "haptics/haptic_engine.h"
+#include "motors/motor_config.h"
+#include "plant_model.h"
+
+// MotorTask's loop around HapticEngine, closed through a PlantModel instead of the motor: the observer is fed the
+// sensor every FOC tick, the engine runs every SIM_HAPTIC_LOOP_DIVIDER ticks, and its torque is clamped to the
+// voltage limit before it drives the plant.
+
+// Same as MOTOR_FOC_LOOP_HZ and MOTOR_HAPTIC_LOOP_DIVIDER (motor_foc/motor_task.h)
+static const uint32_t SIM_FOC_LOOP_HZ = 5000;
+static const uint8_t SIM_HAPTIC_LOOP_DIVIDER = 5;
+
+struct MotorProfile
+{
+    HapticGains gains;
+    float voltage_limit;
+    float observer_bandwidth_hz;
+};
+
+// The profile the firmware is built with (motors/motor_config.h)
+static const MotorProfile DEFAULT_MOTOR_PROFILE = {
+    .gains = {
+        .p = FOC_PID_P,
+        .i = FOC_PID_I,
+        .d = FOC_PID_D,
+        .output_ramp = FOC_PID_OUTPUT_RAMP,
+        .limit = FOC_PID_LIMIT,
+    },
+    .voltage_limit = FOC_VOLTAGE_LIMIT,
+    .observer_bandwidth_hz = FOC_OBSERVER_BANDWIDTH_HZ,
+};
+
+class KnobSimulation
+{
+public:
+    KnobSimulation(const PB_SmartKnobConfig &config, const MotorProfile &profile = DEFAULT_MOTOR_PROFILE,
+                   const PlantParameters &plant = DEFAULT_PLANT_PARAMETERS, uint32_t seed = 1)
+        : plant_(plant, seed),
+          observer_(ObserverGains::criticallyDamped(profile.observer_bandwidth_hz, 1.0f / SIM_FOC_LOOP_HZ)),
+          engine_(profile.gains),
+          voltage_limit_(profile.voltage_limit)
+    {
+        MultiTurnAngle start = MultiTurnAngle::fromRadians(plant_.getAngle());
+        observer_.reset(start, now_us_);
+        engine_.reset(start);
+        config_status_ = engine_.setConfig(config, start);
+    }
+
+    HapticConfigStatus getConfigStatus() const
+    {
+        return config_status_;
+    }
+
+    // Runs one haptic loop period with external_torque (N*m, e.g. a finger) on the knob
+    const HapticOutput &tick(float external_torque)
+    {
+        const uint32_t foc_period_us = 1000000 / SIM_FOC_LOOP_HZ;
+        for (uint8_t i = 0; i < SIM_HAPTIC_LOOP_DIVIDER; i++)
+        {
+            plant_.step(torque_, external_torque, foc_period_us / 1e6f);
+            now_us_ += foc_period_us;
+            observer_.update(MultiTurnAngle::fromRadians(plant_.readSensor()), now_us_);
+        }
+        const ObserverEstimate &estimate = observer_.getEstimate();
+        input_ = {
+            .angle = estimate.angle,
+            .velocity = estimate.velocity,
+            .acceleration = estimate.acceleration,
+            .now_us = now_us_,
+        };
+        output_ = engine_.update(input_);
+        torque_ = fmaxf(-voltage_limit_, fminf(voltage_limit_, output_.torque));
+        return output_;
+    }
+
+    // Torque of a finger holding the knob like a spring-damper towards target_angle
+    float fingerTorque(float target_angle, float stiffness, float damping) const
+    {
+        return -stiffness * (plant_.getAngle() - target_angle) - damping * plant_.getVelocity();
+    }
+
+    PlantModel &getPlant()
+    {
+        return plant_;
+    }
+
+    HapticEngine &getEngine()
+    {
+        return engine_;
+    }
+
+    // What the engine was last given and returned
+    const HapticInput &getInput() const
+    {
+        return input_;
+    }
+
+    const HapticOutput &getOutput() const
+    {
+        return output_;
+    }
+
+private:
+    PlantModel plant_;
+    AngleObserver observer_;
+    HapticEngine engine_;
+    float voltage_limit_;
+    HapticConfigStatus config_status_;
+
+    uint32_t now_us_ = 1000000;
+    float torque_ = 0;
+    HapticInput input_ = {};
+    HapticOutput output_ = {};
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+// Host-side model of the knob for exercising HapticEngine without hardware: a rigid rotor with viscous and
+// coulomb friction, driven by the engine's torque output, observed through a noisy, quantized angle sensor.
+
+struct PlantParameters
+{
+    float inertia;              // kg*m^2
+    float viscous_friction;     // N*m per rad/s
+    float coulomb_friction;     // N*m
+    float torque_per_unit;      // N*m per unit of HapticOutput::torque (i.e. per volt of q-axis voltage)
+    float sensor_noise_rad;     // standard deviation of additive sensor noise
+    uint8_t sensor_resolution_bits;
+};
+
+// Rough figures for a 2804-class gimbal motor with a knob attached and an MT6701 (14 bit) encoder
+static const PlantParameters DEFAULT_PLANT_PARAMETERS = {
+    .inertia = 4e-6,
+    .viscous_friction = 2e-5,
+    .coulomb_friction = 1e-4,
+    .torque_per_unit = 5e-3,
+    .sensor_noise_rad = 2e-4,
+    .sensor_resolution_bits = 14,
+};
+
+class PlantModel
+{
+public:
+    PlantModel(const PlantParameters &params, uint32_t seed = 1) : params_(params), rng_state_(seed ? seed : 1) {}
+
+    // Advances the rotor by dt seconds. applied_torque is in engine units; external_torque (e.g. a finger) in N*m.
+    void step(float applied_torque, float external_torque, float dt)
+    {
+        float drive = applied_torque * params_.torque_per_unit + external_torque - params_.viscous_friction * velocity_;
+        if (velocity_ != 0)
+        {
+            drive -= velocity_ > 0 ? params_.coulomb_friction : -params_.coulomb_friction;
+        }
+        else if (fabsf(drive) <= params_.coulomb_friction)
+        {
+            // Static friction holds the rotor
+            drive = 0;
+        }
+        else
+        {
+            drive -= drive > 0 ? params_.coulomb_friction : -params_.coulomb_friction;
+        }
+
+        float new_velocity = velocity_ + drive / params_.inertia * dt;
+        if (velocity_ != 0 && (new_velocity > 0) != (velocity_ > 0))
+        {
+            // Friction can stop the rotor but never reverse it within a step
+            new_velocity = 0;
+        }
+        angle_ += 0.5f * (velocity_ + new_velocity) * dt;
+        velocity_ = new_velocity;
+    }
+
+    // True state
+    float getAngle() const { return angle_; }
+    float getVelocity() const { return velocity_; }
+
+    // Angle as seen through the sensor: true angle plus gaussian noise, quantized to the sensor resolution
+    float readSensor()
+    {
+        const float lsb = 2 * M_PI / (1 << params_.sensor_resolution_bits);
+        return roundf((angle_ + gaussian() * params_.sensor_noise_rad) / lsb) * lsb;
+    }
+
+private:
+    PlantParameters params_;
+    float angle_ = 0;
+    float velocity_ = 0;
+    uint32_t rng_state_;
+
+    // xorshift32, so simulations are reproducible across hosts
+    float uniform()
+    {
+        rng_state_ ^= rng_state_ << 13;
+        rng_state_ ^= rng_state_ >> 17;
+        rng_state_ ^= rng_state_ << 5;
+        return (rng_state_ >> 8) * (1.0f / (1 << 24));
+    }
+
+    // Box-Muller
+    float gaussian()
+    {
+        float u1 = uniform();
+        float u2 = uniform();
+        if (u1 < 1e-7f)
+        {
+            u1 = 1e-7f;
+        }
+        return sqrtf(-2 * logf(u1)) * cosf(2 * M_PI * u2);
+    }
+};
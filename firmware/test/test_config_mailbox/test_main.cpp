@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "mailbox.h"
+#include "proto/proto_gen/smartknob.pb.h"
+
+// Floods the motor task's config mailbox (MotorTask::setConfig) from writer threads while a reader takes from it
+// as fast as it can. Every field of a posted config is derived from its sequence number, so a value the reader
+// sees half overwritten by a later post shows up as fields that disagree.
+
+static const uint32_t POSTS_PER_WRITER = 200000;
+
+static PB_SmartKnobConfig configFor(uint32_t writer, uint32_t sequence)
+{
+    PB_SmartKnobConfig config = {};
+    config.position = sequence;
+    config.position_nonce = sequence & 0xff;
+    config.min_position = -(int32_t)sequence;
+    config.max_position = writer;
+    config.position_width_radians = sequence;
+    config.detent_strength_unit = writer;
+    config.snap_point = sequence + 0.5f;
+    snprintf(config.id, sizeof(config.id), "writer %u config %u", writer, sequence);
+    config.detent_positions_count = 5;
+    for (pb_size_t i = 0; i < 5; i++)
+    {
+        config.detent_positions[i] = sequence * 5 + i;
+    }
+    config.led_hue = sequence % 360;
+    return config;
+}
+
+static bool isConsistent(const PB_SmartKnobConfig &config)
+{
+    PB_SmartKnobConfig expected = configFor(config.max_position, config.position);
+    return memcmp(&config, &expected, sizeof(config)) == 0;
+}
+
+struct FloodResult
+{
+    uint32_t posted;
+    uint32_t merged;
+    uint32_t taken;
+    uint32_t torn;
+    uint32_t out_of_order;
+    uint32_t last_sequence[4];
+};
+
+static FloodResult flood(Mailbox<PB_SmartKnobConfig> &mailbox, uint32_t writers)
+{
+    FloodResult result = {};
+    std::atomic<uint32_t> merged(0);
+    std::atomic<bool> writing(true);
+
+    auto check = [&](const PB_SmartKnobConfig *config, uint32_t posted_us) {
+        result.taken++;
+        if (!isConsistent(*config) || posted_us != (uint32_t)config->position)
+        {
+            result.torn++;
+            return;
+        }
+        // Each writer's posts have to come out in the order it made them
+        uint32_t writer = config->max_position;
+        if ((uint32_t)config->position <= result.last_sequence[writer])
+        {
+            result.out_of_order++;
+        }
+        result.last_sequence[writer] = config->position;
+    };
+
+    std::thread reader([&]() {
+        uint32_t posted_us;
+        while (writing)
+        {
+            const PB_SmartKnobConfig *config = mailbox.take(posted_us);
+            if (config != nullptr)
+            {
+                check(config, posted_us);
+            }
+        }
+    });
+
+    std::vector<std::thread> writer_threads;
+    for (uint32_t writer = 0; writer < writers; writer++)
+    {
+        writer_threads.emplace_back([&, writer]() {
+            for (uint32_t sequence = 1; sequence <= POSTS_PER_WRITER; sequence++)
+            {
+                if (mailbox.post(configFor(writer, sequence), sequence))
+                {
+                    merged++;
+                }
+            }
+        });
+    }
+    for (std::thread &thread : writer_threads)
+    {
+        thread.join();
+    }
+    writing = false;
+    reader.join();
+
+    // Whatever the reader hadn't picked up yet
+    uint32_t posted_us;
+    const PB_SmartKnobConfig *config = mailbox.take(posted_us);
+    if (config != nullptr)
+    {
+        check(config, posted_us);
+    }
+    result.posted = writers * POSTS_PER_WRITER;
+    result.merged = merged;
+    return result;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_take_returns_latest_post(void)
+{
+    Mailbox<PB_SmartKnobConfig> mailbox;
+    uint32_t posted_us = 0;
+    TEST_ASSERT_FALSE(mailbox.pending());
+    TEST_ASSERT_NULL(mailbox.take(posted_us));
+
+    TEST_ASSERT_FALSE(mailbox.post(configFor(0, 1), 1));
+    TEST_ASSERT_TRUE(mailbox.post(configFor(0, 2), 2));
+    TEST_ASSERT_TRUE(mailbox.post(configFor(0, 3), 3));
+    TEST_ASSERT_TRUE(mailbox.pending());
+
+    const PB_SmartKnobConfig *config = mailbox.take(posted_us);
+    TEST_ASSERT_NOT_NULL(config);
+    TEST_ASSERT_EQUAL_INT32(3, config->position);
+    TEST_ASSERT_EQUAL_UINT32(3, posted_us);
+    TEST_ASSERT_TRUE(isConsistent(*config));
+    TEST_ASSERT_FALSE(mailbox.pending());
+    TEST_ASSERT_NULL(mailbox.take(posted_us));
+
+    // Posting after a take doesn't count as a merge, and doesn't touch the value the reader holds
+    TEST_ASSERT_FALSE(mailbox.post(configFor(0, 4), 4));
+    TEST_ASSERT_EQUAL_INT32(3, config->position);
+    TEST_ASSERT_TRUE(isConsistent(*config));
+}
+
+void test_flood_from_one_writer(void)
+{
+    Mailbox<PB_SmartKnobConfig> mailbox;
+    FloodResult result = flood(mailbox, 1);
+    TEST_ASSERT_EQUAL_UINT32(0, result.torn);
+    TEST_ASSERT_EQUAL_UINT32(0, result.out_of_order);
+    // Every post was either taken or replaced by a later one
+    TEST_ASSERT_EQUAL_UINT32(result.posted, result.taken + result.merged);
+    // Latest wins: the last config the reader saw is the last one posted
+    TEST_ASSERT_EQUAL_UINT32(POSTS_PER_WRITER, result.last_sequence[0]);
+    TEST_ASSERT_GREATER_THAN(0, result.merged);
+}
+
+void test_flood_from_several_writers(void)
+{
+    Mailbox<PB_SmartKnobConfig> mailbox;
+    FloodResult result = flood(mailbox, 3);
+    TEST_ASSERT_EQUAL_UINT32(0, result.torn);
+    TEST_ASSERT_EQUAL_UINT32(0, result.out_of_order);
+    TEST_ASSERT_EQUAL_UINT32(result.posted, result.taken + result.merged);
+    TEST_ASSERT_FALSE(mailbox.pending());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_take_returns_latest_post);
+    RUN_TEST(test_flood_from_one_writer);
+    RUN_TEST(test_flood_from_several_writers);
+    return UNITY_END();
+}
@@ -0,0 +1,358 @@
+#include <math.h>
+#include <unity.h>
+
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
+#include "benchmark.h"
+#include "filters.h"
+
+// The filters in filters.h against straightforward reference implementations, their frequency and step responses,
+// and what each costs per sample next to the MovingAverage they replaced.
+
+// The MovingAverage filters.h replaced (util.h): shifts the whole window and re-sums it on every sample
+class ShiftingAverage
+{
+public:
+    explicit ShiftingAverage(int length) : window_(length, 0.0f)
+    {
+    }
+
+    float addSample(float value)
+    {
+        for (int i = window_.size() - 1; i > 0; i--)
+        {
+            window_[i] = window_[i - 1];
+        }
+        window_[0] = value;
+        double sum = 0;
+        for (float sample : window_)
+        {
+            sum += sample;
+        }
+        return sum / window_.size();
+    }
+
+private:
+    std::vector<float> window_;
+};
+
+// The last N samples, to compute the exact mean and median from
+template <typename T>
+class NaiveWindow
+{
+public:
+    explicit NaiveWindow(size_t length) : length_(length)
+    {
+    }
+
+    void add(T sample)
+    {
+        samples_.push_back(sample);
+        if (samples_.size() > length_)
+        {
+            samples_.erase(samples_.begin());
+        }
+    }
+
+    double mean() const
+    {
+        double sum = 0;
+        for (T sample : samples_)
+        {
+            sum += sample;
+        }
+        return sum / samples_.size();
+    }
+
+    // The upper median of an even count, like MedianFilter
+    T median() const
+    {
+        std::vector<T> sorted = samples_;
+        std::sort(sorted.begin(), sorted.end());
+        return sorted[sorted.size() / 2];
+    }
+
+    size_t size() const
+    {
+        return samples_.size();
+    }
+
+private:
+    size_t length_;
+    std::vector<T> samples_;
+};
+
+// xorshift32, so every host sees the same samples
+static uint32_t random_state = 1;
+
+static uint32_t nextRandom()
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+// Uniform in [-1, 1)
+static float randomUnit()
+{
+    return (nextRandom() >> 8) * (2.0f / (1 << 24)) - 1;
+}
+
+// Amplitude of the output for a unit sine at frequency_hz, from its RMS over whole periods once the filter has
+// settled (a peak would depend on where the samples happen to fall)
+static float sineGain(const Biquad::Coefficients &coefficients, float frequency_hz, float sample_hz)
+{
+    Biquad filter(coefficients);
+    double square_sum = 0;
+    for (int i = 0; i < 4000; i++)
+    {
+        float out = filter.add(sinf(2 * (float)M_PI * frequency_hz * i / sample_hz));
+        if (i >= 2000)
+        {
+            square_sum += out * out;
+        }
+    }
+    return sqrt(2 * square_sum / 2000);
+}
+
+void setUp(void)
+{
+    random_state = 1;
+}
+
+void tearDown(void)
+{
+}
+
+void test_running_average_matches_a_naive_window(void)
+{
+    // Strain filter style: 24 bit readings, summed exactly
+    RunningAverage<int32_t, 10, int64_t> counts;
+    NaiveWindow<int32_t> counts_reference(10);
+    // Float samples with a double sum
+    RunningAverage<float, 50, double> values;
+    NaiveWindow<float> values_reference(50);
+    for (int i = 0; i < 10000; i++)
+    {
+        int32_t reading = randomUnit() * 8000000;
+        counts.add(reading);
+        counts_reference.add(reading);
+        TEST_ASSERT_EQUAL_UINT32(counts_reference.size(), counts.count());
+        // Within the rounding of the float result
+        TEST_ASSERT_FLOAT_WITHIN(1, counts_reference.mean(), counts.average());
+
+        float value = randomUnit() * 1000;
+        values.add(value);
+        values_reference.add(value);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3, values_reference.mean(), values.average());
+    }
+    TEST_ASSERT_TRUE(counts.isFull());
+
+    counts.clear();
+    TEST_ASSERT_EQUAL_UINT32(0, counts.count());
+    TEST_ASSERT_FALSE(counts.isFull());
+    TEST_ASSERT_EQUAL_FLOAT(0, counts.average());
+    counts.add(7);
+    TEST_ASSERT_EQUAL_FLOAT(7, counts.average());
+}
+
+void test_median_filter_matches_a_naive_window(void)
+{
+    MedianFilter<float, 5> short_filter;
+    NaiveWindow<float> short_reference(5);
+    MedianFilter<float, 15> long_filter;
+    NaiveWindow<float> long_reference(15);
+    for (int i = 0; i < 10000; i++)
+    {
+        // Few distinct values, so the window is full of duplicates
+        float value = nextRandom() % 50;
+        short_reference.add(value);
+        long_reference.add(value);
+        TEST_ASSERT_EQUAL_FLOAT(short_reference.median(), short_filter.add(value));
+        TEST_ASSERT_EQUAL_FLOAT(long_reference.median(), long_filter.add(value));
+    }
+}
+
+void test_median_filter_drops_outliers(void)
+{
+    MedianFilter<float, 3> filter;
+    TEST_ASSERT_EQUAL_FLOAT(0, filter.value());
+    filter.add(1);
+    // Until the window is full, an even count gives the upper median
+    TEST_ASSERT_EQUAL_FLOAT(100, filter.add(100));
+    TEST_ASSERT_EQUAL_FLOAT(2, filter.add(2));
+    // Up to (N - 1) / 2 outliers in a row don't get through
+    TEST_ASSERT_EQUAL_FLOAT(2, filter.add(-500));
+
+    // A NaN can't be found again when it leaves the window; the filter recovers once it's gone
+    filter.add(NAN);
+    for (int i = 0; i < 3; i++)
+    {
+        filter.add(1);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(1, filter.value());
+    TEST_ASSERT_EQUAL_UINT32(3, filter.count());
+}
+
+void test_ewma(void)
+{
+    Ewma average(0.5);
+    TEST_ASSERT_FALSE(average.hasValue());
+    // The first sample is taken as is
+    TEST_ASSERT_EQUAL_FLOAT(10, average.add(10));
+    TEST_ASSERT_EQUAL_FLOAT(15, average.add(20));
+    TEST_ASSERT_EQUAL_FLOAT(17.5, average.add(20));
+    TEST_ASSERT_EQUAL_FLOAT(16.25, average.add(15, 0.5));
+    average.reset();
+    TEST_ASSERT_FALSE(average.hasValue());
+    TEST_ASSERT_EQUAL_FLOAT(4, average.add(4));
+
+    // A step covers 1 - 1/e of the way in about one time constant
+    Ewma step(Ewma::alphaFor(100, 1));
+    step.reset(0);
+    for (int i = 0; i < 100; i++)
+    {
+        step.add(1);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1 - expf(-1), step.value());
+}
+
+void test_biquad_is_3db_down_at_the_cutoff(void)
+{
+    const float sample_hz = 1000;
+    Biquad::Coefficients low_pass = Biquad::lowPass(50, sample_hz);
+    TEST_ASSERT_FLOAT_WITHIN(0.02, M_SQRT1_2, sineGain(low_pass, 50, sample_hz));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1, sineGain(low_pass, 1, sample_hz));
+    // Second order: 12 dB per octave well past the corner
+    TEST_ASSERT_FLOAT_WITHIN(0.03, 0, sineGain(low_pass, 400, sample_hz));
+
+    Biquad::Coefficients high_pass = Biquad::highPass(50, sample_hz);
+    TEST_ASSERT_FLOAT_WITHIN(0.02, M_SQRT1_2, sineGain(high_pass, 50, sample_hz));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 0, sineGain(high_pass, 1, sample_hz));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1, sineGain(high_pass, 400, sample_hz));
+}
+
+void test_biquad_reset_starts_settled(void)
+{
+    // Without a reset, a low pass rings up from 0
+    Biquad cold(Biquad::lowPass(10, 1000));
+    TEST_ASSERT_FLOAT_WITHIN(1, 0, cold.add(500));
+
+    Biquad low_pass(Biquad::lowPass(10, 1000));
+    low_pass.reset(500);
+    for (int i = 0; i < 100; i++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(0.01, 500, low_pass.add(500));
+    }
+    // A high pass settled on a constant passes nothing of it
+    Biquad high_pass(Biquad::highPass(10, 1000));
+    high_pass.reset(500);
+    for (int i = 0; i < 100; i++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(0.01, 0, high_pass.add(500));
+    }
+}
+
+// A proximity-style reading at 20 Hz: smoothed while the hand is still, followed closely when it approaches
+void test_one_euro_filter(void)
+{
+    OneEuroFilter filter(1, 0.05, 1);
+    const uint32_t sample_us = 50000;
+    uint32_t now_us = 0;
+    double raw_square_error = 0;
+    double filtered_square_error = 0;
+    for (int i = 0; i < 400; i++)
+    {
+        now_us += sample_us;
+        float noise = randomUnit() * 5;
+        float out = filter.add(300 + noise, now_us);
+        if (i >= 20)
+        {
+            raw_square_error += noise * noise;
+            filtered_square_error += (out - 300) * (out - 300);
+        }
+    }
+    report("one euro at rest: rms error %.2f raw, %.2f filtered", sqrt(raw_square_error / 380), sqrt(filtered_square_error / 380));
+    TEST_ASSERT_TRUE(filtered_square_error < raw_square_error / 3);
+
+    // Closing in at 500 units/s: the output crosses half way at most two samples after the signal
+    float distance = 300;
+    int raw_crossed = -1;
+    int filtered_crossed = -1;
+    for (int i = 0; i < 40; i++)
+    {
+        now_us += sample_us;
+        distance = fmaxf(100, distance - 25);
+        float out = filter.add(distance + randomUnit() * 5, now_us);
+        raw_crossed = raw_crossed < 0 && distance < 200 ? i : raw_crossed;
+        filtered_crossed = filtered_crossed < 0 && out < 200 ? i : filtered_crossed;
+    }
+    report("one euro approaching: crosses %d samples after the signal", filtered_crossed - raw_crossed);
+    TEST_ASSERT_TRUE(filtered_crossed >= 0);
+    TEST_ASSERT_TRUE(filtered_crossed - raw_crossed <= 2);
+
+    // A repeated timestamp is ignored, and a reset starts over from the next sample
+    float value = filter.value();
+    TEST_ASSERT_EQUAL_FLOAT(value, filter.add(0, now_us));
+    filter.reset();
+    TEST_ASSERT_EQUAL_FLOAT(42, filter.add(42, now_us + sample_us));
+}
+
+void test_benchmark_filters(void)
+{
+    const uint32_t SAMPLES = 1 << 16;
+    std::vector<float> input(SAMPLES);
+    for (float &sample : input)
+    {
+        sample = randomUnit() * 1000;
+    }
+
+    ShiftingAverage shifting_10(10);
+    ShiftingAverage shifting_50(50);
+    RunningAverage<float, 10, double> running_10;
+    RunningAverage<float, 50, double> running_50;
+    NaiveWindow<float> naive_5(5);
+    MedianFilter<float, 5> median_5;
+    MedianFilter<float, 15> median_15;
+    Ewma ewma(0.1);
+    Biquad biquad(Biquad::lowPass(50, 1000));
+    OneEuroFilter one_euro(1, 0.05);
+
+    report("%-30s %10s", "filter", "ns/sample");
+    report("%-30s %10.1f", "MovingAverage(10) [replaced]", nanosPerCall(SAMPLES, [&](uint32_t i) { benchmarkSink(shifting_10.addSample(input[i])); }));
+    report("%-30s %10.1f", "MovingAverage(50) [replaced]", nanosPerCall(SAMPLES, [&](uint32_t i) { benchmarkSink(shifting_50.addSample(input[i])); }));
+    report("%-30s %10.1f", "RunningAverage<10>", nanosPerCall(SAMPLES, [&](uint32_t i) {
+               running_10.add(input[i]);
+               benchmarkSink(running_10.average());
+           }));
+    report("%-30s %10.1f", "RunningAverage<50>", nanosPerCall(SAMPLES, [&](uint32_t i) {
+               running_50.add(input[i]);
+               benchmarkSink(running_50.average());
+           }));
+    report("%-30s %10.1f", "median of 5, sorting", nanosPerCall(SAMPLES, [&](uint32_t i) {
+               naive_5.add(input[i]);
+               benchmarkSink(naive_5.median());
+           }));
+    report("%-30s %10.1f", "MedianFilter<5>", nanosPerCall(SAMPLES, [&](uint32_t i) { benchmarkSink(median_5.add(input[i])); }));
+    report("%-30s %10.1f", "MedianFilter<15>", nanosPerCall(SAMPLES, [&](uint32_t i) { benchmarkSink(median_15.add(input[i])); }));
+    report("%-30s %10.1f", "Ewma", nanosPerCall(SAMPLES, [&](uint32_t i) { benchmarkSink(ewma.add(input[i])); }));
+    report("%-30s %10.1f", "Biquad", nanosPerCall(SAMPLES, [&](uint32_t i) { benchmarkSink(biquad.add(input[i])); }));
+    report("%-30s %10.1f", "OneEuroFilter", nanosPerCall(SAMPLES, [&](uint32_t i) { benchmarkSink(one_euro.add(input[i], i * 1000)); }));
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_running_average_matches_a_naive_window);
+    RUN_TEST(test_median_filter_matches_a_naive_window);
+    RUN_TEST(test_median_filter_drops_outliers);
+    RUN_TEST(test_ewma);
+    RUN_TEST(test_biquad_is_3db_down_at_the_cutoff);
+    RUN_TEST(test_biquad_reset_starts_settled);
+    RUN_TEST(test_one_euro_filter);
+    RUN_TEST(test_benchmark_filters);
+    return UNITY_END();
+}
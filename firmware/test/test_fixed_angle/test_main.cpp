@@ -0,0 +1,286 @@
+#include <math.h>
+#include <string.h>
+#include <unity.h>
+
+#include <initializer_list>
+
+#include "benchmark.h"
+#include "haptics/fixed_angle.h"
+#include "motor_foc/cogging_compensation.h"
+#include "motor_foc/encoder_linearization.h"
+
+// FixedAngle against the float code it replaced on the sensor path: the MT6701 angle, the encoder linearization
+// lookup and the cogging map lookup. Every 14 bit sensor code is checked.
+
+static const float TWO_PI = 2 * M_PI;
+static const uint8_t SENSOR_BITS = 14;
+static const uint32_t SENSOR_CODES = 1 << SENSOR_BITS;
+// One MT6701 count
+static const float SENSOR_LSB_RAD = TWO_PI / SENSOR_CODES;
+
+static float wrapAngle(float angle)
+{
+    angle = fmodf(angle, TWO_PI);
+    return angle < 0 ? angle + TWO_PI : angle;
+}
+
+// Signed difference of two angles in [-PI, PI]
+static float angleDifference(float a, float b)
+{
+    return remainderf(a - b, TWO_PI);
+}
+
+// The float implementations FixedAngle replaced
+
+static float floatSensorAngle(uint32_t code)
+{
+    float angle = (float)code * 2 * M_PI / 16384;
+    // The sensor counts the other way round
+    return angle > 0 ? 2 * M_PI - angle : 0;
+}
+
+class FloatLinearizationTable
+{
+public:
+    void build(const PB_EncoderLinearization &linearization)
+    {
+        for (uint16_t i = 0; i < TABLE_SIZE; i++)
+        {
+            float theta = i * TWO_PI / TABLE_SIZE;
+            float error = 0;
+            for (uint8_t k = 0; k < linearization.harmonic_cos_count; k++)
+            {
+                error += linearization.harmonic_cos[k] * cosf((k + 1) * theta) + linearization.harmonic_sin[k] * sinf((k + 1) * theta);
+            }
+            error_[i] = error;
+        }
+        error_[TABLE_SIZE] = error_[0];
+    }
+
+    float apply(float raw_angle) const
+    {
+        float index = raw_angle * (TABLE_SIZE / TWO_PI);
+        if (index < 0)
+        {
+            index = 0;
+        }
+        uint16_t i = (uint16_t)index;
+        if (i >= TABLE_SIZE)
+        {
+            i = TABLE_SIZE - 1;
+        }
+        float t = index - i;
+        float error = error_[i] + (error_[i + 1] - error_[i]) * t;
+        return wrapAngle(raw_angle - error);
+    }
+
+private:
+    static const uint16_t TABLE_SIZE = 256;
+    float error_[TABLE_SIZE + 1];
+};
+
+class FloatCoggingCompensation
+{
+public:
+    void build(const PB_CoggingMap &map)
+    {
+        memcpy(samples_, map.samples.bytes, map.samples.size);
+        count_ = map.samples.size;
+        scale_ = map.scale;
+        samples_per_rad_ = count_ / (2 * M_PI);
+    }
+
+    float torque(float mechanical_angle) const
+    {
+        float index = mechanical_angle * samples_per_rad_;
+        if (index < 0)
+        {
+            index = 0;
+        }
+        uint16_t i = (uint16_t)index;
+        if (i >= count_)
+        {
+            i = count_ - 1;
+        }
+        float t = index - i;
+        uint16_t next = i + 1 < count_ ? i + 1 : 0;
+        return (samples_[i] + (samples_[next] - samples_[i]) * t) * scale_;
+    }
+
+private:
+    int8_t samples_[COGGING_MAP_MAX_SAMPLES];
+    uint16_t count_;
+    float scale_;
+    float samples_per_rad_;
+};
+
+// A few mrad of once and twice per revolution error, like a slightly off-center magnet
+static PB_EncoderLinearization testLinearization()
+{
+    PB_EncoderLinearization linearization = {};
+    linearization.harmonic_cos_count = 2;
+    linearization.harmonic_sin_count = 2;
+    linearization.harmonic_cos[0] = 0.004;
+    linearization.harmonic_sin[0] = -0.002;
+    linearization.harmonic_cos[1] = -0.0015;
+    linearization.harmonic_sin[1] = 0.0008;
+    return linearization;
+}
+
+static float exactError(const PB_EncoderLinearization &linearization, float theta)
+{
+    float error = 0;
+    for (uint8_t k = 0; k < linearization.harmonic_cos_count; k++)
+    {
+        error += linearization.harmonic_cos[k] * cosf((k + 1) * theta) + linearization.harmonic_sin[k] * sinf((k + 1) * theta);
+    }
+    return error;
+}
+
+static PB_CoggingMap testCoggingMap(uint16_t count)
+{
+    PB_CoggingMap map = {};
+    map.scale = 0.01;
+    map.samples.size = count;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        map.samples.bytes[i] = (int8_t)lroundf(100 * sinf(i * 11 * TWO_PI / count) + 20 * cosf(i * 3 * TWO_PI / count));
+    }
+    return map;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_conversions_wrap(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(0x40000000u, FixedAngle::fromCounts(4096, SENSOR_BITS).turns);
+    TEST_ASSERT_EQUAL_UINT32(0xC0000000u, FixedAngle::fromRadians(-M_PI / 2).turns);
+    // Multi-turn floats wrap too, to within their own rounding
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 0, FixedAngle::fromRadians(5 * M_PI / 2).radiansFrom({0x40000000u}));
+    TEST_ASSERT_EQUAL_UINT32(0u, (FixedAngle{0x80000000u} + FixedAngle{0x80000000u}).turns);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFu, (-FixedAngle{1}).turns);
+
+    // radiansFrom takes the short way across zero
+    FixedAngle before_zero = {0xFFFFFF00u};
+    FixedAngle after_zero = {0x00000100u};
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, 512 * FIXED_ANGLE_Q32_TO_RADIANS, after_zero.radiansFrom(before_zero));
+    TEST_ASSERT_FLOAT_WITHIN(1e-12, -512 * FIXED_ANGLE_Q32_TO_RADIANS, before_zero.radiansFrom(after_zero));
+
+    // Table lookups split the angle into entry and fraction
+    FixedAngle angle = {0x12345678u};
+    TEST_ASSERT_EQUAL_UINT32(0x12u, angle.tableIndex(8));
+    TEST_ASSERT_EQUAL_UINT32(0x3456u, angle.tableFractionQ16(8));
+}
+
+void test_sensor_angle_matches_float_path(void)
+{
+    float max_error = 0;
+    for (uint32_t code = 0; code < SENSOR_CODES; code++)
+    {
+        float fixed = (-FixedAngle::fromCounts(code, SENSOR_BITS)).toRadians();
+        max_error = fmaxf(max_error, fabsf(angleDifference(fixed, floatSensorAngle(code))));
+    }
+    report("sensor angle: max difference to float path %.2e rad", max_error);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 0, max_error);
+}
+
+void test_linearization_matches_float_path(void)
+{
+    PB_EncoderLinearization linearization = testLinearization();
+    EncoderLinearizationTable fixed_table;
+    fixed_table.build(linearization);
+    FloatLinearizationTable float_table;
+    float_table.build(linearization);
+
+    float max_difference = 0;
+    float max_model_error = 0;
+    for (uint32_t code = 0; code < SENSOR_CODES; code++)
+    {
+        FixedAngle raw = -FixedAngle::fromCounts(code, SENSOR_BITS);
+        float fixed = fixed_table.apply(raw).toRadians();
+        max_difference = fmaxf(max_difference, fabsf(angleDifference(fixed, float_table.apply(floatSensorAngle(code)))));
+        float exact = raw.toRadians() - exactError(linearization, raw.toRadians());
+        max_model_error = fmaxf(max_model_error, fabsf(angleDifference(fixed, exact)));
+    }
+    report("linearization: max difference to float path %.2e rad, to the exact correction %.2e rad", max_difference, max_model_error);
+    // Both well inside one sensor count
+    TEST_ASSERT_FLOAT_WITHIN(2e-6, 0, max_difference);
+    TEST_ASSERT_FLOAT_WITHIN(SENSOR_LSB_RAD / 50, 0, max_model_error);
+}
+
+void test_linearization_disabled_passes_through(void)
+{
+    EncoderLinearizationTable table;
+    TEST_ASSERT_FALSE(table.isEnabled());
+    TEST_ASSERT_EQUAL_UINT32(0x12345678u, table.apply({0x12345678u}).turns);
+
+    table.build(testLinearization());
+    TEST_ASSERT_TRUE(table.isEnabled());
+    table.build(PB_EncoderLinearization{});
+    TEST_ASSERT_FALSE(table.isEnabled());
+    TEST_ASSERT_EQUAL_UINT32(0x12345678u, table.apply({0x12345678u}).turns);
+}
+
+void test_cogging_lookup_matches_float_path(void)
+{
+    // The firmware's map size, and one that isn't a power of two
+    for (uint16_t count : {(uint16_t)COGGING_MAP_MAX_SAMPLES, (uint16_t)360})
+    {
+        PB_CoggingMap map = testCoggingMap(count);
+        CoggingCompensation fixed;
+        fixed.build(map);
+        FloatCoggingCompensation reference;
+        reference.build(map);
+
+        float max_difference = 0;
+        for (uint32_t code = 0; code < SENSOR_CODES; code++)
+        {
+            FixedAngle angle = FixedAngle::fromCounts(code, SENSOR_BITS);
+            max_difference = fmaxf(max_difference, fabsf(fixed.torque(angle) - reference.torque(angle.toRadians())));
+        }
+        report("cogging map of %d samples: max difference to float path %.2e (full scale %.2f)", count, max_difference, 127 * map.scale);
+        // Float rounding of the index; the map itself only has 8 bits
+        TEST_ASSERT_FLOAT_WITHIN(1e-4 * 127 * map.scale, 0, max_difference);
+    }
+}
+
+void test_benchmark_fixed_vs_float(void)
+{
+    PB_EncoderLinearization linearization = testLinearization();
+    EncoderLinearizationTable fixed_table;
+    fixed_table.build(linearization);
+    FloatLinearizationTable float_table;
+    float_table.build(linearization);
+
+    // From the raw sensor code to the corrected angle in radians, as MT6701Sensor::getSensorAngle() does it
+    double fixed_ns = nanosPerCall(SENSOR_CODES, [&](uint32_t code) { benchmarkSink(fixed_table.apply(-FixedAngle::fromCounts(code, SENSOR_BITS)).toRadians()); });
+    double float_ns = nanosPerCall(SENSOR_CODES, [&](uint32_t code) { benchmarkSink(float_table.apply(floatSensorAngle(code))); });
+    report("sensor angle + linearization: fixed %.1f ns, float %.1f ns per sample", fixed_ns, float_ns);
+
+    PB_CoggingMap map = testCoggingMap(COGGING_MAP_MAX_SAMPLES);
+    CoggingCompensation fixed_cogging;
+    fixed_cogging.build(map);
+    FloatCoggingCompensation float_cogging;
+    float_cogging.build(map);
+    fixed_ns = nanosPerCall(SENSOR_CODES, [&](uint32_t code) { benchmarkSink(fixed_cogging.torque(FixedAngle::fromCounts(code, SENSOR_BITS))); });
+    float_ns = nanosPerCall(SENSOR_CODES, [&](uint32_t code) { benchmarkSink(float_cogging.torque(code * SENSOR_LSB_RAD)); });
+    report("cogging lookup: fixed %.1f ns, float %.1f ns per sample", fixed_ns, float_ns);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_conversions_wrap);
+    RUN_TEST(test_sensor_angle_matches_float_path);
+    RUN_TEST(test_linearization_matches_float_path);
+    RUN_TEST(test_linearization_disabled_passes_through);
+    RUN_TEST(test_cogging_lookup_matches_float_path);
+    RUN_TEST(test_benchmark_fixed_vs_float);
+    return UNITY_END();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <math.h>
+
+#include "proto/proto_gen/smartknob.pb.h"
+
+// The motor configs the apps and components use (apps/, components/), copied here since those pull in LVGL.
+// Keep in step with them when an app's feel changes.
+
+struct AppConfig
+{
+    const char *name;
+    PB_SmartKnobConfig config;
+};
+
+static PB_SmartKnobConfig appConfig(int32_t position, int32_t min_position, int32_t max_position, float position_width_radians,
+                                    float detent_strength_unit, float endstop_strength_unit, float snap_point)
+{
+    PB_SmartKnobConfig config = {};
+    config.position = position;
+    config.min_position = min_position;
+    config.max_position = max_position;
+    config.position_width_radians = position_width_radians;
+    config.detent_strength_unit = detent_strength_unit;
+    config.endstop_strength_unit = endstop_strength_unit;
+    config.snap_point = snap_point;
+    return config;
+}
+
+static const float DEGREES = M_PI / 180;
+// climate, blinds
+static const float THERMOSTAT_WIDTH = 8.225806452 * M_PI / 120;
+
+static const AppConfig APP_CONFIGS[] = {
+    {"stopwatch", appConfig(0, 0, 0, 60 * DEGREES, 0.01, 0.6, 1.1)},
+    {"switch", appConfig(0, 0, 1, 60 * DEGREES, 1, 1, 0.55)},
+    // SETTINGS_PAGE_COUNT = 2
+    {"settings", appConfig(0, 0, 1, 35 * DEGREES, 2, 1, 0.55)},
+    {"app_menu", appConfig(1, 0, -1, 25 * DEGREES, 2, 1, 0.55)},
+    // CLIMATE_APP_MIN_TEMP..CLIMATE_APP_MAX_TEMP
+    {"climate", appConfig(20, 16, 35, THERMOSTAT_WIDTH, 2, 1, 1.1)},
+    {"blinds", appConfig(0, 0, 20, THERMOSTAT_WIDTH, 2, 1, 1.1)},
+    {"dimmer", appConfig(0, 0, 100, 2.4 * DEGREES, 1, 1, 1.1)},
+    // LIGHT_DIMMER_PAGE_COUNT - 3 = 1
+    {"page_selector", appConfig(0, 0, 1, 25 * DEGREES, 1, 1, 1.1)},
+    // hue and temperature pages
+    {"hue", appConfig(0, 0, -1, 4 * DEGREES, 1, 1, 1)},
+    // toggle component, with the detent strength and snap point of examples/test_components.py
+    {"toggle", appConfig(0, 0, 1, 60 * DEGREES, 2, 1, 0.5)},
+    // multiple choice component with 4 options and unit strengths
+    {"multichoice", appConfig(0, 0, 3, 12 * DEGREES, 2, 1, 0.5)},
+    // apps.h blocked_motor_config
+    {"blocked", appConfig(0, 0, 0, 60 * DEGREES, 0, 0, 0.5)},
+};
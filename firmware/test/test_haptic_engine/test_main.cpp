@@ -0,0 +1,160 @@
+#include <math.h>
+#include <unity.h>
+
+#include <vector>
+
+#include "app_configs.h"
+#include "benchmark.h"
+#include "knob_simulation.h"
+
+// Closed-loop runs of every app config: the engine drives PlantModel through the motor task's loop, with a finger
+// (a stiff spring-damper) turning the knob.
+
+static const float FINGER_STIFFNESS = 0.5;  // N*m/rad
+static const float FINGER_DAMPING = 2e-3;   // N*m per rad/s
+static const float DRAG_SPEED = 0.3;        // rad/s, slow enough to read off where each transition happens
+static const uint32_t SETTLE_MS = 3000;
+
+static int32_t numPositions(const PB_SmartKnobConfig &config)
+{
+    return config.max_position - config.min_position + 1;
+}
+
+static int32_t clampPosition(const PB_SmartKnobConfig &config, int32_t position)
+{
+    if (numPositions(config) <= 0)
+    {
+        return position;
+    }
+    return position < config.min_position ? config.min_position : (position > config.max_position ? config.max_position : position);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_app_configs_are_accepted(void)
+{
+    for (const AppConfig &app : APP_CONFIGS)
+    {
+        KnobSimulation sim(app.config);
+        TEST_ASSERT_TRUE_MESSAGE(sim.getConfigStatus() == HapticConfigStatus::OK, app.name);
+    }
+}
+
+// Turn the knob up to 0.3 positions past the third detent up (or the last one before the endstop) and let go: it
+// has to come to rest on that detent, close to its center
+void test_drag_and_release_settles_on_a_detent(void)
+{
+    for (const AppConfig &app : APP_CONFIGS)
+    {
+        const PB_SmartKnobConfig &config = app.config;
+        KnobSimulation sim(config);
+        for (int i = 0; i < 200; i++)
+        {
+            sim.tick(0);
+        }
+
+        int32_t expected = clampPosition(config, config.position + 3);
+        // Higher positions are at lower angles
+        float target = -(expected - config.position + 0.3f) * config.position_width_radians;
+        uint32_t drag_ms = fabsf(target) / DRAG_SPEED * 1000;
+        for (uint32_t i = 1; i <= drag_ms; i++)
+        {
+            sim.tick(sim.fingerTorque(target * i / drag_ms, FINGER_STIFFNESS, FINGER_DAMPING));
+        }
+        for (uint32_t i = 0; i < SETTLE_MS; i++)
+        {
+            sim.tick(0);
+        }
+
+        const HapticOutput &output = sim.getOutput();
+        report("%-14s position %d, sub-position %.3f", app.name, (int)output.current_position, output.sub_position_unit);
+        TEST_ASSERT_EQUAL_INT32_MESSAGE(expected, output.current_position, app.name);
+        TEST_ASSERT_TRUE_MESSAGE(fabsf(sim.getPlant().getVelocity()) < 0.01f, app.name);
+        if (config.detent_strength_unit >= 1)
+        {
+            // Friction can hold it anywhere in the detent's dead zone (up to 0.2 positions either side)
+            TEST_ASSERT_FLOAT_WITHIN_MESSAGE(0.25, 0, output.sub_position_unit, app.name);
+        }
+    }
+}
+
+// Where a position change should happen: past snap_point (adjusted by the bias) from the current detent center,
+// which is position_width_radians per position from the start
+static float idealTransitionAngle(const PB_SmartKnobConfig &config, int32_t from_position, bool increase)
+{
+    float width = config.position_width_radians;
+    float center = -(from_position - config.position) * width;
+    float snap = width * config.snap_point;
+    float bias = width * config.snap_point_bias;
+    if (increase)
+    {
+        return center - snap + (from_position >= 0 ? -bias : bias);
+    }
+    return center + snap + (from_position <= 0 ? bias : -bias);
+}
+
+// Slowly turn the knob up through up to 10 positions and back down, and compare the true knob angle at each position
+// change against the config's snap point. Also times the engine on the inputs it saw.
+void test_detent_transition_accuracy_and_cost(void)
+{
+    report("%-14s %11s %11s %13s", "config", "ns/update", "transitions", "max error");
+    for (const AppConfig &app : APP_CONFIGS)
+    {
+        const PB_SmartKnobConfig &config = app.config;
+        int32_t steps = numPositions(config) <= 0 ? 10 : config.max_position - config.position;
+        steps = steps > 10 ? 10 : steps;
+
+        KnobSimulation sim(config);
+        std::vector<HapticInput> inputs;
+        for (int i = 0; i < 200; i++)
+        {
+            sim.tick(0);
+        }
+
+        // Snap points past 1 only change position beyond the next detent, so turn 0.3 positions past both ends
+        float overshoot = 0.3f * config.position_width_radians;
+        float out = steps * config.position_width_radians + overshoot;
+        uint32_t drag_ms = (2 * out + overshoot) / DRAG_SPEED * 1000;
+        int transitions = 0;
+        float max_error = 0; // in positions
+        int32_t position = sim.getOutput().current_position;
+        for (uint32_t i = 1; i <= drag_ms; i++)
+        {
+            float turned = DRAG_SPEED * i / 1000;
+            float target = turned <= out ? -turned : turned - 2 * out;
+            const HapticOutput &output = sim.tick(sim.fingerTorque(target, FINGER_STIFFNESS, FINGER_DAMPING));
+            inputs.push_back(sim.getInput());
+            if (output.current_position != position)
+            {
+                bool increase = output.current_position > position;
+                float error = (sim.getPlant().getAngle() - idealTransitionAngle(config, position, increase)) / config.position_width_radians;
+                max_error = fmaxf(max_error, fabsf(error));
+                transitions++;
+                position = output.current_position;
+            }
+        }
+        TEST_ASSERT_EQUAL_INT32_MESSAGE(config.position, position, app.name);
+        TEST_ASSERT_EQUAL_MESSAGE(2 * steps, transitions, app.name);
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(0.05, 0, max_error, app.name);
+
+        HapticEngine engine(DEFAULT_MOTOR_PROFILE.gains);
+        engine.setConfig(config, inputs[0].angle);
+        double ns = nanosPerCall(inputs.size(), [&](uint32_t i) { benchmarkSink(engine.update(inputs[i]).torque); });
+        report("%-14s %11.1f %11d %9.3f pos", app.name, ns, transitions, max_error);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_app_configs_are_accepted);
+    RUN_TEST(test_drag_and_release_settles_on_a_detent);
+    RUN_TEST(test_detent_transition_accuracy_and_cost);
+    return UNITY_END();
+}
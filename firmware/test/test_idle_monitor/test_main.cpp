@@ -0,0 +1,156 @@
+#include <unity.h>
+
+#include <esp_timer.h>
+
+#include "motor_foc/idle_monitor.h"
+#include "motor_foc/loop_timer.h"
+
+// The motor's idle mode: IdleMonitor deciding when to sleep and wake, and the loop timer switching between the
+// active and idle rates, against the host esp_timer stand-in (firmware/test/stubs), which fails the way the
+// device does when a running timer is started again.
+
+static const uint32_t ACTIVE_LOOP_HZ = 5000;
+static const uint32_t HAPTIC_LOOP_HZ = 1000;
+
+// The power switching of MotorTask::run() and enterIdle(), without the motor: one haptic tick every ms while
+// active, one sensor check per idle loop period while idle
+class MotorLoop
+{
+public:
+    void begin()
+    {
+        timer.begin([](void *) {}, nullptr, "motor_loop");
+        timer.start(ACTIVE_LOOP_HZ);
+        idle_monitor.reset(now_ms);
+    }
+
+    void run(uint32_t duration_ms, MultiTurnAngle angle, float velocity)
+    {
+        uint32_t end_ms = now_ms + duration_ms;
+        while (now_ms < end_ms)
+        {
+            if (idle_monitor.isIdle())
+            {
+                now_ms += 1000 / idle_monitor.loopHz();
+                if (idle_monitor.moved(angle))
+                {
+                    idle_ms += idle_monitor.wake(now_ms);
+                    wakes++;
+                    timer.start(ACTIVE_LOOP_HZ);
+                }
+                continue;
+            }
+
+            now_ms += 1000 / HAPTIC_LOOP_HZ;
+            if (idle_monitor.update(velocity, false, now_ms))
+            {
+                active_ms += idle_monitor.sleep(angle, now_ms);
+                sleeps++;
+                timer.start(idle_monitor.loopHz());
+            }
+        }
+    }
+
+    IdleMonitor idle_monitor;
+    LoopTimer timer;
+    uint32_t now_ms = 0;
+    uint32_t sleeps = 0;
+    uint32_t wakes = 0;
+    uint32_t active_ms = 0;
+    uint32_t idle_ms = 0;
+};
+
+void setUp(void)
+{
+    espErrorCheckFailures() = 0;
+}
+
+void tearDown(void)
+{
+}
+
+void test_stub_rejects_starting_a_running_timer(void)
+{
+    // What MotorTask did on wake before LoopTimer: the idle rate timer was still running
+    esp_timer_handle_t timer;
+    esp_timer_create_args_t args = {};
+    args.callback = [](void *) {};
+    TEST_ASSERT_EQUAL(ESP_OK, esp_timer_create(&args, &timer));
+    TEST_ASSERT_EQUAL(ESP_OK, esp_timer_start_periodic(timer, 1000000 / MOTOR_IDLE_LOOP_HZ));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, esp_timer_start_periodic(timer, 1000000 / ACTIVE_LOOP_HZ));
+}
+
+void test_loop_timer_restarts_at_any_rate(void)
+{
+    LoopTimer timer;
+    timer.begin([](void *) {}, nullptr, "test");
+    TEST_ASSERT_FALSE(timer.isRunning());
+
+    timer.start(ACTIVE_LOOP_HZ);
+    TEST_ASSERT_EQUAL_UINT32(ACTIVE_LOOP_HZ, timer.getHz());
+    timer.start(MOTOR_IDLE_LOOP_HZ);
+    TEST_ASSERT_EQUAL_UINT32(MOTOR_IDLE_LOOP_HZ, timer.getHz());
+    timer.start(ACTIVE_LOOP_HZ);
+    TEST_ASSERT_EQUAL_UINT32(ACTIVE_LOOP_HZ, timer.getHz());
+
+    // Calibration stops the loop and restarts it; stopping twice is harmless
+    timer.stop();
+    timer.stop();
+    TEST_ASSERT_FALSE(timer.isRunning());
+    TEST_ASSERT_EQUAL_UINT32(0, timer.getHz());
+    timer.start(ACTIVE_LOOP_HZ);
+    TEST_ASSERT_TRUE(timer.isRunning());
+
+    TEST_ASSERT_EQUAL_UINT32(0, espErrorCheckFailures());
+}
+
+void test_idle_wake_idle(void)
+{
+    MotorLoop loop;
+    loop.begin();
+    MultiTurnAngle rest = MultiTurnAngle::fromRadians(1);
+
+    // Still for the timeout: drops to the idle rate
+    loop.run(MOTOR_IDLE_TIMEOUT_MS + 100, rest, 0);
+    TEST_ASSERT_TRUE(loop.idle_monitor.isIdle());
+    TEST_ASSERT_EQUAL_UINT32(1, loop.sleeps);
+    TEST_ASSERT_TRUE(loop.active_ms >= MOTOR_IDLE_TIMEOUT_MS);
+    TEST_ASSERT_EQUAL_UINT32(MOTOR_IDLE_LOOP_HZ, loop.timer.getHz());
+
+    // Sensor noise-sized movement doesn't wake it
+    loop.run(10000, rest.offsetBy(0.002), 0);
+    TEST_ASSERT_TRUE(loop.idle_monitor.isIdle());
+    TEST_ASSERT_EQUAL_UINT32(0, loop.wakes);
+
+    // Turning the knob wakes it back to the full rate
+    MultiTurnAngle turned = rest.offsetBy(0.1);
+    loop.run(1000 / MOTOR_IDLE_LOOP_HZ, turned, 0);
+    TEST_ASSERT_FALSE(loop.idle_monitor.isIdle());
+    TEST_ASSERT_EQUAL_UINT32(1, loop.wakes);
+    TEST_ASSERT_EQUAL_UINT32(ACTIVE_LOOP_HZ, loop.timer.getHz());
+    TEST_ASSERT_TRUE(loop.idle_ms >= 10000);
+
+    // Turning keeps it awake; then still again, and idle again
+    loop.run(MOTOR_IDLE_TIMEOUT_MS + 100, turned, 2);
+    TEST_ASSERT_FALSE(loop.idle_monitor.isIdle());
+    loop.run(MOTOR_IDLE_TIMEOUT_MS + 100, turned, 0);
+    TEST_ASSERT_TRUE(loop.idle_monitor.isIdle());
+    TEST_ASSERT_EQUAL_UINT32(2, loop.sleeps);
+    TEST_ASSERT_EQUAL_UINT32(MOTOR_IDLE_LOOP_HZ, loop.timer.getHz());
+
+    // And once more, so the wake after the second sleep is covered too
+    loop.run(1000 / MOTOR_IDLE_LOOP_HZ, rest, 0);
+    TEST_ASSERT_EQUAL_UINT32(2, loop.wakes);
+    TEST_ASSERT_EQUAL_UINT32(ACTIVE_LOOP_HZ, loop.timer.getHz());
+
+    TEST_ASSERT_EQUAL_UINT32(0, espErrorCheckFailures());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_stub_rejects_starting_a_running_timer);
+    RUN_TEST(test_loop_timer_restarts_at_any_rate);
+    RUN_TEST(test_idle_wake_idle);
+    return UNITY_END();
+}
@@ -0,0 +1,207 @@
+#include <math.h>
+#include <unity.h>
+
+#include <initializer_list>
+
+#include "benchmark.h"
+#include "knob_simulation.h"
+
+// The flywheel and spring-return motion models have to be passive: once the finger lets go, nothing but the
+// engine's own stored energy (the flywheel and the spring) may drive the knob, so the total energy of knob plus
+// model can only fall. Each case releases the knob with energy in it and tracks that total every tick.
+
+// Allowed rise of the total energy above its lowest point so far, relative to the energy at release: sensor
+// noise and the observer's lag show up as small wobbles, a model that feeds energy in as steady growth
+static const double MAX_ENERGY_RISE = 0.02;
+
+static PB_SmartKnobConfig motionConfig(PB_MotionModel model, float strength)
+{
+    PB_SmartKnobConfig config = {};
+    config.min_position = 0;
+    config.max_position = -1;
+    config.position_width_radians = 5 * M_PI / 180;
+    config.detent_strength_unit = strength;
+    config.endstop_strength_unit = 1;
+    config.snap_point = 1.1;
+    config.motion_model = model;
+    return config;
+}
+
+// Kinetic energy of the knob, plus what the active motion model stores, in joules
+static double totalEnergy(KnobSimulation &sim)
+{
+    const PlantParameters &plant = DEFAULT_PLANT_PARAMETERS;
+    HapticEngine &engine = sim.getEngine();
+    // Engine gains are torque units per radian; the plant turns those into N*m
+    double stiffness = engine.getDetentGains().p * plant.torque_per_unit;
+    double velocity = sim.getPlant().getVelocity();
+    double energy = 0.5 * plant.inertia * velocity * velocity;
+
+    MultiTurnAngle knob = MultiTurnAngle::fromRadians(sim.getPlant().getAngle());
+    const PB_SmartKnobConfig &config = engine.getConfig();
+    if (config.motion_model == PB_MotionModel_MOTION_FLYWHEEL)
+    {
+        const Flywheel &flywheel = engine.getFlywheel();
+        double flywheel_velocity = flywheel.getVelocity();
+        double offset = flywheel.getAngle().radiansFrom(knob);
+        energy += 0.5 * flywheel.getInertia() * plant.torque_per_unit * flywheel_velocity * flywheel_velocity;
+        energy += 0.5 * stiffness * offset * offset;
+    }
+    else if (config.motion_model == PB_MotionModel_MOTION_SPRING_RETURN)
+    {
+        double stretch = fabs(knob.radiansFrom(engine.getSpringHome())) - config.spring_dead_band_radians;
+        if (stretch > 0)
+        {
+            energy += 0.5 * stiffness * stretch * stretch;
+        }
+    }
+    return energy;
+}
+
+struct Release
+{
+    double initial_energy;
+    double max_rise; // relative to initial_energy
+};
+
+// Lets go of the knob for duration_ms, tracking the largest rise of the total energy above its running minimum
+static Release release(KnobSimulation &sim, uint32_t duration_ms)
+{
+    Release result = {};
+    result.initial_energy = totalEnergy(sim);
+    double lowest = result.initial_energy;
+    double max_rise = 0;
+    for (uint32_t i = 0; i < duration_ms; i++)
+    {
+        sim.tick(0);
+        double energy = totalEnergy(sim);
+        max_rise = fmax(max_rise, energy - lowest);
+        lowest = fmin(lowest, energy);
+    }
+    result.max_rise = max_rise / result.initial_energy;
+    return result;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+// Flick the knob and let the flywheel carry it
+void test_flywheel_is_passive(void)
+{
+    for (float strength : {0.5f, 1.0f, 2.0f})
+    {
+        for (float inertia : {0.002f, 0.01f, 0.05f})
+        {
+            for (float friction : {0.0f, 10.0f})
+            {
+                PB_SmartKnobConfig config = motionConfig(PB_MotionModel_MOTION_FLYWHEEL, strength);
+                config.flywheel_inertia = inertia;
+                config.flywheel_friction = friction;
+                KnobSimulation sim(config);
+                for (int i = 0; i < 200; i++)
+                {
+                    sim.tick(0);
+                }
+                // Push longer on the heavier flywheels, so they are all let go at comparable speeds
+                uint32_t flick_ms = 150 * fmaxf(1, inertia / 0.01f);
+                for (uint32_t i = 0; i < flick_ms; i++)
+                {
+                    sim.tick(3e-3);
+                }
+                float release_velocity = sim.getPlant().getVelocity();
+
+                Release result = release(sim, 8000);
+                float final_velocity = sim.getPlant().getVelocity();
+                report("strength %.1f inertia %.3f friction %4.1f: released at %6.1f rad/s, energy rise %.4f, final %.3f rad/s",
+                       strength, inertia, friction, release_velocity, result.max_rise, final_velocity);
+                TEST_ASSERT_TRUE(result.initial_energy > 0);
+                TEST_ASSERT_FLOAT_WITHIN(MAX_ENERGY_RISE, 0, result.max_rise);
+                if (friction > 0)
+                {
+                    TEST_ASSERT_FLOAT_WITHIN(0.05, 0, final_velocity);
+                }
+            }
+        }
+    }
+}
+
+// Hold the knob well away from home and let go: the spring pulls it back to the edge of the dead band
+void test_spring_return_is_passive(void)
+{
+    for (float strength : {0.5f, 1.0f, 2.0f})
+    {
+        for (float dead_band : {0.0f, 0.2f})
+        {
+            PB_SmartKnobConfig config = motionConfig(PB_MotionModel_MOTION_SPRING_RETURN, strength);
+            config.spring_dead_band_radians = dead_band;
+            config.min_position = -10;
+            config.max_position = 10;
+            KnobSimulation sim(config);
+            for (int i = 0; i < 200; i++)
+            {
+                sim.tick(0);
+            }
+            for (int i = 0; i < 1000; i++)
+            {
+                sim.tick(sim.fingerTorque(1.2, 0.03, 3e-4));
+            }
+
+            Release result = release(sim, 3000);
+            float from_home = MultiTurnAngle::fromRadians(sim.getPlant().getAngle()).radiansFrom(sim.getEngine().getSpringHome());
+            report("strength %.1f dead band %.1f: energy rise %.4f, rests %.3f rad from home", strength, dead_band, result.max_rise,
+                   from_home);
+            TEST_ASSERT_TRUE(result.initial_energy > 0);
+            TEST_ASSERT_FLOAT_WITHIN(MAX_ENERGY_RISE, 0, result.max_rise);
+            TEST_ASSERT_FLOAT_WITHIN(0.05, 0, sim.getPlant().getVelocity());
+            TEST_ASSERT_TRUE(fabsf(from_home) <= dead_band + 0.05f);
+        }
+    }
+}
+
+// Switch to the flywheel while a finger holds the knob off a detent: the flywheel starts where the knob is, so the
+// torque can only fall from what the detent was pushing back with, without a derivative kick from its old error
+void test_switching_motion_model_does_not_kick(void)
+{
+    for (float strength : {0.5f, 1.0f, 2.0f})
+    {
+        PB_SmartKnobConfig config = motionConfig(PB_MotionModel_MOTION_DETENTS, strength);
+        config.min_position = -10;
+        config.max_position = 10;
+        KnobSimulation sim(config);
+        for (int i = 0; i < 200; i++)
+        {
+            sim.tick(0);
+        }
+        float held = 0.6f * config.position_width_radians;
+        for (int i = 0; i < 1000; i++)
+        {
+            sim.tick(sim.fingerTorque(held, 0.03, 3e-4));
+        }
+        float held_torque = fabsf(sim.getOutput().torque);
+
+        config.motion_model = PB_MotionModel_MOTION_FLYWHEEL;
+        sim.getEngine().setConfig(config, sim.getInput().angle);
+        float peak_torque = 0;
+        for (int i = 0; i < 20; i++)
+        {
+            peak_torque = fmaxf(peak_torque, fabsf(sim.tick(sim.fingerTorque(held, 0.03, 3e-4)).torque));
+        }
+        report("strength %.1f: held with %.3f, peak %.3f after switching", strength, held_torque, peak_torque);
+        TEST_ASSERT_TRUE(held_torque > 0);
+        TEST_ASSERT_TRUE(peak_torque <= held_torque * 1.05f);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_flywheel_is_passive);
+    RUN_TEST(test_spring_return_is_passive);
+    RUN_TEST(test_switching_motion_model_does_not_kick);
+    return UNITY_END();
+}
@@ -0,0 +1,140 @@
+#include <math.h>
+#include <unity.h>
+
+#include <initializer_list>
+
+#include "benchmark.h"
+#include "haptics/angle_observer.h"
+#include "haptics/fixed_angle.h"
+#include "haptics/haptic_engine.h"
+
+// MultiTurnAngle keeps the same resolution however far the knob has turned. The soak turns the engine through
+// millions of revolutions, checking that a small nudge off the detent center always reads as the same
+// sub-position, which a float angle stops resolving after a few thousand turns.
+
+static const float NUDGE_RAD = 1e-4;
+static const uint32_t SOAK_REVOLUTIONS = 2000000;
+static const uint32_t CHECK_EVERY_REVOLUTIONS = 100000;
+
+static PB_SmartKnobConfig unboundedConfig(float position_width_radians)
+{
+    PB_SmartKnobConfig config = {};
+    config.min_position = 0;
+    config.max_position = -1;
+    config.position_width_radians = position_width_radians;
+    config.detent_strength_unit = 1;
+    config.endstop_strength_unit = 1;
+    // Snaps as soon as the knob is past the midpoint, so moving one width moves one position
+    config.snap_point = 0.55;
+    return config;
+}
+
+static HapticInput inputAt(MultiTurnAngle angle, uint32_t now_us)
+{
+    // Moving, so the idle re-centering leaves the detent alone
+    return {
+        .angle = angle,
+        .velocity = 1,
+        .acceleration = 0,
+        .now_us = now_us,
+    };
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_differences_are_independent_of_turns(void)
+{
+    for (int32_t turns : {0, 1000, -1000, 1000000, 1000000000, -2000000000, 2147483646})
+    {
+        MultiTurnAngle center = MultiTurnAngle::fromTurns(turns, 1.0f);
+        MultiTurnAngle nudged = center.offsetBy(NUDGE_RAD);
+        TEST_ASSERT_FLOAT_WITHIN(1e-9, NUDGE_RAD, nudged.radiansFrom(center));
+        // Offsetting there and back lands exactly where it started
+        TEST_ASSERT_TRUE(nudged.offsetBy(-NUDGE_RAD).turns_q32 == center.turns_q32);
+        // Across a turn boundary
+        MultiTurnAngle next_turn = MultiTurnAngle::fromTurns(turns + 1, 0.001f);
+        TEST_ASSERT_FLOAT_WITHIN(1e-6, 2 * M_PI + 0.001f - 1.0f, next_turn.radiansFrom(center));
+    }
+}
+
+void test_engine_soak_keeps_sub_position_resolution(void)
+{
+    // Three detents per revolution, so the soak stays quick
+    PB_SmartKnobConfig config = unboundedConfig(2 * M_PI / 3);
+    HapticEngine engine({.p = 4, .i = 0, .d = 0.04, .output_ramp = 10000, .limit = 10});
+    MultiTurnAngle center = MultiTurnAngle::fromTurns(0, 0);
+    engine.reset(center);
+    TEST_ASSERT_TRUE(engine.setConfig(config, center) == HapticConfigStatus::OK);
+
+    uint32_t now_us = 0;
+    float nudge_sub_position = engine.update(inputAt(center.offsetBy(-NUDGE_RAD), now_us += 1000)).sub_position_unit;
+    TEST_ASSERT_FLOAT_WITHIN(1e-7, NUDGE_RAD / config.position_width_radians, nudge_sub_position);
+    float float_worst = 0;
+
+    // Turn towards lower angles (higher positions) one detent per update
+    for (uint32_t revolution = 1; revolution <= SOAK_REVOLUTIONS; revolution++)
+    {
+        for (uint8_t detent = 0; detent < 3; detent++)
+        {
+            center = center.offsetBy(-config.position_width_radians);
+            engine.update(inputAt(center, now_us += 1000));
+        }
+        if (revolution % CHECK_EVERY_REVOLUTIONS != 0)
+        {
+            continue;
+        }
+
+        TEST_ASSERT_EQUAL_INT32(3 * revolution, engine.getCurrentPosition());
+        HapticOutput nudged = engine.update(inputAt(center.offsetBy(-NUDGE_RAD), now_us += 1000));
+        TEST_ASSERT_EQUAL_INT32(3 * revolution, nudged.current_position);
+        TEST_ASSERT_FLOAT_WITHIN(1e-7, nudge_sub_position, nudged.sub_position_unit);
+        engine.update(inputAt(center, now_us += 1000));
+
+        // What the same nudge looks like on a float angle this far out
+        float absolute = center.toRadians();
+        float float_nudge = (absolute - NUDGE_RAD) - absolute;
+        float_worst = fmaxf(float_worst, fabsf(float_nudge + NUDGE_RAD));
+    }
+    report("%u revolutions: nudge of %.0e rad still reads %.6f positions; as floats it would be off by up to %.1e rad",
+           SOAK_REVOLUTIONS, NUDGE_RAD, nudge_sub_position, float_worst);
+}
+
+void test_observer_tracks_the_same_far_out(void)
+{
+    // A steady 10 rev/s turn seen by the observer at 5 kHz, near zero and near the end of the range: the angle
+    // estimates relative to the measurements have to match to the float resolution of the differences
+    const float velocity = 20 * M_PI;
+    const uint32_t period_us = 200;
+    float lag[2] = {};
+    int32_t starts[2] = {0, 2147480000};
+    for (int run = 0; run < 2; run++)
+    {
+        AngleObserver observer(ObserverGains::criticallyDamped(50, period_us * 1e-6f));
+        MultiTurnAngle start = MultiTurnAngle::fromTurns(starts[run], 0);
+        observer.reset(start, 0);
+        MultiTurnAngle measured = start;
+        for (uint32_t i = 1; i <= 50000; i++)
+        {
+            measured = measured.offsetBy(velocity * period_us * 1e-6f);
+            observer.update(measured, i * period_us);
+        }
+        lag[run] = measured.radiansFrom(observer.getEstimate().angle);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3, velocity, observer.getEstimate().velocity);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-7, lag[0], lag[1]);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_differences_are_independent_of_turns);
+    RUN_TEST(test_engine_soak_keeps_sub_position_resolution);
+    RUN_TEST(test_observer_tracks_the_same_far_out);
+    return UNITY_END();
+}
@@ -0,0 +1,129 @@
+#include <unity.h>
+
+#include "sensors/press_detector.h"
+#include "benchmark.h"
+#include "trace_fixtures.h"
+
+// PressDetector on the synthetic strain traces in trace_fixtures.h, configured as the sensors task does: every
+// press has to be detected once, nothing else may be, and the onset-to-event latencies go into the histogram the
+// firmware reports through GET_PRESS_DETECTOR_STATS.
+
+static const float STRAIN_RELEASED = 0.3; // as in sensors_task.cpp
+
+struct TraceResult
+{
+    uint32_t detected;
+    uint32_t ghosts;
+    uint32_t releases;
+    bool early_onset; // an onset estimate before the press began
+    PressLatencyHistogram latency;
+};
+
+static TraceResult runTrace(const TraceCase &trace_case)
+{
+    PressDetector detector;
+    detector.configure(TRACE_PRESS_WEIGHT, STRAIN_RELEASED, PRESS_CUSUM_THRESHOLD, PRESS_BASELINE_TIME_CONSTANT_MS);
+    StrainTrace trace(trace_case);
+
+    TraceResult result = {};
+    bool hit[TRACE_PRESSES] = {};
+    for (uint32_t sample = 0; sample < trace.sampleCount(); sample++)
+    {
+        uint32_t now_us = StrainTrace::timestampUs(sample);
+        PressDetector::Edge edge = detector.addSample(trace.next(sample), now_us);
+        if (edge == PressDetector::Edge::RELEASED)
+        {
+            result.releases++;
+        }
+        if (edge != PressDetector::Edge::PRESSED)
+        {
+            continue;
+        }
+        int press = StrainTrace::pressAt(now_us);
+        if (press < 0 || hit[press])
+        {
+            result.ghosts++;
+            continue;
+        }
+        hit[press] = true;
+        result.detected++;
+        // The onset can't be placed more than a sample before the press started
+        if (detector.getOnsetUs() + TRACE_SAMPLE_US < tracePress(press).start_s * 1e6f)
+        {
+            result.early_onset = true;
+        }
+        result.latency.add(now_us - detector.getOnsetUs());
+    }
+    return result;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_detects_every_press_without_ghosts(void)
+{
+    for (const TraceCase &trace_case : TRACE_CASES)
+    {
+        TraceResult result = runTrace(trace_case);
+        report("%-14s %2u/%u detected, %u ghosts, latency avg %.1f ms, max %.1f ms", trace_case.name, (unsigned)result.detected,
+               (unsigned)TRACE_PRESSES, (unsigned)result.ghosts, result.latency.total_us / 1000.0 / (result.latency.count ? result.latency.count : 1),
+               result.latency.max_us / 1000.0);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(TRACE_PRESSES, result.detected, trace_case.name);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, result.ghosts, trace_case.name);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(TRACE_PRESSES, result.releases, trace_case.name);
+        TEST_ASSERT_FALSE_MESSAGE(result.early_onset, trace_case.name);
+
+        // The histogram counts every press, and at 80 SPS the CUSUM fires within a few samples of the onset (a
+        // couple more when the turning wobble is pulling the signal down)
+        const PressLatencyHistogram &latency = result.latency;
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(TRACE_PRESSES, latency.count, trace_case.name);
+        uint32_t bucketed = 0;
+        for (uint8_t i = 0; i < PressLatencyHistogram::BUCKETS; i++)
+        {
+            bucketed += latency.buckets[i];
+        }
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(latency.count, bucketed, trace_case.name);
+        TEST_ASSERT_TRUE_MESSAGE(latency.max_us <= 6 * TRACE_SAMPLE_US, trace_case.name);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, latency.buckets[PressLatencyHistogram::BUCKETS - 1], trace_case.name);
+    }
+}
+
+void test_latency_histogram_buckets(void)
+{
+    PressLatencyHistogram histogram;
+    histogram.add(0);
+    histogram.add(PressLatencyHistogram::BUCKET_US - 1);
+    histogram.add(PressLatencyHistogram::BUCKET_US);
+    histogram.add(7000);
+    // Past the last bucket: counted in it
+    histogram.add(1000000);
+
+    TEST_ASSERT_EQUAL_UINT32(2, histogram.buckets[0]);
+    TEST_ASSERT_EQUAL_UINT32(2, histogram.buckets[1]);
+    TEST_ASSERT_EQUAL_UINT32(1, histogram.buckets[PressLatencyHistogram::BUCKETS - 1]);
+    TEST_ASSERT_EQUAL_UINT32(5, histogram.count);
+    TEST_ASSERT_EQUAL_UINT32(1000000, histogram.max_us);
+    TEST_ASSERT_TRUE(histogram.total_us == 0 + 4999 + 5000 + 7000 + 1000000);
+
+    histogram.clear();
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.count);
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.max_us);
+    TEST_ASSERT_TRUE(histogram.total_us == 0);
+    for (uint8_t i = 0; i < PressLatencyHistogram::BUCKETS; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT32(0, histogram.buckets[i]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_detects_every_press_without_ghosts);
+    RUN_TEST(test_latency_histogram_buckets);
+    return UNITY_END();
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <math.h>
+#include <stdint.h>
+
+// Synthetic strain gauge traces for PressDetector, in the calibrated units the sensors task feeds it (a full press
+// is PRESS_WEIGHT), sampled at the HX711's 80 SPS. Each trace holds the same 40 presses of varied length and force,
+// on top of gaussian noise, a linear drift of the gauge and, for turning, the slow wobble of a hand turning the
+// knob. Knocks are bumps as high as a full press but only two samples long, half way between presses, that must not
+// count as presses. Generated from a fixed seed, so every host sees the same samples.
+
+static const float TRACE_PRESS_WEIGHT = 250; // PRESS_WEIGHT in platformio.ini
+static const uint32_t TRACE_SAMPLE_US = 1000000 / 80;
+static const float TRACE_RAMP_S = 0.03; // how long a finger takes to press in and to let go
+static const uint8_t TRACE_PRESSES = 40;
+static const float TRACE_DURATION_S = 5 + TRACE_PRESSES * 4 + 5;
+static const float TRACE_KNOCK_S = 0.025;
+
+struct TracePress
+{
+    float start_s;
+    float duration_s;
+    float level; // in full presses
+};
+
+// A press every 4 s from 5 s in, 150 to 500 ms long, at 1 to 2 full presses
+static TracePress tracePress(uint8_t i)
+{
+    return {
+        .start_s = 5.0f + i * 4.0f,
+        .duration_s = 0.15f + 0.05f * (i % 8),
+        .level = 1.0f + 0.25f * (i % 5),
+    };
+}
+
+struct TraceCase
+{
+    const char *name;
+    float noise;        // standard deviation, in full presses
+    float drift_per_s;  // units per second
+    float turning;      // amplitude of the turning wobble, in full presses
+    bool knocks;
+};
+
+static const TraceCase TRACE_CASES[] = {
+    {"clean", 0.02, 0, 0, false},
+    {"noisy", 0.08, 0, 0, false},
+    {"drift", 0.03, 3, 0, false},
+    {"drift+turning", 0.05, -3, 0.3, false},
+    {"knocks", 0.05, 0, 0, true},
+};
+
+class StrainTrace
+{
+public:
+    explicit StrainTrace(const TraceCase &trace_case, uint32_t seed = 1) : case_(trace_case), rng_state_(seed) {}
+
+    uint32_t sampleCount() const
+    {
+        return TRACE_DURATION_S * 1000000 / TRACE_SAMPLE_US;
+    }
+
+    static uint32_t timestampUs(uint32_t sample)
+    {
+        return sample * TRACE_SAMPLE_US;
+    }
+
+    // Call in order: the noise comes from a running generator
+    float next(uint32_t sample)
+    {
+        float t = timestampUs(sample) / 1e6f;
+        float value = case_.drift_per_s * t + case_.noise * TRACE_PRESS_WEIGHT * gaussian();
+        for (uint8_t i = 0; i < TRACE_PRESSES; i++)
+        {
+            TracePress press = tracePress(i);
+            float into = t - press.start_s;
+            if (into > 0 && into < press.duration_s)
+            {
+                float ramp = fminf(1, fminf(into, press.duration_s - into) / TRACE_RAMP_S);
+                value += press.level * TRACE_PRESS_WEIGHT * ramp;
+            }
+            // Starting half a sample early, so the knock covers exactly two samples
+            float after_knock = into - 2 + TRACE_SAMPLE_US / 2e6f;
+            if (case_.knocks && after_knock >= 0 && after_knock < TRACE_KNOCK_S)
+            {
+                value += TRACE_PRESS_WEIGHT;
+            }
+        }
+        value += case_.turning * TRACE_PRESS_WEIGHT * sinf(2 * M_PI * 0.7f * t);
+        return value;
+    }
+
+    // The press the trace is in at timestamp_us, or -1 between presses
+    static int pressAt(uint32_t timestamp_us)
+    {
+        float t = timestamp_us / 1e6f;
+        for (uint8_t i = 0; i < TRACE_PRESSES; i++)
+        {
+            TracePress press = tracePress(i);
+            if (t >= press.start_s && t < press.start_s + press.duration_s)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+private:
+    TraceCase case_;
+    uint32_t rng_state_;
+
+    // xorshift32 and Box-Muller, as in PlantModel
+    float uniform()
+    {
+        rng_state_ ^= rng_state_ << 13;
+        rng_state_ ^= rng_state_ >> 17;
+        rng_state_ ^= rng_state_ << 5;
+        return (rng_state_ >> 8) * (1.0f / (1 << 24));
+    }
+
+    float gaussian()
+    {
+        float u1 = fmaxf(uniform(), 1e-7f);
+        float u2 = uniform();
+        return sqrtf(-2 * logf(u1)) * cosf(2 * M_PI * u2);
+    }
+};
@@ -0,0 +1,174 @@
+#include <unity.h>
+
+#include "sensors/strain_filter.h"
+
+// StrainFilter on hand-made HX711 readings: decoding, the averaging window, glitch rejection and taring.
+
+static const int WINDOW = 10;
+
+// Feeds the same reading until the window holds nothing else
+static void fill(StrainFilter &filter, int32_t counts)
+{
+    for (int i = 0; i < WINDOW; i++)
+    {
+        filter.addSample(counts);
+    }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_decode_sign_extends_24_bits(void)
+{
+    TEST_ASSERT_EQUAL_INT32(0, hx711DecodeCounts(0));
+    TEST_ASSERT_EQUAL_INT32(1, hx711DecodeCounts(1));
+    TEST_ASSERT_EQUAL_INT32(8388607, hx711DecodeCounts(0x7FFFFF));
+    TEST_ASSERT_EQUAL_INT32(-8388608, hx711DecodeCounts(0x800000));
+    TEST_ASSERT_EQUAL_INT32(-1, hx711DecodeCounts(0xFFFFFF));
+    // Anything above the 24 bits is ignored
+    TEST_ASSERT_EQUAL_INT32(-1, hx711DecodeCounts(0x1FFFFFF));
+    TEST_ASSERT_EQUAL_INT32(5, hx711DecodeCounts(0xFF000005));
+}
+
+void test_first_window_tares(void)
+{
+    StrainFilter filter;
+    filter.setScale(2);
+    filter.reset();
+    for (int i = 0; i < WINDOW - 1; i++)
+    {
+        TEST_ASSERT_TRUE(filter.addSample(1000 + i) == StrainSampleStatus::TARING);
+    }
+    TEST_ASSERT_TRUE(filter.addSample(1000 + WINDOW - 1) == StrainSampleStatus::OK);
+    TEST_ASSERT_EQUAL_FLOAT(1004.5, filter.getOffset());
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 0, filter.getValue());
+
+    // A load is the window's average, less the offset, over the scale
+    fill(filter, 1204);
+    TEST_ASSERT_EQUAL_FLOAT((1204 - 1004.5) / 2, filter.getValue());
+}
+
+void test_window_averages_the_latest_readings(void)
+{
+    StrainFilter filter;
+    fill(filter, 0);
+    TEST_ASSERT_EQUAL_FLOAT(0, filter.getOffset());
+
+    // Half the window at 100: half way there
+    for (int i = 0; i < WINDOW / 2; i++)
+    {
+        filter.addSample(100);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(50, filter.getValue());
+
+    // The older readings drop out one by one
+    for (int i = 0; i < WINDOW / 2 - 1; i++)
+    {
+        filter.addSample(100);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(90, filter.getValue());
+    filter.addSample(100);
+    TEST_ASSERT_EQUAL_FLOAT(100, filter.getValue());
+}
+
+void test_window_is_exact_near_full_scale(void)
+{
+    // Readings close to the HX711's range, differing by one count: the window's sum is past a float's 24 bits, but
+    // the average still resolves half a count
+    StrainFilter filter;
+    fill(filter, 8388600);
+    for (int i = 0; i < WINDOW / 2; i++)
+    {
+        filter.addSample(8388601);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(0.5, filter.getValue());
+}
+
+void test_glitches_are_discarded(void)
+{
+    StrainFilter filter;
+    filter.setScale(2);
+    fill(filter, 1000);
+    float value = filter.getValue();
+
+    // More than 2000 units (4000 counts at this scale) off the last accepted reading
+    TEST_ASSERT_TRUE(filter.addSample(1000 + 4001) == StrainSampleStatus::DISCARDED);
+    TEST_ASSERT_TRUE(filter.addSample(1000 - 4001) == StrainSampleStatus::DISCARDED);
+    TEST_ASSERT_EQUAL_FLOAT(value, filter.getValue());
+
+    // Real steps just inside the limit go through, and move the reference along
+    TEST_ASSERT_TRUE(filter.addSample(1000 + 3999) == StrainSampleStatus::OK);
+    TEST_ASSERT_TRUE(filter.addSample(1000 + 7998) == StrainSampleStatus::OK);
+    TEST_ASSERT_TRUE(filter.addSample(1000 + 3999) == StrainSampleStatus::OK);
+}
+
+void test_stuck_sensor_needs_a_reset(void)
+{
+    StrainFilter filter;
+    fill(filter, 1000);
+
+    // The HX711 stuck at a rail: discarded, until it has been for too long
+    for (int i = 0; i < 20; i++)
+    {
+        TEST_ASSERT_TRUE(filter.addSample(-100000) == StrainSampleStatus::DISCARDED);
+    }
+    TEST_ASSERT_TRUE(filter.addSample(-100000) == StrainSampleStatus::RESET_NEEDED);
+    TEST_ASSERT_TRUE(filter.addSample(-100000) == StrainSampleStatus::RESET_NEEDED);
+
+    // After a reset any reading is accepted again, and the filter tares on the new window
+    filter.reset();
+    TEST_ASSERT_TRUE(filter.addSample(-100000) == StrainSampleStatus::TARING);
+    for (int i = 0; i < WINDOW - 1; i++)
+    {
+        filter.addSample(-100000);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(-100000, filter.getOffset());
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 0, filter.getValue());
+}
+
+void test_tare_zeroes_the_current_window(void)
+{
+    StrainFilter filter;
+    fill(filter, 50);
+    fill(filter, 80);
+    TEST_ASSERT_EQUAL_FLOAT(30, filter.getValue());
+
+    filter.tare();
+    TEST_ASSERT_EQUAL_FLOAT(80, filter.getOffset());
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 0, filter.getValue());
+}
+
+void test_tare_waits_for_a_full_window(void)
+{
+    StrainFilter filter;
+    filter.setOffset(10);
+    // Before the first reading there's nothing to tare on: it waits, without touching the offset
+    filter.tare();
+    TEST_ASSERT_EQUAL_FLOAT(10, filter.getOffset());
+    for (int i = 0; i < WINDOW - 1; i++)
+    {
+        TEST_ASSERT_TRUE(filter.addSample(300) == StrainSampleStatus::TARING);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(10, filter.getOffset());
+    TEST_ASSERT_TRUE(filter.addSample(300) == StrainSampleStatus::OK);
+    TEST_ASSERT_EQUAL_FLOAT(300, filter.getOffset());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_decode_sign_extends_24_bits);
+    RUN_TEST(test_first_window_tares);
+    RUN_TEST(test_window_averages_the_latest_readings);
+    RUN_TEST(test_window_is_exact_near_full_scale);
+    RUN_TEST(test_glitches_are_discarded);
+    RUN_TEST(test_stuck_sensor_needs_a_reset);
+    RUN_TEST(test_tare_zeroes_the_current_window);
+    RUN_TEST(test_tare_waits_for_a_full_window);
+    return UNITY_END();
+}
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""
+SmartKnob Config Flood
+
+Sends a burst of SmartKnobConfig messages as fast as the serial link takes them and reports how the motor task
+handled them (from MotorLoopStats): the motor task keeps only the newest config posted since its last haptic tick,
+so most of a flood is merged rather than queued, and each applied config is counted with its latency from being
+posted to being applied.
+
+The configs are written straight to the port instead of through the protocol's send queue, which waits for every
+ACK and so could never send faster than the knob answers. The knob still ACKs each one; those ACKs are ignored.
+
+Expected behavior:
+- Connects to SmartKnob device and resets the loop statistics
+- Sends --count configs, alternating the detent strength so each differs from the last
+- Prints how many configs were applied and merged, the apply latency, and any dropped commands
+- Leaves the knob on the last config sent
+"""
+
+import sys
+import os
+import time
+import logging
+import anyio
+
+# Add parent directory to path for imports
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from smartknob.protocol import SmartKnobConnection
+from smartknob.connection import find_smartknob_ports
+from smartknob.proto_gen import smartknob_pb2
+
+logging.basicConfig(level=logging.INFO, format="%(asctime)s %(levelname)s %(message)s")
+logger = logging.getLogger(__name__)
+
+
+def make_config(i):
+    return smartknob_pb2.SmartKnobConfig(
+        position=0,
+        min_position=0,
+        max_position=100,
+        position_width_radians=0.1,
+        detent_strength_unit=1.0 + 0.5 * (i % 2),
+        endstop_strength_unit=1.0,
+        snap_point=1.1,
+        id="config_flood",
+    )
+
+
+async def flood(port, baud, count):
+    received = []
+
+    def on_message(msg):
+        if msg.WhichOneof("payload") == "motor_loop_stats":
+            received.append(msg.motor_loop_stats)
+
+    async with SmartKnobConnection(port, baud) as knob:
+        knob.set_message_callback(on_message)
+        async with anyio.create_task_group() as tg:
+            tg.start_soon(knob.protocol.read_loop)
+
+            # The first request only resets the window
+            await knob.send_command(smartknob_pb2.GET_MOTOR_LOOP_STATS)
+            await anyio.sleep(0.5)
+            received.clear()
+
+            protocol = knob.protocol
+            start = time.monotonic()
+            for i in range(count):
+                message = smartknob_pb2.ToSmartknob(protocol_version=protocol.protocol_version)
+                protocol.last_nonce += 1
+                message.nonce = protocol.last_nonce
+                message.smartknob_config.CopyFrom(make_config(i))
+                protocol.serial.write(protocol._encode_frame(message.SerializeToString()))
+                if i % 16 == 15:
+                    # Let the read loop drain the ACKs
+                    await anyio.sleep(0)
+            protocol.serial.flush()
+            elapsed = time.monotonic() - start
+
+            # Let the last configs arrive before reading the counters
+            await anyio.sleep(0.5)
+            await knob.send_command(smartknob_pb2.GET_MOTOR_LOOP_STATS)
+            await anyio.sleep(0.5)
+            tg.cancel_scope.cancel()
+
+    return elapsed, received[-1] if received else None
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="SmartKnob Config Flood")
+    parser.add_argument("--port", help="Serial port (auto-detect if not specified)")
+    parser.add_argument("--baud", type=int, default=921600, help="Baud rate")
+    parser.add_argument("--count", type=int, default=500, help="Number of configs to send")
+    args = parser.parse_args()
+
+    port = args.port
+    if not port:
+        ports = find_smartknob_ports()
+        if not ports:
+            print("❌ No SmartKnob devices found")
+            print("💡 Try: python examples/config_flood.py --port <PORT>")
+            return 1
+        port = ports[0]
+        print(f"✅ Auto-detected SmartKnob: {port}")
+
+    try:
+        elapsed, stats = anyio.run(flood, port, args.baud, args.count)
+    except KeyboardInterrupt:
+        print("\n⏹️  Stopped by user")
+        return 1
+    if stats is None:
+        print("❌ No MotorLoopStats received")
+        return 1
+
+    handled = stats.configs_applied + stats.configs_merged
+    print("=" * 60)
+    print(f"Sent:              {args.count} configs in {elapsed * 1000:.0f} ms "
+          f"({args.count / max(elapsed, 1e-6):.0f}/s)")
+    print(f"Applied:           {stats.configs_applied}")
+    print(f"Merged:            {stats.configs_merged}")
+    print(f"Apply latency:     {stats.config_latency_avg_us} us avg, {stats.config_latency_max_us} us max")
+    print(f"Commands dropped:  {stats.commands_dropped}")
+    if stats.configs_applied == 0:
+        print("⚠️  Nothing applied: is the motor calibrated?")
+        return 1
+    if handled < args.count:
+        # Lost on the link (CRC errors, buffer overflow) or rejected as invalid
+        print(f"⚠️  {args.count - handled} configs were neither applied nor merged")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
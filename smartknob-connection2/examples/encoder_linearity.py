@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""
+SmartKnob Encoder Linearity Report
+
+Runs a motor calibration and reports the angle sensor's nonlinearity (INL) that was learned during it:
+the RMS error of the raw sensor angle, and the error that remains after the stored correction.
+
+Expected behavior:
+- Connects to SmartKnob device and starts MOTOR_CALIBRATE (or MOTOR_CALIBRATE_FAST with --fast)
+- Prints calibration progress as MotorCalibState messages arrive
+- Prints the linearity residuals before and after correction once calibration is done
+
+DO NOT touch the knob while the calibration runs.
+"""
+
+import sys
+import os
+import math
+import logging
+import anyio
+
+# Add parent directory to path for imports
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from smartknob.protocol import SmartKnobConnection
+from smartknob.connection import find_smartknob_ports
+from smartknob.proto_gen import smartknob_pb2
+
+logging.basicConfig(level=logging.INFO, format="%(asctime)s %(levelname)s %(message)s")
+logger = logging.getLogger(__name__)
+
+
+def format_angle(rad):
+    return f"{rad:.5f} rad ({math.degrees(rad):.3f}°)"
+
+
+async def run(port, baud, fast, timeout):
+    done = anyio.Event()
+    result = {}
+
+    def on_message(msg):
+        if msg.WhichOneof("payload") != "motor_calib_state":
+            return
+        state = msg.motor_calib_state
+        step = smartknob_pb2.MotorCalibStep.Name(state.step)
+        print(f"  {step:<28} {state.progress_percent:3d}%  {state.elapsed_ms / 1000:5.1f}s")
+        if state.step in (smartknob_pb2.MOTOR_CALIB_DONE, smartknob_pb2.MOTOR_CALIB_FAILED):
+            result["state"] = state
+            done.set()
+
+    async with SmartKnobConnection(port, baud) as knob:
+        knob.set_message_callback(on_message)
+        async with anyio.create_task_group() as tg:
+            tg.start_soon(knob.protocol.read_loop)
+
+            command = smartknob_pb2.MOTOR_CALIBRATE_FAST if fast else smartknob_pb2.MOTOR_CALIBRATE
+            print(f"🚀 Starting {'fast ' if fast else ''}calibration, do not touch the knob...")
+            await knob.send_command(command)
+
+            with anyio.move_on_after(timeout):
+                await done.wait()
+            tg.cancel_scope.cancel()
+
+    state = result.get("state")
+    if state is None:
+        print(f"❌ No calibration result within {timeout}s")
+        return 1
+    if state.step == smartknob_pb2.MOTOR_CALIB_FAILED:
+        print("❌ Calibration failed")
+        return 1
+
+    print("=" * 60)
+    print(f"Pole pairs:        {state.pole_pairs} (estimate {state.pole_pairs_estimate:.3f})")
+    print(f"Direction:         {'CW' if state.direction_cw else 'CCW'}")
+    if state.linearity_residual_before_rad == 0 and state.linearity_residual_after_rad == 0:
+        print("Sensor linearity:  not measured (sensor without linearization support, or sweep incomplete)")
+        return 0
+    before = state.linearity_residual_before_rad
+    after = state.linearity_residual_after_rad
+    print(f"RMS error before:  {format_angle(before)}")
+    print(f"RMS error after:   {format_angle(after)}")
+    if before > 0:
+        print(f"Improvement:       {100 * (1 - after / before):.0f}%")
+    return 0
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="SmartKnob Encoder Linearity Report")
+    parser.add_argument("--port", help="Serial port (auto-detect if not specified)")
+    parser.add_argument("--baud", type=int, default=921600, help="Baud rate")
+    parser.add_argument("--fast", action="store_true", help="Use the fast sweep calibration")
+    parser.add_argument("--timeout", type=float, default=120.0, help="Calibration timeout (seconds)")
+    args = parser.parse_args()
+
+    port = args.port
+    if not port:
+        ports = find_smartknob_ports()
+        if not ports:
+            print("❌ No SmartKnob devices found")
+            print("💡 Try: python examples/encoder_linearity.py --port <PORT>")
+            return 1
+        port = ports[0]
+        print(f"✅ Auto-detected SmartKnob: {port}")
+
+    try:
+        return anyio.run(run, port, args.baud, args.fast, args.timeout)
+    except KeyboardInterrupt:
+        print("\n⏹️  Stopped by user")
+        return 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
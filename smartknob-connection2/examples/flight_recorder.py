@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""
+SmartKnob Motor Flight Recorder
+
+The motor task always keeps the last second or so of haptic loop samples and freezes them when something goes wrong
+(velocity runaway, sensor CRC or status error, loop overrun). This script uploads the frozen window
+(FLIGHT_RECORDER_UPLOAD) and writes it to a CSV with the same columns as telemetry_scope.py, plus every signal the
+telemetry stream offers. It can also re-arm the recorder with other triggers, or freeze it on demand.
+
+Expected behavior:
+- Connects to SmartKnob device
+- With --trigger, freezes the recorder first (FLIGHT_RECORDER_TRIGGER)
+- Uploads and saves the window, printing what triggered it
+- With --arm, re-arms the recorder afterwards with the given triggers
+"""
+
+import sys
+import os
+import csv
+import logging
+import anyio
+
+# Add parent directory to path for imports
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from smartknob.protocol import SmartKnobConnection
+from smartknob.connection import find_smartknob_ports
+from smartknob.proto_gen import smartknob_pb2
+from telemetry_scope import SIGNALS, decode_frame
+
+logging.basicConfig(level=logging.INFO, format="%(asctime)s %(levelname)s %(message)s")
+logger = logging.getLogger(__name__)
+
+TRIGGERS = {
+    "runaway": smartknob_pb2.FLIGHT_TRIGGER_VELOCITY_RUNAWAY,
+    "sensor_crc": smartknob_pb2.FLIGHT_TRIGGER_SENSOR_CRC,
+    "sensor_status": smartknob_pb2.FLIGHT_TRIGGER_SENSOR_STATUS,
+    "overrun": smartknob_pb2.FLIGHT_TRIGGER_LOOP_OVERRUN,
+}
+
+
+async def upload(port, baud, trigger, arm, post_trigger_samples):
+    recordings = []
+
+    def on_message(msg):
+        if msg.WhichOneof("payload") == "flight_recording":
+            recordings.append(msg.flight_recording)
+
+    async with SmartKnobConnection(port, baud) as knob:
+        knob.set_message_callback(on_message)
+        async with anyio.create_task_group() as tg:
+            tg.start_soon(knob.protocol.read_loop)
+
+            if trigger:
+                await knob.send_command(smartknob_pb2.FLIGHT_RECORDER_TRIGGER)
+                # Wait for the post-trigger samples to be recorded
+                await anyio.sleep(1.0)
+
+            await knob.send_command(smartknob_pb2.FLIGHT_RECORDER_UPLOAD)
+            with anyio.move_on_after(5.0):
+                while not recordings or sum(r.frame.sample_count for r in recordings) < recordings[-1].total_samples:
+                    if recordings and recordings[-1].trigger == smartknob_pb2.FLIGHT_TRIGGER_NONE:
+                        break
+                    await anyio.sleep(0.1)
+
+            if arm is not None:
+                message = smartknob_pb2.ToSmartknob()
+                message.flight_recorder_config.triggers = arm
+                message.flight_recorder_config.post_trigger_samples = post_trigger_samples
+                await knob.protocol._enqueue_message(message)
+                await anyio.sleep(0.2)
+            tg.cancel_scope.cancel()
+
+    return recordings
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="SmartKnob Motor Flight Recorder")
+    parser.add_argument("--port", help="Serial port (auto-detect if not specified)")
+    parser.add_argument("--baud", type=int, default=921600, help="Baud rate")
+    parser.add_argument("--trigger", action="store_true", help="Freeze the recorder now, before uploading")
+    parser.add_argument("--arm", help=f"Re-arm after uploading with these comma separated triggers: "
+                                      f"{', '.join(TRIGGERS)} (empty for host trigger only)")
+    parser.add_argument("--post", type=int, default=256, help="Samples to keep after the trigger when re-arming")
+    parser.add_argument("--output", default="flight_recording.csv", help="CSV file to write")
+    args = parser.parse_args()
+
+    arm = None
+    if args.arm is not None:
+        arm = 0
+        for name in filter(None, (n.strip() for n in args.arm.split(","))):
+            if name not in TRIGGERS:
+                print(f"❌ Unknown trigger: {name}")
+                return 1
+            arm |= 1 << TRIGGERS[name]
+
+    port = args.port
+    if not port:
+        ports = find_smartknob_ports()
+        if not ports:
+            print("❌ No SmartKnob devices found")
+            print("💡 Try: python examples/flight_recorder.py --port <PORT>")
+            return 1
+        port = ports[0]
+        print(f"✅ Auto-detected SmartKnob: {port}")
+
+    try:
+        recordings = anyio.run(upload, port, args.baud, args.trigger, arm, args.post)
+    except KeyboardInterrupt:
+        print("\n⏹️  Stopped by user")
+        return 1
+    if not recordings:
+        print("❌ No FlightRecording received")
+        return 1
+    if recordings[0].trigger == smartknob_pb2.FLIGHT_TRIGGER_NONE:
+        print("ℹ️  The flight recorder has not triggered")
+        return 0
+
+    first = recordings[0]
+    signals = [s for s in sorted(SIGNALS) if first.frame.signals & (1 << s)]
+    received = 0
+    with open(args.output, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["sample", "timestamp_us", "trigger"] + [SIGNALS[s][1] for s in signals])
+        for recording in recordings:
+            if not recording.HasField("frame"):
+                continue
+            for index, timestamp_us, values in decode_frame(recording.frame):
+                writer.writerow([index, timestamp_us, int(index == first.trigger_sample)] + values)
+                received += 1
+
+    print("=" * 60)
+    print(f"Trigger:           {smartknob_pb2.FlightRecorderTrigger.Name(first.trigger)}")
+    print(f"Samples:           {received} of {first.total_samples}, trigger at sample {first.trigger_sample}")
+    print(f"💾 Saved to {args.output}")
+    if recordings[-1].trigger == smartknob_pb2.FLIGHT_TRIGGER_NONE:
+        print("⚠️  The recorder was re-armed during the upload, the window is incomplete")
+    if arm is not None:
+        print(f"🔁 Re-armed with triggers 0x{arm:02x}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+"""
+SmartKnob Frequency Response
+
+Runs an on-device frequency sweep (FrequencySweepConfig): the motor task adds a sine torque to the detent
+controller and measures the plant (angle per unit of torque) and the loop gain at log-spaced frequencies. The
+script prints a Bode table, finds the loop's crossover frequency with its phase and gain margins, and writes the
+points to a CSV file.
+
+To compare motors or gains, configure the knob (detent strength, position width) first, e.g. with
+App_communication.py, then run the sweep with the knob untouched. A phase margin below about 30 degrees means
+the detent is close to ringing; the plant columns let you predict what other controller gains would do.
+
+Expected behavior:
+- Connects to SmartKnob device and starts the sweep
+- Prints each point as it is measured (a default sweep takes about 25 seconds)
+- Stops the sweep on Ctrl+C
+"""
+
+import sys
+import os
+import csv
+import math
+import logging
+import anyio
+
+# Add parent directory to path for imports
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from smartknob.protocol import SmartKnobConnection
+from smartknob.connection import find_smartknob_ports
+from smartknob.proto_gen import smartknob_pb2
+
+logging.basicConfig(level=logging.INFO, format="%(asctime)s %(levelname)s %(message)s")
+logger = logging.getLogger(__name__)
+
+
+def unwrap_degrees(phases):
+    """Removes the 360 degree jumps between consecutive phases."""
+    unwrapped = []
+    for phase in phases:
+        if unwrapped:
+            phase -= 360 * round((phase - unwrapped[-1]) / 360)
+        unwrapped.append(phase)
+    return unwrapped
+
+
+def interpolate_crossing(points, values, target):
+    """Log-frequency interpolation of the first point where values crosses target; returns (index, fraction)."""
+    for i in range(1, len(points)):
+        a, b = values[i - 1], values[i]
+        if (a - target) * (b - target) <= 0 and a != b:
+            return i - 1, (target - a) / (b - a)
+    return None
+
+
+def margins(points):
+    """Crossover frequency, phase margin and gain margin (dB) of the loop, or None where not crossed."""
+    frequencies = [p.frequency_hz for p in points]
+    log_gains = [math.log10(max(p.loop_gain, 1e-12)) for p in points]
+    phases = unwrap_degrees([p.loop_phase_deg for p in points])
+
+    def at(crossing, values):
+        i, t = crossing
+        return values[i] + t * (values[i + 1] - values[i])
+
+    crossover_hz = phase_margin = gain_margin_db = None
+    crossing = interpolate_crossing(points, log_gains, 0)
+    if crossing:
+        crossover_hz = 10 ** at(crossing, [math.log10(f) for f in frequencies])
+        phase_margin = 180 + at(crossing, phases)
+        # The unwrapped phase may sit a whole turn away from -180
+        phase_margin -= 360 * round(phase_margin / 360)
+    # Gain margin where the phase passes through -180 (mod 360) above the crossover
+    if phases:
+        shift = 360 * round((phases[0] + 180) / 360)
+        crossing = interpolate_crossing(points, [p - shift for p in phases], -180)
+        if crossing:
+            gain_margin_db = -20 * at(crossing, log_gains)
+    return crossover_hz, phase_margin, gain_margin_db
+
+
+async def sweep(port, baud, config, on_point):
+    points = []
+    result = {"state": smartknob_pb2.FREQUENCY_SWEEP_RUNNING}
+
+    def on_message(msg):
+        if msg.WhichOneof("payload") != "frequency_response":
+            return
+        response = msg.frequency_response
+        if response.HasField("point") and response.point_index == len(points):
+            points.append(response.point)
+            on_point(response.point_index, response.point_count, response.point)
+        if not response.HasField("point"):
+            result["state"] = response.state
+
+    async with SmartKnobConnection(port, baud) as knob:
+        knob.set_message_callback(on_message)
+        async with anyio.create_task_group() as tg:
+            tg.start_soon(knob.protocol.read_loop)
+            message = smartknob_pb2.ToSmartknob()
+            message.frequency_sweep.CopyFrom(config)
+            await knob.protocol._enqueue_message(message)
+            try:
+                while result["state"] == smartknob_pb2.FREQUENCY_SWEEP_RUNNING:
+                    await anyio.sleep(0.1)
+            finally:
+                if result["state"] == smartknob_pb2.FREQUENCY_SWEEP_RUNNING:
+                    with anyio.CancelScope(shield=True):
+                        await knob.send_command(smartknob_pb2.FREQUENCY_SWEEP_STOP)
+                        await anyio.sleep(0.2)
+                tg.cancel_scope.cancel()
+
+    return result["state"], points
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="SmartKnob Frequency Response")
+    parser.add_argument("--port", help="Serial port (auto-detect if not specified)")
+    parser.add_argument("--baud", type=int, default=921600, help="Baud rate")
+    parser.add_argument("--start", type=float, default=0, help="First frequency, Hz (default 2)")
+    parser.add_argument("--stop", type=float, default=0, help="Last frequency, Hz (default 200)")
+    parser.add_argument("--points", type=int, default=0, help="Number of frequencies (default 24, max 48)")
+    parser.add_argument("--amplitude", type=float, default=0, help="Peak injected torque (default 0.3)")
+    parser.add_argument("--cycles", type=int, default=0, help="Periods measured per frequency (default 6)")
+    parser.add_argument("--output", default="frequency_response.csv", help="CSV file to write")
+    args = parser.parse_args()
+
+    config = smartknob_pb2.FrequencySweepConfig(start_hz=args.start, stop_hz=args.stop, points=args.points,
+                                                amplitude=args.amplitude, cycles=args.cycles)
+
+    port = args.port
+    if not port:
+        ports = find_smartknob_ports()
+        if not ports:
+            print("❌ No SmartKnob devices found")
+            print("💡 Try: python examples/frequency_response.py --port <PORT>")
+            return 1
+        port = ports[0]
+        print(f"✅ Auto-detected SmartKnob: {port}")
+
+    def on_point(index, count, point):
+        print(f"  [{index + 1:2d}/{count}] {point.frequency_hz:8.2f} Hz  "
+              f"plant {point.plant_gain:10.4g} rad/unit {point.plant_phase_deg:7.1f} deg  "
+              f"loop {point.loop_gain:8.3g} {point.loop_phase_deg:7.1f} deg")
+
+    print("⚠️  Don't touch the knob while the sweep runs")
+    try:
+        state, points = anyio.run(sweep, port, args.baud, config, on_point)
+    except KeyboardInterrupt:
+        print("\n⏹️  Stopped by user")
+        return 1
+
+    if state != smartknob_pb2.FREQUENCY_SWEEP_DONE:
+        print(f"❌ Sweep {smartknob_pb2.FrequencySweepState.Name(state)} after {len(points)} points "
+              f"(invalid config, knob moved too fast, or motor not calibrated)")
+    if not points:
+        return 1
+
+    with open(args.output, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["frequency_hz", "plant_gain", "plant_phase_deg", "loop_gain", "loop_phase_deg"])
+        for p in points:
+            writer.writerow([p.frequency_hz, p.plant_gain, p.plant_phase_deg, p.loop_gain, p.loop_phase_deg])
+
+    crossover_hz, phase_margin, gain_margin_db = margins(points)
+    print("=" * 60)
+    print(f"Crossover:    {f'{crossover_hz:.1f} Hz' if crossover_hz else 'not within the sweep'}")
+    print(f"Phase margin: {f'{phase_margin:.1f} deg' if phase_margin is not None else '-'}")
+    print(f"Gain margin:  {f'{gain_margin_db:.1f} dB' if gain_margin_db is not None else 'not within the sweep'}")
+    print(f"💾 Saved to {args.output}")
+    return 0 if state == smartknob_pb2.FREQUENCY_SWEEP_DONE else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
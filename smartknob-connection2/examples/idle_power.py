@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""
+SmartKnob Idle Power
+
+Configures the motor's low-power idle mode (MotorIdleConfig) and logs every MotorPowerEvent: when the knob has
+been left alone for the timeout, the motor loop drops to the idle loop rate with the driver off, and turning
+the knob, the proximity sensor or a command brings the detents back. Each wake is printed with its reason and
+the latency the knob measured, and the wake latencies are summarized on exit.
+
+To try it, run with a short timeout (e.g. --timeout 2000), leave the knob alone until it reports idle, then turn
+it, or wave a hand over the proximity sensor.
+
+Expected behavior:
+- Connects to SmartKnob device and sends the idle config (--disable turns the idle mode off and exits)
+- Prints a line for every transition to idle and back
+- Prints the wake latency per reason on Ctrl+C
+"""
+
+import sys
+import os
+import time
+import logging
+import anyio
+
+# Add parent directory to path for imports
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from smartknob.protocol import SmartKnobConnection
+from smartknob.connection import find_smartknob_ports
+from smartknob.proto_gen import smartknob_pb2
+
+logging.basicConfig(level=logging.INFO, format="%(asctime)s %(levelname)s %(message)s")
+logger = logging.getLogger(__name__)
+
+
+async def monitor(port, baud, config, wakes):
+    def on_message(msg):
+        if msg.WhichOneof("payload") != "motor_power_event":
+            return
+        event = msg.motor_power_event
+        stamp = time.strftime("%H:%M:%S")
+        if event.state == smartknob_pb2.MOTOR_POWER_IDLE:
+            print(f"  {stamp} 💤 idle after {event.previous_state_ms / 1000:.1f} s active")
+        else:
+            reason = smartknob_pb2.MotorWakeReason.Name(event.wake_reason).replace("MOTOR_WAKE_", "").lower()
+            print(f"  {stamp} ⚡ woke on {reason} after {event.previous_state_ms / 1000:.1f} s idle, "
+                  f"latency {event.wake_latency_us} us")
+            wakes.setdefault(reason, []).append(event.wake_latency_us)
+
+    async with SmartKnobConnection(port, baud) as knob:
+        knob.set_message_callback(on_message)
+        async with anyio.create_task_group() as tg:
+            tg.start_soon(knob.protocol.read_loop)
+            message = smartknob_pb2.ToSmartknob()
+            message.motor_idle_config.CopyFrom(config)
+            await knob.protocol._enqueue_message(message)
+            if not config.enabled:
+                await anyio.sleep(0.5)
+                tg.cancel_scope.cancel()
+                return
+            await anyio.sleep_forever()
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="SmartKnob Idle Power")
+    parser.add_argument("--port", help="Serial port (auto-detect if not specified)")
+    parser.add_argument("--baud", type=int, default=921600, help="Baud rate")
+    parser.add_argument("--timeout", type=int, default=0, help="Inactivity before going idle, ms (default 30000)")
+    parser.add_argument("--loop-hz", type=int, default=0, help="Loop rate while idle (default 200)")
+    parser.add_argument("--velocity-threshold", type=float, default=0,
+                        help="Knob velocity counted as untouched, rad/s (default 0.5)")
+    parser.add_argument("--wake-angle", type=float, default=0, help="Rotation that wakes the motor, rad (default 0.02)")
+    parser.add_argument("--disable", action="store_true", help="Turn the idle mode off")
+    args = parser.parse_args()
+
+    config = smartknob_pb2.MotorIdleConfig(enabled=not args.disable, timeout_ms=args.timeout, loop_hz=args.loop_hz,
+                                           velocity_threshold=args.velocity_threshold,
+                                           wake_angle_radians=args.wake_angle)
+
+    port = args.port
+    if not port:
+        ports = find_smartknob_ports()
+        if not ports:
+            print("❌ No SmartKnob devices found")
+            print("💡 Try: python examples/idle_power.py --port <PORT>")
+            return 1
+        port = ports[0]
+        print(f"✅ Auto-detected SmartKnob: {port}")
+
+    wakes = {}
+    if config.enabled:
+        print("👀 Watching power state transitions (Ctrl+C to stop)")
+    try:
+        anyio.run(monitor, port, args.baud, config, wakes)
+    except KeyboardInterrupt:
+        print("\n⏹️  Stopped by user")
+    if not config.enabled:
+        print("✅ Idle mode disabled")
+        return 0
+
+    if wakes:
+        print("=" * 60)
+        for reason, latencies in sorted(wakes.items()):
+            print(f"{reason:>9}: {len(latencies):3d} wakes, latency {sum(latencies) / len(latencies):7.0f} us avg, "
+                  f"{max(latencies)} us max")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""
+SmartKnob Motor Loop Benchmark
+
+Samples the motor task's loop timing (GET_MOTOR_LOOP_STATS) for a while and prints the averages: FOC loop period,
+busy time, and the CPU cycles spent in loopFOC() (sensor read plus commutation) per iteration.
+
+To compare two firmware builds (e.g. MT6701_SPI_ASYNC=0 and =1), save the result of the first with --save and
+pass it as --baseline when running the second; the cycles saved per FOC iteration are printed.
+
+Expected behavior:
+- Connects to SmartKnob device and resets the loop statistics
+- Requests MotorLoopStats once per interval and prints each window
+- Prints the totals over all windows (and the difference to the baseline)
+"""
+
+import sys
+import os
+import json
+import logging
+import anyio
+
+# Add parent directory to path for imports
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from smartknob.protocol import SmartKnobConnection
+from smartknob.connection import find_smartknob_ports
+from smartknob.proto_gen import smartknob_pb2
+
+logging.basicConfig(level=logging.INFO, format="%(asctime)s %(levelname)s %(message)s")
+logger = logging.getLogger(__name__)
+
+
+async def collect(port, baud, windows, interval):
+    received = []
+
+    def on_message(msg):
+        if msg.WhichOneof("payload") == "motor_loop_stats":
+            received.append(msg.motor_loop_stats)
+
+    async with SmartKnobConnection(port, baud) as knob:
+        knob.set_message_callback(on_message)
+        async with anyio.create_task_group() as tg:
+            tg.start_soon(knob.protocol.read_loop)
+
+            # The first request only resets the window
+            await knob.send_command(smartknob_pb2.GET_MOTOR_LOOP_STATS)
+            await anyio.sleep(interval)
+            received.clear()
+
+            for _ in range(windows):
+                await knob.send_command(smartknob_pb2.GET_MOTOR_LOOP_STATS)
+                await anyio.sleep(interval)
+                if received:
+                    s = received[-1]
+                    print(f"  {s.samples:6d} samples  period {s.period_avg_us:4d} us (max {s.period_max_us:4d})  "
+                          f"busy {s.busy_avg_us:3d} us (max {s.busy_max_us:4d})  "
+                          f"loopFOC {s.foc_avg_cycles:6d} cycles (max {s.foc_max_cycles:6d})  overruns {s.overruns}")
+            tg.cancel_scope.cancel()
+
+    return [s for s in received if s.samples > 0]
+
+
+def summarize(stats):
+    samples = sum(s.samples for s in stats)
+    return {
+        "foc_loop_hz": stats[0].foc_loop_hz,
+        "samples": samples,
+        "period_avg_us": sum(s.period_avg_us * s.samples for s in stats) / samples,
+        "busy_avg_us": sum(s.busy_avg_us * s.samples for s in stats) / samples,
+        "busy_max_us": max(s.busy_max_us for s in stats),
+        "foc_avg_cycles": sum(s.foc_avg_cycles * s.samples for s in stats) / samples,
+        "foc_max_cycles": max(s.foc_max_cycles for s in stats),
+        "overruns": sum(s.overruns for s in stats),
+    }
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="SmartKnob Motor Loop Benchmark")
+    parser.add_argument("--port", help="Serial port (auto-detect if not specified)")
+    parser.add_argument("--baud", type=int, default=921600, help="Baud rate")
+    parser.add_argument("--windows", type=int, default=10, help="Number of stats windows to collect")
+    parser.add_argument("--interval", type=float, default=1.0, help="Length of each window (seconds)")
+    parser.add_argument("--save", help="Write the summary to this JSON file")
+    parser.add_argument("--baseline", help="Summary JSON of another build to compare against")
+    args = parser.parse_args()
+
+    port = args.port
+    if not port:
+        ports = find_smartknob_ports()
+        if not ports:
+            print("❌ No SmartKnob devices found")
+            print("💡 Try: python examples/loop_stats.py --port <PORT>")
+            return 1
+        port = ports[0]
+        print(f"✅ Auto-detected SmartKnob: {port}")
+
+    try:
+        stats = anyio.run(collect, port, args.baud, args.windows, args.interval)
+    except KeyboardInterrupt:
+        print("\n⏹️  Stopped by user")
+        return 1
+    if not stats:
+        print("❌ No MotorLoopStats received (is the motor calibrated?)")
+        return 1
+
+    summary = summarize(stats)
+    print("=" * 60)
+    print(f"FOC loop:          {summary['foc_loop_hz']} Hz, {summary['samples']} iterations")
+    print(f"Period:            {summary['period_avg_us']:.1f} us")
+    print(f"Busy:              {summary['busy_avg_us']:.1f} us avg, {summary['busy_max_us']} us max")
+    print(f"loopFOC():         {summary['foc_avg_cycles']:.0f} cycles avg, {summary['foc_max_cycles']} max")
+    print(f"Overruns:          {summary['overruns']}")
+
+    if args.save:
+        with open(args.save, "w") as f:
+            json.dump(summary, f, indent=2)
+        print(f"💾 Saved to {args.save}")
+
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        saved = baseline["foc_avg_cycles"] - summary["foc_avg_cycles"]
+        print(f"vs baseline:       {saved:+.0f} cycles saved per FOC iteration "
+              f"({100 * saved / baseline['foc_avg_cycles']:.0f}%), "
+              f"busy {baseline['busy_avg_us'] - summary['busy_avg_us']:+.1f} us")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""
+SmartKnob Motion Models
+
+Sends a SmartKnobConfig selecting one of the knob's motion models and prints the position as the knob reports it.
+The models run on the knob itself, so nothing here streams position updates back to it:
+- flywheel: flick the knob and it keeps spinning, counting positions, until friction stops it
+- spring: the knob springs back to position 0 once it is turned past the dead band
+- ratchet: detents that only advance one way; turning back hits a wall
+- detents: plain detents, to go back to
+
+Expected behavior:
+- Connects to SmartKnob device and sends the config for --model
+- Prints every position change with the knob's sub-position
+- Leaves the knob on the config sent
+"""
+
+import sys
+import os
+import math
+import logging
+import anyio
+
+# Add parent directory to path for imports
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from smartknob.protocol import SmartKnobConnection
+from smartknob.connection import find_smartknob_ports
+from smartknob.proto_gen import smartknob_pb2
+
+logging.basicConfig(level=logging.INFO, format="%(asctime)s %(levelname)s %(message)s")
+logger = logging.getLogger(__name__)
+
+MODELS = {
+    "detents": smartknob_pb2.MOTION_DETENTS,
+    "flywheel": smartknob_pb2.MOTION_FLYWHEEL,
+    "spring": smartknob_pb2.MOTION_SPRING_RETURN,
+    "ratchet": smartknob_pb2.MOTION_RATCHET,
+}
+
+
+def make_config(args):
+    bounded = args.model in ("spring", "detents")
+    return smartknob_pb2.SmartKnobConfig(
+        position=0,
+        position_nonce=args.nonce,
+        min_position=-args.range if bounded else 0,
+        max_position=args.range if bounded else -1,
+        position_width_radians=math.radians(args.width),
+        detent_strength_unit=args.strength,
+        endstop_strength_unit=1.0,
+        snap_point=1.1,
+        id=f"motion_{args.model}",
+        motion_model=MODELS[args.model],
+        flywheel_inertia=args.inertia,
+        flywheel_friction=args.friction,
+        spring_dead_band_radians=math.radians(args.dead_band),
+        ratchet_decreasing=args.decreasing,
+    )
+
+
+async def watch(port, baud, config):
+    last = [None]
+
+    def on_message(msg):
+        if msg.WhichOneof("payload") != "smartknob_state":
+            return
+        state = msg.smartknob_state
+        if state.config.id != config.id or state.current_position == last[0]:
+            return
+        last[0] = state.current_position
+        print(f"  📍 {state.current_position:6d}  ({state.sub_position_unit:+.2f})")
+
+    async with SmartKnobConnection(port, baud) as knob:
+        knob.set_message_callback(on_message)
+        async with anyio.create_task_group() as tg:
+            tg.start_soon(knob.protocol.read_loop)
+            message = smartknob_pb2.ToSmartknob()
+            message.smartknob_config.CopyFrom(config)
+            await knob.protocol._enqueue_message(message)
+            await anyio.sleep_forever()
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="SmartKnob Motion Models")
+    parser.add_argument("--port", help="Serial port (auto-detect if not specified)")
+    parser.add_argument("--baud", type=int, default=921600, help="Baud rate")
+    parser.add_argument("--model", choices=sorted(MODELS), default="flywheel", help="Motion model")
+    parser.add_argument("--width", type=float, default=5, help="Position width, degrees")
+    parser.add_argument("--strength", type=float, default=1.0,
+                        help="Detent strength: coupling stiffness for the flywheel, spring stiffness for the spring")
+    parser.add_argument("--range", type=int, default=20, help="Positions either side of 0 (spring, detents)")
+    parser.add_argument("--inertia", type=float, default=0, help="Flywheel inertia (default 0.01)")
+    parser.add_argument("--friction", type=float, default=10, help="Flywheel friction, rad/s^2")
+    parser.add_argument("--dead-band", type=float, default=5, help="Spring dead band, degrees")
+    parser.add_argument("--decreasing", action="store_true", help="Ratchet towards lower positions")
+    args = parser.parse_args()
+    # A new nonce every run, so the knob starts from position 0
+    args.nonce = os.getpid() % 256
+
+    port = args.port
+    if not port:
+        ports = find_smartknob_ports()
+        if not ports:
+            print("❌ No SmartKnob devices found")
+            print("💡 Try: python examples/motion_models.py --port <PORT>")
+            return 1
+        port = ports[0]
+        print(f"✅ Auto-detected SmartKnob: {port}")
+
+    print(f"🎛️  {args.model}: turn the knob (Ctrl+C to stop)")
+    try:
+        anyio.run(watch, port, args.baud, make_config(args))
+    except KeyboardInterrupt:
+        print("\n⏹️  Stopped by user")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
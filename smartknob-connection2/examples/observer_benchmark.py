@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+"""
+SmartKnob Angle Observer Benchmark
+
+Runs a recorded encoder trace through the firmware's angle/velocity estimators offline and compares them:
+- legacy: the previous filter chain (MT6701 vector EWMA, SimpleFOC angle and velocity low-pass filters)
+- observer: the alpha-beta-gamma observer in firmware/src/haptics/angle_observer.cpp
+
+For each estimator it reports the velocity phase lag (the delay that best aligns the estimate with a zero-phase
+reference) and the noise (RMS velocity while the knob is at rest, RMS angle error while moving).
+
+The trace is a CSV file with one "timestamp_us,angle_rad" row per encoder sample (a header row is allowed),
+recorded at the FOC loop rate. Without a trace (--synthetic) a simulated knob turn with sensor noise and 14-bit
+quantization is used, and the true angle serves as reference.
+"""
+
+import sys
+import csv
+import math
+import random
+import argparse
+
+# Legacy chain parameters (see git history of mt6701_sensor.cpp and motor_task.cpp)
+LEGACY_SENSOR_ALPHA = 0.4
+SIMPLEFOC_VELOCITY_TF = 0.005
+
+
+def load_trace(path):
+    timestamps, angles = [], []
+    with open(path, newline="") as f:
+        for row in csv.reader(f):
+            try:
+                timestamps.append(int(float(row[0])))
+                angles.append(float(row[1]))
+            except (ValueError, IndexError):
+                continue  # header or malformed row
+    return timestamps, angles
+
+
+def synthetic_trace(rate_hz, seconds, noise_rad, seed=1):
+    rng = random.Random(seed)
+    lsb = 2 * math.pi / (1 << 14)
+    timestamps, measured, truth = [], [], []
+    period_us = int(1e6 / rate_hz)
+    for i in range(int(seconds * rate_hz)):
+        t = i / rate_hz
+        # At rest, a few back-and-forth turns of increasing speed, at rest again
+        angle = 0.0
+        if 1 < t < 5:
+            angle = 1.5 * math.sin(2 * math.pi * (0.5 + 0.5 * (t - 1)) * (t - 1))
+        timestamps.append(i * period_us)
+        truth.append(angle)
+        measured.append(round((angle + rng.gauss(0, noise_rad)) / lsb) * lsb)
+    return timestamps, measured, truth
+
+
+def low_pass(value, previous, dt, tf):
+    if tf <= 0:
+        return value
+    a = tf / (tf + dt)
+    return a * previous + (1 - a) * value
+
+
+def run_legacy(timestamps, angles, angle_tf):
+    x, y = math.cos(angles[0]), math.sin(angles[0])
+    angle_out, velocity_out = [], []
+    previous_angle = filtered_angle = angles[0]
+    velocity = 0.0
+    turns = 0.0
+    last_wrapped = angles[0] % (2 * math.pi)
+    for i, (t, z) in enumerate(zip(timestamps, angles)):
+        dt = (t - timestamps[i - 1]) * 1e-6 if i > 0 else 1e-3
+        x = math.cos(z) * LEGACY_SENSOR_ALPHA + x * (1 - LEGACY_SENSOR_ALPHA)
+        y = math.sin(z) * LEGACY_SENSOR_ALPHA + y * (1 - LEGACY_SENSOR_ALPHA)
+        wrapped = math.atan2(y, x) % (2 * math.pi)
+        # Full rotation tracking as in SimpleFOC's Sensor::update()
+        if wrapped - last_wrapped > 0.8 * 2 * math.pi:
+            turns -= 1
+        elif wrapped - last_wrapped < -0.8 * 2 * math.pi:
+            turns += 1
+        last_wrapped = wrapped
+        sensor_angle = turns * 2 * math.pi + wrapped
+        velocity = low_pass((sensor_angle - previous_angle) / dt, velocity, dt, SIMPLEFOC_VELOCITY_TF)
+        previous_angle = sensor_angle
+        filtered_angle = low_pass(sensor_angle, filtered_angle, dt, angle_tf)
+        angle_out.append(filtered_angle)
+        velocity_out.append(velocity)
+    return angle_out, velocity_out
+
+
+def run_observer(timestamps, angles, bandwidth_hz, period_s):
+    theta = math.exp(-2 * math.pi * bandwidth_hz * period_s)
+    alpha = 1 - theta ** 3
+    beta = 1.5 * (1 - theta) ** 2 * (1 + theta)
+    gamma = 0.5 * (1 - theta) ** 3
+    angle, velocity, acceleration = angles[0], 0.0, 0.0
+    angle_out, velocity_out = [], []
+    for i, (t, z) in enumerate(zip(timestamps, angles)):
+        if i > 0:
+            dt = (t - timestamps[i - 1]) * 1e-6
+            predicted = angle + velocity * dt + 0.5 * acceleration * dt * dt
+            velocity += acceleration * dt
+            residual = z - predicted
+            angle = predicted + alpha * residual
+            velocity += beta * residual / dt
+            acceleration += 2 * gamma * residual / (dt * dt)
+        angle_out.append(angle)
+        velocity_out.append(velocity)
+    return angle_out, velocity_out
+
+
+def zero_phase_reference(timestamps, angles, window):
+    # Centered moving average and centered differences: smooth, but without any phase shift
+    n = len(angles)
+    half = window // 2
+    prefix = [0.0]
+    for a in angles:
+        prefix.append(prefix[-1] + a)
+    smooth = []
+    for i in range(n):
+        lo, hi = max(0, i - half), min(n, i + half + 1)
+        smooth.append((prefix[hi] - prefix[lo]) / (hi - lo))
+    velocity = [0.0] * n
+    for i in range(n):
+        lo, hi = max(0, i - half), min(n - 1, i + half)
+        if hi > lo:
+            velocity[i] = (smooth[hi] - smooth[lo]) / ((timestamps[hi] - timestamps[lo]) * 1e-6)
+    return smooth, velocity
+
+
+def best_lag(estimate, reference, max_lag):
+    best, best_error = 0, float("inf")
+    n = len(reference)
+    for lag in range(max_lag + 1):
+        error = sum((estimate[i + lag] - reference[i]) ** 2 for i in range(0, n - lag, 4))
+        if error < best_error:
+            best, best_error = lag, error
+    return best
+
+
+def rest_mask(ref_velocity, threshold, window):
+    # At rest: the reference stays below threshold for at least window samples either side (turning points of
+    # a back-and-forth motion pass through zero velocity without the knob being at rest)
+    n = len(ref_velocity)
+    since, until = [0] * n, [0] * n
+    count = window
+    for i in range(n):
+        count = count + 1 if abs(ref_velocity[i]) < threshold else 0
+        since[i] = count
+    count = window
+    for i in reversed(range(n)):
+        count = count + 1 if abs(ref_velocity[i]) < threshold else 0
+        until[i] = count
+    return [since[i] > window and until[i] > window for i in range(n)]
+
+
+def report(name, angle, velocity, ref_angle, ref_velocity, at_rest, period_s):
+    still = [v for v, rest in zip(velocity, at_rest) if rest]
+    moving = [(a - r) ** 2 for a, r, rest in zip(angle, ref_angle, at_rest) if not rest]
+    lag = best_lag(velocity, ref_velocity, int(0.05 / period_s))
+    still_noise = math.sqrt(sum(v * v for v in still) / len(still)) if still else float("nan")
+    angle_error = math.sqrt(sum(moving) / len(moving)) if moving else float("nan")
+    print(f"{name:<10} velocity lag {lag * period_s * 1000:6.2f} ms   "
+          f"velocity noise at rest {still_noise:7.4f} rad/s   angle error moving {angle_error:.2e} rad")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="SmartKnob Angle Observer Benchmark")
+    parser.add_argument("trace", nargs="?", help="CSV trace of timestamp_us,angle_rad samples")
+    parser.add_argument("--synthetic", action="store_true", help="Use a simulated trace instead of a recording")
+    parser.add_argument("--bandwidth", type=float, default=50.0, help="Observer bandwidth (Hz), FOC_OBSERVER_BANDWIDTH_HZ")
+    parser.add_argument("--legacy-lpf", type=float, default=0.0, help="Legacy SimpleFOC angle LPF Tf (s), FOC_LPF")
+    parser.add_argument("--rate", type=float, default=5000.0, help="Sample rate of the synthetic trace (Hz)")
+    args = parser.parse_args()
+
+    if args.synthetic:
+        timestamps, angles, truth = synthetic_trace(args.rate, 6.0, 2e-4)
+        ref_angle = truth
+        ref_velocity = [0.0] + [(truth[i + 1] - truth[i - 1]) / ((timestamps[i + 1] - timestamps[i - 1]) * 1e-6)
+                                for i in range(1, len(truth) - 1)] + [0.0]
+    elif args.trace:
+        timestamps, angles = load_trace(args.trace)
+        if len(timestamps) < 100:
+            print("❌ Trace too short")
+            return 1
+        ref_angle, ref_velocity = zero_phase_reference(timestamps, angles, 41)
+    else:
+        parser.print_help()
+        return 1
+
+    period_s = (timestamps[-1] - timestamps[0]) * 1e-6 / (len(timestamps) - 1)
+    print(f"{len(timestamps)} samples at {1 / period_s:.0f} Hz")
+
+    legacy_angle, legacy_velocity = run_legacy(timestamps, angles, args.legacy_lpf)
+    observer_angle, observer_velocity = run_observer(timestamps, angles, args.bandwidth, period_s)
+    at_rest = rest_mask(ref_velocity, 0.05, int(0.05 / period_s))
+    report("legacy", legacy_angle, legacy_velocity, ref_angle, ref_velocity, at_rest, period_s)
+    report("observer", observer_angle, observer_velocity, ref_angle, ref_velocity, at_rest, period_s)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+SmartKnob Press Latency
+
+Optionally sets the press detector's CUSUM threshold and baseline time constant (PressDetectorConfig), then samples
+its statistics (GET_PRESS_DETECTOR_STATS) once per interval and prints the onset-to-event latency histogram of the
+presses in each window. Lower thresholds detect presses sooner but let smaller bumps through as ghost presses.
+
+Expected behavior:
+- Connects to SmartKnob device, applies the given configuration and resets the statistics
+- Requests PressDetectorStats once per interval and prints each window that had presses
+"""
+
+import sys
+import os
+import logging
+import anyio
+
+# Add parent directory to path for imports
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from smartknob.protocol import SmartKnobConnection
+from smartknob.connection import find_smartknob_ports
+from smartknob.proto_gen import smartknob_pb2
+
+logging.basicConfig(level=logging.INFO, format="%(asctime)s %(levelname)s %(message)s")
+logger = logging.getLogger(__name__)
+
+
+def print_window(stats):
+    print(f"--- {stats.window_ms} ms, threshold {stats.threshold:.2f}, baseline {stats.baseline_time_constant_ms} ms: "
+          f"{stats.presses} presses, latency avg {stats.latency_avg_us / 1000:.1f} ms, "
+          f"max {stats.latency_max_us / 1000:.1f} ms")
+    peak = max(stats.latency_histogram) if stats.latency_histogram else 0
+    for i, count in enumerate(stats.latency_histogram):
+        if count == 0:
+            continue
+        low_ms = i * stats.bucket_us / 1000
+        label = f"{low_ms:>5.0f}+ ms" if i == len(stats.latency_histogram) - 1 else f"{low_ms:>5.0f} ms"
+        print(f"  {label} {'#' * max(1, count * 40 // peak)} {count}")
+
+
+async def collect(port, baud, windows, interval, threshold, baseline_ms):
+    received = []
+
+    def on_message(msg):
+        if msg.WhichOneof("payload") == "press_detector_stats":
+            received.append(msg.press_detector_stats)
+
+    async with SmartKnobConnection(port, baud) as knob:
+        knob.set_message_callback(on_message)
+        async with anyio.create_task_group() as tg:
+            tg.start_soon(knob.protocol.read_loop)
+
+            if threshold or baseline_ms:
+                # Zero fields keep the firmware defaults
+                message = smartknob_pb2.ToSmartknob()
+                message.press_detector_config.threshold = threshold or 0
+                message.press_detector_config.baseline_time_constant_ms = baseline_ms or 0
+                await knob.protocol._enqueue_message(message)
+                print(f"🎛️  Sent press detector config: threshold {threshold}, baseline {baseline_ms} ms")
+
+            # The first request only resets the window
+            await knob.send_command(smartknob_pb2.GET_PRESS_DETECTOR_STATS)
+            await anyio.sleep(interval)
+            received.clear()
+
+            print("👆 Press the knob")
+            for _ in range(windows):
+                await knob.send_command(smartknob_pb2.GET_PRESS_DETECTOR_STATS)
+                await anyio.sleep(interval)
+                if received and received[-1].presses > 0:
+                    print_window(received[-1])
+            tg.cancel_scope.cancel()
+
+    return received
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="SmartKnob Press Latency")
+    parser.add_argument("--port", help="Serial port (auto-detect if not specified)")
+    parser.add_argument("--baud", type=int, default=921600, help="Baud rate")
+    parser.add_argument("--windows", type=int, default=10, help="Number of stats windows to collect")
+    parser.add_argument("--interval", type=float, default=5.0, help="Length of each window (seconds)")
+    parser.add_argument("--threshold", type=float, help="CUSUM threshold, in full presses (firmware default if omitted)")
+    parser.add_argument("--baseline-ms", type=int, help="Baseline time constant (firmware default if omitted)")
+    args = parser.parse_args()
+
+    port = args.port
+    if not port:
+        ports = find_smartknob_ports()
+        if not ports:
+            print("❌ No SmartKnob devices found")
+            print("💡 Try: python examples/press_latency.py --port <PORT>")
+            return 1
+        port = ports[0]
+        print(f"✅ Auto-detected SmartKnob: {port}")
+
+    try:
+        stats = anyio.run(collect, port, args.baud, args.windows, args.interval, args.threshold, args.baseline_ms)
+    except KeyboardInterrupt:
+        print("\n⏹️  Stopped by user")
+        return 1
+    if not stats:
+        print("❌ No PressDetectorStats received")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
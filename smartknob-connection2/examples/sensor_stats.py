@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+"""
+SmartKnob Sensor Scheduler Stats
+
+Samples the sensors task's job timing (GET_SENSOR_SCHEDULER_STATS) once per interval and prints a table per
+window: how long each job (sensor or bus) takes per run, how late it starts, and how often it overruns its deadline
+or has periods skipped. A job with a large run time is the one holding the others up.
+
+Expected behavior:
+- Connects to SmartKnob device and resets the statistics
+- Requests SensorSchedulerStats once per interval and prints each window
+"""
+
+import sys
+import os
+import logging
+import anyio
+
+# Add parent directory to path for imports
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from smartknob.protocol import SmartKnobConnection
+from smartknob.connection import find_smartknob_ports
+from smartknob.proto_gen import smartknob_pb2
+
+logging.basicConfig(level=logging.INFO, format="%(asctime)s %(levelname)s %(message)s")
+logger = logging.getLogger(__name__)
+
+
+def print_window(stats):
+    print(f"--- {stats.window_ms} ms")
+    print(f"  {'job':<14}{'period':>9}{'runs':>7}{'run avg':>9}{'run max':>9}{'late avg':>10}{'late max':>10}"
+          f"{'misses':>8}{'skipped':>9}")
+    for job in stats.jobs:
+        print(f"  {job.name:<14}{job.period_us:>9}{job.runs:>7}{job.run_avg_us:>9}{job.run_max_us:>9}"
+              f"{job.lateness_avg_us:>10}{job.lateness_max_us:>10}{job.misses:>8}{job.skipped:>9}")
+
+
+async def collect(port, baud, windows, interval):
+    received = []
+
+    def on_message(msg):
+        if msg.WhichOneof("payload") == "sensor_scheduler_stats":
+            received.append(msg.sensor_scheduler_stats)
+
+    async with SmartKnobConnection(port, baud) as knob:
+        knob.set_message_callback(on_message)
+        async with anyio.create_task_group() as tg:
+            tg.start_soon(knob.protocol.read_loop)
+
+            # The first request only resets the window
+            await knob.send_command(smartknob_pb2.GET_SENSOR_SCHEDULER_STATS)
+            await anyio.sleep(interval)
+            received.clear()
+
+            for _ in range(windows):
+                await knob.send_command(smartknob_pb2.GET_SENSOR_SCHEDULER_STATS)
+                await anyio.sleep(interval)
+                if received:
+                    print_window(received[-1])
+            tg.cancel_scope.cancel()
+
+    return received
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="SmartKnob Sensor Scheduler Stats")
+    parser.add_argument("--port", help="Serial port (auto-detect if not specified)")
+    parser.add_argument("--baud", type=int, default=921600, help="Baud rate")
+    parser.add_argument("--windows", type=int, default=10, help="Number of stats windows to collect")
+    parser.add_argument("--interval", type=float, default=1.0, help="Length of each window (seconds)")
+    args = parser.parse_args()
+
+    port = args.port
+    if not port:
+        ports = find_smartknob_ports()
+        if not ports:
+            print("❌ No SmartKnob devices found")
+            print("💡 Try: python examples/sensor_stats.py --port <PORT>")
+            return 1
+        port = ports[0]
+        print(f"✅ Auto-detected SmartKnob: {port}")
+
+    try:
+        stats = anyio.run(collect, port, args.baud, args.windows, args.interval)
+    except KeyboardInterrupt:
+        print("\n⏹️  Stopped by user")
+        return 1
+    if not stats:
+        print("❌ No SensorSchedulerStats received")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""
+SmartKnob Motor Telemetry Scope
+
+Subscribes to the motor loop telemetry stream (TelemetrySubscribe), decodes the delta-encoded TelemetryFrames and
+writes one CSV row per sample, with every signal converted back to SI units. Useful for tuning detent gains: record
+angle, detent error and torque while turning the knob, then plot the CSV.
+
+Expected behavior:
+- Connects to SmartKnob device and subscribes to the selected signals
+- Prints the sample rate and any samples the device dropped once per second
+- Unsubscribes on exit (duration elapsed or Ctrl+C)
+"""
+
+import sys
+import os
+import csv
+import math
+import time
+import logging
+import anyio
+
+# Add parent directory to path for imports
+sys.path.insert(0, os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+from smartknob.protocol import SmartKnobConnection
+from smartknob.connection import find_smartknob_ports
+from smartknob.proto_gen import smartknob_pb2
+
+logging.basicConfig(level=logging.INFO, format="%(asctime)s %(levelname)s %(message)s")
+logger = logging.getLogger(__name__)
+
+# Command line name, CSV column and scale from the integer unit documented on TelemetrySignal to SI units
+SIGNALS = {
+    smartknob_pb2.TELEMETRY_ANGLE: ("angle", "angle_rad", 2 * math.pi / 65536),
+    smartknob_pb2.TELEMETRY_VELOCITY: ("velocity", "velocity_rad_s", 1e-3),
+    smartknob_pb2.TELEMETRY_ACCELERATION: ("acceleration", "acceleration_rad_s2", 1.0),
+    smartknob_pb2.TELEMETRY_DETENT_ERROR: ("detent_error", "detent_error_rad", 1e-6),
+    smartknob_pb2.TELEMETRY_TORQUE: ("torque", "torque", 1e-4),
+    smartknob_pb2.TELEMETRY_POSITION: ("position", "position", 1),
+    smartknob_pb2.TELEMETRY_LOOP_BUSY: ("loop_busy", "loop_busy_us", 1),
+    smartknob_pb2.TELEMETRY_EVENTS: ("events", "events", 1),
+}
+
+
+def to_int32(value):
+    value &= 0xFFFFFFFF
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def decode_frame(frame):
+    """Yields (sample index, timestamp_us, [signal values]) for each sample in a TelemetryFrame."""
+    signals = [s for s in sorted(SIGNALS) if frame.signals & (1 << s)]
+    columns = 1 + len(signals)
+    previous = [0] * columns
+    for row in range(frame.sample_count):
+        values = []
+        for column in range(columns):
+            # Deltas wrap at 32 bits on the device; the timestamp is unsigned, the signals are signed
+            previous[column] = (previous[column] + frame.values[row * columns + column]) & 0xFFFFFFFF
+            values.append(previous[column] if column == 0 else to_int32(previous[column]))
+        yield frame.first_sample + row, values[0], [v * SIGNALS[s][2] for s, v in zip(signals, values[1:])]
+
+
+def subscribe_message(signals, decimation):
+    message = smartknob_pb2.ToSmartknob()
+    message.telemetry_subscribe.signals = signals
+    message.telemetry_subscribe.decimation = decimation
+    return message
+
+
+async def record(port, baud, signals, decimation, duration, writer):
+    stats = {"samples": 0, "dropped": 0, "gaps": 0}
+    next_sample = [None]
+
+    def on_message(msg):
+        if msg.WhichOneof("payload") != "telemetry_frame":
+            return
+        frame = msg.telemetry_frame
+        stats["dropped"] += frame.dropped
+        if frame.sample_count and next_sample[0] is not None and frame.first_sample != next_sample[0]:
+            stats["gaps"] += 1
+        for index, timestamp_us, values in decode_frame(frame):
+            writer.writerow([index, timestamp_us] + values)
+            stats["samples"] += 1
+            next_sample[0] = index + 1
+
+    async with SmartKnobConnection(port, baud) as knob:
+        knob.set_message_callback(on_message)
+        async with anyio.create_task_group() as tg:
+            tg.start_soon(knob.protocol.read_loop)
+            await knob.protocol._enqueue_message(subscribe_message(signals, decimation))
+            try:
+                start = time.time()
+                while duration <= 0 or time.time() - start < duration:
+                    before = dict(stats)
+                    await anyio.sleep(1.0)
+                    print(f"  {stats['samples'] - before['samples']:6d} samples/s  "
+                          f"dropped {stats['dropped'] - before['dropped']:5d}  total {stats['samples']}")
+            finally:
+                with anyio.CancelScope(shield=True):
+                    await knob.protocol._enqueue_message(subscribe_message(0, 0))
+                    await anyio.sleep(0.2)
+                tg.cancel_scope.cancel()
+
+    return stats
+
+
+def main():
+    import argparse
+
+    names = {name: s for s, (name, _, _) in SIGNALS.items()}
+
+    parser = argparse.ArgumentParser(description="SmartKnob Motor Telemetry Scope")
+    parser.add_argument("--port", help="Serial port (auto-detect if not specified)")
+    parser.add_argument("--baud", type=int, default=921600, help="Baud rate")
+    parser.add_argument("--signals", default="angle,velocity,detent_error,torque",
+                        help=f"Comma separated signals to record: {', '.join(sorted(names))}")
+    parser.add_argument("--decimation", type=int, default=1, help="Record every Nth haptic loop tick (1 kHz)")
+    parser.add_argument("--duration", type=float, default=10.0, help="Seconds to record (0 = until Ctrl+C)")
+    parser.add_argument("--output", default="telemetry.csv", help="CSV file to write")
+    args = parser.parse_args()
+
+    signals = 0
+    for name in args.signals.split(","):
+        if name.strip() not in names:
+            print(f"❌ Unknown signal: {name}")
+            return 1
+        signals |= 1 << names[name.strip()]
+
+    port = args.port
+    if not port:
+        ports = find_smartknob_ports()
+        if not ports:
+            print("❌ No SmartKnob devices found")
+            print("💡 Try: python examples/telemetry_scope.py --port <PORT>")
+            return 1
+        port = ports[0]
+        print(f"✅ Auto-detected SmartKnob: {port}")
+
+    with open(args.output, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["sample", "timestamp_us"] + [SIGNALS[s][1] for s in sorted(SIGNALS) if signals & (1 << s)])
+        try:
+            stats = anyio.run(record, port, args.baud, signals, args.decimation, args.duration, writer)
+        except KeyboardInterrupt:
+            print("\n⏹️  Stopped by user")
+            return 0
+
+    print("=" * 60)
+    print(f"Samples:           {stats['samples']}")
+    print(f"Dropped on device: {stats['dropped']} ({stats['gaps']} gaps)")
+    print(f"💾 Saved to {args.output}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -26,7 +26,7 @@ from . import nanopb_pb2 as nanopb__pb2
 from . import settings_pb2 as settings__pb2
 
 
-DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x0fsmartknob.proto\x12\x02PB\x1a\x0cnanopb.proto\x1a\x0esettings.proto\"\x9a\x02\n\rFromSmartKnob\x12\x1f\n\x10protocol_version\x18\x01 \x01(\rB\x05\x92?\x02\x18\x08\x12\x18\n\x04knob\x18\x03 \x01(\x0b\x32\x08.PB.KnobH\x00\x12\x16\n\x03\x61\x63k\x18\x04 \x01(\x0b\x32\x07.PB.AckH\x00\x12\x16\n\x03log\x18\x05 \x01(\x0b\x32\x07.PB.LogH\x00\x12-\n\x0fsmartknob_state\x18\x06 \x01(\x0b\x32\x12.PB.SmartKnobStateH\x00\x12\x30\n\x11motor_calib_state\x18\x07 \x01(\x0b\x32\x13.PB.MotorCalibStateH\x00\x12\x32\n\x12strain_calib_state\x18\x08 \x01(\x0b\x32\x14.PB.StrainCalibStateH\x00\x42\t\n\x07payload\"\xdf\x02\n\x0bToSmartknob\x12\x1f\n\x10protocol_version\x18\x01 \x01(\rB\x05\x92?\x02\x18\x08\x12\r\n\x05nonce\x18\x02 \x01(\r\x12)\n\rrequest_state\x18\x03 \x01(\x0b\x32\x10.PB.RequestStateH\x00\x12/\n\x10smartknob_config\x18\x04 \x01(\x0b\x32\x13.PB.SmartKnobConfigH\x00\x12\x31\n\x11smartknob_command\x18\x05 \x01(\x0e\x32\x14.PB.SmartKnobCommandH\x00\x12\x33\n\x12strain_calibration\x18\x06 \x01(\x0b\x32\x15.PB.StrainCalibrationH\x00\x12&\n\x08settings\x18\x07 \x01(\x0b\x32\x12.SETTINGS.SettingsH\x00\x12)\n\rapp_component\x18\x08 \x01(\x0b\x32\x10.PB.AppComponentH\x00\x42\t\n\x07payload\"\x9b\x01\n\x04Knob\x12\x1a\n\x0bmac_address\x18\x01 \x01(\tB\x05\x92?\x02\x08\x32\x12\x19\n\nip_address\x18\x02 \x01(\tB\x05\x92?\x02\x08\x32\x12\x36\n\x11persistent_config\x18\x03 \x01(\x0b\x32\x1b.PB.PersistentConfiguration\x12$\n\x08settings\x18\x04 \x01(\x0b\x32\x12.SETTINGS.Settings\"%\n\x0fMotorCalibState\x12\x12\n\ncalibrated\x18\x01 \x01(\x08\"6\n\x10StrainCalibState\x12\x0c\n\x04step\x18\x01 \x01(\r\x12\x14\n\x0cstrain_scale\x18\x02 \x01(\x02\"\x14\n\x03\x41\x63k\x12\r\n\x05nonce\x18\x01 \x01(\r\"b\n\x03Log\x12\x13\n\x03msg\x18\x01 \x01(\tB\x06\x92?\x03\x08\xff\x01\x12\x1b\n\x05level\x18\x02 \x01(\x0e\x32\x0c.PB.LogLevel\x12\x16\n\x06origin\x18\x03 \x01(\tB\x06\x92?\x03\x08\x80\x01\x12\x11\n\tisVerbose\x18\x04 \x01(\x08\"\x86\x01\n\x0eSmartKnobState\x12\x18\n\x10\x63urrent_position\x18\x01 \x01(\x05\x12\x19\n\x11sub_position_unit\x18\x02 \x01(\x02\x12#\n\x06\x63onfig\x18\x03 \x01(\x0b\x32\x13.PB.SmartKnobConfig\x12\x1a\n\x0bpress_nonce\x18\x04 \x01(\rB\x05\x92?\x02\x18\x08\"\xdf\x02\n\x0fSmartKnobConfig\x12\x10\n\x08position\x18\x01 \x01(\x05\x12\x19\n\x11sub_position_unit\x18\x02 \x01(\x02\x12\x1d\n\x0eposition_nonce\x18\x03 \x01(\rB\x05\x92?\x02\x18\x08\x12\x14\n\x0cmin_position\x18\x04 \x01(\x05\x12\x14\n\x0cmax_position\x18\x05 \x01(\x05\x12\x1e\n\x16position_width_radians\x18\x06 \x01(\x02\x12\x1c\n\x14\x64\x65tent_strength_unit\x18\x07 \x01(\x02\x12\x1d\n\x15\x65ndstop_strength_unit\x18\x08 \x01(\x02\x12\x12\n\nsnap_point\x18\t \x01(\x02\x12\x11\n\x02id\x18\n \x01(\tB\x05\x92?\x02\x08@\x12\x1f\n\x10\x64\x65tent_positions\x18\x0b \x03(\x05\x42\x05\x92?\x02\x10\x05\x12\x17\n\x0fsnap_point_bias\x18\x0c \x01(\x02\x12\x16\n\x07led_hue\x18\r \x01(\x05\x42\x05\x92?\x02\x18\x10\"\x0e\n\x0cRequestState\"e\n\x17PersistentConfiguration\x12\x0f\n\x07version\x18\x01 \x01(\r\x12#\n\x05motor\x18\x02 \x01(\x0b\x32\x14.PB.MotorCalibration\x12\x14\n\x0cstrain_scale\x18\x03 \x01(\x02\"p\n\x10MotorCalibration\x12\x12\n\ncalibrated\x18\x01 \x01(\x08\x12\x1e\n\x16zero_electrical_offset\x18\x02 \x01(\x02\x12\x14\n\x0c\x64irection_cw\x18\x03 \x01(\x08\x12\x12\n\npole_pairs\x18\x04 \x01(\r\"8\n\x0bStrainState\x12\x14\n\x0cpress_weight\x18\x01 \x01(\x05\x12\x13\n\x0bpress_value\x18\x02 \x01(\x02\"/\n\x11StrainCalibration\x12\x1a\n\x12\x63\x61libration_weight\x18\x01 \x01(\x02\"\xd0\x01\n\x0c\x41ppComponent\x12\x1b\n\x0c\x63omponent_id\x18\x01 \x01(\tB\x05\x92?\x02\x08 \x12\x1f\n\x04type\x18\x02 \x01(\x0e\x32\x11.PB.ComponentType\x12\x1b\n\x0c\x64isplay_name\x18\x03 \x01(\tB\x05\x92?\x02\x08@\x12\"\n\x06toggle\x18\x04 \x01(\x0b\x32\x10.PB.ToggleConfigH\x00\x12-\n\x0cmulti_choice\x18\x06 \x01(\x0b\x32\x15.PB.MultiChoiceConfigH\x00\x42\x12\n\x10\x63omponent_config\"\xda\x01\n\x0cToggleConfig\x12\x18\n\toff_label\x18\x01 \x01(\tB\x05\x92?\x02\x08 \x12\x17\n\x08on_label\x18\x02 \x01(\tB\x05\x92?\x02\x08 \x12\x12\n\nsnap_point\x18\x03 \x01(\x02\x12\x17\n\x0fsnap_point_bias\x18\x04 \x01(\x02\x12\x1c\n\x14\x64\x65tent_strength_unit\x18\x05 \x01(\x02\x12\x1a\n\x0boff_led_hue\x18\x06 \x01(\x05\x42\x05\x92?\x02\x18\x10\x12\x19\n\non_led_hue\x18\x07 \x01(\x05\x42\x05\x92?\x02\x18\x10\x12\x15\n\rinitial_state\x18\x08 \x01(\x08\"\xca\x01\n\x11MultiChoiceConfig\x12\x18\n\x07options\x18\x01 \x03(\tB\x07\x92?\x04\x08 \x10\x10\x12\x1c\n\rinitial_index\x18\x02 \x01(\x05\x42\x05\x92?\x02\x18\x08\x12\x13\n\x0bwrap_around\x18\x03 \x01(\x08\x12\x13\n\x0b\x63\x65nter_text\x18\x04 \x01(\x08\x12\x1c\n\x14\x64\x65tent_strength_unit\x18\x05 \x01(\x02\x12\x1d\n\x15\x65ndstop_strength_unit\x18\x06 \x01(\x02\x12\x16\n\x07led_hue\x18\x07 \x01(\x05\x42\x05\x92?\x02\x18\x10*D\n\x08LogLevel\x12\x08\n\x04INFO\x10\x00\x12\x0b\n\x07WARNING\x10\x01\x12\t\n\x05\x45RROR\x10\x02\x12\t\n\x05\x44\x45\x42UG\x10\x03\x12\x0b\n\x07VERBOSE\x10\x04*P\n\x10SmartKnobCommand\x12\x11\n\rGET_KNOB_INFO\x10\x00\x12\x13\n\x0fMOTOR_CALIBRATE\x10\x01\x12\x14\n\x10STRAIN_CALIBRATE\x10\x02*-\n\rComponentType\x12\n\n\x06TOGGLE\x10\x00\x12\x10\n\x0cMULTI_CHOICE\x10\x02\x62\x06proto3')
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x0fsmartknob.proto\x12\x02PB\x1a\x0cnanopb.proto\x1a\x0esettings.proto\"\x85\x05\n\rFromSmartKnob\x12\x1f\n\x10protocol_version\x18\x01 \x01(\rB\x05\x92?\x02\x18\x08\x12\x18\n\x04knob\x18\x03 \x01(\x0b\x32\x08.PB.KnobH\x00\x12\x16\n\x03\x61\x63k\x18\x04 \x01(\x0b\x32\x07.PB.AckH\x00\x12\x16\n\x03log\x18\x05 \x01(\x0b\x32\x07.PB.LogH\x00\x12-\n\x0fsmartknob_state\x18\x06 \x01(\x0b\x32\x12.PB.SmartKnobStateH\x00\x12\x30\n\x11motor_calib_state\x18\x07 \x01(\x0b\x32\x13.PB.MotorCalibStateH\x00\x12\x32\n\x12strain_calib_state\x18\x08 \x01(\x0b\x32\x14.PB.StrainCalibStateH\x00\x12.\n\x10motor_loop_stats\x18\t \x01(\x0b\x32\x12.PB.MotorLoopStatsH\x00\x12-\n\x0ftelemetry_frame\x18\n \x01(\x0b\x32\x12.PB.TelemetryFrameH\x00\x12/\n\x10\x66light_recording\x18\x0b \x01(\x0b\x32\x13.PB.FlightRecordingH\x00\x12\x33\n\x12\x66requency_response\x18\x0c \x01(\x0b\x32\x15.PB.FrequencyResponseH\x00\x12\x30\n\x11motor_power_event\x18\r \x01(\x0b\x32\x13.PB.MotorPowerEventH\x00\x12:\n\x16sensor_scheduler_stats\x18\x0e \x01(\x0b\x32\x18.PB.SensorSchedulerStatsH\x00\x12\x36\n\x14press_detector_stats\x18\x0f \x01(\x0b\x32\x16.PB.PressDetectorStatsH\x00\x42\t\n\x07payload\"\xc6\x06\n\x0bToSmartknob\x12\x1f\n\x10protocol_version\x18\x01 \x01(\rB\x05\x92?\x02\x18\x08\x12\r\n\x05nonce\x18\x02 \x01(\r\x12)\n\rrequest_state\x18\x03 \x01(\x0b\x32\x10.PB.RequestStateH\x00\x12/\n\x10smartknob_config\x18\x04 \x01(\x0b\x32\x13.PB.SmartKnobConfigH\x00\x12\x31\n\x11smartknob_command\x18\x05 \x01(\x0e\x32\x14.PB.SmartKnobCommandH\x00\x12\x33\n\x12strain_calibration\x18\x06 \x01(\x0b\x32\x15.PB.StrainCalibrationH\x00\x12&\n\x08settings\x18\x07 \x01(\x0b\x32\x12.SETTINGS.SettingsH\x00\x12)\n\rapp_component\x18\x08 \x01(\x0b\x32\x10.PB.AppComponentH\x00\x12%\n\x0bplay_haptic\x18\t \x01(\x0b\x32\x0e.PB.PlayHapticH\x00\x12-\n\x0fhaptic_waveform\x18\n \x01(\x0b\x32\x12.PB.HapticWaveformH\x00\x12+\n\x0etorque_profile\x18\x0b \x01(\x0b\x32\x11.PB.TorqueProfileH\x00\x12#\n\ndetent_set\x18\x0c \x01(\x0b\x32\r.PB.DetentSetH\x00\x12\x35\n\x13telemetry_subscribe\x18\r \x01(\x0b\x32\x16.PB.TelemetrySubscribeH\x00\x12:\n\x16\x66light_recorder_config\x18\x0e \x01(\x0b\x32\x18.PB.FlightRecorderConfigH\x00\x12\x33\n\x0f\x66requency_sweep\x18\x0f \x01(\x0b\x32\x18.PB.FrequencySweepConfigH\x00\x12)\n\rgain_schedule\x18\x10 \x01(\x0b\x32\x10.PB.GainScheduleH\x00\x12\x30\n\x11motor_idle_config\x18\x11 \x01(\x0b\x32\x13.PB.MotorIdleConfigH\x00\x12\x38\n\x15press_detector_config\x18\x12 \x01(\x0b\x32\x17.PB.PressDetectorConfigH\x00\x42\t\n\x07payload\"\x9b\x01\n\x04Knob\x12\x1a\n\x0bmac_address\x18\x01 \x01(\tB\x05\x92?\x02\x08\x32\x12\x19\n\nip_address\x18\x02 \x01(\tB\x05\x92?\x02\x08\x32\x12\x36\n\x11persistent_config\x18\x03 \x01(\x0b\x32\x1b.PB.PersistentConfiguration\x12$\n\x08settings\x18\x04 \x01(\x0b\x32\x12.SETTINGS.Settings\"\x90\x03\n\x0fMotorCalibState\x12\x12\n\ncalibrated\x18\x01 \x01(\x08\x12 \n\x04step\x18\x02 \x01(\x0e\x32\x12.PB.MotorCalibStep\x12\x1f\n\x10progress_percent\x18\x03 \x01(\rB\x05\x92?\x02\x18\x08\x12\x12\n\nelapsed_ms\x18\x04 \x01(\r\x12\x0c\n\x04\x66\x61st\x18\x05 \x01(\x08\x12\x14\n\x0c\x64irection_cw\x18\x06 \x01(\x08\x12\x1b\n\x13pole_pairs_estimate\x18\x07 \x01(\x02\x12\x19\n\npole_pairs\x18\x08 \x01(\rB\x05\x92?\x02\x18\x08\x12\x1e\n\x16zero_electrical_offset\x18\t \x01(\x02\x12\x18\n\x10\x66it_residual_rad\x18\n \x01(\x02\x12\x19\n\x11offset_spread_rad\x18\x0b \x01(\x02\x12%\n\x1dlinearity_residual_before_rad\x18\x0c \x01(\x02\x12$\n\x1clinearity_residual_after_rad\x18\r \x01(\x02\x12\x14\n\x0c\x63ogging_peak\x18\x0e \x01(\x02\"6\n\x10StrainCalibState\x12\x0c\n\x04step\x18\x01 \x01(\r\x12\x14\n\x0cstrain_scale\x18\x02 \x01(\x02\"\xa0\x03\n\x0eMotorLoopStats\x12\x13\n\x0b\x66oc_loop_hz\x18\x01 \x01(\r\x12\x1b\n\x13haptic_loop_divider\x18\x02 \x01(\r\x12\x0f\n\x07samples\x18\x03 \x01(\r\x12\x15\n\rperiod_min_us\x18\x04 \x01(\r\x12\x15\n\rperiod_avg_us\x18\x05 \x01(\r\x12\x15\n\rperiod_max_us\x18\x06 \x01(\r\x12\x13\n\x0b\x62usy_avg_us\x18\x07 \x01(\r\x12\x13\n\x0b\x62usy_max_us\x18\x08 \x01(\r\x12\x10\n\x08overruns\x18\t \x01(\r\x12\x11\n\twindow_ms\x18\n \x01(\r\x12\x16\n\x0e\x66oc_avg_cycles\x18\x0b \x01(\r\x12\x16\n\x0e\x66oc_max_cycles\x18\x0c \x01(\r\x12\x17\n\x0f\x63onfigs_applied\x18\r \x01(\r\x12\x16\n\x0e\x63onfigs_merged\x18\x0e \x01(\r\x12\x18\n\x10\x63ommands_dropped\x18\x0f \x01(\r\x12\x1d\n\x15\x63onfig_latency_avg_us\x18\x10 \x01(\r\x12\x1d\n\x15\x63onfig_latency_max_us\x18\x11 \x01(\r\"9\n\x12TelemetrySubscribe\x12\x0f\n\x07signals\x18\x01 \x01(\r\x12\x12\n\ndecimation\x18\x02 \x01(\r\"v\n\x0eTelemetryFrame\x12\x0f\n\x07signals\x18\x01 \x01(\r\x12\x14\n\x0c\x66irst_sample\x18\x02 \x01(\r\x12\x0f\n\x07\x64ropped\x18\x03 \x01(\r\x12\x14\n\x0csample_count\x18\x04 \x01(\r\x12\x16\n\x06values\x18\x05 \x03(\x11\x42\x06\x92?\x03\x10\x80\x01\"F\n\x14\x46lightRecorderConfig\x12\x10\n\x08triggers\x18\x01 \x01(\r\x12\x1c\n\x14post_trigger_samples\x18\x02 \x01(\r\"\x8f\x01\n\x0f\x46lightRecording\x12*\n\x07trigger\x18\x01 \x01(\x0e\x32\x19.PB.FlightRecorderTrigger\x12\x16\n\x0etrigger_sample\x18\x02 \x01(\r\x12\x15\n\rtotal_samples\x18\x03 \x01(\r\x12!\n\x05\x66rame\x18\x04 \x01(\x0b\x32\x12.PB.TelemetryFrame\"l\n\x14\x46requencySweepConfig\x12\x10\n\x08start_hz\x18\x01 \x01(\x02\x12\x0f\n\x07stop_hz\x18\x02 \x01(\x02\x12\x0e\n\x06points\x18\x03 \x01(\r\x12\x11\n\tamplitude\x18\x04 \x01(\x02\x12\x0e\n\x06\x63ycles\x18\x05 \x01(\r\"\x86\x01\n\x16\x46requencyResponsePoint\x12\x14\n\x0c\x66requency_hz\x18\x01 \x01(\x02\x12\x12\n\nplant_gain\x18\x02 \x01(\x02\x12\x17\n\x0fplant_phase_deg\x18\x03 \x01(\x02\x12\x11\n\tloop_gain\x18\x04 \x01(\x02\x12\x16\n\x0eloop_phase_deg\x18\x05 \x01(\x02\"\x90\x01\n\x11\x46requencyResponse\x12&\n\x05state\x18\x01 \x01(\x0e\x32\x17.PB.FrequencySweepState\x12\x13\n\x0bpoint_index\x18\x02 \x01(\r\x12\x13\n\x0bpoint_count\x18\x03 \x01(\r\x12)\n\x05point\x18\x04 \x01(\x0b\x32\x1a.PB.FrequencyResponsePoint\"\x7f\n\x0fMotorIdleConfig\x12\x0f\n\x07\x65nabled\x18\x01 \x01(\x08\x12\x12\n\ntimeout_ms\x18\x02 \x01(\r\x12\x0f\n\x07loop_hz\x18\x03 \x01(\r\x12\x1a\n\x12velocity_threshold\x18\x04 \x01(\x02\x12\x1a\n\x12wake_angle_radians\x18\x05 \x01(\x02\"\x93\x01\n\x0fMotorPowerEvent\x12\"\n\x05state\x18\x01 \x01(\x0e\x32\x13.PB.MotorPowerState\x12(\n\x0bwake_reason\x18\x02 \x01(\x0e\x32\x13.PB.MotorWakeReason\x12\x17\n\x0fwake_latency_us\x18\x03 \x01(\r\x12\x19\n\x11previous_state_ms\x18\x04 \x01(\r\"\xd6\x01\n\x0eSensorJobStats\x12\x13\n\x04name\x18\x01 \x01(\tB\x05\x92?\x02\x08\x0f\x12\x11\n\tperiod_us\x18\x02 \x01(\r\x12\x13\n\x0b\x64\x65\x61\x64line_us\x18\x03 \x01(\r\x12\x0c\n\x04runs\x18\x04 \x01(\r\x12\x12\n\nrun_avg_us\x18\x05 \x01(\r\x12\x12\n\nrun_max_us\x18\x06 \x01(\r\x12\x17\n\x0flateness_avg_us\x18\x07 \x01(\r\x12\x17\n\x0flateness_max_us\x18\x08 \x01(\r\x12\x0e\n\x06misses\x18\t \x01(\r\x12\x0f\n\x07skipped\x18\n \x01(\r\"R\n\x14SensorSchedulerStats\x12\'\n\x04jobs\x18\x01 \x03(\x0b\x32\x12.PB.SensorJobStatsB\x05\x92?\x02\x10\x08\x12\x11\n\twindow_ms\x18\x02 \x01(\r\"K\n\x13PressDetectorConfig\x12\x11\n\tthreshold\x18\x01 \x01(\x02\x12!\n\x19\x62\x61seline_time_constant_ms\x18\x02 \x01(\r\"\xd3\x01\n\x12PressDetectorStats\x12\x0f\n\x07presses\x18\x01 \x01(\r\x12\x11\n\tbucket_us\x18\x02 \x01(\r\x12 \n\x11latency_histogram\x18\x03 \x03(\rB\x05\x92?\x02\x10\x10\x12\x16\n\x0elatency_avg_us\x18\x04 \x01(\r\x12\x16\n\x0elatency_max_us\x18\x05 \x01(\r\x12\x11\n\tthreshold\x18\x06 \x01(\x02\x12!\n\x19\x62\x61seline_time_constant_ms\x18\x07 \x01(\r\x12\x11\n\twindow_ms\x18\x08 \x01(\r\"\x14\n\x03\x41\x63k\x12\r\n\x05nonce\x18\x01 \x01(\r\"b\n\x03Log\x12\x13\n\x03msg\x18\x01 \x01(\tB\x06\x92?\x03\x08\xff\x01\x12\x1b\n\x05level\x18\x02 \x01(\x0e\x32\x0c.PB.LogLevel\x12\x16\n\x06origin\x18\x03 \x01(\tB\x06\x92?\x03\x08\x80\x01\x12\x11\n\tisVerbose\x18\x04 \x01(\x08\"\x86\x01\n\x0eSmartKnobState\x12\x18\n\x10\x63urrent_position\x18\x01 \x01(\x05\x12\x19\n\x11sub_position_unit\x18\x02 \x01(\x02\x12#\n\x06\x63onfig\x18\x03 \x01(\x0b\x32\x13.PB.SmartKnobConfig\x12\x1a\n\x0bpress_nonce\x18\x04 \x01(\rB\x05\x92?\x02\x18\x08\"\xb9\x04\n\x0fSmartKnobConfig\x12\x10\n\x08position\x18\x01 \x01(\x05\x12\x19\n\x11sub_position_unit\x18\x02 \x01(\x02\x12\x1d\n\x0eposition_nonce\x18\x03 \x01(\rB\x05\x92?\x02\x18\x08\x12\x14\n\x0cmin_position\x18\x04 \x01(\x05\x12\x14\n\x0cmax_position\x18\x05 \x01(\x05\x12\x1e\n\x16position_width_radians\x18\x06 \x01(\x02\x12\x1c\n\x14\x64\x65tent_strength_unit\x18\x07 \x01(\x02\x12\x1d\n\x15\x65ndstop_strength_unit\x18\x08 \x01(\x02\x12\x12\n\nsnap_point\x18\t \x01(\x02\x12\x11\n\x02id\x18\n \x01(\tB\x05\x92?\x02\x08@\x12\x1f\n\x10\x64\x65tent_positions\x18\x0b \x03(\x05\x42\x05\x92?\x02\x10\x05\x12\x17\n\x0fsnap_point_bias\x18\x0c \x01(\x02\x12\x16\n\x07led_hue\x18\r \x01(\x05\x42\x05\x92?\x02\x18\x10\x12 \n\x11torque_profile_id\x18\x0e \x01(\rB\x05\x92?\x02\x18\x08\x12\x1c\n\rdetent_set_id\x18\x0f \x01(\rB\x05\x92?\x02\x18\x08\x12%\n\x0cmotion_model\x18\x10 \x01(\x0e\x32\x0f.PB.MotionModel\x12\x18\n\x10\x66lywheel_inertia\x18\x11 \x01(\x02\x12\x19\n\x11\x66lywheel_friction\x18\x12 \x01(\x02\x12 \n\x18spring_dead_band_radians\x18\x13 \x01(\x02\x12\x1a\n\x12ratchet_decreasing\x18\x14 \x01(\x08\"\x0e\n\x0cRequestState\"e\n\x17PersistentConfiguration\x12\x0f\n\x07version\x18\x01 \x01(\r\x12#\n\x05motor\x18\x02 \x01(\x0b\x32\x14.PB.MotorCalibration\x12\x14\n\x0cstrain_scale\x18\x03 \x01(\x02\"\xa1\x01\n\x10MotorCalibration\x12\x12\n\ncalibrated\x18\x01 \x01(\x08\x12\x1e\n\x16zero_electrical_offset\x18\x02 \x01(\x02\x12\x14\n\x0c\x64irection_cw\x18\x03 \x01(\x08\x12\x12\n\npole_pairs\x18\x04 \x01(\r\x12/\n\rlinearization\x18\x05 \x01(\x0b\x32\x18.PB.EncoderLinearization\"\x89\x01\n\x14\x45ncoderLinearization\x12\x1b\n\x0charmonic_cos\x18\x01 \x03(\x02\x42\x05\x92?\x02\x10\x04\x12\x1b\n\x0charmonic_sin\x18\x02 \x03(\x02\x42\x05\x92?\x02\x10\x04\x12\x1b\n\x13residual_before_rad\x18\x03 \x01(\x02\x12\x1a\n\x12residual_after_rad\x18\x04 \x01(\x02\"4\n\nCoggingMap\x12\r\n\x05scale\x18\x01 \x01(\x02\x12\x17\n\x07samples\x18\x02 \x01(\x0c\x42\x06\x92?\x03 \x80\x04\"\x90\x01\n\x0cGainSchedule\x12&\n\x17position_widths_radians\x18\x01 \x03(\x02\x42\x05\x92?\x02\x10\x06\x12\x18\n\tstrengths\x18\x02 \x03(\x02\x42\x05\x92?\x02\x10\x04\x12\x10\n\x01p\x18\x03 \x03(\x02\x42\x05\x92?\x02\x10H\x12\x10\n\x01\x64\x18\x04 \x03(\x02\x42\x05\x92?\x02\x10H\x12\x1a\n\x0boutput_ramp\x18\x05 \x03(\x02\x42\x05\x92?\x02\x10H\"8\n\x0bStrainState\x12\x14\n\x0cpress_weight\x18\x01 \x01(\x05\x12\x13\n\x0bpress_value\x18\x02 \x01(\x02\"/\n\x11StrainCalibration\x12\x1a\n\x12\x63\x61libration_weight\x18\x01 \x01(\x02\"\xa3\x01\n\rTorqueProfile\x12\x11\n\x02id\x18\x01 \x01(\rB\x05\x92?\x02\x18\x08\x12#\n\x04mode\x18\x02 \x01(\x0e\x32\x15.PB.TorqueProfileMode\x12\x1d\n\x0e\x64\x65tent_samples\x18\x03 \x03(\x02\x42\x05\x92?\x02\x10@\x12\x1e\n\x0f\x65ndstop_samples\x18\x04 \x03(\x02\x42\x05\x92?\x02\x10\x10\x12\x1b\n\x13\x65ndstop_range_units\x18\x05 \x01(\x02\"s\n\tDetentSet\x12\x11\n\x02id\x18\x01 \x01(\rB\x05\x92?\x02\x18\x08\x12\x0e\n\x06period\x18\x02 \x01(\r\x12\x15\n\rperiod_offset\x18\x03 \x01(\x05\x12\x14\n\x0c\x62itmap_start\x18\x04 \x01(\x05\x12\x16\n\x06\x62itmap\x18\x05 \x01(\x0c\x42\x06\x92?\x03 \x80\x01\"F\n\nPlayHaptic\x12&\n\x08waveform\x18\x01 \x01(\x0e\x32\x14.PB.HapticWaveformId\x12\x10\n\x08strength\x18\x02 \x01(\x02\"q\n\x0eHapticWaveform\x12&\n\x08waveform\x18\x01 \x01(\x0e\x32\x14.PB.HapticWaveformId\x12\x1f\n\x10ticks_per_sample\x18\x02 \x01(\rB\x05\x92?\x02\x18\x08\x12\x16\n\x07samples\x18\x03 \x03(\x02\x42\x05\x92?\x02\x10@\"\xd0\x01\n\x0c\x41ppComponent\x12\x1b\n\x0c\x63omponent_id\x18\x01 \x01(\tB\x05\x92?\x02\x08 \x12\x1f\n\x04type\x18\x02 \x01(\x0e\x32\x11.PB.ComponentType\x12\x1b\n\x0c\x64isplay_name\x18\x03 \x01(\tB\x05\x92?\x02\x08@\x12\"\n\x06toggle\x18\x04 \x01(\x0b\x32\x10.PB.ToggleConfigH\x00\x12-\n\x0cmulti_choice\x18\x06 \x01(\x0b\x32\x15.PB.MultiChoiceConfigH\x00\x42\x12\n\x10\x63omponent_config\"\xda\x01\n\x0cToggleConfig\x12\x18\n\toff_label\x18\x01 \x01(\tB\x05\x92?\x02\x08 \x12\x17\n\x08on_label\x18\x02 \x01(\tB\x05\x92?\x02\x08 \x12\x12\n\nsnap_point\x18\x03 \x01(\x02\x12\x17\n\x0fsnap_point_bias\x18\x04 \x01(\x02\x12\x1c\n\x14\x64\x65tent_strength_unit\x18\x05 \x01(\x02\x12\x1a\n\x0boff_led_hue\x18\x06 \x01(\x05\x42\x05\x92?\x02\x18\x10\x12\x19\n\non_led_hue\x18\x07 \x01(\x05\x42\x05\x92?\x02\x18\x10\x12\x15\n\rinitial_state\x18\x08 \x01(\x08\"\xcd\x01\n\x11MultiChoiceConfig\x12\x1b\n\x07options\x18\x01 \x03(\tB\n\x92?\x02\x10\x10\x92?\x02\x08 \x12\x1c\n\rinitial_index\x18\x02 \x01(\x05\x42\x05\x92?\x02\x18\x08\x12\x13\n\x0bwrap_around\x18\x03 \x01(\x08\x12\x13\n\x0b\x63\x65nter_text\x18\x04 \x01(\x08\x12\x1c\n\x14\x64\x65tent_strength_unit\x18\x05 \x01(\x02\x12\x1d\n\x15\x65ndstop_strength_unit\x18\x06 \x01(\x02\x12\x16\n\x07led_hue\x18\x07 \x01(\x05\x42\x05\x92?\x02\x18\x10*\x91\x02\n\x0eMotorCalibStep\x12\x14\n\x10MOTOR_CALIB_IDLE\x10\x00\x12\x18\n\x14MOTOR_CALIB_SETTLING\x10\x01\x12\x19\n\x15MOTOR_CALIB_DIRECTION\x10\x02\x12\x1a\n\x16MOTOR_CALIB_POLE_PAIRS\x10\x03\x12\x1f\n\x1bMOTOR_CALIB_ELECTRICAL_ZERO\x10\x04\x12\x15\n\x11MOTOR_CALIB_SWEEP\x10\x05\x12\x14\n\x10MOTOR_CALIB_DONE\x10\x06\x12\x16\n\x12MOTOR_CALIB_FAILED\x10\x07\x12\x19\n\x15MOTOR_CALIB_LINEARITY\x10\x08\x12\x17\n\x13MOTOR_CALIB_COGGING\x10\t*\xd3\x01\n\x0fTelemetrySignal\x12\x13\n\x0fTELEMETRY_ANGLE\x10\x00\x12\x16\n\x12TELEMETRY_VELOCITY\x10\x01\x12\x1a\n\x16TELEMETRY_ACCELERATION\x10\x02\x12\x1a\n\x16TELEMETRY_DETENT_ERROR\x10\x03\x12\x14\n\x10TELEMETRY_TORQUE\x10\x04\x12\x16\n\x12TELEMETRY_POSITION\x10\x05\x12\x17\n\x13TELEMETRY_LOOP_BUSY\x10\x06\x12\x14\n\x10TELEMETRY_EVENTS\x10\x07*\xd0\x01\n\x15\x46lightRecorderTrigger\x12\x17\n\x13\x46LIGHT_TRIGGER_NONE\x10\x00\x12#\n\x1f\x46LIGHT_TRIGGER_VELOCITY_RUNAWAY\x10\x01\x12\x1d\n\x19\x46LIGHT_TRIGGER_SENSOR_CRC\x10\x02\x12 \n\x1c\x46LIGHT_TRIGGER_SENSOR_STATUS\x10\x03\x12\x1f\n\x1b\x46LIGHT_TRIGGER_LOOP_OVERRUN\x10\x04\x12\x17\n\x13\x46LIGHT_TRIGGER_HOST\x10\x05*\x83\x01\n\x13\x46requencySweepState\x12\x18\n\x14\x46REQUENCY_SWEEP_IDLE\x10\x00\x12\x1b\n\x17\x46REQUENCY_SWEEP_RUNNING\x10\x01\x12\x18\n\x14\x46REQUENCY_SWEEP_DONE\x10\x02\x12\x1b\n\x17\x46REQUENCY_SWEEP_ABORTED\x10\x03*?\n\x0fMotorPowerState\x12\x16\n\x12MOTOR_POWER_ACTIVE\x10\x00\x12\x14\n\x10MOTOR_POWER_IDLE\x10\x01*n\n\x0fMotorWakeReason\x12\x13\n\x0fMOTOR_WAKE_NONE\x10\x00\x12\x15\n\x11MOTOR_WAKE_MOTION\x10\x01\x12\x17\n\x13MOTOR_WAKE_PRESENCE\x10\x02\x12\x16\n\x12MOTOR_WAKE_COMMAND\x10\x03*D\n\x08LogLevel\x12\x08\n\x04INFO\x10\x00\x12\x0b\n\x07WARNING\x10\x01\x12\t\n\x05\x45RROR\x10\x02\x12\t\n\x05\x44\x45\x42UG\x10\x03\x12\x0b\n\x07VERBOSE\x10\x04*d\n\x0bMotionModel\x12\x12\n\x0eMOTION_DETENTS\x10\x00\x12\x13\n\x0fMOTION_FLYWHEEL\x10\x01\x12\x18\n\x14MOTION_SPRING_RETURN\x10\x02\x12\x12\n\x0eMOTION_RATCHET\x10\x03*W\n\x10GainScheduleMode\x12\x14\n\x10GAIN_MODE_DETENT\x10\x00\x12\x16\n\x12GAIN_MODE_MAGNETIC\x10\x01\x12\x15\n\x11GAIN_MODE_ENDSTOP\x10\x02*\xb2\x02\n\x10SmartKnobCommand\x12\x11\n\rGET_KNOB_INFO\x10\x00\x12\x13\n\x0fMOTOR_CALIBRATE\x10\x01\x12\x14\n\x10STRAIN_CALIBRATE\x10\x02\x12\x18\n\x14GET_MOTOR_LOOP_STATS\x10\x03\x12\x18\n\x14MOTOR_CALIBRATE_FAST\x10\x04\x12\x1b\n\x17MOTOR_CALIBRATE_COGGING\x10\x05\x12\x1b\n\x17\x46LIGHT_RECORDER_TRIGGER\x10\x06\x12\x1a\n\x16\x46LIGHT_RECORDER_UPLOAD\x10\x07\x12\x18\n\x14\x46REQUENCY_SWEEP_STOP\x10\x08\x12\x1e\n\x1aGET_SENSOR_SCHEDULER_STATS\x10\t\x12\x1c\n\x18GET_PRESS_DETECTOR_STATS\x10\n*Q\n\x11TorqueProfileMode\x12\x1d\n\x19TORQUE_PROFILE_PER_DETENT\x10\x00\x12\x1d\n\x19TORQUE_PROFILE_FULL_RANGE\x10\x01*\xbc\x01\n\x10HapticWaveformId\x12\x10\n\x0cHAPTIC_CLICK\x10\x00\x12\x17\n\x13HAPTIC_DOUBLE_CLICK\x10\x01\x12\x0f\n\x0bHAPTIC_BUZZ\x10\x02\x12\x0f\n\x0bHAPTIC_RAMP\x10\x03\x12\x0f\n\x0bHAPTIC_THUD\x10\x04\x12\x11\n\rHAPTIC_USER_0\x10\x10\x12\x11\n\rHAPTIC_USER_1\x10\x11\x12\x11\n\rHAPTIC_USER_2\x10\x12\x12\x11\n\rHAPTIC_USER_3\x10\x13*-\n\rComponentType\x12\n\n\x06TOGGLE\x10\x00\x12\x10\n\x0cMULTI_CHOICE\x10\x02\x62\x06proto3')
 
 _globals = globals()
 _builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, _globals)
@@ -41,6 +41,18 @@ if not _descriptor._USE_C_DESCRIPTORS:
   _globals['_KNOB'].fields_by_name['mac_address']._serialized_options = b'\222?\002\0102'
   _globals['_KNOB'].fields_by_name['ip_address']._loaded_options = None
   _globals['_KNOB'].fields_by_name['ip_address']._serialized_options = b'\222?\002\0102'
+  _globals['_MOTORCALIBSTATE'].fields_by_name['progress_percent']._loaded_options = None
+  _globals['_MOTORCALIBSTATE'].fields_by_name['progress_percent']._serialized_options = b'\222?\002\030\010'
+  _globals['_MOTORCALIBSTATE'].fields_by_name['pole_pairs']._loaded_options = None
+  _globals['_MOTORCALIBSTATE'].fields_by_name['pole_pairs']._serialized_options = b'\222?\002\030\010'
+  _globals['_TELEMETRYFRAME'].fields_by_name['values']._loaded_options = None
+  _globals['_TELEMETRYFRAME'].fields_by_name['values']._serialized_options = b'\222?\003\020\200\001'
+  _globals['_SENSORJOBSTATS'].fields_by_name['name']._loaded_options = None
+  _globals['_SENSORJOBSTATS'].fields_by_name['name']._serialized_options = b'\222?\002\010\017'
+  _globals['_SENSORSCHEDULERSTATS'].fields_by_name['jobs']._loaded_options = None
+  _globals['_SENSORSCHEDULERSTATS'].fields_by_name['jobs']._serialized_options = b'\222?\002\020\010'
+  _globals['_PRESSDETECTORSTATS'].fields_by_name['latency_histogram']._loaded_options = None
+  _globals['_PRESSDETECTORSTATS'].fields_by_name['latency_histogram']._serialized_options = b'\222?\002\020\020'
   _globals['_LOG'].fields_by_name['msg']._loaded_options = None
   _globals['_LOG'].fields_by_name['msg']._serialized_options = b'\222?\003\010\377\001'
   _globals['_LOG'].fields_by_name['origin']._loaded_options = None
@@ -55,6 +67,40 @@ if not _descriptor._USE_C_DESCRIPTORS:
   _globals['_SMARTKNOBCONFIG'].fields_by_name['detent_positions']._serialized_options = b'\222?\002\020\005'
   _globals['_SMARTKNOBCONFIG'].fields_by_name['led_hue']._loaded_options = None
   _globals['_SMARTKNOBCONFIG'].fields_by_name['led_hue']._serialized_options = b'\222?\002\030\020'
+  _globals['_SMARTKNOBCONFIG'].fields_by_name['torque_profile_id']._loaded_options = None
+  _globals['_SMARTKNOBCONFIG'].fields_by_name['torque_profile_id']._serialized_options = b'\222?\002\030\010'
+  _globals['_SMARTKNOBCONFIG'].fields_by_name['detent_set_id']._loaded_options = None
+  _globals['_SMARTKNOBCONFIG'].fields_by_name['detent_set_id']._serialized_options = b'\222?\002\030\010'
+  _globals['_ENCODERLINEARIZATION'].fields_by_name['harmonic_cos']._loaded_options = None
+  _globals['_ENCODERLINEARIZATION'].fields_by_name['harmonic_cos']._serialized_options = b'\222?\002\020\004'
+  _globals['_ENCODERLINEARIZATION'].fields_by_name['harmonic_sin']._loaded_options = None
+  _globals['_ENCODERLINEARIZATION'].fields_by_name['harmonic_sin']._serialized_options = b'\222?\002\020\004'
+  _globals['_COGGINGMAP'].fields_by_name['samples']._loaded_options = None
+  _globals['_COGGINGMAP'].fields_by_name['samples']._serialized_options = b'\222?\003 \200\004'
+  _globals['_GAINSCHEDULE'].fields_by_name['position_widths_radians']._loaded_options = None
+  _globals['_GAINSCHEDULE'].fields_by_name['position_widths_radians']._serialized_options = b'\222?\002\020\006'
+  _globals['_GAINSCHEDULE'].fields_by_name['strengths']._loaded_options = None
+  _globals['_GAINSCHEDULE'].fields_by_name['strengths']._serialized_options = b'\222?\002\020\004'
+  _globals['_GAINSCHEDULE'].fields_by_name['p']._loaded_options = None
+  _globals['_GAINSCHEDULE'].fields_by_name['p']._serialized_options = b'\222?\002\020H'
+  _globals['_GAINSCHEDULE'].fields_by_name['d']._loaded_options = None
+  _globals['_GAINSCHEDULE'].fields_by_name['d']._serialized_options = b'\222?\002\020H'
+  _globals['_GAINSCHEDULE'].fields_by_name['output_ramp']._loaded_options = None
+  _globals['_GAINSCHEDULE'].fields_by_name['output_ramp']._serialized_options = b'\222?\002\020H'
+  _globals['_TORQUEPROFILE'].fields_by_name['id']._loaded_options = None
+  _globals['_TORQUEPROFILE'].fields_by_name['id']._serialized_options = b'\222?\002\030\010'
+  _globals['_TORQUEPROFILE'].fields_by_name['detent_samples']._loaded_options = None
+  _globals['_TORQUEPROFILE'].fields_by_name['detent_samples']._serialized_options = b'\222?\002\020@'
+  _globals['_TORQUEPROFILE'].fields_by_name['endstop_samples']._loaded_options = None
+  _globals['_TORQUEPROFILE'].fields_by_name['endstop_samples']._serialized_options = b'\222?\002\020\020'
+  _globals['_DETENTSET'].fields_by_name['id']._loaded_options = None
+  _globals['_DETENTSET'].fields_by_name['id']._serialized_options = b'\222?\002\030\010'
+  _globals['_DETENTSET'].fields_by_name['bitmap']._loaded_options = None
+  _globals['_DETENTSET'].fields_by_name['bitmap']._serialized_options = b'\222?\003 \200\001'
+  _globals['_HAPTICWAVEFORM'].fields_by_name['ticks_per_sample']._loaded_options = None
+  _globals['_HAPTICWAVEFORM'].fields_by_name['ticks_per_sample']._serialized_options = b'\222?\002\030\010'
+  _globals['_HAPTICWAVEFORM'].fields_by_name['samples']._loaded_options = None
+  _globals['_HAPTICWAVEFORM'].fields_by_name['samples']._serialized_options = b'\222?\002\020@'
   _globals['_APPCOMPONENT'].fields_by_name['component_id']._loaded_options = None
   _globals['_APPCOMPONENT'].fields_by_name['component_id']._serialized_options = b'\222?\002\010 '
   _globals['_APPCOMPONENT'].fields_by_name['display_name']._loaded_options = None
@@ -68,49 +114,111 @@ if not _descriptor._USE_C_DESCRIPTORS:
   _globals['_TOGGLECONFIG'].fields_by_name['on_led_hue']._loaded_options = None
   _globals['_TOGGLECONFIG'].fields_by_name['on_led_hue']._serialized_options = b'\222?\002\030\020'
   _globals['_MULTICHOICECONFIG'].fields_by_name['options']._loaded_options = None
-  _globals['_MULTICHOICECONFIG'].fields_by_name['options']._serialized_options = b'\222?\004\010 \020\020'
+  _globals['_MULTICHOICECONFIG'].fields_by_name['options']._serialized_options = b'\222?\002\020\020\222?\002\010 '
   _globals['_MULTICHOICECONFIG'].fields_by_name['initial_index']._loaded_options = None
   _globals['_MULTICHOICECONFIG'].fields_by_name['initial_index']._serialized_options = b'\222?\002\030\010'
   _globals['_MULTICHOICECONFIG'].fields_by_name['led_hue']._loaded_options = None
   _globals['_MULTICHOICECONFIG'].fields_by_name['led_hue']._serialized_options = b'\222?\002\030\020'
-  _globals['_LOGLEVEL']._serialized_start=2535
-  _globals['_LOGLEVEL']._serialized_end=2603
-  _globals['_SMARTKNOBCOMMAND']._serialized_start=2605
-  _globals['_SMARTKNOBCOMMAND']._serialized_end=2685
-  _globals['_COMPONENTTYPE']._serialized_start=2687
-  _globals['_COMPONENTTYPE']._serialized_end=2732
+  _globals['_MOTORCALIBSTEP']._serialized_start=6913
+  _globals['_MOTORCALIBSTEP']._serialized_end=7186
+  _globals['_TELEMETRYSIGNAL']._serialized_start=7189
+  _globals['_TELEMETRYSIGNAL']._serialized_end=7400
+  _globals['_FLIGHTRECORDERTRIGGER']._serialized_start=7403
+  _globals['_FLIGHTRECORDERTRIGGER']._serialized_end=7611
+  _globals['_FREQUENCYSWEEPSTATE']._serialized_start=7614
+  _globals['_FREQUENCYSWEEPSTATE']._serialized_end=7745
+  _globals['_MOTORPOWERSTATE']._serialized_start=7747
+  _globals['_MOTORPOWERSTATE']._serialized_end=7810
+  _globals['_MOTORWAKEREASON']._serialized_start=7812
+  _globals['_MOTORWAKEREASON']._serialized_end=7922
+  _globals['_LOGLEVEL']._serialized_start=7924
+  _globals['_LOGLEVEL']._serialized_end=7992
+  _globals['_MOTIONMODEL']._serialized_start=7994
+  _globals['_MOTIONMODEL']._serialized_end=8094
+  _globals['_GAINSCHEDULEMODE']._serialized_start=8096
+  _globals['_GAINSCHEDULEMODE']._serialized_end=8183
+  _globals['_SMARTKNOBCOMMAND']._serialized_start=8186
+  _globals['_SMARTKNOBCOMMAND']._serialized_end=8492
+  _globals['_TORQUEPROFILEMODE']._serialized_start=8494
+  _globals['_TORQUEPROFILEMODE']._serialized_end=8575
+  _globals['_HAPTICWAVEFORMID']._serialized_start=8578
+  _globals['_HAPTICWAVEFORMID']._serialized_end=8766
+  _globals['_COMPONENTTYPE']._serialized_start=8768
+  _globals['_COMPONENTTYPE']._serialized_end=8813
   _globals['_FROMSMARTKNOB']._serialized_start=54
-  _globals['_FROMSMARTKNOB']._serialized_end=336
-  _globals['_TOSMARTKNOB']._serialized_start=339
-  _globals['_TOSMARTKNOB']._serialized_end=690
-  _globals['_KNOB']._serialized_start=693
-  _globals['_KNOB']._serialized_end=848
-  _globals['_MOTORCALIBSTATE']._serialized_start=850
-  _globals['_MOTORCALIBSTATE']._serialized_end=887
-  _globals['_STRAINCALIBSTATE']._serialized_start=889
-  _globals['_STRAINCALIBSTATE']._serialized_end=943
-  _globals['_ACK']._serialized_start=945
-  _globals['_ACK']._serialized_end=965
-  _globals['_LOG']._serialized_start=967
-  _globals['_LOG']._serialized_end=1065
-  _globals['_SMARTKNOBSTATE']._serialized_start=1068
-  _globals['_SMARTKNOBSTATE']._serialized_end=1202
-  _globals['_SMARTKNOBCONFIG']._serialized_start=1205
-  _globals['_SMARTKNOBCONFIG']._serialized_end=1556
-  _globals['_REQUESTSTATE']._serialized_start=1558
-  _globals['_REQUESTSTATE']._serialized_end=1572
-  _globals['_PERSISTENTCONFIGURATION']._serialized_start=1574
-  _globals['_PERSISTENTCONFIGURATION']._serialized_end=1675
-  _globals['_MOTORCALIBRATION']._serialized_start=1677
-  _globals['_MOTORCALIBRATION']._serialized_end=1789
-  _globals['_STRAINSTATE']._serialized_start=1791
-  _globals['_STRAINSTATE']._serialized_end=1847
-  _globals['_STRAINCALIBRATION']._serialized_start=1849
-  _globals['_STRAINCALIBRATION']._serialized_end=1896
-  _globals['_APPCOMPONENT']._serialized_start=1899
-  _globals['_APPCOMPONENT']._serialized_end=2107
-  _globals['_TOGGLECONFIG']._serialized_start=2110
-  _globals['_TOGGLECONFIG']._serialized_end=2328
-  _globals['_MULTICHOICECONFIG']._serialized_start=2331
-  _globals['_MULTICHOICECONFIG']._serialized_end=2533
+  _globals['_FROMSMARTKNOB']._serialized_end=699
+  _globals['_TOSMARTKNOB']._serialized_start=702
+  _globals['_TOSMARTKNOB']._serialized_end=1540
+  _globals['_KNOB']._serialized_start=1543
+  _globals['_KNOB']._serialized_end=1698
+  _globals['_MOTORCALIBSTATE']._serialized_start=1701
+  _globals['_MOTORCALIBSTATE']._serialized_end=2101
+  _globals['_STRAINCALIBSTATE']._serialized_start=2103
+  _globals['_STRAINCALIBSTATE']._serialized_end=2157
+  _globals['_MOTORLOOPSTATS']._serialized_start=2160
+  _globals['_MOTORLOOPSTATS']._serialized_end=2576
+  _globals['_TELEMETRYSUBSCRIBE']._serialized_start=2578
+  _globals['_TELEMETRYSUBSCRIBE']._serialized_end=2635
+  _globals['_TELEMETRYFRAME']._serialized_start=2637
+  _globals['_TELEMETRYFRAME']._serialized_end=2755
+  _globals['_FLIGHTRECORDERCONFIG']._serialized_start=2757
+  _globals['_FLIGHTRECORDERCONFIG']._serialized_end=2827
+  _globals['_FLIGHTRECORDING']._serialized_start=2830
+  _globals['_FLIGHTRECORDING']._serialized_end=2973
+  _globals['_FREQUENCYSWEEPCONFIG']._serialized_start=2975
+  _globals['_FREQUENCYSWEEPCONFIG']._serialized_end=3083
+  _globals['_FREQUENCYRESPONSEPOINT']._serialized_start=3086
+  _globals['_FREQUENCYRESPONSEPOINT']._serialized_end=3220
+  _globals['_FREQUENCYRESPONSE']._serialized_start=3223
+  _globals['_FREQUENCYRESPONSE']._serialized_end=3367
+  _globals['_MOTORIDLECONFIG']._serialized_start=3369
+  _globals['_MOTORIDLECONFIG']._serialized_end=3496
+  _globals['_MOTORPOWEREVENT']._serialized_start=3499
+  _globals['_MOTORPOWEREVENT']._serialized_end=3646
+  _globals['_SENSORJOBSTATS']._serialized_start=3649
+  _globals['_SENSORJOBSTATS']._serialized_end=3863
+  _globals['_SENSORSCHEDULERSTATS']._serialized_start=3865
+  _globals['_SENSORSCHEDULERSTATS']._serialized_end=3947
+  _globals['_PRESSDETECTORCONFIG']._serialized_start=3949
+  _globals['_PRESSDETECTORCONFIG']._serialized_end=4024
+  _globals['_PRESSDETECTORSTATS']._serialized_start=4027
+  _globals['_PRESSDETECTORSTATS']._serialized_end=4238
+  _globals['_ACK']._serialized_start=4240
+  _globals['_ACK']._serialized_end=4260
+  _globals['_LOG']._serialized_start=4262
+  _globals['_LOG']._serialized_end=4360
+  _globals['_SMARTKNOBSTATE']._serialized_start=4363
+  _globals['_SMARTKNOBSTATE']._serialized_end=4497
+  _globals['_SMARTKNOBCONFIG']._serialized_start=4500
+  _globals['_SMARTKNOBCONFIG']._serialized_end=5069
+  _globals['_REQUESTSTATE']._serialized_start=5071
+  _globals['_REQUESTSTATE']._serialized_end=5085
+  _globals['_PERSISTENTCONFIGURATION']._serialized_start=5087
+  _globals['_PERSISTENTCONFIGURATION']._serialized_end=5188
+  _globals['_MOTORCALIBRATION']._serialized_start=5191
+  _globals['_MOTORCALIBRATION']._serialized_end=5352
+  _globals['_ENCODERLINEARIZATION']._serialized_start=5355
+  _globals['_ENCODERLINEARIZATION']._serialized_end=5492
+  _globals['_COGGINGMAP']._serialized_start=5494
+  _globals['_COGGINGMAP']._serialized_end=5546
+  _globals['_GAINSCHEDULE']._serialized_start=5549
+  _globals['_GAINSCHEDULE']._serialized_end=5693
+  _globals['_STRAINSTATE']._serialized_start=5695
+  _globals['_STRAINSTATE']._serialized_end=5751
+  _globals['_STRAINCALIBRATION']._serialized_start=5753
+  _globals['_STRAINCALIBRATION']._serialized_end=5800
+  _globals['_TORQUEPROFILE']._serialized_start=5803
+  _globals['_TORQUEPROFILE']._serialized_end=5966
+  _globals['_DETENTSET']._serialized_start=5968
+  _globals['_DETENTSET']._serialized_end=6083
+  _globals['_PLAYHAPTIC']._serialized_start=6085
+  _globals['_PLAYHAPTIC']._serialized_end=6155
+  _globals['_HAPTICWAVEFORM']._serialized_start=6157
+  _globals['_HAPTICWAVEFORM']._serialized_end=6270
+  _globals['_APPCOMPONENT']._serialized_start=6273
+  _globals['_APPCOMPONENT']._serialized_end=6481
+  _globals['_TOGGLECONFIG']._serialized_start=6484
+  _globals['_TOGGLECONFIG']._serialized_end=6702
+  _globals['_MULTICHOICECONFIG']._serialized_start=6705
+  _globals['_MULTICHOICECONFIG']._serialized_end=6910
 # @@protoc_insertion_point(module_scope)